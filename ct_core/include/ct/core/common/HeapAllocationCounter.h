@@ -0,0 +1,117 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+namespace ct {
+namespace core {
+
+//! Process-wide counter of heap allocations, used to instrument real-time critical code
+/*!
+ * The counter is only incremented if the allocation functions are instrumented, which is done by defining
+ * CT_INSTRUMENT_HEAP_ALLOCATIONS in exactly one translation unit of the executable before including this header:
+ *
+ * \code
+ * #define CT_INSTRUMENT_HEAP_ALLOCATIONS
+ * #include <ct/core/common/HeapAllocationCounter.h>
+ * \endcode
+ *
+ * This replaces malloc, calloc and realloc, which are also used by operator new and by Eigen's aligned allocator,
+ * as well as the aligned allocation functions posix_memalign, aligned_alloc and memalign, which are used by the
+ * over-aligned operator new and by Eigen if the platform malloc is already aligned.
+ * The instrumentation is only available with the GNU C library, otherwise isEnabled() returns false.
+ */
+class HeapAllocationCounter
+{
+public:
+    //! total number of heap allocations since program start
+    static size_t get() { return counter().load(std::memory_order_relaxed); }
+
+    //! true if the allocation functions are instrumented
+    static bool isEnabled() { return enabled().load(std::memory_order_relaxed); }
+
+    //! register a heap allocation, called by the instrumented allocation functions
+    static void increment()
+    {
+        counter().fetch_add(1, std::memory_order_relaxed);
+        enabled().store(true, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<size_t>& counter()
+    {
+        static std::atomic<size_t> counter(0);
+        return counter;
+    }
+
+    static std::atomic<bool>& enabled()
+    {
+        static std::atomic<bool> enabled(false);
+        return enabled;
+    }
+};
+
+}  // namespace core
+}  // namespace ct
+
+
+#if defined(CT_INSTRUMENT_HEAP_ALLOCATIONS) && defined(__GLIBC__)
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) __THROW
+{
+    ct::core::HeapAllocationCounter::increment();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) __THROW
+{
+    ct::core::HeapAllocationCounter::increment();
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size) __THROW
+{
+    ct::core::HeapAllocationCounter::increment();
+    return __libc_realloc(ptr, size);
+}
+
+int posix_memalign(void** memptr, size_t alignment, size_t size) __THROW
+{
+    // the alignment has to be a power of two multiple of sizeof(void*)
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0)
+        return EINVAL;
+
+    ct::core::HeapAllocationCounter::increment();
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr)
+        return ENOMEM;
+    *memptr = ptr;
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) __THROW
+{
+    ct::core::HeapAllocationCounter::increment();
+    return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) __THROW
+{
+    ct::core::HeapAllocationCounter::increment();
+    return __libc_memalign(alignment, size);
+}
+}
+
+#endif
@@ -5,6 +5,9 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include <ct/core/types/arrays/DiscreteArray.h>
 #include <ct/core/types/arrays/TimeArray.h>
 
@@ -108,6 +111,70 @@ public:
             throw std::runtime_error("Unknown Interpolation type!");
     }
 
+    //! Interpolate at many enquiry times at once
+    /*!
+	 * The indices and interpolation weights of all enquiry times are computed first, followed by a single sweep
+	 * over the data. For sorted enquiry times, the index search starts from the previous bracket, hence the
+	 * overall cost is linear in the number of data points plus enquiry times.
+	 *
+	 * @param timeArray timing information of the data points
+	 * @param dataArray	the data points in form of a DiscreteArray
+	 * @param enquiryTimes the times where to evaluate the interpolation
+	 * @param enquiryData the results of the interpolation, resized to the number of enquiry times
+	 */
+    void interpolate(const tpl::TimeArray<SCALAR>& timeArray,
+        const DiscreteArray_t& dataArray,
+        const tpl::TimeArray<SCALAR>& enquiryTimes,
+        DiscreteArray_t& enquiryData)
+    {
+        const size_t M = enquiryTimes.size();
+        enquiryData.resize(M);
+
+        if (timeArray.size() != dataArray.size() || timeArray.size() < 2)
+        {
+            for (size_t j = 0; j < M; j++)
+                interpolate(timeArray, dataArray, enquiryTimes[j], enquiryData[j]);
+            return;
+        }
+
+        if (type_ == InterpolationType::ZOH)
+        {
+            for (size_t j = 0; j < M; j++)
+                enquiryData[j] = dataArray[findIndex(timeArray, enquiryTimes[j])];
+            return;
+        }
+        else if (type_ != InterpolationType::LIN)
+            throw std::runtime_error("Unknown Interpolation type!");
+
+        const int last = static_cast<int>(timeArray.size()) - 1;
+        indices_.resize(M);
+        alphas_.resize(M);
+
+        for (size_t j = 0; j < M; j++)
+        {
+            const SCALAR& t = enquiryTimes[j];
+            const int ind = findIndex(timeArray, t);
+
+            // outside of the time array, the first or last data point is returned
+            if (t < timeArray[0] || ind == last)
+            {
+                indices_[j] = std::min(ind, last - 1);
+                alphas_[j] = (ind == last) ? SCALAR(0.0) : SCALAR(1.0);
+            }
+            else
+            {
+                indices_[j] = ind;
+                alphas_[j] = (t - timeArray[ind + 1]) / (timeArray[ind] - timeArray[ind + 1]);
+            }
+        }
+
+        for (size_t j = 0; j < M; j++)
+        {
+            const int ind = indices_[j];
+            enquiryData[j] = alphas_[j] * dataArray[ind] + (1 - alphas_[j]) * dataArray[ind + 1];
+        }
+    }
+
 
     //! access the greatest index which is smaller than the inquired interpolation time
     int getGreatestLessTimeStampIndex() { return index_; }
@@ -116,50 +183,96 @@ public:
     //! change the interpolation type
     void changeInterpolationType(const InterpolationType& type) { type_ = type; }
     //! find an index corresponding to a certain inquiry time
+    /*!
+	 * Returns the greatest index whose time stamp is not greater than the enquiry time, or 0 if the enquiry time
+	 * lies before the first time stamp. The search checks, in this order,
+	 *  - the bracket of the previous call, which covers sequential access in O(1)
+	 *  - the bracket predicted by assuming equidistant time stamps, which covers uniform grids in O(1)
+	 *  - a galloping search starting at the previous index followed by a binary search, O(log(distance))
+	 */
     int findIndex(const tpl::TimeArray<SCALAR>& timeArray, const SCALAR& enquiryTime)
     {
-        int index = -1;
+        const int N = static_cast<int>(timeArray.size());
+        if (N == 0)
+            throw std::runtime_error("Interpolation.h : TimeArray is size 0.");
+
+        index_ = std::max(0, std::min(index_, N - 1));
+
+        if (!(enquiryTime >= timeArray[0]))  // also catches NaN
+        {
+            index_ = 0;
+            return index_;
+        }
+        if (enquiryTime >= timeArray[N - 1])
+        {
+            index_ = N - 1;
+            return index_;
+        }
+
+        // from here on, the result is in [0, N-2]
+        if (isBracket(timeArray, index_, enquiryTime))
+            return index_;
+        if (index_ + 1 < N - 1 && isBracket(timeArray, index_ + 1, enquiryTime))
+            return ++index_;
 
-        index_ = std::min(index_, (int)timeArray.size() - 1);
+        const SCALAR span = timeArray[N - 1] - timeArray[0];
+        const SCALAR guess = std::floor((enquiryTime - timeArray[0]) / span * SCALAR(N - 1));
+        const int uniformIndex = std::max(0, std::min(N - 2, static_cast<int>(guess)));
+        if (isBracket(timeArray, uniformIndex, enquiryTime))
+        {
+            index_ = uniformIndex;
+            return index_;
+        }
 
-        if (timeArray.at(index_) > enquiryTime)
+        // galloping search for a range [lo, hi) which contains the result
+        int lo, hi;
+        if (timeArray[index_] <= enquiryTime)
         {
-            for (int i = index_; i >= 0; i--)
+            lo = index_;
+            int step = 1;
+            hi = std::min(N - 1, lo + step);
+            while (hi < N - 1 && timeArray[hi] <= enquiryTime)
             {
-                index = i;
-                if (timeArray.at(i) <= enquiryTime)
-                    break;
+                lo = hi;
+                step *= 2;
+                hi = std::min(N - 1, lo + step);
             }
         }
         else
         {
-            for (int i = index_; i < (int)timeArray.size(); i++)
+            hi = index_;
+            int step = 1;
+            lo = std::max(0, hi - step);
+            while (lo > 0 && timeArray[lo] > enquiryTime)
             {
-                index = i;
-                if (timeArray.at(i) > enquiryTime)
-                {
-                    index = i - 1;
-                    break;
-                }
+                hi = lo;
+                step *= 2;
+                lo = std::max(0, hi - step);
             }
         }
 
-        // throw error if index is wrong
-        if (index < 0)
-            throw std::runtime_error(
-                "Interpolation.h : index in protected member findIndex((const SCALAR& enquiryTime) not computed "
-                "properly");
-
-        index_ = index;
+        // binary search for the first time stamp greater than the enquiry time
+        auto upper = std::upper_bound(timeArray.begin() + lo, timeArray.begin() + hi + 1, enquiryTime);
+        index_ = static_cast<int>(upper - timeArray.begin()) - 1;
 
-        return index;
+        return index_;
     }
 
 
 protected:
+    //! true if the enquiry time lies in [t_i, t_{i+1})
+    static bool isBracket(const tpl::TimeArray<SCALAR>& timeArray, int i, const SCALAR& enquiryTime)
+    {
+        return timeArray[i] <= enquiryTime && enquiryTime < timeArray[i + 1];
+    }
+
     int index_;
 
     InterpolationType type_;
+
+    //! scratch memory for batched interpolation
+    std::vector<int> indices_;
+    std::vector<SCALAR> alphas_;
 };
 
 
@@ -0,0 +1,371 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ct {
+namespace core {
+
+//! A simple count-down latch, used to wait for the completion of a group of tasks
+class TaskLatch
+{
+public:
+    explicit TaskLatch(size_t count = 0) : count_(count) {}
+    TaskLatch(const TaskLatch&) = delete;
+    TaskLatch& operator=(const TaskLatch&) = delete;
+
+    //! add tasks that need to be completed before the latch opens
+    void add(size_t n) { count_.fetch_add(n); }
+    //! mark a task as completed
+    void countDown()
+    {
+        // decrement under the lock, such that a waiting thread cannot destroy the latch while it is still accessed
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_.fetch_sub(1) == 1)
+            cv_.notify_all();
+    }
+
+    //! returns true if all tasks have been completed
+    bool ready() const { return count_.load() == 0; }
+    //! block until all tasks have been completed
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return ready(); });
+    }
+
+private:
+    std::atomic_size_t count_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+
+//! A work-stealing thread pool
+/*!
+ * Every worker thread owns a task deque. Tasks are distributed across the deques when they are submitted, workers
+ * pop work from the front of their own deque and steal from the back of the other deques once they run dry, such that
+ * owner and thief work on opposite ends of a block of consecutive tasks.
+ * A worker only sleeps on its own condition variable, such that waking it up does not require a global handshake.
+ *
+ * Tasks receive the id of the thread they are executed on, which is in [0, getNumThreads()]. The ids [0, nThreads-1]
+ * belong to the worker threads, id nThreads is reserved for an external thread that calls parallelFor() or wait() and
+ * helps out with executing tasks while waiting. This allows the caller to index thread-local resources (e.g. cloned
+ * cost functions) with a fixed number of nThreads+1 instances.
+ *
+ * Once the deques have grown to the number of tasks in flight, parallelFor() does not allocate heap memory, which
+ * makes it usable in real-time loops.
+ *
+ * \warning parallelFor() and wait() may only be called by one external thread at a time.
+ */
+class TaskPool
+{
+public:
+    typedef std::function<void(size_t threadId)> Task;
+
+    //! constructor, launches nThreads worker threads
+    explicit TaskPool(size_t nThreads) : nThreads_(nThreads), active_(true), queues_(nThreads)
+    {
+        for (size_t i = 0; i < nThreads_; i++)
+            queues_[i].reset(new WorkerQueue());
+
+        workers_.reserve(nThreads_);
+        for (size_t i = 0; i < nThreads_; i++)
+            workers_.push_back(std::thread(&TaskPool::workerLoop, this, i));
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    //! destructor, finishes all outstanding tasks and joins the workers
+    ~TaskPool()
+    {
+        active_ = false;
+        for (size_t i = 0; i < nThreads_; i++)
+        {
+            std::lock_guard<std::mutex> lock(queues_[i]->mutex);
+            queues_[i]->cv.notify_all();
+        }
+        for (size_t i = 0; i < workers_.size(); i++)
+            workers_[i].join();
+    }
+
+    //! the number of worker threads
+    size_t getNumThreads() const { return nThreads_; }
+    //! the id of the calling thread, nThreads if it is not a worker of this pool
+    size_t getCurrentThreadId() const
+    {
+        if (currentPool() == this)
+            return currentWorkerId();
+        return nThreads_;
+    }
+
+    //! enqueue a single task and obtain a future to wait for its completion
+    std::future<void> submit(const Task& task)
+    {
+        std::shared_ptr<std::packaged_task<void(size_t)>> packaged(new std::packaged_task<void(size_t)>(task));
+        std::future<void> future = packaged->get_future();
+        push(nextQueue_++, [packaged](size_t threadId) { (*packaged)(threadId); });
+        return future;
+    }
+
+    /*!
+     * \brief enqueue a single task and register it with a latch
+     *
+     * The callable is stored as is rather than as a Task, such that a small callable together with the latch
+     * reference still fits into the local storage of the queued Task and does not require a heap allocation.
+     */
+    template <typename CALLABLE>
+    void submit(const CALLABLE& task, TaskLatch& latch)
+    {
+        latch.add(1);
+        push(nextQueue_++, [task, &latch](size_t threadId) {
+            task(threadId);
+            latch.countDown();
+        });
+    }
+
+    /*!
+     * \brief execute body(threadId, i) for all i in [first, last] and block until all are done.
+     *
+     * The index range is split into chunks of chunkSize consecutive indices, which are distributed over the worker
+     * deques in contiguous blocks. The calling thread participates in the execution of the chunks.
+     *
+     * @param first first index (inclusive)
+     * @param last last index (inclusive)
+     * @param body function to execute for every index
+     * @param chunkSize number of consecutive indices handled by one task. If zero, a chunk size that yields roughly
+     *        four chunks per thread is chosen.
+     * @param reverse if true, the indices are handed out from last to first
+     */
+    void parallelFor(size_t first,
+        size_t last,
+        const std::function<void(size_t threadId, size_t i)>& body,
+        size_t chunkSize = 0,
+        bool reverse = false)
+    {
+        if (last < first)
+            return;
+
+        const size_t n = last - first + 1;
+        const size_t nParticipants = nThreads_ + 1;
+
+        if (chunkSize == 0)
+            chunkSize = std::max<size_t>(1, n / (4 * nParticipants));
+
+        const size_t nChunks = (n + chunkSize - 1) / chunkSize;
+
+        // trivial cases are executed directly on the calling thread
+        if (nThreads_ == 0 || nChunks == 1)
+        {
+            const size_t threadId = getCurrentThreadId();
+            for (size_t j = 0; j < n; j++)
+                body(threadId, reverse ? last - j : first + j);
+            return;
+        }
+
+        TaskLatch latch(nChunks);
+        const ChunkedLoop loop{&body, &latch, first, last, n, chunkSize, reverse};
+        const ChunkedLoop* loopPtr = &loop;
+        const size_t chunksPerQueue = (nChunks + queueCount() - 1) / queueCount();
+
+        // the tasks only capture the loop and the chunk index, which fits into the small buffer of std::function
+        for (size_t c = 0; c < nChunks; c++)
+            push(c / chunksPerQueue, [loopPtr, c](size_t threadId) { loopPtr->runChunk(threadId, c); });
+
+        wait(latch);
+    }
+
+    //! block until the latch opens while helping to execute outstanding tasks
+    void wait(TaskLatch& latch)
+    {
+        const size_t threadId = getCurrentThreadId();
+        Task task;
+        while (!latch.ready())
+        {
+            if (tryPop(threadId, task) || trySteal(threadId, task))
+                task(threadId);
+            else if (threadId < nThreads_)
+                std::this_thread::yield();  // nested call from a worker: never block, other waiters may need our deque
+            else
+                break;
+        }
+
+        latch.wait();
+    }
+
+private:
+    //! a range of indices split into chunks, which lives on the stack of parallelFor() until all chunks are done
+    struct ChunkedLoop
+    {
+        const std::function<void(size_t threadId, size_t i)>* body;
+        TaskLatch* latch;
+        size_t first;
+        size_t last;
+        size_t n;
+        size_t chunkSize;
+        bool reverse;
+
+        void runChunk(size_t threadId, size_t c) const
+        {
+            const size_t cEnd = std::min(n, (c + 1) * chunkSize);
+            for (size_t j = c * chunkSize; j < cEnd; j++)
+                (*body)(threadId, reverse ? last - j : first + j);
+            latch->countDown();
+        }
+    };
+
+    //! a double-ended task queue on a ring buffer, which keeps its memory and only grows if it is full
+    class TaskDeque
+    {
+    public:
+        TaskDeque() : buffer_(64), head_(0), size_(0) {}
+        bool empty() const { return size_ == 0; }
+        void push_back(Task&& task)
+        {
+            if (size_ == buffer_.size())
+                grow();
+            buffer_[(head_ + size_) % buffer_.size()] = std::move(task);
+            size_++;
+        }
+
+        void pop_front(Task& task)
+        {
+            task = std::move(buffer_[head_]);
+            head_ = (head_ + 1) % buffer_.size();
+            size_--;
+        }
+
+        void pop_back(Task& task)
+        {
+            size_--;
+            task = std::move(buffer_[(head_ + size_) % buffer_.size()]);
+        }
+
+    private:
+        void grow()
+        {
+            std::vector<Task> buffer(2 * buffer_.size());
+            for (size_t i = 0; i < size_; i++)
+                buffer[i] = std::move(buffer_[(head_ + i) % buffer_.size()]);
+            buffer_.swap(buffer);
+            head_ = 0;
+        }
+
+        std::vector<Task> buffer_;
+        size_t head_;
+        size_t size_;
+    };
+
+    //! a task deque. Every deque is allocated separately to avoid false sharing between the workers
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        TaskDeque tasks;
+    };
+
+    //! number of deques, the external caller does not own a deque
+    size_t queueCount() const { return nThreads_; }
+    void push(size_t queueId, Task&& task)
+    {
+        if (nThreads_ == 0)
+        {
+            task(getCurrentThreadId());
+            return;
+        }
+
+        WorkerQueue& q = *queues_[queueId % queueCount()];
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        q.cv.notify_one();
+    }
+
+    //! pop from the front of the own deque
+    bool tryPop(size_t threadId, Task& task)
+    {
+        if (threadId >= nThreads_)
+            return false;
+
+        WorkerQueue& q = *queues_[threadId];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty())
+            return false;
+        q.tasks.pop_front(task);
+        return true;
+    }
+
+    //! steal from the back of another deque
+    bool trySteal(size_t threadId, Task& task)
+    {
+        for (size_t k = 1; k <= nThreads_; k++)
+        {
+            WorkerQueue& q = *queues_[(threadId + k) % nThreads_];
+            std::unique_lock<std::mutex> lock(q.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || q.tasks.empty())
+                continue;
+            q.tasks.pop_back(task);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(size_t threadId)
+    {
+        currentPool() = this;
+        currentWorkerId() = threadId;
+
+        WorkerQueue& q = *queues_[threadId];
+        Task task;
+
+        while (true)
+        {
+            if (tryPop(threadId, task) || trySteal(threadId, task))
+            {
+                task(threadId);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(q.mutex);
+            q.cv.wait(lock, [this, &q] { return !q.tasks.empty() || !active_; });
+            if (!active_ && q.tasks.empty())
+                return;
+        }
+    }
+
+    static const TaskPool*& currentPool()
+    {
+        static thread_local const TaskPool* pool = nullptr;
+        return pool;
+    }
+
+    static size_t& currentWorkerId()
+    {
+        static thread_local size_t id = 0;
+        return id;
+    }
+
+    const size_t nThreads_;
+    std::atomic_bool active_;
+    std::atomic_size_t nextQueue_{0};
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+namespace ct {
+namespace core {
+
+//! A lock-free triple buffer for handing data from one producer thread to one consumer thread
+/*!
+ * The buffer holds three instances of T. The producer owns the back buffer, the consumer owns the front buffer and
+ * the third instance sits in the middle. Publishing swaps the back buffer with the middle one, updating swaps the
+ * front buffer with the middle one if the producer has published since. Both swaps are a single atomic exchange of
+ * an index, hence neither side ever blocks, waits for the other side or copies an instance of T.
+ *
+ * The producer always writes the latest data, the consumer always reads the latest published data. Intermediate
+ * data that was published but never picked up by the consumer is overwritten.
+ *
+ * Usage:
+ * \code
+ * // producer thread
+ * buffer.back() = newData;
+ * buffer.publish();
+ *
+ * // consumer thread
+ * buffer.update();
+ * use(buffer.front());
+ * \endcode
+ *
+ * \warning there may only be one producer and one consumer thread at a time.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! constructor, initializes all three buffers with the given value
+    explicit TripleBuffer(const T& init = T()) : buffers_{init, init, init}, back_(0), middle_(1), front_(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    //! the buffer the producer writes to. Only to be accessed from the producer thread.
+    T& back() { return buffers_[back_]; }
+
+    //! make the back buffer available to the consumer. Only to be called from the producer thread.
+    void publish()
+    {
+        // release the written data and acquire the buffer which the consumer may have handed back
+        back_ = middle_.exchange(back_ | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /*!
+     * \brief fetch the latest published buffer, if any. Only to be called from the consumer thread.
+     * @return true if the front buffer changed
+     */
+    bool update()
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH_BIT))
+            return false;
+
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    //! true if the producer has published since the last update(). May be called from any thread.
+    bool hasNewData() const { return middle_.load(std::memory_order_relaxed) & FRESH_BIT; }
+
+    //! the buffer the consumer reads from. Only to be accessed from the consumer thread.
+    T& front() { return buffers_[front_]; }
+    const T& front() const { return buffers_[front_]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH_BIT = 0x4;
+
+    T buffers_[3];
+
+    uint8_t back_;                  //! index of the back buffer, owned by the producer
+    std::atomic<uint8_t> middle_;  //! index of the middle buffer, plus a flag for unconsumed data
+    uint8_t front_;                 //! index of the front buffer, owned by the consumer
+};
+
+}  // namespace core
+}  // namespace ct
@@ -57,16 +57,39 @@ public:
     }
 
     void setEnable(bool activated) { activated_ = activated; }
-    //! resets kill flag to false
+    //! resets the recorded substeps
+    /*!
+     * Containers which are not referenced elsewhere are cleared and keep their memory. Containers which have been
+     * handed out through getSubstates() or getSubcontrols() and are still in use are replaced by new ones.
+     */
     virtual void reset() override
     {
-        states_ = std::shared_ptr<ct::core::StateVectorArray<STATE_DIM, SCALAR>>(
-            new ct::core::StateVectorArray<STATE_DIM, SCALAR>);
-        controls_ = std::shared_ptr<ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>>(
-            new ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>);
-        times_ = std::shared_ptr<ct::core::tpl::TimeArray<SCALAR>>(new ct::core::tpl::TimeArray<SCALAR>);
+        if (states_.use_count() == 1)
+            states_->clear();
+        else
+            states_ = std::shared_ptr<ct::core::StateVectorArray<STATE_DIM, SCALAR>>(
+                new ct::core::StateVectorArray<STATE_DIM, SCALAR>);
+
+        if (controls_.use_count() == 1)
+            controls_->clear();
+        else
+            controls_ = std::shared_ptr<ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>>(
+                new ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>);
+
+        if (times_.use_count() == 1)
+            times_->clear();
+        else
+            times_ = std::shared_ptr<ct::core::tpl::TimeArray<SCALAR>>(new ct::core::tpl::TimeArray<SCALAR>);
     };
 
+    //! reserves memory for recording numSubsteps substeps without reallocation
+    void reserve(const size_t numSubsteps)
+    {
+        states_->reserve(numSubsteps);
+        controls_->reserve(numSubsteps);
+        times_->reserve(numSubsteps);
+    }
+
     const std::shared_ptr<ct::core::StateVectorArray<STATE_DIM, SCALAR>>& getSubstates() const { return states_; }
     const std::shared_ptr<ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>>& getSubcontrols() const
     {
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace core {
+
+template <size_t STATE_DIM, typename SCALAR>
+IntegratorBatch<STATE_DIM, SCALAR>::IntegratorBatch(const std::shared_ptr<System<STATE_DIM, SCALAR>>& system,
+    const IntegrationType& intType)
+    : system_(system)
+{
+    changeIntegrationType(intType);
+
+    systemFunction_ = [this](const StateBatch& x, StateBatch& dxdt, SCALAR t) {
+        dxdt.resize(STATE_DIM, x.cols());
+        system_->computeDynamicsBatch(x, t, dxdt);
+    };
+}
+
+template <size_t STATE_DIM, typename SCALAR>
+void IntegratorBatch<STATE_DIM, SCALAR>::changeIntegrationType(const IntegrationType& intType)
+{
+    switch (intType)
+    {
+        case EULERCT:
+        {
+            integratorStepper_ = std::shared_ptr<internal::StepperEulerCT<StateBatch, SCALAR>>(
+                new internal::StepperEulerCT<StateBatch, SCALAR>());
+            break;
+        }
+
+        case RK4CT:
+        {
+            integratorStepper_ = std::shared_ptr<internal::StepperRK4CT<StateBatch, SCALAR>>(
+                new internal::StepperRK4CT<StateBatch, SCALAR>());
+            break;
+        }
+
+        default:
+            throw std::runtime_error("IntegratorBatch only supports the integration types EULERCT and RK4CT");
+    }
+}
+
+template <size_t STATE_DIM, typename SCALAR>
+void IntegratorBatch<STATE_DIM, SCALAR>::integrate_n_steps(StateBatch& states,
+    const SCALAR& startTime,
+    size_t numSteps,
+    SCALAR dt)
+{
+    integratorStepper_->integrate_n_steps(systemFunction_, states, startTime, numSteps, dt);
+}
+
+template <size_t STATE_DIM, typename SCALAR>
+void IntegratorBatch<STATE_DIM, SCALAR>::integrate_n_steps(StateBatch& states,
+    const SCALAR& startTime,
+    size_t numSteps,
+    SCALAR dt,
+    StateBatchArray& stateTrajectory,
+    tpl::TimeArray<SCALAR>& timeTrajectory)
+{
+    stateTrajectory.clear();
+    timeTrajectory.clear();
+    stateTrajectory.push_back(states);
+    timeTrajectory.push_back(startTime);
+
+    integratorStepper_->integrate_n_steps(
+        [&](const StateBatch& x, const SCALAR& t) {
+            stateTrajectory.push_back(x);
+            timeTrajectory.push_back(t);
+        },
+        systemFunction_, states, startTime, numSteps, dt);
+}
+
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,91 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "Integrator.h"
+
+#include <ct/core/types/StateVectorBatch.h>
+
+namespace ct {
+namespace core {
+
+
+//! Integrator advancing a batch of states in lock-step
+/*!
+ * Integrates W states through the same system at once, using the fixed-step steppers EULERCT and RK4CT. The states
+ * are stored in a StateVectorBatch, whose rows are contiguous across the batch. The dynamics are evaluated through
+ * System::computeDynamicsBatch(), which systems can overload to vectorize across the batch.
+ *
+ * Typical use cases are line search candidates, sigma points of an unscented transform or Monte-Carlo rollouts.
+ *
+ * @tparam STATE_DIM the size of the state vector
+ * @tparam SCALAR The scalar type
+ */
+template <size_t STATE_DIM, typename SCALAR = double>
+class IntegratorBatch
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef StateVectorBatch<STATE_DIM, SCALAR> StateBatch;
+    typedef std::vector<StateBatch, Eigen::aligned_allocator<StateBatch>> StateBatchArray;
+
+    //! constructor
+    /*!
+	 * @param system the system (ODE)
+	 * @param intType integration type, either EULERCT or RK4CT
+	 */
+    IntegratorBatch(const std::shared_ptr<System<STATE_DIM, SCALAR>>& system,
+        const IntegrationType& intType = IntegrationType::EULERCT);
+
+    /**
+	 * @brief      Changes the integration type
+	 *
+	 * @param[in]  intType  The new integration type, either EULERCT or RK4CT
+	 */
+    void changeIntegrationType(const IntegrationType& intType);
+
+    //! Equidistant integration based on number of time steps and step length
+    /*!
+	 * \warning Overrides the initial states
+	 *
+	 * @param states initial states, contain the final states after integration
+	 * @param startTime start time of the integration
+	 * @param numSteps number of steps to integrate forward
+	 * @param dt step size
+	 */
+    void integrate_n_steps(StateBatch& states, const SCALAR& startTime, size_t numSteps, SCALAR dt);
+
+    //! Equidistant integration based on number of time steps and step length, recording the trajectory
+    /*!
+	 * \warning Overrides the initial states
+	 *
+	 * @param states initial states, contain the final states after integration
+	 * @param startTime start time of the integration
+	 * @param numSteps number of steps to integrate forward
+	 * @param dt step size
+	 * @param stateTrajectory batch of states at every time step, including the initial states
+	 * @param timeTrajectory time trajectory corresponding to state trajectory
+	 */
+    void integrate_n_steps(StateBatch& states,
+        const SCALAR& startTime,
+        size_t numSteps,
+        SCALAR dt,
+        StateBatchArray& stateTrajectory,
+        tpl::TimeArray<SCALAR>& timeTrajectory);
+
+private:
+    std::shared_ptr<System<STATE_DIM, SCALAR>> system_;  //! pointer to the system
+
+    //! the fixed-step stepper operating on the whole batch
+    std::shared_ptr<internal::StepperCTBase<StateBatch, SCALAR>> integratorStepper_;
+
+    //! the system function handed to the stepper
+    std::function<void(const StateBatch&, StateBatch&, SCALAR)> systemFunction_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -10,8 +10,8 @@ namespace core {
 
 template <size_t STATE_DIM, typename SCALAR>
 Observer<STATE_DIM, SCALAR>::Observer(const EventHandlerPtrVector& eventHandlers)
-    : observeWrap([this](const StateVector<STATE_DIM, SCALAR>& x, const SCALAR& t) { this->observe(x, t); }),
-      observeWrapWithLogging([this](const StateVector<STATE_DIM, SCALAR>& x, const SCALAR& t) {
+    : observeWrap([this](const Eigen::Matrix<SCALAR, STATE_DIM, 1>& x, const SCALAR& t) { this->observe(x, t); }),
+      observeWrapWithLogging([this](const Eigen::Matrix<SCALAR, STATE_DIM, 1>& x, const SCALAR& t) {
           this->log(x, t);
           this->observe(x, t);
       })
@@ -131,6 +131,112 @@ private:
     MATRIX k4_;
     SCALAR oneSixth_;
 };
+
+/**
+ * @brief      Custom implementation of the Dormand-Prince 5(4) integration
+ *             scheme
+ *
+ *             do_step() takes fixed steps of the 5th order scheme. For step
+ *             size control, do_step_embedded() additionally returns the
+ *             difference to the embedded 4th order solution. Its last stage is
+ *             the first stage of the next step (first same as last), hence an
+ *             embedded step evaluates the ODE six times, just like do_step().
+ *
+ * @tparam     MATRIX  The matrix type
+ * @tparam     SCALAR  The scalar type
+ */
+template <typename MATRIX, typename SCALAR = double>
+class StepperDormandPrinceCT : public StepperCTBase<MATRIX, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    StepperDormandPrinceCT() {}
+    /**
+     * @brief      Evaluates the first stage of the first embedded step
+     *
+     * @param[in]  rhs    The ODE
+     * @param[in]  state  The initial state
+     * @param[in]  time   The initial time
+     */
+    void init_embedded(const std::function<void(const MATRIX&, MATRIX&, SCALAR)>& rhs,
+        const MATRIX& state,
+        const SCALAR time)
+    {
+        rhs(state, k1_, time);
+    }
+
+    /**
+     * @brief      Tries a step with error estimate. The stages are evaluated in
+     *             the order 2 to 7, call accept_step() if the step is taken.
+     *
+     * @param[in]  rhs       The ODE
+     * @param[in]  stateIn   The state at the beginning of the step
+     * @param[out] stateOut  The 5th order solution at the end of the step
+     * @param[out] error     The difference of the 5th and 4th order solutions
+     * @param[in]  time      The integration time
+     * @param[in]  dt        The integration timestep
+     */
+    void do_step_embedded(const std::function<void(const MATRIX&, MATRIX&, SCALAR)>& rhs,
+        const MATRIX& stateIn,
+        MATRIX& stateOut,
+        MATRIX& error,
+        const SCALAR time,
+        const SCALAR dt)
+    {
+        stages(rhs, stateIn, stateOut, time, dt);
+        rhs(stateOut, k7_, time + dt);
+
+        error = dt * (SCALAR(71.0 / 57600.0) * k1_ - SCALAR(71.0 / 16695.0) * k3_ + SCALAR(71.0 / 1920.0) * k4_ -
+                         SCALAR(17253.0 / 339200.0) * k5_ + SCALAR(22.0 / 525.0) * k6_ - SCALAR(1.0 / 40.0) * k7_);
+    }
+
+    //! reuses the last stage of the step computed by do_step_embedded() as first stage of the next step
+    void accept_step() { k1_ = k7_; }
+private:
+    virtual void do_step(const std::function<void(const MATRIX&, MATRIX&, SCALAR)>& rhs,
+        MATRIX& stateInOut,
+        const SCALAR time,
+        const SCALAR dt) override
+    {
+        rhs(stateInOut, k1_, time);
+        stages(rhs, stateInOut, result_, time, dt);
+        stateInOut = result_;
+    }
+
+    //! evaluates the stages 2 to 6 and the 5th order solution, given the first stage
+    void stages(const std::function<void(const MATRIX&, MATRIX&, SCALAR)>& rhs,
+        const MATRIX& stateIn,
+        MATRIX& stateOut,
+        const SCALAR time,
+        const SCALAR dt)
+    {
+        rhs(stateIn + dt * SCALAR(1.0 / 5.0) * k1_, k2_, time + SCALAR(1.0 / 5.0) * dt);
+        rhs(stateIn + dt * (SCALAR(3.0 / 40.0) * k1_ + SCALAR(9.0 / 40.0) * k2_), k3_, time + SCALAR(3.0 / 10.0) * dt);
+        rhs(stateIn + dt * (SCALAR(44.0 / 45.0) * k1_ - SCALAR(56.0 / 15.0) * k2_ + SCALAR(32.0 / 9.0) * k3_), k4_,
+            time + SCALAR(4.0 / 5.0) * dt);
+        rhs(stateIn + dt * (SCALAR(19372.0 / 6561.0) * k1_ - SCALAR(25360.0 / 2187.0) * k2_ +
+                               SCALAR(64448.0 / 6561.0) * k3_ - SCALAR(212.0 / 729.0) * k4_),
+            k5_, time + SCALAR(8.0 / 9.0) * dt);
+        rhs(stateIn + dt * (SCALAR(9017.0 / 3168.0) * k1_ - SCALAR(355.0 / 33.0) * k2_ +
+                               SCALAR(46732.0 / 5247.0) * k3_ + SCALAR(49.0 / 176.0) * k4_ -
+                               SCALAR(5103.0 / 18656.0) * k5_),
+            k6_, time + dt);
+
+        stateOut = stateIn + dt * (SCALAR(35.0 / 384.0) * k1_ + SCALAR(500.0 / 1113.0) * k3_ +
+                                      SCALAR(125.0 / 192.0) * k4_ - SCALAR(2187.0 / 6784.0) * k5_ +
+                                      SCALAR(11.0 / 84.0) * k6_);
+    }
+
+    MATRIX k1_;
+    MATRIX k2_;
+    MATRIX k3_;
+    MATRIX k4_;
+    MATRIX k5_;
+    MATRIX k6_;
+    MATRIX k7_;
+    MATRIX result_;
+};
 }
 }
 }
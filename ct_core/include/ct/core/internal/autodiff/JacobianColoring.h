@@ -0,0 +1,188 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace ct {
+namespace core {
+namespace internal {
+
+//! Graph colouring of a sparse Jacobian for compressed evaluation
+/*!
+ * Columns of a Jacobian which do not share a non-zero row are structurally orthogonal. Seeding a forward sweep with
+ * the sum of the unit vectors of such a group of columns yields all their non-zeros at once, hence a Jacobian with
+ * n columns and c column colours needs c instead of n forward sweeps. The same holds for rows and reverse sweeps.
+ *
+ * The colouring is computed greedily for both columns and rows, and the mode requiring fewer sweeps is chosen.
+ * The evaluation itself is left to the caller:
+ *
+ * \code
+ * for (size_t c = 0; c < coloring.numColors(); c++)
+ * {
+ *     coloring.seed(c, seed);
+ *     product = coloring.isForward() ? J * seed : J.transpose() * seed;  // i.e. a forward or reverse sweep
+ *     coloring.recover(c, product, values);
+ * }
+ * \endcode
+ *
+ * The non-zeros are stored row-major, see row() and col().
+ */
+class JacobianColoring
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> SparsityMatrix;
+
+    JacobianColoring() : rows_(0), cols_(0), forward_(true), numColors_(0) {}
+
+    /*!
+     * \brief colour a sparsity pattern
+     * @param sparsity true for the structural non-zeros of the Jacobian
+     */
+    void initPattern(const SparsityMatrix& sparsity)
+    {
+        rows_ = sparsity.rows();
+        cols_ = sparsity.cols();
+
+        row_.clear();
+        col_.clear();
+        for (size_t i = 0; i < rows_; i++)
+            for (size_t j = 0; j < cols_; j++)
+                if (sparsity(i, j))
+                {
+                    row_.push_back(i);
+                    col_.push_back(j);
+                }
+
+        std::vector<size_t> columnColors;
+        std::vector<size_t> rowColors;
+        const size_t nColumnColors = colorGreedy(sparsity, columnColors);
+        const size_t nRowColors = colorGreedy(sparsity.transpose(), rowColors);
+
+        // reverse sweeps are more expensive than forward sweeps, prefer forward mode in case of a tie
+        forward_ = nColumnColors <= nRowColors;
+        numColors_ = forward_ ? nColumnColors : nRowColors;
+        colors_ = forward_ ? columnColors : rowColors;
+    }
+
+    //! fill the seed vector of a colour, of size cols() in forward and rows() in reverse mode
+    template <typename SCALAR>
+    void seed(size_t color, Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& seed) const
+    {
+        seed.setZero(colors_.size());
+        for (size_t k = 0; k < colors_.size(); k++)
+            if (colors_[k] == color)
+                seed(k) = SCALAR(1.0);
+    }
+
+    /*!
+     * \brief extract the non-zeros of a colour
+     * @param color the colour
+     * @param product the Jacobian times the seed (forward) or the seed times the Jacobian (reverse)
+     * @param values the non-zeros, in the order of row() and col()
+     */
+    template <typename SCALAR>
+    void recover(size_t color,
+        const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& product,
+        Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& values) const
+    {
+        values.conservativeResize(row_.size());
+        for (size_t k = 0; k < row_.size(); k++)
+        {
+            if (forward_ && colors_[col_[k]] == color)
+                values(k) = product(row_[k]);
+            else if (!forward_ && colors_[row_[k]] == color)
+                values(k) = product(col_[k]);
+        }
+    }
+
+    //! write the non-zeros into a dense matrix, which has to be zero at the structural zeros
+    template <typename SCALAR, typename DERIVED>
+    void scatter(const Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>& values, Eigen::MatrixBase<DERIVED>& matrix) const
+    {
+        for (size_t k = 0; k < row_.size(); k++)
+            matrix(row_[k], col_[k]) = values(k);
+    }
+
+    //! true if forward sweeps are used, reverse sweeps otherwise
+    bool isForward() const { return forward_; }
+    //! the number of sweeps required to evaluate the Jacobian
+    size_t numColors() const { return numColors_; }
+    //! the colour of every column (forward mode) or row (reverse mode)
+    const std::vector<size_t>& colors() const { return colors_; }
+    //! the number of structural non-zeros
+    size_t nonZeros() const { return row_.size(); }
+    //! row indices of the non-zeros
+    const std::vector<size_t>& row() const { return row_; }
+    //! column indices of the non-zeros
+    const std::vector<size_t>& col() const { return col_; }
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+
+private:
+    //! greedy colouring of the columns such that columns of the same colour do not share a row
+    template <typename DERIVED>
+    static size_t colorGreedy(const Eigen::MatrixBase<DERIVED>& sparsity, std::vector<size_t>& colors)
+    {
+        const size_t rows = sparsity.rows();
+        const size_t cols = sparsity.cols();
+
+        // the columns of every row
+        std::vector<std::vector<size_t>> rowColumns(rows);
+        for (size_t i = 0; i < rows; i++)
+            for (size_t j = 0; j < cols; j++)
+                if (sparsity(i, j))
+                    rowColumns[i].push_back(j);
+
+        const size_t uncolored = cols;
+        colors.assign(cols, uncolored);
+
+        // forbidden[c] == j marks colour c as used by a neighbour of column j
+        std::vector<size_t> forbidden(cols, uncolored);
+
+        size_t nColors = 0;
+        for (size_t j = 0; j < cols; j++)
+        {
+            for (size_t i = 0; i < rows; i++)
+            {
+                if (!sparsity(i, j))
+                    continue;
+
+                for (size_t neighbour : rowColumns[i])
+                    if (colors[neighbour] != uncolored)
+                        forbidden[colors[neighbour]] = j;
+            }
+
+            size_t color = 0;
+            while (forbidden[color] == j)
+                color++;
+
+            colors[j] = color;
+            nColors = std::max(nColors, color + 1);
+        }
+
+        return nColors;
+    }
+
+    size_t rows_;
+    size_t cols_;
+
+    std::vector<size_t> row_;  //! row indices of the non-zeros
+    std::vector<size_t> col_;  //! column indices of the non-zeros
+
+    bool forward_;
+    size_t numColors_;
+    std::vector<size_t> colors_;
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#ifdef CPPADCG
+
+#include <memory>
+#include <mutex>
+
+#include "CGHelpers.h"
+
+namespace ct {
+namespace core {
+namespace internal {
+
+//! A dynamically loaded code generation library, shared by all instances using its models
+/*!
+ * Loading a library and its models is expensive compared to evaluating the generated code. Clones of codegen
+ * classes, e.g. one per thread of a solver, therefore share one loaded library and only create their own model
+ * instance from it. A model instance owns the evaluation buffers and must only be used by one thread at a time.
+ *
+ * Creating and destroying models registers and unregisters them with the library, which CppADCodeGen does not
+ * synchronize. Both are guarded by a mutex here, such that clones can be created and destroyed on any thread. Every
+ * model keeps the library alive until it gets destroyed.
+ *
+ * @tparam BASE scalar type of the generated code
+ */
+template <typename BASE>
+class SharedDynamicLib : public std::enable_shared_from_this<SharedDynamicLib<BASE>>
+{
+public:
+    typedef CppAD::cg::DynamicLib<BASE> DynamicLib_t;
+    typedef CppAD::cg::GenericModel<BASE> GenericModel_t;
+
+    //! take ownership of a loaded library
+    explicit SharedDynamicLib(const std::shared_ptr<DynamicLib_t>& dynamicLib) : dynamicLib_(dynamicLib) {}
+
+    SharedDynamicLib(const SharedDynamicLib&) = delete;
+    SharedDynamicLib& operator=(const SharedDynamicLib&) = delete;
+
+    //! load a library from file
+    static std::shared_ptr<SharedDynamicLib> load(const std::string& libPath)
+    {
+        return std::make_shared<SharedDynamicLib>(CGHelpers::loadDynamicLibCppad<BASE>(libPath));
+    }
+
+    //! create a new instance of a model contained in the library
+    std::shared_ptr<GenericModel_t> createModel(const std::string& modelName)
+    {
+        std::shared_ptr<SharedDynamicLib> self = this->shared_from_this();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        GenericModel_t* model = dynamicLib_->model(modelName);
+        if (!model)
+            throw std::runtime_error("SharedDynamicLib: library does not contain model " + modelName);
+
+        return std::shared_ptr<GenericModel_t>(model, [self](GenericModel_t* m) {
+            std::lock_guard<std::mutex> lock(self->mutex_);
+            delete m;
+        });
+    }
+
+    //! the underlying library
+    const std::shared_ptr<DynamicLib_t>& get() const { return dynamicLib_; }
+
+private:
+    std::shared_ptr<DynamicLib_t> dynamicLib_;
+    std::mutex mutex_;
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace ct
+
+#endif
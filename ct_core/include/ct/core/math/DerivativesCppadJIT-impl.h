@@ -19,6 +19,7 @@ DerivativesCppadJIT<IN_DIM, OUT_DIM>::DerivativesCppadJIT(FUN_TYPE_CG& f, int in
       outputDim_(outputDim),
       compiled_(false),
       libName_(""),
+      libPath_(""),
       dynamicLib_(nullptr)
 #ifdef LLVM_VERSION_MAJOR
       ,
@@ -36,6 +37,7 @@ DerivativesCppadJIT<IN_DIM, OUT_DIM>::DerivativesCppadJIT(const DerivativesCppad
       outputDim_(arg.outputDim_),
       compiled_(arg.compiled_),
       libName_(arg.libName_),
+      libPath_(arg.libPath_),
       dynamicLib_(nullptr)
 #ifdef LLVM_VERSION_MAJOR
       ,
@@ -47,8 +49,9 @@ DerivativesCppadJIT<IN_DIM, OUT_DIM>::DerivativesCppadJIT(const DerivativesCppad
     {
         if (arg.dynamicLib_)  // in case of dynamic libraries
         {
-            dynamicLib_ = internal::CGHelpers::loadDynamicLibCppad<double>(libName_);
-            model_ = std::shared_ptr<CppAD::cg::GenericModel<double>>(dynamicLib_->model(libName_));
+            // share the loaded library, only the model with its evaluation buffers is instance specific
+            dynamicLib_ = arg.dynamicLib_;
+            model_ = dynamicLib_->createModel(libName_);
         }
 #ifdef LLVM_VERSION_MAJOR
         else if (arg.llvmModelLib_)  // in case of regular JIT without dynamic lib
@@ -74,6 +77,7 @@ void DerivativesCppadJIT<IN_DIM, OUT_DIM>::update(FUN_TYPE_CG& f, const size_t i
         recordCg();
         compiled_ = false;
         libName_ = "";
+        libPath_ = "";
         dynamicLib_ = nullptr;
         model_ = nullptr;
     }
@@ -300,62 +304,32 @@ void DerivativesCppadJIT<IN_DIM, OUT_DIM>::compileJIT(const DerivativesCppadSett
     if (compiled_)
         return;
 
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-
     // assigning a unique identifier to the library in order to avoid race conditions in JIT
-    std::string uniqueID =
-        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "_" + std::to_string(ts.tv_nsec);
-
-    libName_ = libName + uniqueID;
-
-    CppAD::cg::ModelCSourceGen<double> cgen(cgCppadFun_, libName_);
+    std::string uniqueID = JITCompilationService::createUniqueID();
 
-    cgen.setMultiThreading(settings.multiThreading_);
-    cgen.setCreateForwardZero(settings.createForwardZero_);
-    cgen.setCreateForwardOne(settings.createForwardOne_);
-    cgen.setCreateReverseOne(settings.createReverseOne_);
-    cgen.setCreateReverseTwo(settings.createReverseTwo_);
-    cgen.setCreateJacobian(settings.createJacobian_);
-    cgen.setCreateSparseJacobian(settings.createSparseJacobian_);
-    cgen.setCreateHessian(settings.createHessian_);
-    cgen.setCreateSparseHessian(settings.createSparseHessian_);
-    cgen.setMaxAssignmentsPerFunc(settings.maxAssignements_);
+    // cached libraries are content-addressed, hence their model name must not differ between processes
+    const bool useCache = settings.useDynamicLibrary_ && settings.useCache_;
+    const std::string modelName = useCache ? libName : libName + uniqueID;
 
-    CppAD::cg::ModelLibraryCSourceGen<double> libcgen(cgen);
+    std::unique_ptr<CppAD::cg::ModelCSourceGen<double>> cgen = createModelSourceGen(settings, modelName);
+    CppAD::cg::ModelLibraryCSourceGen<double> libcgen(*cgen);
 
     if (settings.useDynamicLibrary_)
     {
-        std::string tempDir = "cppad_temp" + uniqueID;
-        if (verbose)
-        {
-            std::cout << "DerivativesCppadJIT: starting to compile dynamic library" << libName_ << std::endl;
-            std::cout << "DerivativesCppadJIT: in temporary directory " << tempDir << std::endl;
-        }
-
-        // compile a dynamic library
-        CppAD::cg::DynamicModelLibraryProcessor<double> p(libcgen, libName_);
+        const uint64_t key =
+            useCache ? JITCompilationService::computeCacheKey(hashModel(settings, modelName), settings) : 0;
 
-        if (settings.compiler_ == DerivativesCppadSettings::GCC)
-        {
-            CppAD::cg::GccCompiler<double> compiler;
-            compiler.setTemporaryFolder(tempDir);
-            dynamicLib_ = std::shared_ptr<CppAD::cg::DynamicLib<double>>(p.createDynamicLibrary(compiler));
-        }
-        else if (settings.compiler_ == DerivativesCppadSettings::CLANG)
-        {
-            CppAD::cg::ClangCompiler<double> compiler;
-            compiler.setTemporaryFolder(tempDir);
-            dynamicLib_ = std::shared_ptr<CppAD::cg::DynamicLib<double>>(p.createDynamicLibrary(compiler));
-        }
-        else
-            throw std::runtime_error("Unknown compiler type for dynamic library, support only gcc and clang.");
+        std::string libPath;
+        std::shared_ptr<CppAD::cg::DynamicLib<double>> dynamicLib =
+            JITCompilationService::buildDynamicLib(libcgen, modelName, key, uniqueID, settings, libPath, verbose);
 
-        // extract model
-        model_ = std::shared_ptr<CppAD::cg::GenericModel<double>>(dynamicLib_->model(libName_));
+        loadModel(std::make_shared<internal::SharedDynamicLib<double>>(dynamicLib), libPath, modelName);
     }
     else  // use regular JIT
     {
+        libName_ = modelName;
+        libPath_ = modelName;
+
         if (verbose)
         {
             std::cout << "DerivativesCppadJIT: starting to compile with LLVM library " << libName_ << std::endl;
@@ -370,6 +344,8 @@ void DerivativesCppadJIT<IN_DIM, OUT_DIM>::compileJIT(const DerivativesCppadSett
 #else
         throw std::runtime_error("DerivativesCppadJIT: LLVM not installed.");
 #endif
+        compiled_ = true;
+        updateSparsityPatterns(verbose);
     }
 
 
@@ -383,8 +359,66 @@ void DerivativesCppadJIT<IN_DIM, OUT_DIM>::compileJIT(const DerivativesCppadSett
         p2.saveSources();
     }
 
+    if (verbose)
+        std::cout << "DerivativesCppadJIT: compileJIT() completed." << std::endl;
+}
+
+template <int IN_DIM, int OUT_DIM>
+bool DerivativesCppadJIT<IN_DIM, OUT_DIM>::isCompiled() const
+{
+    return compiled_;
+}
+
+template <int IN_DIM, int OUT_DIM>
+std::unique_ptr<CppAD::cg::ModelCSourceGen<double>> DerivativesCppadJIT<IN_DIM, OUT_DIM>::createModelSourceGen(
+    const DerivativesCppadSettings& settings,
+    const std::string& modelName)
+{
+    std::unique_ptr<CppAD::cg::ModelCSourceGen<double>> cgen(
+        new CppAD::cg::ModelCSourceGen<double>(cgCppadFun_, modelName));
+
+    cgen->setMultiThreading(settings.multiThreading_);
+    cgen->setCreateForwardZero(settings.createForwardZero_);
+    cgen->setCreateForwardOne(settings.createForwardOne_);
+    cgen->setCreateReverseOne(settings.createReverseOne_);
+    cgen->setCreateReverseTwo(settings.createReverseTwo_);
+    cgen->setCreateJacobian(settings.createJacobian_);
+    cgen->setCreateSparseJacobian(settings.createSparseJacobian_);
+    cgen->setCreateHessian(settings.createHessian_);
+    cgen->setCreateSparseHessian(settings.createSparseHessian_);
+    cgen->setMaxAssignmentsPerFunc(settings.maxAssignements_);
+
+    return cgen;
+}
+
+template <int IN_DIM, int OUT_DIM>
+uint64_t DerivativesCppadJIT<IN_DIM, OUT_DIM>::hashModel(const DerivativesCppadSettings& settings,
+    const std::string& modelName,
+    uint64_t seed)
+{
+    return JITCompilationService::hashModel(cgCppadFun_, settings, modelName, seed);
+}
+
+template <int IN_DIM, int OUT_DIM>
+void DerivativesCppadJIT<IN_DIM, OUT_DIM>::loadModel(
+    const std::shared_ptr<internal::SharedDynamicLib<double>>& dynamicLib,
+    const std::string& libPath,
+    const std::string& modelName)
+{
+    dynamicLib_ = dynamicLib;
+    libPath_ = libPath;
+    libName_ = modelName;
+
+    // extract model
+    model_ = dynamicLib_->createModel(libName_);
+
     compiled_ = true;
+    updateSparsityPatterns(false);
+}
 
+template <int IN_DIM, int OUT_DIM>
+void DerivativesCppadJIT<IN_DIM, OUT_DIM>::updateSparsityPatterns(bool verbose)
+{
     if (model_->isJacobianSparsityAvailable())
     {
         if (verbose)
@@ -430,16 +464,13 @@ void DerivativesCppadJIT<IN_DIM, OUT_DIM>::compileJIT(const DerivativesCppadSett
         sparsityRowsHessianEigen_ = rowsSizeT.cast<int>();
         sparsityColsHessianEigen_ = colsSizeT.cast<int>();
     }
-
-    if (verbose)
-        std::cout << "DerivativesCppadJIT: compileJIT() completed." << std::endl;
 }
 
 template <int IN_DIM, int OUT_DIM>
 auto DerivativesCppadJIT<IN_DIM, OUT_DIM>::getDynamicLib() -> const std::shared_ptr<CppAD::cg::DynamicLib<double>>
 {
     if (dynamicLib_)
-        return dynamicLib_;
+        return dynamicLib_->get();
     else
         throw std::runtime_error("DerivativesCppADJIT: dynamic lib not compiled.");
 }
@@ -9,8 +9,10 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/core/types/AutoDiff.h>
 #include <ct/core/internal/autodiff/CGHelpers.h>
+#include <ct/core/internal/autodiff/SharedDynamicLib.h>
 #include <ct/core/math/Derivatives.h>
 #include <ct/core/math/DerivativesCppadSettings.h>
+#include <ct/core/math/JITCompilationService.h>
 
 #include <cppad/cg/model/llvm/llvm.hpp>
 
@@ -72,7 +74,8 @@ public:
     /*!
      * @brief copy constructor
      * @param arg instance to copy
-     * @note  It is  important to not only copy the pointer to the dynamic library, but to load the library properly instead.
+     * @note  The copy shares the loaded dynamic library with arg, but gets its own model instance. Hence, arg and the
+     * copy can be evaluated concurrently.
      */
     DerivativesCppadJIT(const DerivativesCppadJIT& arg);
 
@@ -170,11 +173,39 @@ public:
     /*!
      *  This method generates source code for the Jacobian and zero order derivative. It then compiles
      *  the source code to a dynamically loadable library that then gets loaded.
+     *
+     *  If caching is enabled in the settings, the library is looked up in a persistent JITLibraryCache first, keyed on
+     *  the recorded function and the settings. Only if it is not found, its code gets generated and compiled and the
+     *  library is added to the cache.
+     *
+     *  To compile several instances into a single library, use a JITCompilationService instead.
      */
     void compileJIT(const DerivativesCppadSettings& settings,
         const std::string& libName = "unnamedLib",
         bool verbose = false);
 
+    //! true once the derivatives are compiled and loaded
+    bool isCompiled() const;
+
+    //! create the code generator for the derivatives selected in the settings, used by the JITCompilationService
+    std::unique_ptr<CppAD::cg::ModelCSourceGen<double>> createModelSourceGen(const DerivativesCppadSettings& settings,
+        const std::string& modelName);
+
+    //! hash the recorded function and settings to look up a cached library, see JITCompilationService::hashModel()
+    uint64_t hashModel(const DerivativesCppadSettings& settings,
+        const std::string& modelName,
+        uint64_t seed = JITLibraryCache::hash(""));
+
+    /*!
+     * @brief load the compiled model from a dynamic library, used by the JITCompilationService
+     * @param dynamicLib the loaded library, shared with all clones
+     * @param libPath path of the library, without file extension
+     * @param modelName name of the model within the library
+     */
+    void loadModel(const std::shared_ptr<internal::SharedDynamicLib<double>>& dynamicLib,
+        const std::string& libPath,
+        const std::string& modelName);
+
     //! retrieve the dynamic library, e.g. for testing purposes
     const std::shared_ptr<CppAD::cg::DynamicLib<double>> getDynamicLib();
 
@@ -187,6 +218,9 @@ protected:
     //! record the Auto-Diff terms for code generation
     void recordCg();
 
+    //! read the sparsity patterns from the loaded model
+    void updateSparsityPatterns(bool verbose);
+
     std::function<OUT_TYPE_CG(const IN_TYPE_CG&)> cgStdFun_;  //! the function
 
     int inputDim_;   //! function input dimension
@@ -195,7 +229,8 @@ protected:
     CppAD::ADFun<CG_VALUE_TYPE> cgCppadFun_;  //!  auto-diff function
 
     bool compiled_;        //! flag if Jacobian is compiled
-    std::string libName_;  //! a unique name for this library
+    std::string libName_;  //! a unique name for this model
+    std::string libPath_;  //! path of the dynamic library, without file extension
 
     std::vector<size_t> sparsityRowsJacobian_;
     std::vector<size_t> sparsityColsJacobian_;
@@ -209,7 +244,7 @@ protected:
     //!
     CppAD::cg::GccCompiler<double> compiler_;  //! compile for codegeneration
     CppAD::cg::ClangCompiler<double> compilerClang_;
-    std::shared_ptr<CppAD::cg::DynamicLib<double>> dynamicLib_;          //! dynamic library to load after compilation
+    std::shared_ptr<internal::SharedDynamicLib<double>> dynamicLib_;     //! dynamic library, shared with all clones
     std::shared_ptr<CppAD::cg::GenericModel<double>> model_;             //! the model
 #ifdef LLVM_VERSION_MAJOR
     std::shared_ptr<CppAD::cg::LlvmModelLibrary<double>> llvmModelLib_;  //! llvm in-memory library
@@ -47,7 +47,11 @@ public:
           maxAssignements_(20000),
           compiler_(GCC),
           generateSourceCode_(false),
-          useDynamicLibrary_(true)
+          useDynamicLibrary_(true),
+          compileThreads_(1),
+          useCache_(false),
+          cacheDirectory_(""),
+          cacheMaxSizeMB_(1024)
     {
     }
 
@@ -64,6 +68,10 @@ public:
     CompilerType compiler_;
     bool generateSourceCode_;
     bool useDynamicLibrary_;
+    size_t compileThreads_;       //! compile translation units in parallel if not 1, 0 uses all cores
+    bool useCache_;               //! cache compiled dynamic libraries on disk, see JITLibraryCache
+    std::string cacheDirectory_;  //! cache directory, empty for the default location
+    size_t cacheMaxSizeMB_;       //! maximum size of the cache, least recently used libraries get evicted
 
     /**
      * @brief      Prints out settings
@@ -100,6 +108,16 @@ public:
 
         if (useDynamicLibrary_)
             std::cout << "Creating a dynamic library (*.so will be saved in execution directory)" << std::endl;
+
+        if (compileThreads_ != 1)
+            std::cout << "Compiling dynamic libraries in parallel on "
+                      << (compileThreads_ == 0 ? std::string("all") : std::to_string(compileThreads_)) << " cores"
+                      << std::endl;
+
+        if (useCache_)
+            std::cout << "Caching dynamic libraries in "
+                      << (cacheDirectory_.empty() ? std::string("the default directory") : cacheDirectory_) << ", max. "
+                      << cacheMaxSizeMB_ << " MB" << std::endl;
     }
 
     /**
@@ -133,6 +151,10 @@ public:
         maxAssignements_ = pt.get<unsigned int>(ns + ".MaxAssignements");
         generateSourceCode_ = pt.get<bool>(ns + ".GenerateSourceCode");
         useDynamicLibrary_ = pt.get<bool>(ns + ".UseDynamicLibrary");
+        compileThreads_ = pt.get<unsigned int>(ns + ".CompileThreads", compileThreads_);
+        useCache_ = pt.get<bool>(ns + ".UseCache", useCache_);
+        cacheDirectory_ = pt.get<std::string>(ns + ".CacheDirectory", cacheDirectory_);
+        cacheMaxSizeMB_ = pt.get<unsigned int>(ns + ".CacheMaxSizeMB", cacheMaxSizeMB_);
 
         std::string compilerStr = pt.get<std::string>(ns + ".Compiler");
 
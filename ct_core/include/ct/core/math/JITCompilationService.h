@@ -0,0 +1,330 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#ifdef CPPADCG
+
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <unistd.h>
+
+#include <ct/core/internal/autodiff/CGHelpers.h>
+#include <ct/core/internal/autodiff/SharedDynamicLib.h>
+#include <ct/core/math/DerivativesCppadSettings.h>
+#include <ct/core/math/JITLibraryCache.h>
+#include <ct/core/math/ParallelCCompiler.h>
+
+namespace ct {
+namespace core {
+
+//! Compiles the generated code of several auto-diff models into a single dynamic library
+/*!
+ * Every DerivativesCppadJIT::compileJIT() call builds its own library. When several codegen instances get compiled at
+ * startup, e.g. cost function, constraints and dynamics, the service instead collects their generated models and
+ * compiles all of them in one library build. If DerivativesCppadSettings::compileThreads_ is not 1, the translation
+ * units of this build are compiled in parallel, see ParallelCCompiler.
+ *
+ * Usage:
+ * \code
+ * JITCompilationService service(settings, "myProblem");
+ * service.add(intermediateCosts, costSettings, "intermediateCosts");
+ * service.add(finalCosts, costSettings, "finalCosts");
+ * service.compile();  // intermediateCosts and finalCosts are ready to use now
+ * \endcode
+ *
+ * The added derivatives need to stay alive until compile() returns.
+ *
+ * The static functions implement building a single library and are used by DerivativesCppadJIT::compileJIT() as well.
+ */
+class JITCompilationService
+{
+public:
+    typedef CppAD::cg::DynamicLib<double> DynamicLib_t;
+    typedef internal::SharedDynamicLib<double> SharedDynamicLib_t;
+    typedef std::function<void(const std::shared_ptr<SharedDynamicLib_t>&, const std::string&)> Loader_t;
+
+    /*!
+     * \brief constructor
+     * @param settings the compiler and cache settings of the library build. The derivatives to create are set per model.
+     * @param libName name of the library
+     */
+    JITCompilationService(const DerivativesCppadSettings& settings, const std::string& libName = "jitLib")
+        : settings_(settings), libName_(libName), uniqueID_(createUniqueID()), modelsKey_(JITLibraryCache::hash(""))
+    {
+        if (!settings_.useDynamicLibrary_)
+            throw std::runtime_error("JITCompilationService: only supported for dynamic libraries.");
+    }
+
+    /*!
+     * \brief add the model of a codegen instance to the library build
+     * @param derivatives the codegen instance, e.g. a DerivativesCppadJIT. Gets loaded once compile() finishes.
+     * @param modelSettings settings determining which derivatives get generated for this model
+     * @param modelName name of the model, needs to be unique within the service
+     */
+    template <typename DERIVATIVES>
+    void add(DERIVATIVES& derivatives, const DerivativesCppadSettings& modelSettings, const std::string& modelName)
+    {
+        if (derivatives.isCompiled())
+            return;
+
+        // cached libraries are content-addressed, hence their model names must not differ between processes
+        const std::string name = settings_.useCache_ ? modelName : modelName + uniqueID_;
+
+        if (settings_.useCache_)
+            modelsKey_ = derivatives.hashModel(modelSettings, name, modelsKey_);
+
+        models_.emplace_back(derivatives.createModelSourceGen(modelSettings, name));
+        loaders_.push_back(
+            [&derivatives, name](const std::shared_ptr<SharedDynamicLib_t>& lib, const std::string& libPath) {
+                derivatives.loadModel(lib, libPath, name);
+            });
+    }
+
+    //! number of models waiting to be compiled
+    size_t size() const { return models_.size(); }
+
+    //! generate, compile and load the library containing all models added so far
+    void compile(bool verbose = false)
+    {
+        if (models_.empty())
+            return;
+
+        CppAD::cg::ModelLibraryCSourceGen<double> libcgen(*models_.front());
+        for (size_t i = 1; i < models_.size(); i++)
+            libcgen.addModel(*models_[i]);
+
+        const std::string libName = settings_.useCache_ ? libName_ : libName_ + uniqueID_;
+        const uint64_t key = settings_.useCache_ ? computeCacheKey(modelsKey_, settings_) : 0;
+
+        std::string libPath;
+        std::shared_ptr<SharedDynamicLib_t> lib = std::make_shared<SharedDynamicLib_t>(
+            buildDynamicLib(libcgen, libName, key, uniqueID_, settings_, libPath, verbose));
+
+        // all models share the loaded library
+        for (const Loader_t& loader : loaders_)
+            loader(lib, libPath);
+
+        models_.clear();
+        loaders_.clear();
+        modelsKey_ = JITLibraryCache::hash("");
+    }
+
+    //! an identifier unique to the calling process, thread and time, avoids name clashes between concurrent builds
+    static std::string createUniqueID()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+
+        return std::to_string(::getpid()) + "_" +
+               std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "_" +
+               std::to_string(ts.tv_nsec);
+    }
+
+    /*!
+     * \brief build and load a dynamic library, using the JITLibraryCache if enabled in the settings
+     * @param libcgen the library sources
+     * @param libName name of the library. Without cache, the library is created in the working directory under
+     * this name, hence it needs to be unique.
+     * @param key the cache key of the library, see computeCacheKey(). Unused without cache.
+     * @param uniqueID see createUniqueID(), used to name temporary files
+     * @param settings compiler and cache settings
+     * @param libPath the path of the loaded library, without file extension
+     * @param verbose print progress
+     * @return the loaded library
+     */
+    static std::shared_ptr<DynamicLib_t> buildDynamicLib(CppAD::cg::ModelLibraryCSourceGen<double>& libcgen,
+        const std::string& libName,
+        uint64_t key,
+        const std::string& uniqueID,
+        const DerivativesCppadSettings& settings,
+        std::string& libPath,
+        bool verbose)
+    {
+        const std::string tempDir = "cppad_temp" + uniqueID;
+
+        if (!settings.useCache_)
+        {
+            libPath = libName;
+            if (verbose)
+            {
+                std::cout << "JITCompilationService: starting to compile dynamic library " << libPath << std::endl;
+                std::cout << "JITCompilationService: in temporary directory " << tempDir << std::endl;
+            }
+
+            return createDynamicLib(libcgen, libPath, tempDir, tempDir + "_objects", settings);
+        }
+
+        JITLibraryCache cache(settings.cacheDirectory_, settings.cacheMaxSizeMB_ * 1024 * 1024);
+
+        // the key is known before generating any code, hence a cached library is loaded without code generation
+        std::shared_ptr<DynamicLib_t> lib;
+        if (cache.lookup(libName, key))
+        {
+            libPath = cache.libraryPath(libName, key);
+            if (verbose)
+                std::cout << "JITCompilationService: loading cached dynamic library " << libPath << std::endl;
+
+            lib = internal::CGHelpers::loadDynamicLibCppad<double>(libPath);
+        }
+        else
+        {
+            const std::string tempLibPath = cache.temporaryPath(libName, key, uniqueID);
+            if (verbose)
+            {
+                std::cout << "JITCompilationService: library not cached, starting to compile dynamic library "
+                          << tempLibPath << std::endl;
+                std::cout << "JITCompilationService: in temporary directory " << tempDir << std::endl;
+            }
+
+            // object files are kept in the cache, such that unchanged translation units are not compiled again
+            if (settings.compileThreads_ != 1)
+            {
+                const std::string sourcesDir = cache.getDirectory() + "/tmp/sources" + uniqueID;
+                CppAD::cg::SaveFilesModelLibraryProcessor<double> sourceSaver(libcgen);
+                sourceSaver.saveSourcesTo(sourcesDir);
+
+                lib = compileSources(sourcesDir, cache.objectsDirectory(), tempLibPath, settings);
+
+                JITLibraryCache::removeDirectory(sourcesDir);
+            }
+            else
+                lib = createDynamicLib(libcgen, tempLibPath, tempDir, "", settings);
+
+            // the library loaded from the temporary path remains valid after moving it into the cache
+            libPath = cache.insert(tempLibPath + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION, libName, key);
+        }
+
+        return lib;
+    }
+
+    /*!
+     * \brief compile the generated sources to a dynamic library at libPath and load it
+     * @param libcgen the library sources
+     * @param libPath path of the library, without file extension
+     * @param tempDir temporary directory for the sources
+     * @param objectsDir directory for the object files of a parallel build, removed afterwards
+     * @param settings compiler settings
+     */
+    static std::shared_ptr<DynamicLib_t> createDynamicLib(CppAD::cg::ModelLibraryCSourceGen<double>& libcgen,
+        const std::string& libPath,
+        const std::string& tempDir,
+        const std::string& objectsDir,
+        const DerivativesCppadSettings& settings)
+    {
+        if (settings.compileThreads_ != 1)
+        {
+            CppAD::cg::SaveFilesModelLibraryProcessor<double> sourceSaver(libcgen);
+            sourceSaver.saveSourcesTo(tempDir);
+
+            std::shared_ptr<DynamicLib_t> lib = compileSources(tempDir, objectsDir, libPath, settings);
+
+            JITLibraryCache::removeDirectory(objectsDir);
+            JITLibraryCache::removeDirectory(tempDir);
+            return lib;
+        }
+
+        CppAD::cg::DynamicModelLibraryProcessor<double> p(libcgen, libPath);
+
+        if (settings.compiler_ == DerivativesCppadSettings::GCC)
+        {
+            CppAD::cg::GccCompiler<double> compiler;
+            compiler.setTemporaryFolder(tempDir);
+            return std::shared_ptr<DynamicLib_t>(p.createDynamicLibrary(compiler));
+        }
+        else if (settings.compiler_ == DerivativesCppadSettings::CLANG)
+        {
+            CppAD::cg::ClangCompiler<double> compiler;
+            compiler.setTemporaryFolder(tempDir);
+            return std::shared_ptr<DynamicLib_t>(p.createDynamicLibrary(compiler));
+        }
+        else
+            throw std::runtime_error("Unknown compiler type for dynamic library, support only gcc and clang.");
+    }
+
+    /*!
+     * \brief hash the recorded function of a model and the settings determining its generated code
+     *
+     * The function is hashed by the source code of a zero order sweep, which is cheap to generate compared to the
+     * derivatives. The derivatives follow from the function and the settings, hence no code needs to be generated
+     * for the derivatives to look up a cached library.
+     * @param fun the recorded function
+     * @param modelSettings settings determining which derivatives get generated for this model
+     * @param modelName name of the model, part of the generated code
+     * @param seed the hash of the previous models of the library
+     */
+    static uint64_t hashModel(CppAD::ADFun<CppAD::cg::CG<double>>& fun,
+        const DerivativesCppadSettings& modelSettings,
+        const std::string& modelName,
+        uint64_t seed)
+    {
+        CppAD::cg::CodeHandler<double> handler;
+        CppAD::vector<CppAD::cg::CG<double>> x(fun.Domain());
+        handler.makeVariables(x);
+        CppAD::vector<CppAD::cg::CG<double>> y = fun.Forward(0, x);
+
+        CppAD::cg::LanguageC<double> language("double");
+        CppAD::cg::LangCDefaultVariableNameGenerator<double> nameGen;
+        std::ostringstream code;
+        handler.generateCode(code, language, y, nameGen);
+
+        // release the Taylor coefficients of the sweep
+        fun.capacity_order(0);
+
+        std::ostringstream codegenSettings;
+        codegenSettings << modelName << "_" << modelSettings.multiThreading_ << modelSettings.createForwardZero_
+                        << modelSettings.createForwardOne_ << modelSettings.createReverseOne_
+                        << modelSettings.createReverseTwo_ << modelSettings.createJacobian_
+                        << modelSettings.createSparseJacobian_ << modelSettings.createHessian_
+                        << modelSettings.createSparseHessian_ << "_" << modelSettings.maxAssignements_;
+
+        uint64_t key = JITLibraryCache::hash(codegenSettings.str(), seed);
+        return JITLibraryCache::hash(code.str(), key);
+    }
+
+    //! combine the hash of all models of a library, see hashModel(), with the compiler settings
+    static uint64_t computeCacheKey(uint64_t modelsKey, const DerivativesCppadSettings& settings)
+    {
+        // bump the version whenever the way libraries get built or models get hashed changes
+        std::ostringstream compilerSettings;
+        compilerSettings << "ct_jit_v2_compiler" << settings.compiler_;
+
+        return JITLibraryCache::hash(compilerSettings.str(), modelsKey);
+    }
+
+private:
+    //! compile saved sources with the ParallelCCompiler and load the library
+    static std::shared_ptr<DynamicLib_t> compileSources(const std::string& sourcesDir,
+        const std::string& objectsDir,
+        const std::string& libPath,
+        const DerivativesCppadSettings& settings)
+    {
+        if (settings.compiler_ != DerivativesCppadSettings::GCC && settings.compiler_ != DerivativesCppadSettings::CLANG)
+            throw std::runtime_error("Unknown compiler type for dynamic library, support only gcc and clang.");
+
+        ParallelCCompiler compiler(
+            settings.compiler_ == DerivativesCppadSettings::GCC ? "gcc" : "clang", settings.compileThreads_);
+        compiler.compileLibrary(
+            sourcesDir, objectsDir, libPath + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+
+        return internal::CGHelpers::loadDynamicLibCppad<double>(libPath);
+    }
+
+    DerivativesCppadSettings settings_;
+    std::string libName_;
+    std::string uniqueID_;
+    uint64_t modelsKey_;  //! hash of the models added so far, see hashModel()
+
+    std::vector<std::unique_ptr<CppAD::cg::ModelCSourceGen<double>>> models_;
+    std::vector<Loader_t> loaders_;
+};
+
+}  // namespace core
+}  // namespace ct
+
+#endif
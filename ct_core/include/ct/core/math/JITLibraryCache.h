@@ -0,0 +1,362 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+
+namespace ct {
+namespace core {
+
+//! A persistent, content-addressed cache for just-in-time compiled dynamic libraries
+/*!
+ * Compiling generated derivative code is expensive. The cache stores compiled libraries in a directory on disk, named
+ * after a hash of everything that determines the library's content, i.e. the recorded functions, the code generation
+ * and the compiler settings. Subsequent runs, or other processes on the same host, can therefore load the library
+ * directly instead of generating and compiling its code again.
+ *
+ * New libraries are compiled under a temporary name and then moved into the cache with an atomic rename, such that
+ * concurrent processes never load a partially written library. Whenever a library gets inserted, the least recently
+ * used libraries are evicted until the total size of the cache is below the configured limit.
+ *
+ * The object files of incremental builds (see ParallelCCompiler) are kept in objectsDirectory(). They count towards
+ * the size limit and are evicted in the same least recently used order as the libraries.
+ *
+ * Hits, misses and evictions of all caches in the process are counted, see getStatistics().
+ *
+ * \note only supported on POSIX systems
+ */
+class JITLibraryCache
+{
+public:
+    //! cache instrumentation, counted for all caches of the process
+    struct Statistics
+    {
+        size_t hits = 0;       //! number of libraries found in the cache
+        size_t misses = 0;     //! number of libraries not found in the cache
+        size_t evictions = 0;  //! number of libraries and object files removed to respect the size limit
+    };
+
+    /*!
+     * \brief constructor
+     * @param directory the cache directory, gets created if it does not exist. If empty, defaultDirectory() is used.
+     * @param maxSizeBytes maximum total size of all libraries and object files in the cache
+     * @param extension file extension of the cached libraries
+     */
+    JITLibraryCache(const std::string& directory, size_t maxSizeBytes, const std::string& extension = ".so")
+        : directory_(directory.empty() ? defaultDirectory() : directory),
+          maxSizeBytes_(maxSizeBytes),
+          extension_(extension)
+    {
+        createDirectory(directory_ + "/tmp");
+    }
+
+    //! the cache directory, $XDG_CACHE_HOME/ct/jit or $HOME/.cache/ct/jit, or a directory in /tmp as a fallback
+    static std::string defaultDirectory()
+    {
+        const char* xdgCache = std::getenv("XDG_CACHE_HOME");
+        if (xdgCache && *xdgCache)
+            return std::string(xdgCache) + "/ct/jit";
+
+        const char* home = std::getenv("HOME");
+        if (home && *home)
+            return std::string(home) + "/.cache/ct/jit";
+
+        return "/tmp/ct_jit_cache";
+    }
+
+    //! incrementally computes a 64 bit FNV-1a hash of the data
+    static uint64_t hash(const std::string& data, uint64_t seed = 14695981039346656037ull)
+    {
+        uint64_t h = seed;
+        for (unsigned char c : data)
+        {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    //! the hash as fixed-length hex string, suitable for file names
+    static std::string toString(uint64_t hash)
+    {
+        std::ostringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return ss.str();
+    }
+
+    //! hash all regular files of a directory, including their names, in alphabetical order
+    static uint64_t hashDirectory(const std::string& directory, uint64_t seed = 14695981039346656037ull)
+    {
+        std::vector<std::string> files = listFiles(directory, "");
+        std::sort(files.begin(), files.end());
+
+        uint64_t h = seed;
+        for (const std::string& file : files)
+        {
+            std::ifstream stream(directory + "/" + file, std::ios::binary);
+            std::ostringstream content;
+            content << stream.rdbuf();
+
+            h = hash(file, h);
+            h = hash(content.str(), h);
+        }
+        return h;
+    }
+
+    //! remove a directory and all regular files in it
+    static void removeDirectory(const std::string& directory)
+    {
+        for (const std::string& file : listFiles(directory, ""))
+            std::remove((directory + "/" + file).c_str());
+
+        ::rmdir(directory.c_str());
+    }
+
+    /*!
+     * \brief the path a library is stored under in the cache, without file extension
+     * @param name a human readable name, only used to make the cache directory easier to inspect
+     * @param key the content hash of the library
+     */
+    std::string libraryPath(const std::string& name, uint64_t key) const
+    {
+        return directory_ + "/" + name + "_" + toString(key);
+    }
+
+    /*!
+     * \brief look up a library and count a hit or miss
+     *
+     * A hit refreshes the library's modification time, which is used to determine the least recently used library.
+     * @return true if the library is in the cache
+     */
+    bool lookup(const std::string& name, uint64_t key)
+    {
+        const std::string file = libraryPath(name, key) + extension_;
+
+        if (::access(file.c_str(), R_OK) == 0)
+        {
+            ::utime(file.c_str(), nullptr);
+            statistics().hits++;
+            return true;
+        }
+
+        statistics().misses++;
+        return false;
+    }
+
+    /*!
+     * \brief a unique path to compile a library to before inserting it, without file extension
+     *
+     * Temporary libraries live in a sub-directory of the cache, such that they are never evicted while being built.
+     */
+    std::string temporaryPath(const std::string& name, uint64_t key, const std::string& uniqueID) const
+    {
+        return directory_ + "/tmp/" + name + "_" + toString(key) + "_" + uniqueID;
+    }
+
+    /*!
+     * \brief move a compiled library into the cache and evict old libraries if the cache grows too large
+     * @param compiledLibrary the file of the compiled library, gets moved
+     * @return the path of the library inside the cache, without file extension
+     */
+    std::string insert(const std::string& compiledLibrary, const std::string& name, uint64_t key)
+    {
+        const std::string path = libraryPath(name, key);
+
+        if (std::rename(compiledLibrary.c_str(), (path + extension_).c_str()) != 0)
+            throw std::runtime_error("JITLibraryCache: could not move " + compiledLibrary + " into the cache: " +
+                                     std::string(std::strerror(errno)));
+
+        evict(name + "_" + toString(key) + extension_);
+
+        return path;
+    }
+
+    //! total size of all libraries and object files in the cache in bytes
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const Entry& entry : listEntries())
+            total += entry.size;
+        return total;
+    }
+
+    //! remove all libraries and object files from the cache
+    void clear()
+    {
+        for (const Entry& entry : listEntries())
+            std::remove(entry.file.c_str());
+    }
+
+    const std::string& getDirectory() const { return directory_; }
+    //! the directory of the object files kept for incremental builds
+    std::string objectsDirectory() const { return directory_ + "/objects"; }
+    size_t getMaxSize() const { return maxSizeBytes_; }
+
+    //! hits, misses and evictions of all caches in this process
+    static Statistics getStatistics()
+    {
+        Statistics stats;
+        stats.hits = statistics().hits;
+        stats.misses = statistics().misses;
+        stats.evictions = statistics().evictions;
+        return stats;
+    }
+
+    //! reset the instrumentation counters to zero
+    static void resetStatistics()
+    {
+        statistics().hits = 0;
+        statistics().misses = 0;
+        statistics().evictions = 0;
+    }
+
+private:
+    struct AtomicStatistics
+    {
+        std::atomic_size_t hits{0};
+        std::atomic_size_t misses{0};
+        std::atomic_size_t evictions{0};
+    };
+
+    static AtomicStatistics& statistics()
+    {
+        static AtomicStatistics stats;
+        return stats;
+    }
+
+    //! object files used more recently than this may be about to be linked by a concurrent build
+    static constexpr time_t objectGracePeriod = 60;
+
+    struct Entry
+    {
+        std::string file;
+        size_t size;
+        time_t lastUsed;
+        bool isObject;
+    };
+
+    //! all libraries and object files in the cache, with full paths
+    std::vector<Entry> listEntries() const
+    {
+        std::vector<Entry> entries;
+
+        auto add = [&entries](const std::string& directory, const std::string& extension, bool isObject) {
+            for (const std::string& file : listFiles(directory, extension))
+            {
+                struct stat info;
+                if (::stat((directory + "/" + file).c_str(), &info) == 0)
+                    entries.push_back({directory + "/" + file, static_cast<size_t>(info.st_size), info.st_mtime,
+                        isObject});
+            }
+        };
+
+        add(directory_, extension_, false);
+        add(objectsDirectory(), ".o", true);
+
+        return entries;
+    }
+
+    //! remove the least recently used files until the cache fits its size limit, keep the given library
+    void evict(const std::string& keep)
+    {
+        std::vector<Entry> entries = listEntries();
+
+        size_t total = 0;
+        for (const Entry& entry : entries)
+            total += entry.size;
+
+        std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+
+        const time_t now = ::time(nullptr);
+
+        for (const Entry& entry : entries)
+        {
+            if (total <= maxSizeBytes_)
+                break;
+
+            if (entry.file == directory_ + "/" + keep)
+                continue;
+
+            if (entry.isObject && entry.lastUsed + objectGracePeriod > now)
+                continue;
+
+            // other processes which loaded the library keep using it, unlinking only removes the directory entry
+            if (std::remove(entry.file.c_str()) == 0)
+            {
+                total -= entry.size;
+                statistics().evictions++;
+            }
+        }
+    }
+
+    //! names of all regular files in the directory ending with the given extension
+    static std::vector<std::string> listFiles(const std::string& directory, const std::string& extension)
+    {
+        std::vector<std::string> files;
+
+        DIR* dir = ::opendir(directory.c_str());
+        if (!dir)
+            return files;
+
+        while (struct dirent* entry = ::readdir(dir))
+        {
+            const std::string file(entry->d_name);
+
+            struct stat info;
+            if (::stat((directory + "/" + file).c_str(), &info) != 0 || !S_ISREG(info.st_mode))
+                continue;
+
+            if (file.size() >= extension.size() &&
+                file.compare(file.size() - extension.size(), extension.size(), extension) == 0)
+                files.push_back(file);
+        }
+
+        ::closedir(dir);
+        return files;
+    }
+
+    //! create a directory including all its parents
+    static void createDirectory(const std::string& directory)
+    {
+        for (size_t pos = directory.find('/', 1); ; pos = directory.find('/', pos + 1))
+        {
+            const std::string parent = directory.substr(0, pos);
+            if (::mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST)
+                throw std::runtime_error("JITLibraryCache: could not create directory " + parent + ": " +
+                                         std::string(std::strerror(errno)));
+
+            if (pos == std::string::npos)
+                break;
+        }
+    }
+
+    std::string directory_;
+    size_t maxSizeBytes_;
+    std::string extension_;
+};
+
+}  // namespace core
+}  // namespace ct
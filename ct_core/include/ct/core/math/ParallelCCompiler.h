@@ -0,0 +1,229 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <ct/core/math/JITLibraryCache.h>
+
+namespace ct {
+namespace core {
+
+//! Compiles a directory of C sources to a dynamic library, one translation unit per thread
+/*!
+ * Generated derivative code is usually split into many source files (see DerivativesCppadSettings::maxAssignements_).
+ * Instead of passing all of them to a single compiler invocation, every translation unit is compiled to an object
+ * file by its own compiler process, with up to nThreads processes running concurrently. The object files are linked
+ * into a dynamic library afterwards.
+ *
+ * Object files are named after a hash of their source and the compile flags. If the objects directory is kept
+ * between builds, translation units which did not change are not compiled again, i.e. the compilation is
+ * incremental. The number of compiled and reused translation units of the last build is available through
+ * getNumCompiled() and getNumReused().
+ *
+ * \note only supported on POSIX systems
+ */
+class ParallelCCompiler
+{
+public:
+    /*!
+     * \brief constructor
+     * @param compiler the compiler executable, e.g. "gcc" or "clang"
+     * @param nThreads maximum number of concurrent compiler processes, 0 to use all cores
+     * @param compileFlags flags used for compiling the translation units, -fPIC -c is added
+     * @param linkFlags flags used for linking the library, -shared is added
+     */
+    ParallelCCompiler(const std::string& compiler = "gcc",
+        size_t nThreads = 0,
+        const std::vector<std::string>& compileFlags = {"-O2"},
+        const std::vector<std::string>& linkFlags = {"-O2", "-rdynamic"})
+        : compiler_(compiler),
+          nThreads_(nThreads > 0 ? nThreads : std::max(1u, std::thread::hardware_concurrency())),
+          compileFlags_(compileFlags),
+          linkFlags_(linkFlags),
+          nCompiled_(0),
+          nReused_(0)
+    {
+    }
+
+    /*!
+     * \brief compile all *.c files of a directory and link them to a dynamic library
+     * @param sourcesDir directory containing the sources
+     * @param objectsDir directory to store the object files in, gets created if it does not exist
+     * @param libraryFile the dynamic library to create, including its file extension
+     */
+    void compileLibrary(const std::string& sourcesDir, const std::string& objectsDir, const std::string& libraryFile)
+    {
+        if (::mkdir(objectsDir.c_str(), 0755) != 0 && errno != EEXIST)
+            throw std::runtime_error("ParallelCCompiler: could not create directory " + objectsDir);
+
+        std::vector<std::string> sources = listSources(sourcesDir);
+        if (sources.empty())
+            throw std::runtime_error("ParallelCCompiler: no sources found in " + sourcesDir);
+
+        // the object file names identify their content, hence the link order is deterministic
+        std::sort(sources.begin(), sources.end());
+
+        std::vector<std::string> objects(sources.size());
+        for (size_t i = 0; i < sources.size(); i++)
+            objects[i] = objectsDir + "/" + objectName(sourcesDir + "/" + sources[i]);
+
+        nCompiled_ = 0;
+        nReused_ = 0;
+
+        std::atomic_size_t next(0);
+        std::mutex errorMutex;
+        std::string errors;
+
+        auto worker = [&]() {
+            for (size_t i = next++; i < sources.size(); i = next++)
+            {
+                if (::access(objects[i].c_str(), R_OK) == 0)
+                {
+                    // mark the object as recently used for the eviction of the JITLibraryCache
+                    ::utime(objects[i].c_str(), nullptr);
+                    nReused_++;
+                    continue;
+                }
+
+                // compile to a unique name first, such that concurrent builds never link partially written objects
+                const std::string temp = objects[i] + "." + std::to_string(::getpid()) + "_" + std::to_string(i);
+
+                std::vector<std::string> args = {compiler_};
+                args.insert(args.end(), compileFlags_.begin(), compileFlags_.end());
+                args.insert(args.end(), {"-fPIC", "-c", sourcesDir + "/" + sources[i], "-o", temp});
+
+                if (execute(args) && std::rename(temp.c_str(), objects[i].c_str()) == 0)
+                {
+                    nCompiled_++;
+                }
+                else
+                {
+                    std::remove(temp.c_str());
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    errors += " " + sources[i];
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < std::min(nThreads_, sources.size()); i++)
+            threads.emplace_back(worker);
+        worker();
+        for (std::thread& thread : threads)
+            thread.join();
+
+        if (!errors.empty())
+            throw std::runtime_error("ParallelCCompiler: failed to compile" + errors);
+
+        std::vector<std::string> args = {compiler_};
+        args.insert(args.end(), linkFlags_.begin(), linkFlags_.end());
+        args.push_back("-shared");
+        args.insert(args.end(), objects.begin(), objects.end());
+        args.insert(args.end(), {"-o", libraryFile});
+
+        if (!execute(args))
+            throw std::runtime_error("ParallelCCompiler: failed to link " + libraryFile);
+    }
+
+    //! number of translation units compiled in the last build
+    size_t getNumCompiled() const { return nCompiled_; }
+    //! number of translation units reused from the objects directory in the last build
+    size_t getNumReused() const { return nReused_; }
+    size_t getNumThreads() const { return nThreads_; }
+
+private:
+    //! the object file name of a source file, unique for its content and the compile settings
+    std::string objectName(const std::string& source) const
+    {
+        std::ifstream stream(source, std::ios::binary);
+        std::ostringstream content;
+        content << stream.rdbuf();
+
+        uint64_t key = JITLibraryCache::hash(compiler_);
+        for (const std::string& flag : compileFlags_)
+            key = JITLibraryCache::hash(flag, key);
+        key = JITLibraryCache::hash(content.str(), key);
+
+        return JITLibraryCache::toString(key) + ".o";
+    }
+
+    //! names of all C sources in a directory
+    static std::vector<std::string> listSources(const std::string& directory)
+    {
+        std::vector<std::string> sources;
+
+        DIR* dir = ::opendir(directory.c_str());
+        if (!dir)
+            return sources;
+
+        while (struct dirent* entry = ::readdir(dir))
+        {
+            const std::string file(entry->d_name);
+            if (file.size() > 2 && file.compare(file.size() - 2, 2, ".c") == 0)
+                sources.push_back(file);
+        }
+
+        ::closedir(dir);
+        return sources;
+    }
+
+    //! run a command without a shell and wait for it, returns true on success
+    static bool execute(const std::vector<std::string>& args)
+    {
+        std::vector<char*> argv;
+        for (const std::string& arg : args)
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+
+        pid_t pid = ::fork();
+        if (pid < 0)
+            return false;
+
+        if (pid == 0)
+        {
+            ::execvp(argv[0], argv.data());
+            ::_exit(127);
+        }
+
+        int status;
+        while (::waitpid(pid, &status, 0) < 0)
+        {
+            if (errno != EINTR)
+                return false;
+        }
+
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    std::string compiler_;
+    size_t nThreads_;
+    std::vector<std::string> compileFlags_;
+    std::vector<std::string> linkFlags_;
+
+    std::atomic_size_t nCompiled_;
+    std::atomic_size_t nReused_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -8,6 +8,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/core/control/continuous_time/Controller.h>
 #include "System.h"
 
+#include <ct/core/types/ControlVectorBatch.h>
+
 #include <ct/core/types/arrays/MatrixArrays.h>
 #include <ct/core/types/arrays/TimeArray.h>
 #include <ct/core/types/trajectories/MatrixTrajectories.h>
@@ -135,16 +137,82 @@ public:
     }
 
 
+    //! compute the dynamics of the system for a batch of states
+    /*!
+	 * Evaluates the controller for every state and then calls computeControlledDynamicsBatch().
+	 *
+	 * \note Generally, this function does not need to be overloaded. Better overload computeControlledDynamicsBatch().
+	 *
+	 * @param states current states, one state per column
+	 * @param t current time
+	 * @param derivatives state derivatives
+	 */
+    virtual void computeDynamicsBatch(const StateVectorBatch<STATE_DIM, SCALAR>& states,
+        const time_t& t,
+        StateVectorBatch<STATE_DIM, SCALAR>& derivatives) override
+    {
+        // like controlAction_, the buffer is owned by the system, concurrent evaluations require clones
+        if (controlActionBatch_.cols() != states.cols())
+            controlActionBatch_.resize(CONTROL_DIM, states.cols());
+
+        if (controller_)
+        {
+            StateVector<STATE_DIM, SCALAR> state;
+            for (int i = 0; i < states.cols(); i++)
+            {
+                state = states.col(i);
+                controller_->computeControl(state, t, controlAction_);
+                controlActionBatch_.col(i) = controlAction_;
+            }
+        }
+        else
+            controlActionBatch_.setZero();
+
+        computeControlledDynamicsBatch(states, t, controlActionBatch_, derivatives);
+    }
+
+
     virtual void computeControlledDynamics(const StateVector<STATE_DIM, SCALAR>& state,
         const time_t& t,
         const ControlVector<CONTROL_DIM, SCALAR>& control,
         StateVector<STATE_DIM, SCALAR>& derivative) = 0;
 
+    //! compute the controlled dynamics for a batch of states and controls
+    /*!
+	 * The default implementation calls computeControlledDynamics() for every column. Overload this function to
+	 * vectorize the dynamics across the batch.
+	 *
+	 * @param states states, one state per column
+	 * @param t current time
+	 * @param controls control inputs, one control per column
+	 * @param derivatives state derivatives, has the same size as states
+	 */
+    virtual void computeControlledDynamicsBatch(const StateVectorBatch<STATE_DIM, SCALAR>& states,
+        const time_t& t,
+        const ControlVectorBatch<CONTROL_DIM, SCALAR>& controls,
+        StateVectorBatch<STATE_DIM, SCALAR>& derivatives)
+    {
+        derivatives.resize(STATE_DIM, states.cols());
+
+        StateVector<STATE_DIM, SCALAR> state;
+        ControlVector<CONTROL_DIM, SCALAR> control;
+        StateVector<STATE_DIM, SCALAR> derivative;
+        for (int i = 0; i < states.cols(); i++)
+        {
+            state = states.col(i);
+            control = controls.col(i);
+            computeControlledDynamics(state, t, control, derivative);
+            derivatives.col(i) = derivative;
+        }
+    }
+
     ControlVector<CONTROL_DIM, SCALAR> getLastControlAction() { return controlAction_; }
 protected:
     std::shared_ptr<Controller<STATE_DIM, CONTROL_DIM, SCALAR>> controller_;  //!< the controller instance
 
     ControlVector<CONTROL_DIM, SCALAR> controlAction_;
+
+    ControlVectorBatch<CONTROL_DIM, SCALAR> controlActionBatch_;  //!< control buffer of computeDynamicsBatch()
 };
 }
 }
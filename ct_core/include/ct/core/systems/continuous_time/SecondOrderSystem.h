@@ -152,6 +152,18 @@ public:
         derivative(1) = g_dc_ * w_n_square_ * control(0) - 2.0 * zeta_ * w_n_ * state(1) - w_n_square_ * state(0);
     }
 
+    //! evaluate the dynamics for a batch of states, vectorized across the batch
+    virtual void computeControlledDynamicsBatch(const StateVectorBatch<2, SCALAR>& states,
+        const time_t& t,
+        const ControlVectorBatch<1, SCALAR>& controls,
+        StateVectorBatch<2, SCALAR>& derivatives) override
+    {
+        derivatives.resize(2, states.cols());
+        derivatives.row(0) = states.row(1);
+        derivatives.row(1) = g_dc_ * w_n_square_ * controls.row(0) - 2.0 * zeta_ * w_n_ * states.row(1) -
+                             w_n_square_ * states.row(0);
+    }
+
     //! check the parameters
     /*!
 	 * @return true if parameters are physical
@@ -7,6 +7,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/core/types/Time.h>
 #include <ct/core/types/StateVector.h>
+#include <ct/core/types/StateVectorBatch.h>
 
 namespace ct {
 namespace core {
@@ -68,6 +69,30 @@ public:
         const time_t& t,
         StateVector<STATE_DIM, SCALAR>& derivative) = 0;
 
+    //! computes the system dynamics for a batch of states at the same time
+    /*!
+	 * The default implementation calls computeDynamics() for every state. Overload this function to vectorize the
+	 * dynamics across the batch, e.g. by operating on entire rows of the batch.
+	 * @param states states to evaluate dynamics at, one state per column
+	 * @param t time to evaluate the dynamics at
+	 * @param derivatives state derivatives, has the same size as states
+	 */
+    virtual void computeDynamicsBatch(const StateVectorBatch<STATE_DIM, SCALAR>& states,
+        const time_t& t,
+        StateVectorBatch<STATE_DIM, SCALAR>& derivatives)
+    {
+        derivatives.resize(STATE_DIM, states.cols());
+
+        StateVector<STATE_DIM, SCALAR> state;
+        StateVector<STATE_DIM, SCALAR> derivative;
+        for (int i = 0; i < states.cols(); i++)
+        {
+            state = states.col(i);
+            computeDynamics(state, t, derivative);
+            derivatives.col(i) = derivative;
+        }
+    }
+
     //! get the type of system
     /*!
 	 * @return system type
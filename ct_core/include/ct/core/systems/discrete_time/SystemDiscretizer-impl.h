@@ -225,6 +225,12 @@ SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::getSubcontrols(
     return substepRecorder_->getSubcontrols();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+void SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::reserveSubsteps(const size_t numSubsteps)
+{
+    substepRecorder_->reserve(numSubsteps);
+}
+
 
 }  // namespace core
 }  // namespace ct
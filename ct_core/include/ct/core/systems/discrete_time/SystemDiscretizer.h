@@ -131,6 +131,9 @@ public:
     //! reuturn a pointer to the subcontrols recorded during integration
     const ControlVectorArrayPtr& getSubcontrols() const;
 
+    //! reserve memory for recording numSubsteps substeps during integration
+    void reserveSubsteps(const size_t numSubsteps);
+
 protected:
     //! initialize the symplectic integrator, if the system is symplectic
     SYMPLECTIC_ENABLED initializeSymplecticIntegrator();
@@ -72,6 +72,8 @@ public:
     }
 
 protected:
+    typedef Eigen::Matrix<OUT_SCALAR, Eigen::Dynamic, 1> dynamic_vector_t;
+
     //! compute the state Jacobian
     /*!
      * @param x state to linearize around
@@ -79,17 +81,7 @@ protected:
      */
     void computeA(const state_vector_t& x, const control_vector_t& u)
     {
-        Eigen::Matrix<OUT_SCALAR, Eigen::Dynamic, 1> input(STATE_DIM + CONTROL_DIM);
-        input << x, u;
-
-        Eigen::Matrix<OUT_SCALAR, Eigen::Dynamic, 1> jac(this->A_entries);
-
-        this->f_.SparseJacobianForward(input, this->sparsityA_.sparsity(), this->sparsityA_.row(),
-            this->sparsityA_.col(), jac, this->sparsityA_.workJacobian());
-
-        Eigen::Map<Eigen::Matrix<OUT_SCALAR, STATE_DIM, STATE_DIM>> out(jac.data());
-
-        dFdx_ = out;
+        computeJacobian(x, u, this->coloringA_, 0, dFdx_);
     }
 
     //! compute the input Jacobian
@@ -99,17 +91,49 @@ protected:
      */
     void computeB(const state_vector_t& x, const control_vector_t& u)
     {
-        Eigen::Matrix<OUT_SCALAR, Eigen::Dynamic, 1> input(STATE_DIM + CONTROL_DIM);
+        computeJacobian(x, u, this->coloringB_, STATE_DIM, dFdu_);
+    }
+
+    //! compute a block of the Jacobian with one forward or reverse sweep per colour
+    /*!
+     * @param x state to linearize around
+     * @param u input to linearize around
+     * @param coloring colouring of the block
+     * @param inputOffset index of the first input of the block
+     * @param jac the block, whose structural zeros are left untouched
+     */
+    template <typename DERIVED>
+    void computeJacobian(const state_vector_t& x,
+        const control_vector_t& u,
+        const internal::JacobianColoring& coloring,
+        size_t inputOffset,
+        Eigen::MatrixBase<DERIVED>& jac)
+    {
+        dynamic_vector_t input(STATE_DIM + CONTROL_DIM);
         input << x, u;
 
-        Eigen::Matrix<OUT_SCALAR, Eigen::Dynamic, 1> jac(this->B_entries);
+        this->f_.Forward(0, input);
 
-        this->f_.SparseJacobianForward(input, this->sparsityB_.sparsity(), this->sparsityB_.row(),
-            this->sparsityB_.col(), jac, this->sparsityB_.workJacobian());
+        for (size_t c = 0; c < coloring.numColors(); c++)
+        {
+            coloring.seed(c, seed_);
 
-        Eigen::Map<Eigen::Matrix<OUT_SCALAR, STATE_DIM, CONTROL_DIM>> out(jac.data());
+            if (coloring.isForward())
+            {
+                direction_.setZero(STATE_DIM + CONTROL_DIM);
+                direction_.segment(inputOffset, coloring.cols()) = seed_;
+                product_ = this->f_.Forward(1, direction_);
+            }
+            else
+            {
+                direction_ = this->f_.Reverse(1, seed_);
+                product_ = direction_.segment(inputOffset, coloring.cols());
+            }
 
-        dFdu_ = out;
+            coloring.recover(c, product_, values_);
+        }
+
+        coloring.scatter(values_, jac);
     }
 
 protected:
@@ -117,6 +141,11 @@ protected:
 
     state_matrix_t dFdx_;          //!< Jacobian wrt state
     state_control_matrix_t dFdu_;  //!< Jacobian wrt input
+
+    dynamic_vector_t seed_;       //!< seed of the current colour
+    dynamic_vector_t direction_;  //!< seed with respect to all inputs or adjoint of all inputs
+    dynamic_vector_t product_;    //!< compressed Jacobian column or row of the current colour
+    dynamic_vector_t values_;     //!< non-zeros of the Jacobian
 };
 
 }  // namespace core
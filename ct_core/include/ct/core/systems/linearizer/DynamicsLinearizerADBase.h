@@ -7,6 +7,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #ifdef CPPADCG
 
+#include <ct/core/internal/autodiff/JacobianColoring.h>
 #include <ct/core/internal/autodiff/SparsityPattern.h>
 
 namespace ct {
@@ -59,7 +60,11 @@ public:
 	 */
     DynamicsLinearizerADBase(dynamics_fct_t dyn) : dynamics_fct_(dyn) { initialize(); }
     //! copy constructor
-    DynamicsLinearizerADBase(const DynamicsLinearizerADBase& arg) : dynamics_fct_(arg.dynamics_fct_)
+    DynamicsLinearizerADBase(const DynamicsLinearizerADBase& arg)
+        : dynamics_fct_(arg.dynamics_fct_),
+          sparsity_(arg.sparsity_),
+          coloringA_(arg.coloringA_),
+          coloringB_(arg.coloringB_)
     {
         setupSparsityA();
         setupSparsityB();
@@ -80,6 +85,12 @@ public:
 
     virtual ~DynamicsLinearizerADBase() = default;
 
+    //! the structural non-zeros of the Jacobian [ A, B ] as detected from the recorded dynamics
+    const Eigen::Matrix<bool, STATE_DIM, STATE_DIM + CONTROL_DIM>& getSparsity() const { return sparsity_; }
+    //! the colouring used to evaluate the state Jacobian
+    const JacobianColoring& getColoringA() const { return coloringA_; }
+    //! the colouring used to evaluate the input Jacobian
+    const JacobianColoring& getColoringB() const { return coloringB_; }
 protected:
     const size_t A_entries = STATE_DIM * STATE_DIM;    //!< number of entries in the state Jacobian
     const size_t B_entries = STATE_DIM * CONTROL_DIM;  //!< number of entries in the input Jacobian
@@ -95,6 +106,7 @@ protected:
         recordTerms();
         setupSparsityA();
         setupSparsityB();
+        setupColoring();
     }
 
     //! record the model
@@ -154,11 +166,42 @@ protected:
         sparsityB_.clearWork();
     }
 
+    //! detect the structural non-zeros of the Jacobians and colour them
+    /*!
+     * Many dynamics only couple a few states, e.g. the positions of a second order system only depend on the
+     * velocities. The colourings allow to evaluate the Jacobians with one sweep per colour instead of one sweep per
+     * state or input, see JacobianColoring.
+     */
+    void setupColoring()
+    {
+        const size_t nInputs = STATE_DIM + CONTROL_DIM;
+
+        CppAD::vector<bool> identity(nInputs * nInputs);
+        for (size_t i = 0; i < nInputs; i++)
+            for (size_t j = 0; j < nInputs; j++)
+                identity[i * nInputs + j] = (i == j);
+
+        // row-major sparsity of the STATE_DIM x (STATE_DIM + CONTROL_DIM) Jacobian
+        CppAD::vector<bool> pattern = f_.ForSparseJac(nInputs, identity);
+        f_.size_forward_bool(0);  // free the forward sparsity stored in f_
+
+        for (size_t i = 0; i < STATE_DIM; i++)
+            for (size_t j = 0; j < nInputs; j++)
+                sparsity_(i, j) = pattern[i * nInputs + j];
+
+        coloringA_.initPattern(sparsity_.template leftCols<STATE_DIM>());
+        coloringB_.initPattern(sparsity_.template rightCols<CONTROL_DIM>());
+    }
+
     dynamics_fct_t dynamics_fct_;                  //!< function handle to system dynamics
     CppAD::ADFun<typename SCALAR::value_type> f_;  //!< Auto-Diff function
 
-    SparsityPattern sparsityA_;  //!< sparsity pattern of the state Jacobian
-    SparsityPattern sparsityB_;  //!< sparsity pattern of the input Jacobian
+    SparsityPattern sparsityA_;  //!< dense sparsity pattern of the state Jacobian, used for code generation
+    SparsityPattern sparsityB_;  //!< dense sparsity pattern of the input Jacobian, used for code generation
+
+    Eigen::Matrix<bool, STATE_DIM, STATE_DIM + CONTROL_DIM> sparsity_;  //!< structural non-zeros of [ A, B ]
+    JacobianColoring coloringA_;  //!< colouring of the state Jacobian
+    JacobianColoring coloringB_;  //!< colouring of the input Jacobian
 };
 
 }  // namespace internal
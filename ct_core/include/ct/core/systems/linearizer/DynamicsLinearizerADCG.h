@@ -9,6 +9,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include "DynamicsLinearizerADBase.h"
 #include <ct/core/internal/autodiff/CGHelpers.h>
+#include <ct/core/internal/autodiff/SharedDynamicLib.h>
 
 namespace ct {
 namespace core {
@@ -64,7 +65,7 @@ public:
     {
     }
 
-    //! copy constructor
+    //! copy constructor, shares the compiled library with rhs but creates its own model instance
     DynamicsLinearizerADCG(const DynamicsLinearizerADCG& rhs)
         : Base(rhs.dynamics_fct_),
           dynamics_fct_(rhs.dynamics_fct_),
@@ -80,9 +81,9 @@ public:
     {
         if (compiled_)
         {
-            dynamicLib_ = internal::CGHelpers::loadDynamicLibCppad<OUT_SCALAR>(jitLibName_);
-            model_ = std::shared_ptr<CppAD::cg::GenericModel<OUT_SCALAR>>(
-                dynamicLib_->model("DynamicsLinearizerADCG" + jitLibName_));
+            dynamicLib_ = rhs.dynamicLib_;
+            model_ = dynamicLib_->createModel("DynamicsLinearizerADCG" + jitLibName_);
+            model_->JacobianSparsity(jacRows_, jacCols_);
         }
     }
 
@@ -156,7 +157,9 @@ public:
         jitLibName_ = libName + uniqueID;
 
         CppAD::cg::ModelCSourceGen<OUT_SCALAR> cgen(this->f_, "DynamicsLinearizerADCG" + jitLibName_);
-        cgen.setCreateJacobian(true);
+        // only the structural non-zeros get generated, using the AD mode which requires fewer sweeps
+        cgen.setCreateSparseJacobian(true);
+        cgen.setJacobianADMode(jacobianADMode());
         CppAD::cg::ModelLibraryCSourceGen<OUT_SCALAR> libcgen(cgen);
         std::string tempDir = "cppad_temp" + uniqueID;
         if (verbose)
@@ -168,10 +171,11 @@ public:
         // compile source code
         CppAD::cg::DynamicModelLibraryProcessor<OUT_SCALAR> p(libcgen, jitLibName_);
         compiler_.setTemporaryFolder(tempDir);
-        dynamicLib_ = std::shared_ptr<CppAD::cg::DynamicLib<OUT_SCALAR>>(p.createDynamicLibrary(compiler_));
+        dynamicLib_ = std::make_shared<internal::SharedDynamicLib<OUT_SCALAR>>(
+            std::shared_ptr<CppAD::cg::DynamicLib<OUT_SCALAR>>(p.createDynamicLibrary(compiler_)));
 
-        model_ = std::shared_ptr<CppAD::cg::GenericModel<OUT_SCALAR>>(
-            dynamicLib_->model("DynamicsLinearizerADCG" + jitLibName_));
+        model_ = dynamicLib_->createModel("DynamicsLinearizerADCG" + jitLibName_);
+        model_->JacobianSparsity(jacRows_, jacCols_);
 
         compiled_ = true;
 
@@ -216,7 +220,11 @@ public:
     }
 
     //! retrieve the dynamic library, e.g. for testing purposes
-    const std::shared_ptr<CppAD::cg::DynamicLib<OUT_SCALAR>> getDynamicLib() const { return dynamicLib_; }
+    const std::shared_ptr<CppAD::cg::DynamicLib<OUT_SCALAR>> getDynamicLib() const
+    {
+        return dynamicLib_ ? dynamicLib_->get() : nullptr;
+    }
+
 protected:
     //! computes the Jacobians
     /*!
@@ -226,23 +234,33 @@ protected:
      */
     void computeJacobian(const state_vector_t& x, const control_vector_t& u)
     {
-        // copy to dynamic type due to requirements by cppad
-        Eigen::Matrix<OUT_SCALAR, Eigen::Dynamic, 1> input(STATE_DIM + CONTROL_DIM);
-        input << x, u;
-
-        Eigen::Matrix<OUT_SCALAR, Eigen::Dynamic, 1> jac(Base::FullJac_entries);
-
-        jac = model_->Jacobian(input);
+        // copy to std::vector due to requirements by cppad
+        input_.resize(STATE_DIM + CONTROL_DIM);
+        Eigen::Map<Eigen::Matrix<OUT_SCALAR, STATE_DIM + CONTROL_DIM, 1>> inputMap(input_.data());
+        inputMap << x, u;
 
-        Eigen::Map<Eigen::Matrix<OUT_SCALAR, STATE_DIM + CONTROL_DIM, STATE_DIM>> out(jac.data());
+        model_->SparseJacobian(input_, jac_, jacRows_, jacCols_);
 
-        dFdx_ = out.template topRows<STATE_DIM>().transpose();
-        dFdu_ = out.template bottomRows<CONTROL_DIM>().transpose();
+        // the structural zeros of dFdx_ and dFdu_ are zero from construction on
+        for (size_t k = 0; k < jac_.size(); k++)
+        {
+            if (jacCols_[k] < STATE_DIM)
+                dFdx_(jacRows_[k], jacCols_[k]) = jac_[k];
+            else
+                dFdu_(jacRows_[k], jacCols_[k] - STATE_DIM) = jac_[k];
+        }
 
         x_at_cache_ = x;
         u_at_cache_ = u;
     }
 
+    //! the AD mode of the generated Jacobian, chosen by the colouring of the full Jacobian [ A, B ]
+    CppAD::cg::JacobianADMode jacobianADMode() const
+    {
+        internal::JacobianColoring coloring;
+        coloring.initPattern(this->sparsity_);
+        return coloring.isForward() ? CppAD::cg::JacobianADMode::Forward : CppAD::cg::JacobianADMode::Reverse;
+    }
 
     dynamics_fct_t dynamics_fct_;  //!< function handle to system dynamics
 
@@ -257,8 +275,13 @@ protected:
     bool cacheJac_;                                //!< flag if Jacobian will be cached
     CppAD::cg::GccCompiler<OUT_SCALAR> compiler_;  //!< compiler instance for JIT compilation
 
-    std::shared_ptr<CppAD::cg::DynamicLib<OUT_SCALAR>> dynamicLib_;  //!< compiled and dynamically loaded library
-    std::shared_ptr<CppAD::cg::GenericModel<OUT_SCALAR>> model_;     //!< Auto-Diff model
+    std::shared_ptr<internal::SharedDynamicLib<OUT_SCALAR>> dynamicLib_;  //!< compiled library, shared with clones
+    std::shared_ptr<CppAD::cg::GenericModel<OUT_SCALAR>> model_;          //!< Auto-Diff model
+
+    std::vector<size_t> jacRows_;    //!< row indices of the non-zeros of the generated Jacobian
+    std::vector<size_t> jacCols_;    //!< column indices of the non-zeros of the generated Jacobian
+    std::vector<OUT_SCALAR> input_;  //!< stacked state and input
+    std::vector<OUT_SCALAR> jac_;    //!< non-zeros of the generated Jacobian
 
     size_t maxTempVarCountState_;    //!< number of temporary variables in the source code of the state Jacobian
     size_t maxTempVarCountControl_;  //!< number of temporary variables in the source code of the input Jacobian
@@ -0,0 +1,52 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace core {
+
+//! A batch of control vectors, one control per column
+/*!
+ * The storage is row-major, i.e. every control entry is contiguous across the batch. Element-wise operations on a row
+ * therefore vectorize across the batch.
+ */
+template <int CONTROL_DIM, class SCALAR = double>
+class ControlVectorBatch : public Eigen::Matrix<SCALAR, CONTROL_DIM, Eigen::Dynamic, Eigen::RowMajor>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, Eigen::Dynamic, Eigen::RowMajor> Base;
+    static const size_t DIM = CONTROL_DIM;
+
+    ControlVectorBatch() {}
+    //! construct a batch of the given size, entries are uninitialized
+    explicit ControlVectorBatch(int batchSize) : Base(CONTROL_DIM, batchSize) {}
+    virtual ~ControlVectorBatch() {}
+    //! This constructor allows you to construct MyVectorType from Eigen expressions
+    template <typename OtherDerived>
+    ControlVectorBatch(const Eigen::MatrixBase<OtherDerived>& other) : Base(other)
+    {
+    }
+
+    //! This method allows you to assign Eigen expressions to MyVectorType
+    template <typename OtherDerived>
+    ControlVectorBatch& operator=(const Eigen::MatrixBase<OtherDerived>& other)
+    {
+        this->Base::operator=(other);
+        return *this;
+    }
+
+    //! number of controls in the batch
+    int batchSize() const { return static_cast<int>(this->cols()); }
+    //! get underlying Eigen type
+    Base& toImplementation() { return *this; }
+    //! get const underlying Eigen type
+    const Base& toImplementation() const { return *this; }
+};
+
+} /* namespace core */
+} /* namespace ct */
@@ -154,6 +154,108 @@ TEST(AutoDiffDiscreteLinearizerTest, DiscreteSystemLinearizerComparison)
 }
 
 
+TEST(AutoDiffLinearizerTest, SparseJacobianTest)
+{
+    const size_t state_dim = 6;
+    const size_t control_dim = 1;
+
+    typedef CppAD::AD<double> AD_Scalar;
+    typedef DynamicsLinearizerAD<state_dim, control_dim, AD_Scalar, AD_Scalar> Linearizer;
+
+    // a chain of integrators with a nonlinear feedback, the state Jacobian has one non-zero per row and column
+    Linearizer::dynamics_fct_t dynamics = [](const StateVector<state_dim, AD_Scalar>& x, const AD_Scalar& t,
+        const ControlVector<control_dim, AD_Scalar>& u, StateVector<state_dim, AD_Scalar>& dx) {
+        for (size_t i = 0; i < state_dim - 1; i++)
+            dx(i) = x(i + 1);
+        dx(state_dim - 1) = CppAD::sin(x(0)) + x(0) * u(0);
+    };
+
+    Linearizer linearizer(dynamics);
+    Linearizer linearizerCopy(linearizer);
+
+    ASSERT_EQ(linearizer.getColoringA().nonZeros(), state_dim);
+    ASSERT_EQ(linearizer.getColoringA().numColors(), 1u);
+    ASSERT_EQ(linearizer.getColoringB().nonZeros(), 1u);
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        StateVector<state_dim> x = StateVector<state_dim>::Random();
+        ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+
+        StateMatrix<state_dim> A_analytic = StateMatrix<state_dim>::Zero();
+        A_analytic.topRightCorner<state_dim - 1, state_dim - 1>().setIdentity();
+        A_analytic(state_dim - 1, 0) = std::cos(x(0)) + u(0);
+
+        StateControlMatrix<state_dim, control_dim> B_analytic = StateControlMatrix<state_dim, control_dim>::Zero();
+        B_analytic(state_dim - 1, 0) = x(0);
+
+        ASSERT_LT((linearizer.getDerivativeState(x, u) - A_analytic).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((linearizer.getDerivativeControl(x, u) - B_analytic).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((linearizerCopy.getDerivativeState(x, u) - A_analytic).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((linearizerCopy.getDerivativeControl(x, u) - B_analytic).array().abs().maxCoeff(), 1e-10);
+    }
+}
+
+TEST(AutoDiffLinearizerTest, SparseJacobianReverseModeTest)
+{
+    const size_t state_dim = 3;
+    const size_t control_dim = 4;
+    const size_t input_dim = state_dim + control_dim;
+
+    typedef CppAD::AD<double> AD_Scalar;
+    typedef DynamicsLinearizerAD<state_dim, control_dim, AD_Scalar, AD_Scalar> Linearizer;
+
+    // the first row of both Jacobians is dense, all other rows are sparse, such that fewer rows than columns
+    // need to be told apart and the coloring switches to reverse sweeps
+    Linearizer::dynamics_fct_t dynamics = [](const StateVector<state_dim, AD_Scalar>& x, const AD_Scalar& t,
+        const ControlVector<control_dim, AD_Scalar>& u, StateVector<state_dim, AD_Scalar>& dx) {
+        dx(0) = x(0) * x(1) * x(2) + u(0) * u(1) + u(2) * u(3);
+        dx(1) = x(1) * x(1);
+        dx(2) = CppAD::sin(x(2)) * u(3);
+    };
+
+    Linearizer linearizer(dynamics);
+    Linearizer linearizerCopy(linearizer);
+
+    ASSERT_FALSE(linearizer.getColoringA().isForward());
+    ASSERT_EQ(linearizer.getColoringA().numColors(), 2u);
+    ASSERT_FALSE(linearizer.getColoringB().isForward());
+    ASSERT_EQ(linearizer.getColoringB().numColors(), 2u);
+
+    // record the same dynamics once more to compute the dense reference Jacobian without any coloring
+    Eigen::Matrix<AD_Scalar, Eigen::Dynamic, 1> inputAD(input_dim);
+    inputAD.setRandom();
+    CppAD::Independent(inputAD);
+    StateVector<state_dim, AD_Scalar> xAD = inputAD.head<state_dim>();
+    ControlVector<control_dim, AD_Scalar> uAD = inputAD.tail<control_dim>();
+    StateVector<state_dim, AD_Scalar> dxAD;
+    dynamics(xAD, AD_Scalar(0.0), uAD, dxAD);
+    Eigen::Matrix<AD_Scalar, Eigen::Dynamic, 1> outputAD = dxAD;
+    CppAD::ADFun<double> denseFun(inputAD, outputAD);
+
+    typedef Eigen::Matrix<double, state_dim, input_dim, Eigen::RowMajor> dense_jacobian_t;
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        StateVector<state_dim> x = StateVector<state_dim>::Random();
+        ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+
+        Eigen::VectorXd input(input_dim);
+        input << x, u;
+        Eigen::VectorXd denseValues = denseFun.Jacobian(input);
+        dense_jacobian_t jacDense = Eigen::Map<dense_jacobian_t>(denseValues.data());
+
+        StateMatrix<state_dim> A_dense = jacDense.leftCols<state_dim>();
+        StateControlMatrix<state_dim, control_dim> B_dense = jacDense.rightCols<control_dim>();
+
+        ASSERT_LT((linearizer.getDerivativeState(x, u) - A_dense).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((linearizer.getDerivativeControl(x, u) - B_dense).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((linearizerCopy.getDerivativeState(x, u) - A_dense).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((linearizerCopy.getDerivativeControl(x, u) - B_dense).array().abs().maxCoeff(), 1e-10);
+    }
+}
+
+
 TEST(AutoDiffLinearizerTestMP, SystemLinearizerComparisonMP)
 {
     // define the dimensions of the system
@@ -46,6 +46,77 @@ TEST(InterplationTest, Linear)
 }
 
 
+//! reference implementation: greatest index with a time stamp not greater than the enquiry time
+int referenceIndex(const TimeArray& timeArray, double t)
+{
+    int index = 0;
+    for (size_t i = 0; i < timeArray.size(); i++)
+        if (timeArray[i] <= t)
+            index = i;
+    return index;
+}
+
+TEST(InterplationTest, FindIndex)
+{
+    // non-uniform grid with a repeated time stamp
+    TimeArray nonUniform(std::vector<double>{0.0, 0.1, 0.15, 0.7, 0.7, 1.2, 1.3, 2.0, 3.5, 3.6});
+    TimeArray uniform(0.01, 1000, -2.0);
+
+    for (const TimeArray* timeArray : {&nonUniform, &uniform})
+    {
+        ct::core::Interpolation<double> interpolation(InterpolationType::LIN);
+        const double t0 = timeArray->front() - 0.5;
+        const double t1 = timeArray->back() + 0.5;
+
+        // random access
+        for (int i = 0; i < 2000; i++)
+        {
+            double t = t0 + (t1 - t0) * (std::rand() / double(RAND_MAX));
+            ASSERT_EQ(interpolation.findIndex(*timeArray, t), referenceIndex(*timeArray, t));
+        }
+
+        // exact time stamps, forward and backward
+        for (size_t i = 0; i < timeArray->size(); i++)
+        {
+            const double t = (*timeArray)[i];
+            ASSERT_EQ(interpolation.findIndex(*timeArray, t), referenceIndex(*timeArray, t));
+        }
+        for (int i = timeArray->size() - 1; i >= 0; i--)
+        {
+            const double t = (*timeArray)[i];
+            ASSERT_EQ(interpolation.findIndex(*timeArray, t), referenceIndex(*timeArray, t));
+        }
+    }
+}
+
+TEST(InterplationTest, Batched)
+{
+    TimeArray timeStamp(std::vector<double>{0.0, 0.3, 0.4, 1.0, 1.7, 2.0});
+    StateVectorArray<2> data(timeStamp.size());
+    for (size_t i = 0; i < data.size(); i++)
+        data[i].setRandom();
+
+    TimeArray enquiryTimes(std::vector<double>{1.9, -1.0, 0.0, 0.2, 0.35, 0.35, 1.0, 1.5, 2.0, 2.5, 0.1});
+
+    for (InterpolationType type : {InterpolationType::LIN, InterpolationType::ZOH})
+    {
+        ct::core::Interpolation<StateVector<2>> single(type);
+        ct::core::Interpolation<StateVector<2>> batched(type);
+
+        StateVectorArray<2> result;
+        batched.interpolate(timeStamp, data, enquiryTimes, result);
+        ASSERT_EQ(result.size(), enquiryTimes.size());
+
+        for (size_t j = 0; j < enquiryTimes.size(); j++)
+        {
+            StateVector<2> expected;
+            single.interpolate(timeStamp, data, enquiryTimes[j], expected);
+            ASSERT_LT((expected - result[j]).array().abs().maxCoeff(), 1e-12);
+        }
+    }
+}
+
+
 /*!
  *  \example InterpolationTest.cpp
  *
@@ -0,0 +1,98 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+#include <iostream>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include <ct/core/core.h>
+
+
+using namespace ct::core;
+
+
+TEST(TaskPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    for (size_t nThreads : {0, 1, 4})
+    {
+        TaskPool pool(nThreads);
+
+        for (size_t chunkSize : {0, 1, 7})
+        {
+            const size_t first = 3;
+            const size_t last = 503;
+            std::vector<std::atomic_int> visits(last + 1);
+            for (auto& v : visits)
+                v = 0;
+
+            std::vector<std::atomic_int> threadUsed(nThreads + 1);
+            for (auto& t : threadUsed)
+                t = 0;
+
+            pool.parallelFor(first, last,
+                [&](size_t threadId, size_t i) {
+                    ASSERT_LE(threadId, nThreads);
+                    threadUsed[threadId]++;
+                    visits[i]++;
+                },
+                chunkSize);
+
+            for (size_t i = 0; i < visits.size(); i++)
+                ASSERT_EQ(visits[i], (i < first) ? 0 : 1);
+        }
+    }
+}
+
+TEST(TaskPoolTest, ReverseOrderOnSingleThread)
+{
+    TaskPool pool(0);
+
+    std::vector<size_t> order;
+    pool.parallelFor(0, 9, [&](size_t threadId, size_t i) { order.push_back(i); }, 1, true);
+
+    ASSERT_EQ(order.size(), 10u);
+    for (size_t j = 0; j < order.size(); j++)
+        ASSERT_EQ(order[j], 9 - j);
+}
+
+TEST(TaskPoolTest, SubmitWithFuturesAndLatch)
+{
+    TaskPool pool(3);
+
+    std::atomic_int counter(0);
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 50; i++)
+        futures.push_back(pool.submit([&](size_t threadId) { counter++; }));
+    for (auto& f : futures)
+        f.wait();
+    ASSERT_EQ(counter, 50);
+
+    TaskLatch latch;
+    for (int i = 0; i < 50; i++)
+        pool.submit([&](size_t threadId) { counter++; }, latch);
+    pool.wait(latch);
+    ASSERT_EQ(counter, 100);
+}
+
+TEST(TaskPoolTest, NestedParallelFor)
+{
+    TaskPool pool(2);
+
+    std::atomic_int counter(0);
+    pool.parallelFor(0, 9,
+        [&](size_t outerThreadId, size_t i) {
+            pool.parallelFor(0, 9, [&](size_t threadId, size_t j) { counter++; }, 1);
+        },
+        1);
+
+    ASSERT_EQ(counter, 100);
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
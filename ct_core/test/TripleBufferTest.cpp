@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ct/core/core.h>
+
+
+using namespace ct::core;
+
+
+TEST(TripleBufferTest, SingleThreaded)
+{
+    TripleBuffer<int> buffer(-1);
+
+    ASSERT_FALSE(buffer.hasNewData());
+    ASSERT_FALSE(buffer.update());
+    ASSERT_EQ(buffer.front(), -1);
+
+    buffer.back() = 1;
+    buffer.publish();
+    ASSERT_TRUE(buffer.hasNewData());
+
+    // unconsumed data gets overwritten by the latest one
+    buffer.back() = 2;
+    buffer.publish();
+
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(buffer.front(), 2);
+    ASSERT_FALSE(buffer.hasNewData());
+
+    // without new data, the front buffer stays untouched
+    ASSERT_FALSE(buffer.update());
+    ASSERT_EQ(buffer.front(), 2);
+
+    buffer.back() = 3;
+    buffer.publish();
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(buffer.front(), 3);
+}
+
+
+TEST(TripleBufferTest, ProducerConsumer)
+{
+    // every published vector is filled with a single value, a torn read would show up as mixed values
+    const size_t size = 1000;
+    const int nPublish = 20000;
+
+    TripleBuffer<std::vector<int>> buffer(std::vector<int>(size, 0));
+
+    std::thread producer([&]() {
+        for (int i = 1; i <= nPublish; i++)
+        {
+            std::fill(buffer.back().begin(), buffer.back().end(), i);
+            buffer.publish();
+        }
+    });
+
+    int lastValue = 0;
+    while (lastValue < nPublish)
+    {
+        if (!buffer.update())
+            continue;
+
+        const std::vector<int>& data = buffer.front();
+        ASSERT_EQ(data.size(), size);
+        for (size_t j = 0; j < size; j++)
+            ASSERT_EQ(data[j], data[0]);
+
+        // the consumer may skip values, but never goes back in time
+        ASSERT_GT(data[0], lastValue);
+        lastValue = data[0];
+    }
+
+    producer.join();
+
+    ASSERT_EQ(lastValue, nPublish);
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ct::core;
+using std::shared_ptr;
+
+
+//! a nonlinear system which does not provide a batched implementation of its dynamics
+class VanDerPol : public System<2>
+{
+public:
+    VanDerPol(double mu) : mu_(mu) {}
+    VanDerPol* clone() const override { return new VanDerPol(*this); }
+    void computeDynamics(const StateVector<2>& state, const Time& t, StateVector<2>& derivative) override
+    {
+        derivative(0) = state(1);
+        derivative(1) = mu_ * (1.0 - state(0) * state(0)) * state(1) - state(0) + std::sin(t);
+    }
+
+private:
+    double mu_;
+};
+
+
+//! a state feedback, such that the control action differs for every state of a batch
+class Damping : public Controller<2, 1>
+{
+public:
+    Damping* clone() const override { return new Damping(*this); }
+    void computeControl(const StateVector<2>& state, const double& t, ControlVector<1>& controlAction) override
+    {
+        controlAction(0) = -2.0 * state(1);
+    }
+};
+
+
+/*!
+ * integrate every column of the batch with the standard integrator and compare with the batched integration
+ */
+template <size_t STATE_DIM>
+void compareWithIntegrator(const shared_ptr<System<STATE_DIM>>& system, const StateVectorBatch<STATE_DIM>& x0)
+{
+    const double dt = 0.001;
+    const size_t nSteps = 500;
+    const double startTime = 0.1;
+
+    for (IntegrationType intType : {EULERCT, RK4CT})
+    {
+        IntegratorBatch<STATE_DIM> integratorBatch(system, intType);
+        Integrator<STATE_DIM> integrator(system, intType);
+
+        StateVectorBatch<STATE_DIM> xBatch = x0;
+        integratorBatch.integrate_n_steps(xBatch, startTime, nSteps, dt);
+
+        typename IntegratorBatch<STATE_DIM>::StateBatchArray trajectory;
+        ct::core::TimeArray times;
+        StateVectorBatch<STATE_DIM> xBatchRecorded = x0;
+        integratorBatch.integrate_n_steps(xBatchRecorded, startTime, nSteps, dt, trajectory, times);
+
+        ASSERT_EQ(trajectory.size(), nSteps + 1);
+        ASSERT_EQ(times.size(), nSteps + 1);
+        ASSERT_NEAR(times.back(), startTime + nSteps * dt, 1e-10);
+        ASSERT_TRUE(trajectory.front().isApprox(x0));
+        ASSERT_TRUE(trajectory.back().isApprox(xBatch));
+        ASSERT_TRUE(xBatchRecorded.isApprox(xBatch));
+
+        for (int i = 0; i < x0.batchSize(); i++)
+        {
+            StateVector<STATE_DIM> x = x0.col(i);
+            integrator.integrate_n_steps(x, startTime, nSteps, dt);
+
+            ASSERT_LT((x - xBatch.col(i)).norm(), 1e-12);
+        }
+    }
+}
+
+
+TEST(IntegratorBatchTest, vectorizedSystem)
+{
+    shared_ptr<SecondOrderSystem> oscillator(new SecondOrderSystem(10.0, 0.1, 2.0));
+
+    ControlVector<1> u;
+    u << 0.3;
+    oscillator->setController(shared_ptr<ConstantController<2, 1>>(new ConstantController<2, 1>(u)));
+
+    StateVectorBatch<2> x0(9);
+    x0.setRandom();
+
+    compareWithIntegrator<2>(oscillator, x0);
+}
+
+
+TEST(IntegratorBatchTest, defaultBatchImplementation)
+{
+    shared_ptr<VanDerPol> vanDerPol(new VanDerPol(0.5));
+
+    StateVectorBatch<2> x0(5);
+    x0.setRandom();
+
+    compareWithIntegrator<2>(vanDerPol, x0);
+}
+
+
+TEST(IntegratorBatchTest, concurrentBatchEvaluation)
+{
+    shared_ptr<SecondOrderSystem> oscillator(new SecondOrderSystem(10.0, 0.1, 2.0));
+    oscillator->setController(shared_ptr<Damping>(new Damping()));
+
+    const size_t nThreads = 4;
+    std::vector<StateVectorBatch<2>> states(nThreads), derivatives(nThreads), expected(nThreads);
+    for (size_t i = 0; i < nThreads; i++)
+    {
+        states[i] = StateVectorBatch<2>::Random(2, 16 * (i + 1));
+        oscillator->computeDynamicsBatch(states[i], 0.0, expected[i]);
+    }
+
+    // the batch evaluation uses buffers of the system, hence every thread evaluates its own clone
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; i++)
+        threads.push_back(std::thread([&, i]() {
+            shared_ptr<SecondOrderSystem> clone(oscillator->clone());
+            for (size_t k = 0; k < 10000; k++)
+            {
+                clone->computeDynamicsBatch(states[i], 0.0, derivatives[i]);
+                if (derivatives[i] != expected[i])
+                    return;
+            }
+        }));
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < nThreads; i++)
+        ASSERT_EQ(derivatives[i], expected[i]);
+}
+
+
+TEST(IntegratorBatchTest, unsupportedIntegrationType)
+{
+    shared_ptr<VanDerPol> vanDerPol(new VanDerPol(0.5));
+
+    ASSERT_ANY_THROW(IntegratorBatch<2> integrator(vanDerPol, ODE45));
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/core.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+typedef Eigen::Vector2d state_t;
+typedef internal::StepperDormandPrinceCT<state_t, double> Stepper_t;
+
+//! harmonic oscillator x'' = -x, its solution for x(0) = (1, 0) is (cos t, -sin t)
+void oscillator(const state_t& x, state_t& dxdt, double t)
+{
+    dxdt(0) = x(1);
+    dxdt(1) = -x(0);
+}
+
+//! explicitly time dependent ODE, its solution for x(0) = 0 is (sin t, t^2)
+void timeDependent(const state_t& x, state_t& dxdt, double t)
+{
+    dxdt(0) = std::cos(t);
+    dxdt(1) = 2.0 * t;
+}
+
+double integrationError(const std::function<void(const state_t&, state_t&, double)>& rhs,
+    const state_t& x0,
+    const state_t& solution,
+    double T,
+    size_t numSteps)
+{
+    Stepper_t stepper;
+    state_t x = x0;
+    stepper.integrate_n_steps(rhs, x, 0.0, numSteps, T / numSteps);
+    return (x - solution).norm();
+}
+
+TEST(StepperDormandPrinceCTTest, convergenceOrder)
+{
+    const double T = 2.0;
+    state_t x0(1.0, 0.0);
+    state_t solution(std::cos(T), -std::sin(T));
+
+    // the global error of a 5th order scheme decreases by 2^5 when halving the step
+    for (size_t numSteps : {10, 20, 40})
+    {
+        const double order = std::log2(integrationError(oscillator, x0, solution, T, numSteps) /
+                                       integrationError(oscillator, x0, solution, T, 2 * numSteps));
+        ASSERT_GT(order, 4.7);
+        ASSERT_LT(order, 5.5);
+    }
+}
+
+TEST(StepperDormandPrinceCTTest, accuracy)
+{
+    const double T = 2.0;
+    ASSERT_LT(integrationError(oscillator, state_t(1.0, 0.0), state_t(std::cos(T), -std::sin(T)), T, 200), 1e-10);
+    ASSERT_LT(integrationError(timeDependent, state_t::Zero(), state_t(std::sin(T), T * T), T, 50), 1e-10);
+}
+
+TEST(StepperDormandPrinceCTTest, embeddedStepsMatchSteps)
+{
+    const size_t numSteps = 25;
+    const double dt = 0.08;
+
+    state_t xSteps(0.3, -0.7);
+    state_t xEmbedded = xSteps;
+
+    Stepper_t stepper;
+    stepper.integrate_n_steps(oscillator, xSteps, 0.5, numSteps, dt);
+
+    // the first stage of an embedded step is the last stage of the step before
+    Stepper_t stepperEmbedded;
+    state_t xNew, error;
+    double time = 0.5;
+    stepperEmbedded.init_embedded(oscillator, xEmbedded, time);
+    for (size_t i = 0; i < numSteps; i++)
+    {
+        stepperEmbedded.do_step_embedded(oscillator, xEmbedded, xNew, error, time, dt);
+        stepperEmbedded.accept_step();
+        xEmbedded = xNew;
+        time += dt;
+    }
+
+    ASSERT_LT((xEmbedded - xSteps).norm(), 1e-14);
+}
+
+TEST(StepperDormandPrinceCTTest, errorEstimate)
+{
+    const state_t x0(1.0, 0.0);
+    state_t x, error;
+
+    // the error estimate is the local error of the embedded 4th order solution, hence it scales with dt^5
+    std::vector<double> errorNorms;
+    for (double dt : {0.2, 0.1, 0.05})
+    {
+        Stepper_t stepper;
+        stepper.init_embedded(oscillator, x0, 0.0);
+        stepper.do_step_embedded(oscillator, x0, x, error, 0.0, dt);
+
+        // the estimate bounds the actual error of the 5th order solution
+        ASSERT_LT((x - state_t(std::cos(dt), -std::sin(dt))).norm(), error.norm());
+        errorNorms.push_back(error.norm());
+    }
+
+    for (size_t i = 0; i + 1 < errorNorms.size(); i++)
+    {
+        const double order = std::log2(errorNorms[i] / errorNorms[i + 1]);
+        ASSERT_GT(order, 4.5);
+        ASSERT_LT(order, 5.5);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
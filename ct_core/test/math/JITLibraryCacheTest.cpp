@@ -0,0 +1,224 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <fstream>
+
+#include <unistd.h>
+
+#include <ct/core/core.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+
+//! a fresh cache directory for every test
+std::string testDirectory(const std::string& name)
+{
+    return "/tmp/ct_jit_cache_test_" + std::to_string(::getpid()) + "_" + name;
+}
+
+//! write a dummy "library" of the given size
+void writeFile(const std::string& path, size_t size)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << std::string(size, 'x');
+}
+
+bool exists(const std::string& path)
+{
+    return ::access(path.c_str(), F_OK) == 0;
+}
+
+
+TEST(JITLibraryCacheTest, Hashing)
+{
+    ASSERT_EQ(JITLibraryCache::hash("abc"), JITLibraryCache::hash("abc"));
+    ASSERT_NE(JITLibraryCache::hash("abc"), JITLibraryCache::hash("abd"));
+
+    // incremental hashing depends on the order of the data
+    ASSERT_NE(JITLibraryCache::hash("b", JITLibraryCache::hash("a")),
+        JITLibraryCache::hash("a", JITLibraryCache::hash("b")));
+
+    ASSERT_EQ(JITLibraryCache::toString(0x1f).size(), 16u);
+
+    JITLibraryCache cache(testDirectory("hashing"), 1000);
+    const std::string sources = cache.getDirectory() + "/tmp/sources";
+    ASSERT_EQ(::mkdir(sources.c_str(), 0755), 0);
+
+    writeFile(sources + "/a.c", 10);
+    writeFile(sources + "/b.c", 20);
+    const uint64_t key = JITLibraryCache::hashDirectory(sources);
+
+    writeFile(sources + "/b.c", 21);
+    ASSERT_NE(JITLibraryCache::hashDirectory(sources), key);
+
+    JITLibraryCache::removeDirectory(sources);
+    ASSERT_FALSE(exists(sources));
+
+    JITLibraryCache::removeDirectory(cache.getDirectory() + "/tmp");
+    JITLibraryCache::removeDirectory(cache.getDirectory());
+}
+
+
+TEST(JITLibraryCacheTest, HitsAndMisses)
+{
+    JITLibraryCache::resetStatistics();
+
+    JITLibraryCache cache(testDirectory("hits"), 1000);
+    const uint64_t key = JITLibraryCache::hash("model");
+
+    ASSERT_FALSE(cache.lookup("model", key));
+    ASSERT_EQ(JITLibraryCache::getStatistics().misses, 1u);
+    ASSERT_EQ(JITLibraryCache::getStatistics().hits, 0u);
+
+    // "compile" the library and move it into the cache
+    const std::string temp = cache.temporaryPath("model", key, "1") + ".so";
+    writeFile(temp, 100);
+    const std::string path = cache.insert(temp, "model", key);
+
+    ASSERT_EQ(path, cache.libraryPath("model", key));
+    ASSERT_TRUE(exists(path + ".so"));
+    ASSERT_FALSE(exists(temp));
+
+    // a second cache instance on the same directory, e.g. in another process, finds the library
+    JITLibraryCache otherCache(cache.getDirectory(), 1000);
+    ASSERT_TRUE(otherCache.lookup("model", key));
+    ASSERT_FALSE(otherCache.lookup("model", key + 1));
+
+    ASSERT_EQ(JITLibraryCache::getStatistics().hits, 1u);
+    ASSERT_EQ(JITLibraryCache::getStatistics().misses, 2u);
+    ASSERT_EQ(JITLibraryCache::getStatistics().evictions, 0u);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0u);
+    ASSERT_FALSE(cache.lookup("model", key));
+
+    JITLibraryCache::removeDirectory(cache.getDirectory() + "/tmp");
+    JITLibraryCache::removeDirectory(cache.getDirectory());
+}
+
+
+TEST(JITLibraryCacheTest, Eviction)
+{
+    JITLibraryCache::resetStatistics();
+
+    const size_t librarySize = 100;
+    JITLibraryCache cache(testDirectory("eviction"), 3 * librarySize);
+
+    // fill the cache to its limit, the libraries are used in the order 1, 0, 2
+    for (uint64_t key = 0; key < 3; key++)
+    {
+        const std::string temp = cache.temporaryPath("lib", key, "1");
+        writeFile(temp, librarySize);
+        cache.insert(temp, "lib", key);
+    }
+    ASSERT_EQ(cache.size(), 3 * librarySize);
+
+    const std::string dir = cache.getDirectory();
+    struct utimbuf times;
+    for (uint64_t key : {1, 0, 2})
+    {
+        times.actime = times.modtime = 1000 + 10 * key + (key == 1 ? -100 : 0);
+        ASSERT_EQ(::utime((cache.libraryPath("lib", key) + ".so").c_str(), &times), 0);
+    }
+
+    // a fourth library exceeds the limit, the least recently used one gets evicted
+    const std::string temp = cache.temporaryPath("lib", 3, "1");
+    writeFile(temp, librarySize);
+    cache.insert(temp, "lib", 3);
+
+    ASSERT_EQ(JITLibraryCache::getStatistics().evictions, 1u);
+    ASSERT_EQ(cache.size(), 3 * librarySize);
+    ASSERT_FALSE(exists(cache.libraryPath("lib", 1) + ".so"));
+    ASSERT_TRUE(exists(cache.libraryPath("lib", 0) + ".so"));
+    ASSERT_TRUE(exists(cache.libraryPath("lib", 2) + ".so"));
+    ASSERT_TRUE(exists(cache.libraryPath("lib", 3) + ".so"));
+
+    // a library larger than the whole cache evicts everything but itself
+    const std::string tempLarge = cache.temporaryPath("lib", 4, "1");
+    writeFile(tempLarge, 4 * librarySize);
+    cache.insert(tempLarge, "lib", 4);
+
+    ASSERT_EQ(JITLibraryCache::getStatistics().evictions, 4u);
+    ASSERT_TRUE(exists(cache.libraryPath("lib", 4) + ".so"));
+    ASSERT_EQ(cache.size(), 4 * librarySize);
+
+    cache.clear();
+    JITLibraryCache::removeDirectory(dir + "/tmp");
+    JITLibraryCache::removeDirectory(dir);
+}
+
+
+TEST(JITLibraryCacheTest, ObjectEviction)
+{
+    JITLibraryCache::resetStatistics();
+
+    const size_t fileSize = 100;
+    JITLibraryCache cache(testDirectory("objects"), 3 * fileSize);
+
+    const std::string dir = cache.getDirectory();
+    const std::string objects = cache.objectsDirectory();
+    ASSERT_EQ(::mkdir(objects.c_str(), 0755), 0);
+
+    // two object files of an incremental build count towards the size of the cache
+    struct utimbuf times;
+    for (int i : {0, 1})
+    {
+        const std::string object = objects + "/" + std::to_string(i) + ".o";
+        writeFile(object, fileSize);
+        times.actime = times.modtime = 1000 + 10 * i;
+        ASSERT_EQ(::utime(object.c_str(), &times), 0);
+    }
+    ASSERT_EQ(cache.size(), 2 * fileSize);
+
+    // a library that is used more recently than object 0, but less recently than object 1
+    const std::string temp = cache.temporaryPath("lib", 0, "1");
+    writeFile(temp, fileSize);
+    cache.insert(temp, "lib", 0);
+    times.actime = times.modtime = 1005;
+    ASSERT_EQ(::utime((cache.libraryPath("lib", 0) + ".so").c_str(), &times), 0);
+    ASSERT_EQ(cache.size(), 3 * fileSize);
+    ASSERT_EQ(JITLibraryCache::getStatistics().evictions, 0u);
+
+    // another library exceeds the limit, the least recently used file is the object 0
+    const std::string temp1 = cache.temporaryPath("lib", 1, "1");
+    writeFile(temp1, fileSize);
+    cache.insert(temp1, "lib", 1);
+
+    ASSERT_EQ(JITLibraryCache::getStatistics().evictions, 1u);
+    ASSERT_EQ(cache.size(), 3 * fileSize);
+    ASSERT_FALSE(exists(objects + "/0.o"));
+    ASSERT_TRUE(exists(objects + "/1.o"));
+    ASSERT_TRUE(exists(cache.libraryPath("lib", 0) + ".so"));
+
+    // recently used object files may be linked by a concurrent build, they are not evicted
+    const std::string recent = objects + "/2.o";
+    writeFile(recent, fileSize);
+    const std::string temp2 = cache.temporaryPath("lib", 2, "1");
+    writeFile(temp2, fileSize);
+    cache.insert(temp2, "lib", 2);
+
+    ASSERT_TRUE(exists(recent));
+    ASSERT_FALSE(exists(objects + "/1.o"));
+    ASSERT_FALSE(exists(cache.libraryPath("lib", 0) + ".so"));
+    ASSERT_TRUE(exists(cache.libraryPath("lib", 2) + ".so"));
+    ASSERT_EQ(cache.size(), 3 * fileSize);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0u);
+    ASSERT_FALSE(exists(recent));
+
+    JITLibraryCache::removeDirectory(objects);
+    JITLibraryCache::removeDirectory(dir + "/tmp");
+    JITLibraryCache::removeDirectory(dir);
+    ASSERT_FALSE(exists(dir));
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
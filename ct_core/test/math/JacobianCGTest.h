@@ -184,10 +184,10 @@ void executeJITCloneTest(bool useDynamicLib)
 
     std::shared_ptr<derivativesCppadJIT> jacCG_cloned(jacCG->clone());
 
-    // make sure the underlying dynamic libraries are not identical
-    if (useDynamicLib && (jacCG_cloned->getDynamicLib() == jacCG->getDynamicLib()))
+    // make sure the clone shares the loaded dynamic library instead of loading it again
+    if (useDynamicLib && (jacCG_cloned->getDynamicLib() != jacCG->getDynamicLib()))
     {
-        std::cout << "FATAL ERROR: dynamic library not cloned correctly in JIT." << std::endl;
+        std::cout << "FATAL ERROR: dynamic library not shared correctly in JIT." << std::endl;
         ASSERT_TRUE(false);
     }
 #ifdef LLVM
@@ -209,6 +209,138 @@ void executeJITCloneTest(bool useDynamicLib)
     }
 }
 
+void executeConcurrentCloneTest()
+{
+    typename derivativesCppadJIT::FUN_TYPE_CG f = testFunction<derivativesCppadJIT::CG_SCALAR>;
+
+    std::shared_ptr<derivativesCppadJIT> jacCG(new derivativesCppadJIT(f));
+
+    DerivativesCppadSettings settings;
+    settings.createJacobian_ = true;
+    jacCG->compileJIT(settings, "jacobianCGLib", verbose);
+
+    // clones get created, evaluated and destroyed concurrently, they keep the library alive after the original is gone
+    const size_t nThreads = 4;
+    std::vector<std::shared_ptr<derivativesCppadJIT>> clones(nThreads);
+    for (size_t i = 0; i < nThreads; i++)
+        clones[i] = std::shared_ptr<derivativesCppadJIT>(jacCG->clone());
+
+    const std::shared_ptr<CppAD::cg::DynamicLib<double>> dynamicLib = jacCG->getDynamicLib();
+    jacCG.reset();
+
+    std::atomic_size_t nErrors(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; i++)
+    {
+        threads.emplace_back([&, i]() {
+            Eigen::Matrix<double, inDim, 1> x;
+            for (size_t j = 0; j < 100; j++)
+            {
+                std::shared_ptr<derivativesCppadJIT> clone(clones[i]->clone());
+                x.setLinSpaced(0.1 * j, 0.01 * i);
+                if ((clone->jacobian(x) - jacobianCheck(x)).array().abs().maxCoeff() > 1e-10)
+                    nErrors++;
+                if (clone->getDynamicLib() != dynamicLib)
+                    nErrors++;
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(nErrors, 0u);
+}
+
+void executeJITCacheTest()
+{
+    typename derivativesCppadJIT::FUN_TYPE_CG f = testFunction<derivativesCppadJIT::CG_SCALAR>;
+
+    DerivativesCppadSettings settings;
+    settings.createJacobian_ = true;
+    settings.useCache_ = true;
+    settings.cacheDirectory_ = "/tmp/ct_jit_cache_test_" + std::to_string(::getpid());
+
+    JITLibraryCache cache(settings.cacheDirectory_, settings.cacheMaxSizeMB_ * 1024 * 1024);
+    cache.clear();
+    JITLibraryCache::resetStatistics();
+
+    // the first compilation misses the cache, the second one loads the library built by the first one
+    derivativesCppadJIT jacCG(f);
+    jacCG.compileJIT(settings, "jacobianCGCacheLib", verbose);
+    ASSERT_EQ(JITLibraryCache::getStatistics().misses, 1u);
+    ASSERT_EQ(JITLibraryCache::getStatistics().hits, 0u);
+
+    derivativesCppadJIT jacCGCached(f);
+    jacCGCached.compileJIT(settings, "jacobianCGCacheLib", verbose);
+    ASSERT_EQ(JITLibraryCache::getStatistics().misses, 1u);
+    ASSERT_EQ(JITLibraryCache::getStatistics().hits, 1u);
+
+    // the key only depends on the recorded function and the settings, hence it is known before generating code
+    ASSERT_EQ(jacCG.hashModel(settings, "model"), jacCGCached.hashModel(settings, "model"));
+    ASSERT_NE(jacCG.hashModel(settings, "model"), jacCG.hashModel(settings, "otherModel"));
+
+    // temporary files of concurrent processes sharing the cache do not clash
+    ASSERT_EQ(JITCompilationService::createUniqueID().find(std::to_string(::getpid()) + "_"), 0u);
+
+    // different settings lead to a different library
+    settings.createForwardZero_ = true;
+    derivativesCppadJIT jacCGOtherSettings(f);
+    jacCGOtherSettings.compileJIT(settings, "jacobianCGCacheLib", verbose);
+    ASSERT_EQ(JITLibraryCache::getStatistics().misses, 2u);
+
+    std::shared_ptr<derivativesCppadJIT> jacCGCloned(jacCGCached.clone());
+
+    Eigen::Matrix<double, inDim, 1> x;
+    for (size_t i = 0; i < 100; i++)
+    {
+        x.setRandom();
+        ASSERT_LT((jacCGCached.jacobian(x) - jacobianCheck(x)).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((jacCGCloned->jacobian(x) - jacobianCheck(x)).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((jacCGOtherSettings.jacobian(x) - jacobianCheck(x)).array().abs().maxCoeff(), 1e-10);
+    }
+
+    cache.clear();
+}
+
+void executeJITCompilationServiceTest(size_t compileThreads)
+{
+    typename derivativesCppadJIT::FUN_TYPE_CG f = testFunction<derivativesCppadJIT::CG_SCALAR>;
+
+    DerivativesCppadSettings settings;
+    settings.compileThreads_ = compileThreads;
+
+    DerivativesCppadSettings jacobianSettings;
+    jacobianSettings.createJacobian_ = true;
+
+    DerivativesCppadSettings forwardZeroSettings;
+    forwardZeroSettings.createForwardZero_ = true;
+
+    // both models end up in the same library
+    derivativesCppadJIT jacCG(f);
+    derivativesCppadJIT forwardZeroCG(f);
+
+    JITCompilationService service(settings, "serviceTestLib");
+    service.add(jacCG, jacobianSettings, "jacobianModel");
+    service.add(forwardZeroCG, forwardZeroSettings, "forwardZeroModel");
+    ASSERT_EQ(service.size(), 2u);
+
+    service.compile(verbose);
+    ASSERT_EQ(service.size(), 0u);
+    ASSERT_TRUE(jacCG.isCompiled());
+    ASSERT_TRUE(forwardZeroCG.isCompiled());
+
+    std::shared_ptr<derivativesCppadJIT> jacCGCloned(jacCG.clone());
+
+    Eigen::Matrix<double, inDim, 1> x;
+    for (size_t i = 0; i < 100; i++)
+    {
+        x.setRandom();
+        ASSERT_LT((jacCG.jacobian(x) - jacobianCheck(x)).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((jacCGCloned->jacobian(x) - jacobianCheck(x)).array().abs().maxCoeff(), 1e-10);
+        ASSERT_LT((forwardZeroCG.forwardZero(x) - testFunction<double>(x)).array().abs().maxCoeff(), 1e-10);
+    }
+}
+
 /*!
  * Test evaluation of the forward-zero function, which should be possible to evaluate in both uncompiled and compiled state
  */
@@ -262,6 +394,37 @@ TEST(HessianCGTest, JITHessianTest)
     }
 }
 
+/*!
+ * Test compiling several models into one library, serially and in parallel
+ */
+TEST(JacobianCGTest, JITCompilationServiceTest)
+{
+    try
+    {
+        executeJITCompilationServiceTest(1);
+        executeJITCompilationServiceTest(0);
+    } catch (std::exception& e)
+    {
+        std::cout << "Exception thrown: " << e.what() << std::endl;
+        ASSERT_TRUE(false);
+    }
+}
+
+/*!
+ * Test loading JIT compiled libraries from the persistent cache
+ */
+TEST(JacobianCGTest, JITCacheTest)
+{
+    try
+    {
+        executeJITCacheTest();
+    } catch (std::exception& e)
+    {
+        std::cout << "Exception thrown: " << e.what() << std::endl;
+        ASSERT_TRUE(false);
+    }
+}
+
 /*!
  * Test cloning of JIT compiled libraries
  */
@@ -296,6 +459,21 @@ TEST(JacobianCGTest, JitCloneTest)
 // /*!
 //  * Test for writing the codegenerated Jacobian to file
 //  */
+/*!
+ * Test that clones share the dynamic library and can be created and evaluated concurrently
+ */
+TEST(JacobianCGTest, ConcurrentCloneTest)
+{
+    try
+    {
+        executeConcurrentCloneTest();
+    } catch (std::exception& e)
+    {
+        std::cout << "Exception thrown: " << e.what() << std::endl;
+        ASSERT_TRUE(false);
+    }
+}
+
 TEST(JacobianCGTest, CodegenTest)
 {
     // create a function handle (also works for class methods, lambdas, function pointers, ...)
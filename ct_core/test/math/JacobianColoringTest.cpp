@@ -0,0 +1,119 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/core/internal/autodiff/JacobianColoring.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+typedef internal::JacobianColoring::SparsityMatrix SparsityMatrix;
+
+//! a random matrix with the given sparsity pattern
+Eigen::MatrixXd randomJacobian(const SparsityMatrix& sparsity)
+{
+    Eigen::MatrixXd J = Eigen::MatrixXd::Random(sparsity.rows(), sparsity.cols());
+    for (int i = 0; i < sparsity.rows(); i++)
+        for (int j = 0; j < sparsity.cols(); j++)
+            if (!sparsity(i, j))
+                J(i, j) = 0.0;
+    return J;
+}
+
+//! evaluates J by compressed products and checks the result
+void checkRecovery(const internal::JacobianColoring& coloring, const Eigen::MatrixXd& J)
+{
+    Eigen::VectorXd seed;
+    Eigen::VectorXd product;
+    Eigen::VectorXd values;
+
+    for (size_t c = 0; c < coloring.numColors(); c++)
+    {
+        coloring.seed(c, seed);
+        if (coloring.isForward())
+            product = J * seed;
+        else
+            product = J.transpose() * seed;
+        coloring.recover(c, product, values);
+    }
+
+    ASSERT_EQ(values.size(), static_cast<int>(coloring.nonZeros()));
+
+    Eigen::MatrixXd recovered = Eigen::MatrixXd::Zero(J.rows(), J.cols());
+    coloring.scatter(values, recovered);
+    ASSERT_TRUE(recovered.isApprox(J, 1e-12));
+}
+
+TEST(JacobianColoringTest, DiagonalTest)
+{
+    const size_t n = 10;
+    SparsityMatrix sparsity = SparsityMatrix::Constant(n, n, false);
+    sparsity.diagonal().setConstant(true);
+
+    internal::JacobianColoring coloring;
+    coloring.initPattern(sparsity);
+
+    ASSERT_TRUE(coloring.isForward());
+    ASSERT_EQ(coloring.numColors(), 1u);
+    ASSERT_EQ(coloring.nonZeros(), n);
+
+    checkRecovery(coloring, randomJacobian(sparsity));
+}
+
+TEST(JacobianColoringTest, BandedTest)
+{
+    const size_t n = 12;
+    SparsityMatrix sparsity = SparsityMatrix::Constant(n, n, false);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = (i > 0 ? i - 1 : 0); j < std::min(n, i + 2); j++)
+            sparsity(i, j) = true;
+
+    internal::JacobianColoring coloring;
+    coloring.initPattern(sparsity);
+
+    ASSERT_EQ(coloring.numColors(), 3u);
+
+    checkRecovery(coloring, randomJacobian(sparsity));
+}
+
+TEST(JacobianColoringTest, DenseRowTest)
+{
+    // a dense row couples all columns, but the rows remain separable
+    const size_t n = 8;
+    SparsityMatrix sparsity = SparsityMatrix::Constant(n + 1, n, false);
+    sparsity.topRows(n).diagonal().setConstant(true);
+    sparsity.row(n).setConstant(true);
+
+    internal::JacobianColoring coloring;
+    coloring.initPattern(sparsity);
+
+    ASSERT_FALSE(coloring.isForward());
+    ASSERT_EQ(coloring.numColors(), 2u);
+
+    checkRecovery(coloring, randomJacobian(sparsity));
+}
+
+TEST(JacobianColoringTest, RandomPatternTest)
+{
+    for (size_t trial = 0; trial < 20; trial++)
+    {
+        const size_t rows = 1 + std::rand() % 15;
+        const size_t cols = 1 + std::rand() % 15;
+
+        SparsityMatrix sparsity = (Eigen::MatrixXd::Random(rows, cols).array() > 0.5).matrix();
+
+        internal::JacobianColoring coloring;
+        coloring.initPattern(sparsity);
+
+        ASSERT_LE(coloring.numColors(), std::min(rows, cols));
+
+        checkRecovery(coloring, randomJacobian(sparsity));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <fstream>
+
+#include <unistd.h>
+
+#include <ct/core/core.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+
+
+const std::string testDirectory = "/tmp/ct_parallel_compiler_test_" + std::to_string(::getpid());
+
+void writeSource(const std::string& file, const std::string& function, int value)
+{
+    std::ofstream stream(testDirectory + "/sources/" + file);
+    stream << "int " << function << "(void) { return " << value << "; }" << std::endl;
+}
+
+bool exists(const std::string& path)
+{
+    return ::access(path.c_str(), F_OK) == 0;
+}
+
+
+TEST(ParallelCCompilerTest, IncrementalCompilation)
+{
+    ASSERT_EQ(::mkdir(testDirectory.c_str(), 0755), 0);
+    ASSERT_EQ(::mkdir((testDirectory + "/sources").c_str(), 0755), 0);
+
+    const size_t nSources = 6;
+    for (size_t i = 0; i < nSources; i++)
+        writeSource("function" + std::to_string(i) + ".c", "function" + std::to_string(i), i);
+
+    const std::string objects = testDirectory + "/objects";
+    const std::string library = testDirectory + "/library.so";
+
+    ParallelCCompiler compiler("gcc", 3);
+    ASSERT_EQ(compiler.getNumThreads(), 3u);
+
+    // a fresh build compiles all translation units
+    compiler.compileLibrary(testDirectory + "/sources", objects, library);
+    ASSERT_TRUE(exists(library));
+    ASSERT_EQ(compiler.getNumCompiled(), nSources);
+    ASSERT_EQ(compiler.getNumReused(), 0u);
+
+    // only the changed translation unit gets recompiled
+    std::remove(library.c_str());
+    writeSource("function2.c", "function2", 42);
+
+    compiler.compileLibrary(testDirectory + "/sources", objects, library);
+    ASSERT_TRUE(exists(library));
+    ASSERT_EQ(compiler.getNumCompiled(), 1u);
+    ASSERT_EQ(compiler.getNumReused(), nSources - 1);
+
+    // different flags lead to different objects
+    ParallelCCompiler debugCompiler("gcc", 0, {"-O0"});
+    debugCompiler.compileLibrary(testDirectory + "/sources", objects, library);
+    ASSERT_EQ(debugCompiler.getNumCompiled(), nSources);
+
+    // compilation errors are reported
+    writeSource("function3.c", "function 3", 0);
+    ASSERT_THROW(compiler.compileLibrary(testDirectory + "/sources", objects, library), std::runtime_error);
+
+    JITLibraryCache::removeDirectory(objects);
+    JITLibraryCache::removeDirectory(testDirectory + "/sources");
+    std::remove(library.c_str());
+    ::rmdir(testDirectory.c_str());
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
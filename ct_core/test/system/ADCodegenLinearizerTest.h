@@ -112,10 +112,10 @@ TEST(ADCodegenLinearizerTest, JITCloneTest)
     std::cout << "cloning without compilation..." << std::endl;
     std::shared_ptr<ADCodegenLinearizer<state_dim, control_dim>> adLinearizerClone(adLinearizer.clone());
 
-    // make sure the underlying dynamic libraries are not identical (dynamic library cloned correctly)
-    if (adLinearizerClone->getLinearizer().getDynamicLib() == adLinearizer.getLinearizer().getDynamicLib())
+    // make sure the clone shares the loaded dynamic library instead of loading it again
+    if (adLinearizerClone->getLinearizer().getDynamicLib() != adLinearizer.getLinearizer().getDynamicLib())
     {
-        std::cout << "FATAL ERROR: dynamic library not cloned correctly in JIT." << std::endl;
+        std::cout << "FATAL ERROR: dynamic library not shared correctly in JIT." << std::endl;
         ASSERT_TRUE(false);
     }
 
@@ -42,10 +42,10 @@ TEST(DiscreteSystemLinearizerADCG, JITCompilationTest)
 
     std::shared_ptr<DiscreteSystemLinearizerADCG<state_dim, control_dim>> adLinearizerClone(adLinearizer.clone());
 
-    // make sure the underlying dynamic libraries are not identical (dynamic library cloned correctly)
-    if (adLinearizerClone->getLinearizer().getDynamicLib() == adLinearizer.getLinearizer().getDynamicLib())
+    // make sure the clone shares the loaded dynamic library instead of loading it again
+    if (adLinearizerClone->getLinearizer().getDynamicLib() != adLinearizer.getLinearizer().getDynamicLib())
     {
-        std::cout << "FATAL ERROR: dynamic library not cloned correctly in JIT." << std::endl;
+        std::cout << "FATAL ERROR: dynamic library not shared correctly in JIT." << std::endl;
         ASSERT_TRUE(false);
     }
 
@@ -31,6 +31,14 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #define CT_L4 fr_Wrist_R
 #define CT_L5 fr_Wrist_FE
 
+// define the names of the links in RobCoGen, e.g. for the analytical dynamics derivatives
+#define CT_L0_NAME Shoulder_AA
+#define CT_L1_NAME Shoulder_FE
+#define CT_L2_NAME Humerus_R
+#define CT_L3_NAME Elbow_FE
+#define CT_L4_NAME Wrist_R
+#define CT_L5_NAME Wrist_FE
+
 // define single end effector (could also be multiple)
 #define CT_N_EE 1
 #define CT_EE0 fr_ee
@@ -26,6 +26,9 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #define CT_BASE fr_InvertedPendulumBase
 #define CT_L0 fr_Link1
 
+// define the names of the links in RobCoGen, e.g. for the analytical dynamics derivatives
+#define CT_L0_NAME Link1
+
 // define single end effector (could also be multiple)
 #define CT_N_EE 1
 #define CT_EE0 fr_ee
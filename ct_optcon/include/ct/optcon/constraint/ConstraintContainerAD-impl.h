@@ -47,11 +47,13 @@ ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintContainerAD(con
       fIntermediate_(arg.fIntermediate_),
       fTerminal_(arg.fTerminal_),
       sparsityIntermediateRows_(arg.sparsityIntermediateRows_),
+      sparsityIntermediateCols_(arg.sparsityIntermediateCols_),
       sparsityStateIntermediateRows_(arg.sparsityStateIntermediateRows_),
       sparsityStateIntermediateCols_(arg.sparsityStateIntermediateCols_),
       sparsityInputIntermediateRows_(arg.sparsityInputIntermediateRows_),
       sparsityInputIntermediateCols_(arg.sparsityInputIntermediateCols_),
       sparsityTerminalRows_(arg.sparsityTerminalRows_),
+      sparsityTerminalCols_(arg.sparsityTerminalCols_),
       sparsityStateTerminalRows_(arg.sparsityStateTerminalRows_),
       sparsityStateTerminalCols_(arg.sparsityStateTerminalCols_),
       sparsityInputTerminalRows_(arg.sparsityInputTerminalRows_),
@@ -187,50 +189,81 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
 ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianStateSparseIntermediate()
 {
-    if (!this->initializedIntermediate_)
-        throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
+    VectorXs jacState;
+    VectorXs jacInput;
+    jacobiansSparseIntermediate(jacState, jacInput);
+    return jacState;
+}
 
-    MatrixXs jacTot = intermediateCodegen_->jacobian(stateControlD_);
 
-    // std::cout << "jacTot" << std::endl;
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::MatrixXs
+ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianStateIntermediate()
+{
+    MatrixXs jacState;
+    MatrixXs jacInput;
+    jacobiansIntermediate(jacState, jacInput);
+    return jacState;
+}
 
-    VectorXs jacSparse;
-    jacSparse.resize(getJacobianStateNonZeroCountIntermediate());
-    for (size_t i = 0; i < getJacobianStateNonZeroCountIntermediate(); ++i)
-        jacSparse(i) = (jacTot.template leftCols<STATE_DIM>())(
-            sparsityStateIntermediateRows_(i), sparsityStateIntermediateCols_(i));
 
-    return jacSparse;
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
+ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputSparseIntermediate()
+{
+    VectorXs jacState;
+    VectorXs jacInput;
+    jacobiansSparseIntermediate(jacState, jacInput);
+    return jacInput;
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::MatrixXs
-ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianStateIntermediate()
+ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputIntermediate()
+{
+    MatrixXs jacState;
+    MatrixXs jacInput;
+    jacobiansIntermediate(jacState, jacInput);
+    return jacInput;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansSparseIntermediate(VectorXs& jacState,
+    VectorXs& jacInput)
 {
     if (!this->initializedIntermediate_)
         throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
 
-    MatrixXs jacTot = intermediateCodegen_->jacobian(stateControlD_);
-    return jacTot.template leftCols<STATE_DIM>();
+    evaluateSparseJacobian(*intermediateCodegen_, sparsityIntermediateCols_, jacState, jacInput);
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
-ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianStateSparseTerminal()
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansIntermediate(MatrixXs& jacState,
+    MatrixXs& jacInput)
 {
-    if (!this->initializedTerminal_)
-        throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
+    VectorXs jacStateSparse;
+    VectorXs jacInputSparse;
+    jacobiansSparseIntermediate(jacStateSparse, jacInputSparse);
 
-    MatrixXs jacTot = terminalCodegen_->jacobian(stateControlD_);
-    VectorXs jacSparse;
-    jacSparse.resize(getJacobianStateNonZeroCountTerminal());
-    for (size_t i = 0; i < getJacobianStateNonZeroCountTerminal(); ++i)
-        jacSparse(i) =
-            (jacTot.template leftCols<STATE_DIM>())(sparsityStateTerminalRows_(i), sparsityStateTerminalCols_(i));
+    const size_t nConstraints = getIntermediateConstraintsCount();
+    sparseToDense(jacStateSparse, sparsityStateIntermediateRows_, sparsityStateIntermediateCols_, nConstraints,
+        STATE_DIM, jacState);
+    sparseToDense(jacInputSparse, sparsityInputIntermediateRows_, sparsityInputIntermediateCols_, nConstraints,
+        CONTROL_DIM, jacInput);
+}
 
-    return jacSparse;
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
+ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianStateSparseTerminal()
+{
+    VectorXs jacState;
+    VectorXs jacInput;
+    jacobiansSparseTerminal(jacState, jacInput);
+    return jacState;
 }
 
 
@@ -238,68 +271,98 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::MatrixXs
 ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianStateTerminal()
 {
-    if (!this->initializedTerminal_)
-        throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
-
-    MatrixXs jacTot = terminalCodegen_->jacobian(stateControlD_);
-    return jacTot.template leftCols<STATE_DIM>();
+    MatrixXs jacState;
+    MatrixXs jacInput;
+    jacobiansTerminal(jacState, jacInput);
+    return jacState;
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
-ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputSparseIntermediate()
+ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputSparseTerminal()
 {
-    MatrixXs jacTot = intermediateCodegen_->jacobian(stateControlD_);
-    VectorXs jacSparse;
-    jacSparse.resize(getJacobianInputNonZeroCountIntermediate());
-    for (size_t i = 0; i < getJacobianInputNonZeroCountIntermediate(); ++i)
-        jacSparse(i) = (jacTot.template rightCols<CONTROL_DIM>())(
-            sparsityInputIntermediateRows_(i), sparsityInputIntermediateCols_(i));
-
-    return jacSparse;
+    VectorXs jacState;
+    VectorXs jacInput;
+    jacobiansSparseTerminal(jacState, jacInput);
+    return jacInput;
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::MatrixXs
-ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputIntermediate()
+ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputTerminal()
 {
-    if (!this->initializedIntermediate_)
-        throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
-
-    MatrixXs jacTot = intermediateCodegen_->jacobian(stateControlD_);
-    return jacTot.template rightCols<CONTROL_DIM>();
+    MatrixXs jacState;
+    MatrixXs jacInput;
+    jacobiansTerminal(jacState, jacInput);
+    return jacInput;
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::VectorXs
-ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputSparseTerminal()
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansSparseTerminal(VectorXs& jacState,
+    VectorXs& jacInput)
 {
     if (!this->initializedTerminal_)
         throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
 
-    MatrixXs jacTot = terminalCodegen_->jacobian(stateControlD_);
-    VectorXs jacSparse;
-    jacSparse.resize(getJacobianInputNonZeroCountTerminal());
-    for (size_t i = 0; i < getJacobianInputNonZeroCountTerminal(); ++i)
-        jacSparse(i) =
-            (jacTot.template rightCols<CONTROL_DIM>())(sparsityInputTerminalRows_(i), sparsityInputTerminalCols_(i));
+    evaluateSparseJacobian(*terminalCodegen_, sparsityTerminalCols_, jacState, jacInput);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansTerminal(MatrixXs& jacState,
+    MatrixXs& jacInput)
+{
+    VectorXs jacStateSparse;
+    VectorXs jacInputSparse;
+    jacobiansSparseTerminal(jacStateSparse, jacInputSparse);
 
-    return jacSparse;
+    const size_t nConstraints = getTerminalConstraintsCount();
+    sparseToDense(
+        jacStateSparse, sparsityStateTerminalRows_, sparsityStateTerminalCols_, nConstraints, STATE_DIM, jacState);
+    sparseToDense(
+        jacInputSparse, sparsityInputTerminalRows_, sparsityInputTerminalCols_, nConstraints, CONTROL_DIM, jacInput);
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-typename ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::MatrixXs
-ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianInputTerminal()
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateSparseJacobian(JacCG& codegen,
+    const Eigen::VectorXi& sparsityCols,
+    VectorXs& jacState,
+    VectorXs& jacInput)
 {
-    if (!this->initializedTerminal_)
-        throw std::runtime_error("Constraints not initialized yet. Call 'initialize()' before");
+    // the non zeros are ordered as in the sparsity pattern, which initialize() split into state and input part
+    const VectorXs jacSparse = codegen.sparseJacobianValues(stateControlD_);
+
+    const int nonZerosState = (sparsityCols.array() < static_cast<int>(STATE_DIM)).count();
+    jacState.resize(nonZerosState);
+    jacInput.resize(sparsityCols.rows() - nonZerosState);
 
-    MatrixXs jacTot = terminalCodegen_->jacobian(stateControlD_);
-    return jacTot.template rightCols<CONTROL_DIM>();
+    size_t stateIndex = 0;
+    size_t inputIndex = 0;
+    for (int i = 0; i < sparsityCols.rows(); ++i)
+    {
+        if (sparsityCols(i) < static_cast<int>(STATE_DIM))
+            jacState(stateIndex++) = jacSparse(i);
+        else
+            jacInput(inputIndex++) = jacSparse(i);
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::sparseToDense(const VectorXs& jacSparse,
+    const Eigen::VectorXi& iRows,
+    const Eigen::VectorXi& jCols,
+    size_t nRows,
+    size_t nCols,
+    MatrixXs& jac)
+{
+    jac.setZero(nRows, nCols);
+    for (int i = 0; i < jacSparse.rows(); ++i)
+        jac(iRows(i), jCols(i)) = jacSparse(i);
 }
 
 
@@ -432,6 +495,9 @@ bool ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::initializeIntermedia
             count += constraintSize;
         }
 
+        sparsityIntermediateRows_ = sparsityRows;
+        sparsityIntermediateCols_ = sparsityCols;
+
         size_t stateIndex = 0;
         size_t inputIndex = 0;
 
@@ -497,6 +563,9 @@ bool ConstraintContainerAD<STATE_DIM, CONTROL_DIM, SCALAR>::initializeTerminal()
             count += constraintSize;
         }
 
+        sparsityTerminalRows_ = sparsityRows;
+        sparsityTerminalCols_ = sparsityCols;
+
         size_t stateIndex = 0;
         size_t inputIndex = 0;
 
@@ -112,6 +112,14 @@ public:
 
     virtual MatrixXs jacobianInputTerminal() override;
 
+    virtual void jacobiansSparseIntermediate(VectorXs& jacState, VectorXs& jacInput) override;
+
+    virtual void jacobiansIntermediate(MatrixXs& jacState, MatrixXs& jacInput) override;
+
+    virtual void jacobiansSparseTerminal(VectorXs& jacState, VectorXs& jacInput) override;
+
+    virtual void jacobiansTerminal(MatrixXs& jacState, MatrixXs& jacInput) override;
+
     virtual void sparsityPatternStateIntermediate(Eigen::VectorXi& iRows, Eigen::VectorXi& jCols) override;
 
     virtual void sparsityPatternStateTerminal(Eigen::VectorXi& iRows, Eigen::VectorXi& jCols) override;
@@ -158,6 +166,27 @@ private:
     Eigen::Matrix<CGScalar, Eigen::Dynamic, 1> evaluateTerminalCodegen(
         const Eigen::Matrix<CGScalar, STATE_DIM + CONTROL_DIM, 1>& stateinput);
 
+    /**
+	 * @brief      Evaluates the sparse jacobian wrt the stacked state and input once and splits its non zeros
+	 *
+	 * @param      codegen       The compiled constraints
+	 * @param[in]  sparsityCols  The column indices of all non zeros of the stacked jacobian
+	 * @param[out] jacState      The non zeros wrt state
+	 * @param[out] jacInput      The non zeros wrt input
+	 */
+    void evaluateSparseJacobian(JacCG& codegen,
+        const Eigen::VectorXi& sparsityCols,
+        VectorXs& jacState,
+        VectorXs& jacInput);
+
+    //! writes the non zeros of a sparse jacobian into a dense matrix of size nRows x nCols
+    static void sparseToDense(const VectorXs& jacSparse,
+        const Eigen::VectorXi& iRows,
+        const Eigen::VectorXi& jCols,
+        size_t nRows,
+        size_t nCols,
+        MatrixXs& jac);
+
     //containers
     std::vector<std::shared_ptr<ConstraintBase<STATE_DIM, CONTROL_DIM, SCALAR>>> constraintsIntermediate_;
     std::vector<std::shared_ptr<ConstraintBase<STATE_DIM, CONTROL_DIM, SCALAR>>> constraintsTerminal_;
@@ -169,12 +198,14 @@ private:
     typename JacCG::FUN_TYPE_CG fTerminal_;
 
     Eigen::VectorXi sparsityIntermediateRows_;
+    Eigen::VectorXi sparsityIntermediateCols_;
     Eigen::VectorXi sparsityStateIntermediateRows_;
     Eigen::VectorXi sparsityStateIntermediateCols_;
     Eigen::VectorXi sparsityInputIntermediateRows_;
     Eigen::VectorXi sparsityInputIntermediateCols_;
 
     Eigen::VectorXi sparsityTerminalRows_;
+    Eigen::VectorXi sparsityTerminalCols_;
     Eigen::VectorXi sparsityStateTerminalRows_;
     Eigen::VectorXi sparsityStateTerminalCols_;
     Eigen::VectorXi sparsityInputTerminalRows_;
@@ -35,6 +35,38 @@ size_t LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::getJacNonZeroC
            getJacobianInputNonZeroCountIntermediate() + getJacobianInputNonZeroCountTerminal();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansSparseIntermediate(VectorXs& jacState,
+    VectorXs& jacInput)
+{
+    jacState = jacobianStateSparseIntermediate();
+    jacInput = jacobianInputSparseIntermediate();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansIntermediate(MatrixXs& jacState,
+    MatrixXs& jacInput)
+{
+    jacState = jacobianStateIntermediate();
+    jacInput = jacobianInputIntermediate();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansSparseTerminal(VectorXs& jacState,
+    VectorXs& jacInput)
+{
+    jacState = jacobianStateSparseTerminal();
+    jacInput = jacobianInputSparseTerminal();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::jacobiansTerminal(MatrixXs& jacState,
+    MatrixXs& jacInput)
+{
+    jacState = jacobianStateTerminal();
+    jacInput = jacobianInputTerminal();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void LinearConstraintContainer<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
 {
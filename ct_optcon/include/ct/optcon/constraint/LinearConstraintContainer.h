@@ -120,6 +120,42 @@ public:
 	 */
     virtual MatrixXs jacobianInputTerminal() = 0;
 
+    /**
+	 * @brief      Evaluates the constraint jacobians wrt state and control input using sparse representation
+	 *
+	 *             Containers which obtain both jacobians from one evaluation should override this method.
+	 *
+	 * @param      jacState  The sparse jacobian wrt state
+	 * @param      jacInput  The sparse jacobian wrt control
+	 */
+    virtual void jacobiansSparseIntermediate(VectorXs& jacState, VectorXs& jacInput);
+
+    /**
+	 * @brief      Evaluates the constraint jacobians wrt state and control input
+	 *
+	 *             Containers which obtain both jacobians from one evaluation should override this method.
+	 *
+	 * @param      jacState  The jacobian wrt state
+	 * @param      jacInput  The jacobian wrt control
+	 */
+    virtual void jacobiansIntermediate(MatrixXs& jacState, MatrixXs& jacInput);
+
+    /**
+	 * @brief      Evaluates the terminal constraint jacobians wrt state and control input using sparse representation
+	 *
+	 * @param      jacState  The sparse jacobian wrt state
+	 * @param      jacInput  The sparse jacobian wrt control
+	 */
+    virtual void jacobiansSparseTerminal(VectorXs& jacState, VectorXs& jacInput);
+
+    /**
+	 * @brief      Evaluates the terminal constraint jacobians wrt state and control input
+	 *
+	 * @param      jacState  The jacobian wrt state
+	 * @param      jacInput  The jacobian wrt control
+	 */
+    virtual void jacobiansTerminal(MatrixXs& jacState, MatrixXs& jacInput);
+
     /**
 	 * @brief      Returns the sparsity pattern for the jacobian wrt state
 	 *
@@ -89,8 +89,11 @@ void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
     settings.createJacobian_ = true;
     settings.createHessian_ = true;
 
-    finalCostCodegen_->compileJIT(settings, "finalCosts");
-    intermediateCostCodegen_->compileJIT(settings, "intermediateCosts");
+    // both models get compiled into a single library
+    ct::core::JITCompilationService compilationService(settings, "costs");
+    compilationService.add(*finalCostCodegen_, settings, "finalCosts");
+    compilationService.add(*intermediateCostCodegen_, settings, "intermediateCosts");
+    compilationService.compile();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
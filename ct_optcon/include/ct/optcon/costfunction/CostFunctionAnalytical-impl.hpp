@@ -173,5 +173,12 @@ CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTe
     return this->stateControlDerivativeTerminalBase();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediateQuadraticApproximation(
+    approximation_t& approx)
+{
+    this->evaluateIntermediateQuadraticApproximationBase(approx);
+}
+
 }  // namespace optcon
 }  // namespace ct
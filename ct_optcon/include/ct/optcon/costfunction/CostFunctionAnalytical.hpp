@@ -40,6 +40,8 @@ public:
     typedef core::StateVector<STATE_DIM, SCALAR> state_vector_t;
     typedef core::ControlVector<CONTROL_DIM, SCALAR> control_vector_t;
 
+    typedef typename CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::approximation_t approximation_t;
+
     /**
 	 * \brief Basic constructor
 	 */
@@ -86,6 +88,8 @@ public:
     control_state_matrix_t stateControlDerivativeIntermediate() override;
     control_state_matrix_t stateControlDerivativeTerminal() override;
 
+    void evaluateIntermediateQuadraticApproximation(approximation_t& approx) override;
+
     void loadFromConfigFile(const std::string& filename, bool verbose = false) override;
 
 private:
@@ -336,6 +336,46 @@ SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateTerminalBa
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediateQuadraticApproximation(
+    approximation_t& approx)
+{
+    approx.value = this->evaluateIntermediate();
+    approx.stateDerivative = this->stateDerivativeIntermediate();
+    approx.controlDerivative = this->controlDerivativeIntermediate();
+    approx.stateSecondDerivative = this->stateSecondDerivativeIntermediate();
+    approx.controlSecondDerivative = this->controlSecondDerivativeIntermediate();
+    approx.stateControlDerivative = this->stateControlDerivativeIntermediate();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediateQuadraticApproximationBase(
+    approximation_t& approx)
+{
+    approx.setZero();
+
+    for (auto it : this->intermediateCostAnalytical_)
+    {
+        if (!it->isActiveAtTime(this->t_))
+        {
+            continue;
+        }
+
+        const SCALAR activation = it->computeActivation(this->t_);
+        it->evaluateQuadraticApproximation(this->x_, this->u_, this->t_, termApproximation_);
+
+        // the activation enters the value twice, consistent with evaluateIntermediateBase()
+        approx.value += activation * activation * termApproximation_.value;
+        approx.stateDerivative += activation * termApproximation_.stateDerivative;
+        approx.controlDerivative += activation * termApproximation_.controlDerivative;
+        approx.stateSecondDerivative += activation * termApproximation_.stateSecondDerivative;
+        approx.controlSecondDerivative += activation * termApproximation_.controlSecondDerivative;
+        approx.stateControlDerivative += activation * termApproximation_.stateControlDerivative;
+    }
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::state_vector_t
 CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeIntermediateBase()
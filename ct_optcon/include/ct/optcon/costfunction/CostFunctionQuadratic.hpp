@@ -6,6 +6,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #pragma once
 
 #include "CostFunction.hpp"
+#include "QuadraticCostApproximation.hpp"
 #include "term/TermBase.hpp"
 
 namespace ct {
@@ -38,6 +39,8 @@ public:
     typedef core::StateVector<STATE_DIM, SCALAR> state_vector_t;
     typedef core::ControlVector<CONTROL_DIM, SCALAR> control_vector_t;
 
+    typedef QuadraticCostApproximation<STATE_DIM, CONTROL_DIM, SCALAR> approximation_t;
+
     typedef CostFunction<STATE_DIM, CONTROL_DIM, SCALAR> BASE;
 
     /**
@@ -159,6 +162,15 @@ public:
 	 */
     virtual control_state_matrix_t stateControlDerivativeTerminal();
 
+    /**
+	 * \brief Computes intermediate-cost value and all its first and second-order derivatives in a single sweep
+	 *
+	 * The default implementation calls the individual evaluation methods above. Cost functions composed of terms
+	 * override it such that every term gets evaluated only once, see TermBase::evaluateQuadraticApproximation().
+	 * @param approx the resulting value and derivatives, all entries get overwritten
+	 */
+    virtual void evaluateIntermediateQuadraticApproximation(approximation_t& approx);
+
     //! update the reference state for intermediate cost terms
     virtual void updateReferenceState(const state_vector_t& x_ref);
 
@@ -192,6 +204,9 @@ protected:
     //! evaluate terminal analytical cost terms
     SCALAR evaluateTerminalBase();
 
+    //! evaluate intermediate analytical cost terms and all their derivatives in a single sweep
+    void evaluateIntermediateQuadraticApproximationBase(approximation_t& approx);
+
     //! evaluate intermediate analytical state derivatives
     state_vector_t stateDerivativeIntermediateBase();
 
@@ -239,6 +254,9 @@ protected:
 
     /** list of final cost terms for which analytic derivatives are available */
     std::vector<std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>>> finalCostAnalytical_;
+
+    //! preallocated approximation of a single term, used in evaluateIntermediateQuadraticApproximationBase()
+    approximation_t termApproximation_;
 };
 
 
@@ -0,0 +1,52 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup CostFunction
+ *
+ * \brief The value, gradient and Hessian blocks of a cost function or cost term at a given state, control and time
+ *
+ * Gets filled in a single evaluation sweep, see TermBase::evaluateQuadraticApproximation() and
+ * CostFunctionQuadratic::evaluateIntermediateQuadraticApproximation().
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+struct QuadraticCostApproximation
+{
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM> state_matrix_t;
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM> control_matrix_t;
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> control_state_matrix_t;
+
+    typedef core::StateVector<STATE_DIM, SCALAR> state_vector_t;
+    typedef core::ControlVector<CONTROL_DIM, SCALAR> control_vector_t;
+
+    QuadraticCostApproximation() { setZero(); }
+
+    void setZero()
+    {
+        value = SCALAR(0.0);
+        stateDerivative.setZero();
+        controlDerivative.setZero();
+        stateSecondDerivative.setZero();
+        controlSecondDerivative.setZero();
+        stateControlDerivative.setZero();
+    }
+
+    SCALAR value;                                   //! cost
+    state_vector_t stateDerivative;                 //! derivative w.r.t. the state
+    control_vector_t controlDerivative;             //! derivative w.r.t. the control
+    state_matrix_t stateSecondDerivative;           //! second derivative w.r.t. the state
+    control_matrix_t controlSecondDerivative;       //! second derivative w.r.t. the control
+    control_state_matrix_t stateControlDerivative;  //! cross-term derivative (state-control)
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -123,6 +123,41 @@ TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDerivative(
         "or implement the analytical derivatives manually.");
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateQuadraticApproximation(
+    const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+    const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+    const SCALAR_EVAL& t,
+    QuadraticCostApproximation<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& approx)
+{
+    approx.value = evaluateInEvalScalar(x, u, t, std::is_same<SCALAR, SCALAR_EVAL>());
+    approx.stateDerivative = stateDerivative(x, u, t);
+    approx.controlDerivative = controlDerivative(x, u, t);
+    approx.stateSecondDerivative = stateSecondDerivative(x, u, t);
+    approx.controlSecondDerivative = controlSecondDerivative(x, u, t);
+    approx.stateControlDerivative = stateControlDerivative(x, u, t);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+SCALAR_EVAL TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateInEvalScalar(
+    const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+    const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+    const SCALAR_EVAL& t,
+    std::true_type)
+{
+    return evaluate(x, u, t);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+SCALAR_EVAL TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateInEvalScalar(
+    const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+    const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+    const SCALAR_EVAL& t,
+    std::false_type)
+{
+    throw std::runtime_error("The cost function term " + name_ + " cannot be evaluated in its evaluation scalar type.");
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
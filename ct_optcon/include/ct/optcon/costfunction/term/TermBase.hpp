@@ -10,6 +10,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/core/common/activations/Activations.h>
 
+#include "../QuadraticCostApproximation.hpp"
+
 namespace ct {
 namespace optcon {
 
@@ -147,6 +149,23 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t);
 
+    /**
+	 * @brief      Evaluates the term and all its derivatives at x, u, t in a single sweep
+	 *
+	 * Does not include time activations. The default implementation calls evaluate() and the derivative methods
+	 * one after another. Terms which share expensive intermediate results between their derivatives, e.g. a time
+	 * varying reference, should override this method and compute these results only once.
+	 *
+	 * @param[in]  x       The current state
+	 * @param[in]  u       The current control
+	 * @param[in]  t       The current time
+	 * @param[out] approx  The value and derivatives of the term, all entries get overwritten
+	 */
+    virtual void evaluateQuadraticApproximation(const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+        const SCALAR_EVAL& t,
+        QuadraticCostApproximation<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& approx);
+
     //! load this term from a configuration file
     virtual void loadConfigFile(const std::string& filename, const std::string& termName, bool verbose = false);
 
@@ -176,6 +195,19 @@ public:
 
     //! retrieve this term's current reference state
     virtual Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> getReferenceState() const;
+
+private:
+    //! evaluate the term in its evaluation scalar type
+    SCALAR_EVAL evaluateInEvalScalar(const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+        const SCALAR_EVAL& t,
+        std::true_type);
+
+    //! terms with a different (e.g. auto-diff) scalar type can only be evaluated through evaluate()
+    SCALAR_EVAL evaluateInEvalScalar(const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+        const SCALAR_EVAL& t,
+        std::false_type);
 };
 
 }  // namespace optcon
@@ -142,6 +142,33 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDeriv
     return control_state_matrix_t::Zero();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateQuadraticApproximation(
+    const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+    const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+    const SCALAR_EVAL& t,
+    QuadraticCostApproximation<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& approx)
+{
+    // interpolate the references only once for all derivatives
+    const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> xDiff = x - x_traj_ref_.eval(t);
+
+    Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1> uDiff;
+
+    if (trackControlTrajectory_)
+        uDiff = u - u_traj_ref_.eval(t);
+    else
+        uDiff = u;
+
+    approx.stateSecondDerivative = Q_ + Q_.transpose();
+    approx.controlSecondDerivative = R_ + R_.transpose();
+    approx.stateControlDerivative.setZero();
+
+    approx.stateDerivative.noalias() = approx.stateSecondDerivative * xDiff;
+    approx.controlDerivative.noalias() = approx.controlSecondDerivative * uDiff;
+
+    approx.value = xDiff.dot(Q_ * xDiff) + uDiff.dot(R_ * uDiff);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
@@ -72,6 +72,11 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t) override;
 
+    void evaluateQuadraticApproximation(const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+        const SCALAR_EVAL& t,
+        QuadraticCostApproximation<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& approx) override;
+
     virtual void loadConfigFile(const std::string& filename,
         const std::string& termName,
         bool verbose = false) override;
@@ -155,7 +155,6 @@ public:
 
     VectorXs evalSparseJacobian() override
     {
-        size_t jacSize = 0;
         size_t discreteInd = 0;
 
         for (size_t n = 0; n < N_ + 1; ++n)
@@ -166,35 +165,29 @@ public:
             {
                 constraint->setCurrentStateAndControl(
                     w_->getOptimizedState(n), controlSpliner_->evalSpline(tShot, n), tShot);
-                jacSize = constraint->getJacobianStateNonZeroCountIntermediate();
-                if (jacSize > 0)
+                if (constraint->getJacobianStateNonZeroCountIntermediate() +
+                        constraint->getJacobianInputNonZeroCountIntermediate() >
+                    0)
                 {
-                    discreteJac_.segment(discreteInd, jacSize) = constraint->jacobianStateSparseIntermediate();
-                    discreteInd += jacSize;
-                }
-
-                jacSize = constraint->getJacobianInputNonZeroCountIntermediate();
-                if (jacSize > 0)
-                {
-                    discreteJac_.segment(discreteInd, jacSize) = constraint->jacobianInputSparseIntermediate();
-                    discreteInd += jacSize;
+                    constraint->jacobiansSparseIntermediate(jacState_, jacInput_);
+                    discreteJac_.segment(discreteInd, jacState_.rows()) = jacState_;
+                    discreteInd += jacState_.rows();
+                    discreteJac_.segment(discreteInd, jacInput_.rows()) = jacInput_;
+                    discreteInd += jacInput_.rows();
                 }
             }
         }
 
         for (auto constraint : constraints_)
         {
-            jacSize = constraint->getJacobianStateNonZeroCountTerminal();
-            if (jacSize > 0)
-            {
-                discreteJac_.segment(discreteInd, jacSize) = constraint->jacobianStateSparseTerminal();
-                discreteInd += jacSize;
-            }
-            jacSize = constraint->getJacobianInputNonZeroCountTerminal();
-            if (jacSize > 0)
+            if (constraint->getJacobianStateNonZeroCountTerminal() + constraint->getJacobianInputNonZeroCountTerminal() >
+                0)
             {
-                discreteJac_.segment(discreteInd, jacSize) = constraint->jacobianInputSparseTerminal();
-                discreteInd += jacSize;
+                constraint->jacobiansSparseTerminal(jacState_, jacInput_);
+                discreteJac_.segment(discreteInd, jacState_.rows()) = jacState_;
+                discreteInd += jacState_.rows();
+                discreteJac_.segment(discreteInd, jacInput_.rows()) = jacInput_;
+                discreteInd += jacInput_.rows();
             }
         }
 
@@ -348,6 +341,8 @@ private:
     VectorXs discreteUpperBound_;
 
     VectorXs discreteJac_;
+    VectorXs jacState_;  //!< non zeros of the state jacobian of a single constraint container
+    VectorXs jacInput_;  //!< non zeros of the input jacobian of a single constraint container
     Eigen::VectorXi discreteIRow_;
     Eigen::VectorXi discreteJCol_;
 
@@ -11,6 +11,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/optcon/dms/dms_core/DmsDimensions.h>
 #include <ct/optcon/dms/dms_core/OptVectorDms.h>
 #include <ct/optcon/dms/dms_core/ShotContainer.h>
+#include <ct/optcon/dms/dms_core/ShotEvaluator.h>
 
 #include <ct/optcon/nlp/DiscreteConstraintBase.h>
 #include <ct/optcon/nlp/DiscreteConstraintContainerBase.h>
@@ -53,7 +54,7 @@ public:
 	 *
 	 * @param[in]  w                        The optimization variables
 	 * @param[in]  timeGrid                 The time grid
-	 * @param[in]  shotContainers           The shot containers
+	 * @param[in]  shotEvaluator            The evaluator of the shots
 	 * @param[in]  constraintsIntermediate  The intermediate constraints
 	 * @param[in]  constraintsFinal         The final constraints
 	 * @param[in]  x0                       The initial state
@@ -61,7 +62,7 @@ public:
 	 */
     ConstraintsContainerDms(std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w,
         std::shared_ptr<tpl::TimeGrid<SCALAR>> timeGrid,
-        std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers,
+        std::shared_ptr<ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>> shotEvaluator,
         std::shared_ptr<ConstraintDiscretizer<STATE_DIM, CONTROL_DIM, SCALAR>> discretizedConstraints,
         const state_vector_t& x0,
         const DmsSettings settings);
@@ -86,7 +87,7 @@ private:
     const DmsSettings settings_;
 
     std::shared_ptr<InitStateConstraint<STATE_DIM, CONTROL_DIM, SCALAR>> c_init_;
-    std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers_;
+    std::shared_ptr<ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>> shotEvaluator_;
 };
 
 #include "implementation/ConstraintsContainerDms-impl.h"
@@ -21,6 +21,11 @@ namespace optcon {
  *
  * @brief      Implementation of the DMS continuity constraints
  *
+ *             The constraint and its Jacobian are evaluated by the
+ *             ShotEvaluator within the task of the shot, see update() and
+ *             updateJacobian(). eval() and evalSparseJacobian() return the
+ *             results of the last evaluation.
+ *
  * @tparam     STATE_DIM    The state dimension
  * @tparam     CONTROL_DIM  The input dimension
  */
@@ -65,6 +70,7 @@ public:
     {
         lb_.setConstant(SCALAR(0.0));
         ub_.setConstant(SCALAR(0.0));
+        c_.setZero();
 
         size_t nr = 0;
 
@@ -92,8 +98,17 @@ public:
     }
 
 
-    VectorXs eval() override { return w_->getOptimizedState(shotIndex_ + 1) - shotContainer_->getStateIntegrated(); }
-    VectorXs evalSparseJacobian() override
+    VectorXs eval() override { return c_; }
+    VectorXs evalSparseJacobian() override { return jacLocal_; }
+    /**
+	 * @brief      Evaluates the constraint once the shot has been integrated
+	 */
+    void update() { c_ = w_->getOptimizedState(shotIndex_ + 1) - shotContainer_->getStateIntegrated(); }
+    /**
+	 * @brief      Evaluates the sparse Jacobian once the sensitivities of the
+	 *             shot have been integrated
+	 */
+    void updateJacobian()
     {
         count_local_ = 0;
         switch (settings_.splineType_)
@@ -122,7 +137,6 @@ public:
                 throw(std::runtime_error("specified invalid spliner type in ContinuityConstraint-class"));
             }
         }
-        return jacLocal_;
     }
 
     size_t getNumNonZerosJacobian() override
@@ -248,6 +262,7 @@ private:
     size_t shotIndex_;
     const DmsSettings settings_;
 
+    state_vector_t c_;
     VectorXs jacLocal_;
     size_t count_local_;
 
@@ -7,26 +7,32 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintsContainerDms(
     std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w,
     std::shared_ptr<tpl::TimeGrid<SCALAR>> timeGrid,
-    std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers,
+    std::shared_ptr<ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>> shotEvaluator,
     std::shared_ptr<ConstraintDiscretizer<STATE_DIM, CONTROL_DIM, SCALAR>> discretizedConstraints,
     const state_vector_t& x0,
     const DmsSettings settings)
-    : settings_(settings), shotContainers_(shotContainers)
+    : settings_(settings), shotEvaluator_(shotEvaluator)
 {
     c_init_ = std::shared_ptr<InitStateConstraint<STATE_DIM, CONTROL_DIM, SCALAR>>(
         new InitStateConstraint<STATE_DIM, CONTROL_DIM, SCALAR>(x0, w));
 
     this->constraints_.push_back(c_init_);
 
+    std::vector<std::shared_ptr<ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>>> continuityConstraints;
     for (size_t shotNr = 0; shotNr < settings_.N_; shotNr++)
     {
         std::shared_ptr<ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>> c_i =
             std::shared_ptr<ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>>(
-                new ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>(shotContainers[shotNr], w, shotNr, settings));
+                new ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>(
+                    shotEvaluator_->getShotContainers()[shotNr], w, shotNr, settings));
 
+        continuityConstraints.push_back(c_i);
         this->constraints_.push_back(c_i);
     }
 
+    // the continuity constraints are evaluated by the tasks of their shots
+    shotEvaluator_->setContinuityConstraints(continuityConstraints);
+
     if (discretizedConstraints)
     {
         std::cout << "Adding discretized constraints" << std::endl;
@@ -37,21 +43,13 @@ ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintsContainerDms
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::prepareEvaluation()
 {
-#pragma omp parallel for num_threads(settings_.nThreads_)
-    for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
-    {
-        (*shotContainer)->integrateShot();
-    }
+    shotEvaluator_->evaluate();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::prepareJacobianEvaluation()
 {
-#pragma omp parallel for num_threads(settings_.nThreads_)
-    for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
-    {
-        (*shotContainer)->integrateSensitivities();
-    }
+    shotEvaluator_->evaluateSensitivities();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -141,6 +141,9 @@ public:
                     nIntegrationSteps)));
         }
 
+        shotEvaluator_ = std::shared_ptr<ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>>(
+            new ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>(shotContainers_, settings_));
+
         switch (settings_.costEvaluationType_)
         {
             case DmsSettings::SIMPLE:
@@ -154,7 +157,7 @@ public:
             {
                 this->costEvaluator_ = std::shared_ptr<CostEvaluatorFull<STATE_DIM, CONTROL_DIM, SCALAR>>(
                     new CostEvaluatorFull<STATE_DIM, CONTROL_DIM, SCALAR>(
-                        costPtrs.front(), optVariablesDms_, controlSpliner_, shotContainers_, settings_));
+                        costPtrs.front(), optVariablesDms_, controlSpliner_, shotEvaluator_, settings_));
                 break;
             }
             default:
@@ -163,7 +166,7 @@ public:
 
         this->constraints_ = std::shared_ptr<ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>>(
             new ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>(
-                optVariablesDms_, timeGrid_, shotContainers_, discretizedConstraints_, x0, settings_));
+                optVariablesDms_, timeGrid_, shotEvaluator_, discretizedConstraints_, x0, settings_));
 
         this->optVariables_->resizeConstraintVars(this->getConstraintsCount());
     }
@@ -176,9 +179,9 @@ public:
 
     void updateProblem() override
     {
+        // the shots re-integrate only if their own variables changed
+        optVariablesDms_->updateShotVersions();
         controlSpliner_->computeSpline(optVariablesDms_->getOptimizedInputs().toImplementation());
-        for (auto shotContainer : shotContainers_)
-            shotContainer->reset();
     }
 
     /**
@@ -248,7 +251,11 @@ public:
 	 *
 	 * @param[in]  tf    The new time horizon
 	 */
-    void changeTimeHorizon(const SCALAR tf) { timeGrid_->changeTimeHorizon(tf); }
+    void changeTimeHorizon(const SCALAR tf)
+    {
+        timeGrid_->changeTimeHorizon(tf);
+        invalidateShots();
+    }
     /**
 	 * @brief      Updates the initial state
 	 *
@@ -260,6 +267,16 @@ public:
         optVariablesDms_->changeInitialState(x0);
     }
 
+    /**
+	 * @brief      Forces all shots to re-integrate at the next update
+	 *
+	 *             The shots only detect changes of their own optimization
+	 *             variables. Every public path which changes the time grid,
+	 *             the systems or the cost functions of the shots has to call
+	 *             this, otherwise stale integration results are reused.
+	 */
+    void invalidateShots() { optVariablesDms_->invalidateShots(); }
+
     /**
 	 * @brief      Prints the solution trajectories
 	 */
@@ -271,6 +288,7 @@ private:
     std::shared_ptr<ConstraintDiscretizer<STATE_DIM, CONTROL_DIM, SCALAR>> discretizedConstraints_;
 
     std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers_;
+    std::shared_ptr<ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>> shotEvaluator_;
     std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> optVariablesDms_;
     std::shared_ptr<SplinerBase<control_vector_t, SCALAR>> controlSpliner_;
     std::shared_ptr<tpl::TimeGrid<SCALAR>> timeGrid_;
@@ -91,7 +91,7 @@ public:
         if (T_ <= 0.0)
             return false;
 
-        if (nThreads_ < 1 || nThreads_ > 32)
+        if (nThreads_ < 1)
             return false;
 
         if (splineType_ < 0 || !(splineType_ < SplineType_t::num_types_splining))
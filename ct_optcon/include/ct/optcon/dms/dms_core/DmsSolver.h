@@ -179,6 +179,10 @@ public:
         if (cf)
             for (size_t i = 0; i < settings_.N_; i++)
                 this->getCostFunctionInstances()[i] = typename Base::OptConProblem_t::CostFunctionPtr_t(cf->clone());
+
+        // the cached shots were integrated with the previous instances
+        if (dmsProblem_)
+            dmsProblem_->invalidateShots();
     }
 
     void changeNonlinearSystem(const typename Base::OptConProblem_t::DynamicsPtr_t& dyn) override
@@ -188,6 +192,10 @@ public:
         if (dyn)
             for (size_t i = 0; i < settings_.N_; i++)
                 this->getNonlinearSystemsInstances()[i] = typename Base::OptConProblem_t::DynamicsPtr_t(dyn->clone());
+
+        // the cached shots were integrated with the previous instances
+        if (dmsProblem_)
+            dmsProblem_->invalidateShots();
     }
 
     void changeLinearSystem(const typename Base::OptConProblem_t::LinearPtr_t& lin) override
@@ -197,6 +205,10 @@ public:
         if (lin)
             for (size_t i = 0; i < settings_.N_; i++)
                 this->getLinearSystemsInstances()[i] = typename Base::OptConProblem_t::LinearPtr_t(lin->clone());
+
+        // the cached shots were integrated with the previous instances
+        if (dmsProblem_)
+            dmsProblem_->invalidateShots();
     }
 
     void changeInputBoxConstraints(const typename Base::OptConProblem_t::ConstraintPtr_t con) override
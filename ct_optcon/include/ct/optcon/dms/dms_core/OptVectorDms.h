@@ -8,6 +8,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <Eigen/Core>
 #include <map>
+#include <vector>
 
 #include "TimeGrid.h"
 
@@ -156,6 +157,32 @@ public:
      * @return     Number of pairs
      */
     size_t numPairs() { return numPairs_; }
+    /**
+     * @brief      Detects the shots affected by the last update of the
+     *             optimization variables
+     *
+     *             Compares the state and control variables every shot depends
+     *             on to their values at the previous call and increments the
+     *             version of the shots whose variables changed. Needs to be
+     *             called after every update, before the shots get integrated.
+     */
+    void updateShotVersions();
+
+    /**
+     * @brief      Marks all shots as changed at the next call to
+     *             updateShotVersions(), e.g. after a change of the time grid
+     */
+    void invalidateShots() { xPrevious_.resize(0); }
+    /**
+     * @brief      Returns the version of the optimization variables a shot
+     *             depends on
+     *
+     * @param[in]  shotNr  The shot number
+     *
+     * @return     The version, which changes whenever the shot needs to be
+     *             integrated again
+     */
+    size_t getShotVersion(const size_t shotNr) const { return shotVersions_[shotNr]; }
     /**
      * @brief      Prints out the solution trajectories
      */
@@ -171,6 +198,10 @@ private:
 
     state_vector_array_t stateSolution_;
     control_vector_array_t inputSolution_;
+
+    std::vector<size_t> shotVersions_;
+    typename Base::VectorXs xPrevious_; /* the optimization variables at the last call to updateShotVersions() */
+    std::vector<bool> pairChanged_;     /* whether the variables of a pair changed at the last update */
 };
 
 }  // namespace optcon
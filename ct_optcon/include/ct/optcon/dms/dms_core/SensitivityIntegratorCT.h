@@ -39,7 +39,7 @@ public:
      */
     SensitivityIntegratorCT(const std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>>& system,
         const ct::core::IntegrationType stepperType = ct::core::IntegrationType::EULERCT)
-        : cacheData_(false), cacheSensitivities_(false)
+        : cacheData_(false), cacheSensitivities_(false), adaptiveFailed_(false)
     {
         setControlledSystem(system);
         initializeDerived(stepperType);
@@ -92,6 +92,25 @@ public:
                 break;
             }
 
+            case ct::core::IntegrationType::RK5VARIABLE:
+            {
+                stepperStateAdaptive_ =
+                    std::shared_ptr<ct::core::internal::StepperDormandPrinceCT<state_vector, SCALAR>>(
+                        new ct::core::internal::StepperDormandPrinceCT<state_vector, SCALAR>());
+                stepperState_ = stepperStateAdaptive_;
+                stepperDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_matrix, SCALAR>>(
+                    new ct::core::internal::StepperDormandPrinceCT<state_matrix, SCALAR>());
+                stepperDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>>(
+                    new ct::core::internal::StepperDormandPrinceCT<state_control_matrix, SCALAR>());
+                stepperCost_ = std::shared_ptr<ct::core::internal::StepperCTBase<SCALAR, SCALAR>>(
+                    new ct::core::internal::StepperDormandPrinceCT<SCALAR, SCALAR>());
+                stepperCostDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
+                    new ct::core::internal::StepperDormandPrinceCT<state_vector, SCALAR>());
+                stepperCostDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>>(
+                    new ct::core::internal::StepperDormandPrinceCT<control_vector, SCALAR>());
+                break;
+            }
+
             default:
                 throw std::runtime_error("Invalid CT integration type");
         }
@@ -231,6 +250,8 @@ public:
     {
         clearStates();
         clearLinearization();
+        stepSizes_.clear();
+        adaptiveFailed_ = false;
         cacheData_ = true;
         stateTrajectory.clear();
         timeTrajectory.clear();
@@ -261,12 +282,124 @@ public:
     {
         clearStates();
         clearLinearization();
+        stepSizes_.clear();
+        adaptiveFailed_ = false;
+        integrateSteps(stepperState_, xDot_, state, startTime, numSteps, dt);
+    }
+
+    /**
+     * @brief          Integrates the system from startTime to endTime with
+     *                 adaptive step size control. Requires the RK5VARIABLE
+     *                 stepper type.
+     *
+     *                 The sensitivities and the cost are integrated afterwards
+     *                 along the accepted steps, such that they are the exact
+     *                 derivatives of the discretized shot. Therefore, the
+     *                 numSteps and dt arguments of the subsequent integrate*
+     *                 calls are ignored until the next fixed step integration.
+     *
+     *                 If the error estimate is not finite or the number of
+     *                 attempted steps exceeds maxNumSteps, the integration is
+     *                 aborted. The final state, the cost and all sensitivities
+     *                 are then set to NaN, like a diverging fixed step
+     *                 integration would propagate them.
+     *
+     * @param[in, out] state            The initial state for integration
+     * @param[in]      startTime        The start time
+     * @param[in]      endTime          The end time
+     * @param[in]      dtInitial        The initial integration timestep
+     * @param[in]      absErrTol        The absolute error tolerance
+     * @param[in]      relErrTol        The relative error tolerance
+     * @param[out]     stateTrajectory  The output state trajectory at the accepted steps
+     * @param[out]     timeTrajectory   The output time trajectory at the accepted steps
+     * @param[in]      maxNumSteps      The maximum number of attempted steps
+     *
+     * @return         True if the integration reached the end time
+     */
+    bool integrateAdaptive(state_vector& state,
+        const SCALAR startTime,
+        const SCALAR endTime,
+        const SCALAR dtInitial,
+        const SCALAR absErrTol,
+        const SCALAR relErrTol,
+        ct::core::StateVectorArray<STATE_DIM, SCALAR>& stateTrajectory,
+        ct::core::tpl::TimeArray<SCALAR>& timeTrajectory,
+        const size_t maxNumSteps = 100000)
+    {
+        if (!stepperStateAdaptive_)
+            throw std::runtime_error("Adaptive integration requires the RK5VARIABLE stepper");
+
+        clearStates();
+        clearLinearization();
+        stepSizes_.clear();
+        adaptiveFailed_ = false;
+        cacheData_ = true;
+        stateTrajectory.clear();
+        timeTrajectory.clear();
         SCALAR time = startTime;
-        for (size_t i = 0; i < numSteps; ++i)
+        stateTrajectory.push_back(state);
+        timeTrajectory.push_back(time);
+
+        const SCALAR minStep = std::numeric_limits<SCALAR>::epsilon() * std::max(SCALAR(1.0), std::abs(endTime));
+        SCALAR dt = dtInitial;
+        state_vector stateNew;
+        state_vector error;
+
+        stepperStateAdaptive_->init_embedded(xDot_, state, time);
+        size_t numSteps = 0;
+        while (endTime - time > minStep)
         {
-            stepperState_->do_step(xDot_, state, time, dt);
-            time += dt;
+            dt = std::min(dt, endTime - time);
+
+            const size_t nCached = statesCached_.size();
+            stepperStateAdaptive_->do_step_embedded(xDot_, state, stateNew, error, time, dt);
+
+            const SCALAR errorNorm =
+                (error.array().abs() /
+                    (absErrTol + relErrTol * state.array().abs().max(stateNew.array().abs()))).maxCoeff();
+
+            // a non-finite error would be rejected with a growing step forever
+            if (!std::isfinite(errorNorm) || ++numSteps > maxNumSteps)
+            {
+                clearStates();
+                stepSizes_.clear();
+                adaptiveFailed_ = true;
+                state.setConstant(std::numeric_limits<SCALAR>::quiet_NaN());
+                stateTrajectory.push_back(state);
+                timeTrajectory.push_back(endTime);
+                return false;
+            }
+
+            // standard step size control for a 5th order scheme, bounded to avoid oscillating step sizes
+            const SCALAR scaling = (errorNorm > SCALAR(0.0))
+                                       ? SCALAR(0.9) * std::pow(errorNorm, SCALAR(-0.2))
+                                       : SCALAR(5.0);
+
+            if (errorNorm <= SCALAR(1.0) || dt <= minStep)
+            {
+                stepperStateAdaptive_->accept_step();
+                state = stateNew;
+                time += dt;
+                stepSizes_.push_back(dt);
+                stateTrajectory.push_back(state);
+                timeTrajectory.push_back(time);
+                dt *= std::min(SCALAR(5.0), std::max(SCALAR(1.0), scaling));
+            }
+            else
+            {
+                // the first stage stays valid, drop the stages of the rejected step
+                statesCached_.resize(nCached);
+                controlsCached_.resize(nCached);
+                timesCached_.resize(nCached);
+                dt = std::max(minStep, dt * std::max(SCALAR(0.2), scaling));
+            }
         }
+
+        // the last stage is evaluated at the end of the shot and is not part of any step
+        statesCached_.pop_back();
+        controlsCached_.pop_back();
+        timesCached_.pop_back();
+        return true;
     }
 
 
@@ -282,13 +415,8 @@ public:
     void integrateSensitivityDX0(state_matrix& dX0, const SCALAR startTime, const size_t numSteps, const SCALAR dt)
     {
         dX0Index_ = 0;
-        SCALAR time = startTime;
         dX0.setIdentity();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperDX0_->do_step(dX0dot_, dX0, time, dt);
-            time += dt;
-        }
+        integrateSteps(stepperDX0_, dX0dot_, dX0, startTime, numSteps, dt);
     }
 
     /**
@@ -306,13 +434,8 @@ public:
         const SCALAR dt)
     {
         dU0Index_ = 0;
-        SCALAR time = startTime;
         dU0.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperDU0_->do_step(dU0dot_, dU0, time, dt);
-            time += dt;
-        }
+        integrateSteps(stepperDU0_, dU0dot_, dU0, startTime, numSteps, dt);
     }
 
     /**
@@ -330,13 +453,8 @@ public:
         const SCALAR dt)
     {
         dU0Index_ = 0;
-        SCALAR time = startTime;
         dUf.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperDU0_->do_step(dUfdot_, dUf, time, dt);
-            time += dt;
-        }
+        integrateSteps(stepperDU0_, dUfdot_, dUf, startTime, numSteps, dt);
     }
 
     /**
@@ -350,16 +468,11 @@ public:
      */
     void integrateCost(SCALAR& cost, const SCALAR startTime, const size_t numSteps, const SCALAR dt)
     {
-        SCALAR time = startTime;
         costIndex_ = 0;
-        if (statesCached_.size() == 0 || controlsCached_.size() == 0 || timesCached_.size() == 0)
+        if (!adaptiveFailed_ && (statesCached_.size() == 0 || controlsCached_.size() == 0 || timesCached_.size() == 0))
             throw std::runtime_error("States cached are empty");
 
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperCost_->do_step(costDot_, cost, time, dt);
-            time += dt;
-        }
+        integrateSteps<SCALAR>(stepperCost_, costDot_, cost, startTime, numSteps, dt);
     }
 
 
@@ -375,13 +488,8 @@ public:
     void integrateCostSensitivityDX0(state_vector& dX0, const SCALAR startTime, const size_t numSteps, const SCALAR dt)
     {
         costIndex_ = 0;
-        SCALAR time = startTime;
         dX0.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperCostDX0_->do_step(costdX0dot_, dX0, time, dt);
-            time += dt;
-        }
+        integrateSteps(stepperCostDX0_, costdX0dot_, dX0, startTime, numSteps, dt);
     }
 
     /**
@@ -399,13 +507,8 @@ public:
         const SCALAR dt)
     {
         costIndex_ = 0;
-        SCALAR time = startTime;
         dU0.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperCostDU0_->do_step(costdU0dot_, dU0, time, dt);
-            time += dt;
-        }
+        integrateSteps(stepperCostDU0_, costdU0dot_, dU0, startTime, numSteps, dt);
     }
 
     /**
@@ -423,13 +526,8 @@ public:
         const SCALAR dt)
     {
         costIndex_ = 0;
-        SCALAR time = startTime;
         dUf.setZero();
-        for (size_t i = 0; i < numSteps; ++i)
-        {
-            stepperCostDU0_->do_step(costdUfdot_, dUf, time, dt);
-            time += dt;
-        }
+        integrateSteps(stepperCostDU0_, costdUfdot_, dUf, startTime, numSteps, dt);
     }
 
     /**
@@ -478,6 +576,42 @@ public:
     }
 
 private:
+    /**
+     * @brief      Integrates the sensitivity or cost ODE along the steps of the
+     *             last state integration
+     */
+    template <typename MATRIX>
+    void integrateSteps(const std::shared_ptr<ct::core::internal::StepperCTBase<MATRIX, SCALAR>>& stepper,
+        const std::function<void(const MATRIX&, MATRIX&, const SCALAR)>& rhs,
+        MATRIX& stateInOut,
+        const SCALAR startTime,
+        const size_t numSteps,
+        const SCALAR dt)
+    {
+        if (adaptiveFailed_)
+        {
+            stateInOut = stateInOut * std::numeric_limits<SCALAR>::quiet_NaN();
+            return;
+        }
+
+        SCALAR time = startTime;
+        if (!stepSizes_.empty())
+        {
+            for (const SCALAR step : stepSizes_)
+            {
+                stepper->do_step(rhs, stateInOut, time, step);
+                time += step;
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < numSteps; ++i)
+        {
+            stepper->do_step(rhs, stateInOut, time, dt);
+            time += dt;
+        }
+    }
+
     std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> controlledSystem_;
     std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem_;
     std::shared_ptr<optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFunction_;
@@ -508,6 +642,7 @@ private:
     ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> arraydUf_;
 
     std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>> stepperState_;
+    std::shared_ptr<ct::core::internal::StepperDormandPrinceCT<state_vector, SCALAR>> stepperStateAdaptive_;
     std::shared_ptr<ct::core::internal::StepperCTBase<state_matrix, SCALAR>> stepperDX0_;
     std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>> stepperDU0_;
 
@@ -515,6 +650,9 @@ private:
     std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>> stepperCostDX0_;
     std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>> stepperCostDU0_;
 
+    std::vector<SCALAR> stepSizes_;  // the accepted steps of the last adaptive integration, empty for fixed steps
+    bool adaptiveFailed_;            // whether the last adaptive integration was aborted
+
     size_t costIndex_;
     size_t dX0Index_;
     size_t dU0Index_;
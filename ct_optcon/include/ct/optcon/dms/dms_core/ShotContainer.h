@@ -7,6 +7,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <cmath>
 #include <functional>
+#include <limits>
 
 #include "SensitivityIntegratorCT.h"
 
@@ -111,7 +112,11 @@ public:
             }
             case DmsSettings::RK5:
             {
-                throw std::runtime_error("Currently we do not support adaptive integrators in dms");
+                integratorCT_ = std::allocate_shared<SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>,
+                    Eigen::aligned_allocator<SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>>>(
+                    Eigen::aligned_allocator<SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>>(),
+                    controlledSystem_, core::RK5VARIABLE);
+                break;
             }
 
             default:
@@ -122,7 +127,7 @@ public:
         }
 
         tStart_ = timeGrid_->getShotStartTime(shotNr_);
-        // SCALAR t_shot_end = timeGrid_->getShotEndTime(shotNr_);
+        tEnd_ = timeGrid_->getShotEndTime(shotNr_);
 
         // +0.5 needed to avoid rounding errors from double to size_t
         nSteps_ = nIntegrationSteps;
@@ -135,24 +140,34 @@ public:
     }
 
     /**
-	 * @brief      Performs the state integration between the shots
+	 * @brief      Performs the state integration between the shots. The
+	 *             integration is skipped as long as the state and control
+	 *             variables of this shot do not change, see
+	 *             OptVectorDms::updateShotVersions()
 	 */
     void integrateShot()
     {
-        if ((w_->getUpdateCount() != integrationCount_))
+        if ((w_->getShotVersion(shotNr_) != integrationCount_))
         {
-            integrationCount_ = w_->getUpdateCount();
+            integrationCount_ = w_->getShotVersion(shotNr_);
+            reset();
             state_vector_t initState = w_->getOptimizedState(shotNr_);
-            integratorCT_->integrate(
-                initState, tStart_, nSteps_, SCALAR(settings_.dt_sim_), stateSubsteps_, timeSubsteps_);
+
+            // the sensitivity and cost integrations follow the steps chosen here
+            if (settings_.integrationType_ == DmsSettings::RK5)
+                integratorCT_->integrateAdaptive(initState, tStart_, tEnd_, SCALAR(settings_.dt_sim_),
+                    SCALAR(settings_.absErrTol_), SCALAR(settings_.relErrTol_), stateSubsteps_, timeSubsteps_);
+            else
+                integratorCT_->integrate(
+                    initState, tStart_, nSteps_, SCALAR(settings_.dt_sim_), stateSubsteps_, timeSubsteps_);
         }
     }
 
     void integrateCost()
     {
-        if ((w_->getUpdateCount() != costIntegrationCount_))
+        if ((w_->getShotVersion(shotNr_) != costIntegrationCount_))
         {
-            costIntegrationCount_ = w_->getUpdateCount();
+            costIntegrationCount_ = w_->getShotVersion(shotNr_);
             integrateShot();
             cost_ = SCALAR(0.0);
             integratorCT_->integrateCost(cost_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
@@ -164,9 +179,9 @@ public:
 	 */
     void integrateSensitivities()
     {
-        if ((w_->getUpdateCount() != sensIntegrationCount_))
+        if ((w_->getShotVersion(shotNr_) != sensIntegrationCount_))
         {
-            sensIntegrationCount_ = w_->getUpdateCount();
+            sensIntegrationCount_ = w_->getShotVersion(shotNr_);
             integrateShot();
             discreteA_.setIdentity();
             discreteB_.setZero();
@@ -184,9 +199,9 @@ public:
 
     void integrateCostSensitivities()
     {
-        if ((w_->getUpdateCount() != costSensIntegrationCount_))
+        if ((w_->getShotVersion(shotNr_) != costSensIntegrationCount_))
         {
-            costSensIntegrationCount_ = w_->getUpdateCount();
+            costSensIntegrationCount_ = w_->getShotVersion(shotNr_);
             integrateSensitivities();
             discreteQ_.setZero();
             discreteR_.setZero();
@@ -353,6 +368,7 @@ private:
     std::shared_ptr<SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>> integratorCT_;
     size_t nSteps_;
     SCALAR tStart_;
+    SCALAR tEnd_;
 };
 
 }  // namespace optcon
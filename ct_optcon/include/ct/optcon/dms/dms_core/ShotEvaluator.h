@@ -0,0 +1,136 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/core/common/TaskPool.h>
+
+#include <ct/optcon/dms/dms_core/DmsSettings.h>
+#include <ct/optcon/dms/dms_core/ShotContainer.h>
+#include <ct/optcon/dms/constraints/ContinuityConstraint.h>
+
+namespace ct {
+namespace optcon {
+
+/**
+ * @ingroup    DMS
+ *
+ * @brief      Evaluates all shots of the DMS problem on a persistent thread
+ *             pool
+ *
+ *             Every shot is evaluated by a single task, which runs all
+ *             integrations the shot needs in the order of their dependencies:
+ *             the state integration, the cost integration, the sensitivity
+ *             integration and the cost sensitivity integration, followed by
+ *             the evaluation of the continuity constraint of the shot or its
+ *             Jacobian. The cost integrations, which yield the cost gradient
+ *             of the shot, are fused with the state and sensitivity
+ *             integrations whenever the cost is evaluated on the shots, such
+ *             that the cost and constraint callbacks of the NLP solver at the
+ *             same iterate share one pass over the shots. Results of shots
+ *             whose variables did not change are reused, see ShotContainer.
+ *
+ * @tparam     STATE_DIM    The state dimension
+ * @tparam     CONTROL_DIM  The control dimension
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class ShotEvaluator
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR> ShotContainer_t;
+    typedef ContinuityConstraint<STATE_DIM, CONTROL_DIM, SCALAR> ContinuityConstraint_t;
+
+    ShotEvaluator() = delete;
+
+    /**
+	 * @brief      Custom constructor
+	 *
+	 * @param[in]  shotContainers  The shot containers
+	 * @param[in]  settings        The dms settings, the calling thread counts
+	 *                             towards the number of threads, hence it
+	 *                             has to be at least one
+	 */
+    ShotEvaluator(const std::vector<std::shared_ptr<ShotContainer_t>>& shotContainers, const DmsSettings& settings)
+        : shotContainers_(shotContainers), integrateCost_(settings.costEvaluationType_ == DmsSettings::FULL)
+    {
+        if (settings.nThreads_ < 1)
+            throw std::runtime_error("ShotEvaluator: the number of threads has to be at least one");
+
+        taskPool_ = std::shared_ptr<ct::core::TaskPool>(new ct::core::TaskPool(settings.nThreads_ - 1));
+    }
+
+    /**
+	 * @brief      Integrates the states, and the cost if it is evaluated on the
+	 *             shots
+	 */
+    void evaluate() { evaluateShots(false); }
+    /**
+	 * @brief      Integrates the states and the sensitivities, and the cost and
+	 *             the cost sensitivities if the cost is evaluated on the shots
+	 */
+    void evaluateSensitivities() { evaluateShots(true); }
+    /**
+	 * @brief      Sets the continuity constraints, which get evaluated in the
+	 *             tasks of their shots
+	 *
+	 * @param[in]  continuityConstraints  One continuity constraint per shot
+	 */
+    void setContinuityConstraints(const std::vector<std::shared_ptr<ContinuityConstraint_t>>& continuityConstraints)
+    {
+        if (continuityConstraints.size() != shotContainers_.size())
+            throw std::runtime_error("ShotEvaluator: there has to be one continuity constraint per shot");
+
+        continuityConstraints_ = continuityConstraints;
+    }
+    /**
+	 * @brief      Returns the shot containers
+	 *
+	 * @return     The shot containers
+	 */
+    const std::vector<std::shared_ptr<ShotContainer_t>>& getShotContainers() const { return shotContainers_; }
+private:
+    void evaluateShots(const bool sensitivities)
+    {
+        if (shotContainers_.empty())
+            return;
+
+        // one chunk per shot, the shot durations may vary a lot with adaptive integration
+        taskPool_->parallelFor(0, shotContainers_.size() - 1,
+            [&](size_t threadId, size_t shotNr) {
+                ShotContainer_t& shot = *shotContainers_[shotNr];
+
+                shot.integrateShot();
+                if (integrateCost_)
+                    shot.integrateCost();
+
+                if (sensitivities)
+                {
+                    shot.integrateSensitivities();
+                    if (integrateCost_)
+                        shot.integrateCostSensitivities();
+                }
+
+                if (!continuityConstraints_.empty())
+                {
+                    if (sensitivities)
+                        continuityConstraints_[shotNr]->updateJacobian();
+                    else
+                        continuityConstraints_[shotNr]->update();
+                }
+            },
+            1);
+    }
+
+    std::vector<std::shared_ptr<ShotContainer_t>> shotContainers_;
+    std::vector<std::shared_ptr<ContinuityConstraint_t>> continuityConstraints_;
+    const bool integrateCost_;
+
+    std::shared_ptr<ct::core::TaskPool> taskPool_;
+};
+
+}  // namespace optcon
+}  // namespace ct
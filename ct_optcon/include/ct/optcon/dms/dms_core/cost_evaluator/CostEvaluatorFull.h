@@ -5,7 +5,6 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
-#include <omp.h>
 #include <math.h>
 #include <cmath>
 #include <functional>
@@ -14,6 +13,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/optcon/dms/dms_core/OptVectorDms.h>
 #include <ct/optcon/dms/dms_core/ShotContainer.h>
+#include <ct/optcon/dms/dms_core/ShotEvaluator.h>
 #include <ct/optcon/nlp/DiscreteCostEvaluatorBase.h>
 
 
@@ -50,15 +50,20 @@ public:
 	 * @param[in]  costFct         The cost function
 	 * @param[in]  w               The optimization vector
 	 * @param[in]  controlSpliner  The control spliner
-	 * @param[in]  shotInt         The shot number
+	 * @param[in]  shotEvaluator   The evaluator of the shots
 	 * @param[in]  settings        The dms settings
 	 */
     CostEvaluatorFull(std::shared_ptr<ct::optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFct,
         std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w,
         std::shared_ptr<SplinerBase<control_vector_t, SCALAR>> controlSpliner,
-        std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotInt,
+        std::shared_ptr<ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>> shotEvaluator,
         DmsSettings settings)
-        : costFct_(costFct), w_(w), controlSpliner_(controlSpliner), shotContainers_(shotInt), settings_(settings)
+        : costFct_(costFct),
+          w_(w),
+          controlSpliner_(controlSpliner),
+          shotEvaluator_(shotEvaluator),
+          shotContainers_(shotEvaluator->getShotContainers()),
+          settings_(settings)
     {
     }
 
@@ -71,11 +76,8 @@ public:
     {
         SCALAR cost = SCALAR(0.0);
 
-#pragma omp parallel for num_threads(settings_.nThreads_)
-        for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
-        {
-            (*shotContainer)->integrateCost();
-        }
+        // no-op if the constraints were evaluated at the same iterate
+        shotEvaluator_->evaluate();
 
         for (auto shotContainer : shotContainers_)
             cost += shotContainer->getCostIntegrated();
@@ -91,13 +93,9 @@ public:
 
         assert(shotContainers_.size() == settings_.N_);
 
-// go through all shots, integrate the state trajectories and evaluate cost accordingly
-// intermediate costs
-#pragma omp parallel for num_threads(settings_.nThreads_)
-        for (auto shotContainer = shotContainers_.begin(); shotContainer < shotContainers_.end(); ++shotContainer)
-        {
-            (*shotContainer)->integrateCostSensitivities();
-        }
+        // the cost gradients of the shots are integrated by the tasks of the shots. Only the assembly remains, which
+        // is sequential since neighbouring shots contribute to the same controls.
+        shotEvaluator_->evaluateSensitivities();
 
         for (size_t shotNr = 0; shotNr < shotContainers_.size(); ++shotNr)
         {
@@ -143,6 +141,7 @@ private:
     std::shared_ptr<ct::optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFct_;
     std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w_;
     std::shared_ptr<SplinerBase<control_vector_t, SCALAR>> controlSpliner_;
+    std::shared_ptr<ShotEvaluator<STATE_DIM, CONTROL_DIM, SCALAR>> shotEvaluator_;
     std::vector<std::shared_ptr<ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>>> shotContainers_;
 
     const DmsSettings settings_;
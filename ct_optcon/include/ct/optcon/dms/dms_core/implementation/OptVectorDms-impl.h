@@ -22,6 +22,8 @@ OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::OptVectorDms(size_t n, const DmsSe
     }
     stateSolution_.resize(numPairs_);
     inputSolution_.resize(numPairs_);
+    shotVersions_.assign(settings_.N_, 1);
+    pairChanged_.resize(numPairs_);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -75,6 +77,41 @@ size_t OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getControlIndex(const size_
     return pairNumToControlIdx_.find(pairNum)->second;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::updateShotVersions()
+{
+    if (xPrevious_.size() != this->x_.size())
+    {
+        for (size_t shotNr = 0; shotNr < shotVersions_.size(); shotNr++)
+            shotVersions_[shotNr]++;
+
+        xPrevious_ = this->x_;
+        return;
+    }
+
+    // exact comparison, any bit change of s_i or q_i invalidates shot i
+    for (size_t i = 0; i < numPairs_; i++)
+    {
+        const size_t s_index = getStateIndex(i);
+        const size_t q_index = getControlIndex(i);
+        pairChanged_[i] = this->x_.segment(s_index, STATE_DIM) != xPrevious_.segment(s_index, STATE_DIM) ||
+                          this->x_.segment(q_index, CONTROL_DIM) != xPrevious_.segment(q_index, CONTROL_DIM);
+    }
+
+    for (size_t shotNr = 0; shotNr < shotVersions_.size(); shotNr++)
+    {
+        // with linear splines, the control trajectory of shot i also depends on q_{i+1}
+        const bool nextControlChanged = settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR &&
+                                        this->x_.segment(getControlIndex(shotNr + 1), CONTROL_DIM) !=
+                                            xPrevious_.segment(getControlIndex(shotNr + 1), CONTROL_DIM);
+
+        if (pairChanged_[shotNr] || nextControlChanged)
+            shotVersions_[shotNr]++;
+    }
+
+    xPrevious_ = this->x_;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::changeInitialState(const state_vector_t& x0)
 {
@@ -18,13 +18,54 @@ CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::CTSystemModel(
       constantController_(new ct::core::ConstantController<STATE_DIM, CONTROL_DIM, SCALAR>()),
       sensApprox_(sensApprox),
       dFdv_(dFdv),
-      integrator_(system_, intType)
+      integrator_(system_, intType),
+      intType_(intType)
 {
     if (!system_)
         throw std::runtime_error("CTSystemModel: System not initialized!");
 
     // hand over constant controller for dynamics evaluation with known control inputs to the system.
     system_->setController(constantController_);
+
+    setNumThreads(1);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::CTSystemModel(
+    std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> system,
+    std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem,
+    const state_matrix_t& dFdv,
+    const ct::core::IntegrationType& intType)
+    : system_(system),
+      constantController_(new ct::core::ConstantController<STATE_DIM, CONTROL_DIM, SCALAR>()),
+      linearSystem_(linearSystem),
+      dFdv_(dFdv),
+      integrator_(system_, intType),
+      intType_(intType)
+{
+    if (!system_)
+        throw std::runtime_error("CTSystemModel: System not initialized!");
+    if (!linearSystem_)
+        throw std::runtime_error("CTSystemModel: Linear system not initialized!");
+
+    switch (intType)
+    {
+        case ct::core::IntegrationType::EULERCT:
+            augmentedStepper_ = std::shared_ptr<ct::core::internal::StepperCTBase<augmented_state_t, SCALAR>>(
+                new ct::core::internal::StepperEulerCT<augmented_state_t, SCALAR>());
+            break;
+        case ct::core::IntegrationType::RK4CT:
+            augmentedStepper_ = std::shared_ptr<ct::core::internal::StepperCTBase<augmented_state_t, SCALAR>>(
+                new ct::core::internal::StepperRK4CT<augmented_state_t, SCALAR>());
+            break;
+        default:
+            throw std::runtime_error("CTSystemModel: Integration of the derivative requires EULERCT or RK4CT.");
+    }
+
+    // hand over constant controller for dynamics evaluation with known control inputs to the system.
+    system_->setController(constantController_);
+
+    setNumThreads(1);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -39,6 +80,73 @@ auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDynamics(const state_
     return x;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDynamicsBatch(
+    ct::core::StateVectorBatch<STATE_DIM, SCALAR>& states,
+    const control_vector_t& u,
+    const Time_t dt,
+    Time_t t)
+{
+    if (batchIntegrators_.empty())
+        return Base::computeDynamicsBatch(states, u, dt, t);
+
+    for (auto& controller : batchControllers_)
+        controller->setControl(u);
+
+    const size_t batchSize = states.cols();
+    const size_t nChunks = std::min(batchIntegrators_.size(), batchSize);
+
+    if (nChunks <= 1)
+    {
+        batchIntegrators_[0]->integrate_n_steps(states, t, 1, dt);
+        return;
+    }
+
+    // every chunk is integrated by its own integrator and system, the chunks write to disjoint columns
+    taskPool_->parallelFor(0, nChunks - 1,
+        [&](size_t threadId, size_t chunk) {
+            const size_t first = chunk * batchSize / nChunks;
+            const size_t size = (chunk + 1) * batchSize / nChunks - first;
+
+            batchChunks_[chunk] = states.middleCols(first, size);
+            batchIntegrators_[chunk]->integrate_n_steps(batchChunks_[chunk], t, 1, dt);
+            states.middleCols(first, size) = batchChunks_[chunk];
+        },
+        1);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::setNumThreads(const size_t nThreads)
+{
+    if (nThreads < 1)
+        throw std::runtime_error("CTSystemModel: Number of threads must be at least one.");
+
+    batchIntegrators_.clear();
+    batchControllers_.clear();
+
+    // IntegratorBatch only provides fixed-step integration
+    if (intType_ != ct::core::IntegrationType::EULERCT && intType_ != ct::core::IntegrationType::RK4CT)
+        return;
+
+    for (size_t i = 0; i < nThreads; ++i)
+    {
+        std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> system = system_;
+        std::shared_ptr<ct::core::ConstantController<STATE_DIM, CONTROL_DIM, SCALAR>> controller = constantController_;
+        if (i > 0)
+        {
+            system.reset(system_->clone());
+            controller.reset(new ct::core::ConstantController<STATE_DIM, CONTROL_DIM, SCALAR>());
+            system->setController(controller);
+        }
+
+        batchIntegrators_.emplace_back(new ct::core::IntegratorBatch<STATE_DIM, SCALAR>(system, intType_));
+        batchControllers_.push_back(controller);
+    }
+
+    batchChunks_.resize(nThreads);
+    taskPool_.reset(new ct::core::TaskPool(nThreads - 1));
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDerivativeState(const state_vector_t& state,
     const control_vector_t& u,
@@ -47,6 +155,13 @@ auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDerivativeState(const
 {
     // local vars
     state_matrix_t A;
+
+    if (linearSystem_)
+    {
+        computeDynamicsAndDerivativeState(state, u, dt, t, A);
+        return A;
+    }
+
     ct::core::StateControlMatrix<STATE_DIM, CONTROL_DIM, SCALAR> Btemp;
 
     sensApprox_->setTimeDiscretization(dt);
@@ -55,6 +170,38 @@ auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDerivativeState(const
     return A;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDynamicsAndDerivativeState(const state_vector_t& state,
+    const control_vector_t& u,
+    const Time_t dt,
+    Time_t t,
+    state_matrix_t& dFdx) -> state_vector_t
+{
+    if (!linearSystem_)
+        return Base::computeDynamicsAndDerivativeState(state, u, dt, t, dFdx);
+
+    constantController_->setControl(u);
+
+    // every stage evaluates the dynamics and the linearization at the same state
+    auto augmentedDynamics = [this, &u](const augmented_state_t& xPhi, augmented_state_t& xPhiDot, const SCALAR time) {
+        const state_vector_t x = xPhi.col(0);
+        state_vector_t dxdt;
+        system_->computeDynamics(x, time, dxdt);
+        xPhiDot.col(0) = dxdt;
+        xPhiDot.template rightCols<STATE_DIM>() =
+            linearSystem_->getDerivativeState(x, u, time) * xPhi.template rightCols<STATE_DIM>();
+    };
+
+    augmented_state_t xPhi;
+    xPhi.col(0) = state;
+    xPhi.template rightCols<STATE_DIM>().setIdentity();
+
+    augmentedStepper_->integrate_n_steps(augmentedDynamics, xPhi, t, 1, dt);
+
+    dFdx = xPhi.template rightCols<STATE_DIM>();
+    return xPhi.col(0);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDerivativeNoise(const state_vector_t& state,
     const control_vector_t& control,
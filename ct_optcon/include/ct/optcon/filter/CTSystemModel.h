@@ -43,18 +43,54 @@ public:
         const state_matrix_t& dFdv,
         const ct::core::IntegrationType& intType = ct::core::IntegrationType::EULERCT);
 
+    /*!
+     * \brief Constructor for a system model which integrates the state and the state transition matrix in one pass.
+     *
+     * The variational equation \f$ \dot{\Phi} = A(x, u, t) \Phi \f$ is integrated alongside the state, with the same
+     * stepper and at the same stage points, such that the derivative w.r.t. state is the exact derivative of the
+     * integration step. Any linear system can provide \f$ A \f$, e.g. an auto-diff code-generated linearizer.
+     */
+    CTSystemModel(std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> system,
+        std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem,
+        const state_matrix_t& dFdv,
+        const ct::core::IntegrationType& intType = ct::core::IntegrationType::EULERCT);
+
     //! Propagates the system giving the next state as output. Control input is generated by the system controller.
     state_vector_t computeDynamics(const state_vector_t& state,
         const control_vector_t& u,
         const Time_t dt,
         Time_t t) override;
 
+    /*!
+     * \brief Propagates a batch of states in a single integration with IntegratorBatch, split into one chunk per
+     *        thread. Falls back to integrating every state separately for integration types other than EULERCT and
+     *        RK4CT.
+     */
+    void computeDynamicsBatch(ct::core::StateVectorBatch<STATE_DIM, SCALAR>& states,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override;
+
+    /*!
+     * \brief Sets the number of threads for the propagation of batches, including the calling thread. Every
+     *        additional thread integrates a clone of the system, hence changes to the system after this call are not
+     *        reflected in the clones.
+     */
+    void setNumThreads(const size_t nThreads);
+
     //! Computes the derivative w.r.t state. Control input is generated by the system controller.
     state_matrix_t computeDerivativeState(const state_vector_t& state,
         const control_vector_t& u,
         const Time_t dt,
         Time_t t) override;
 
+    //! Propagates the system and computes the derivative w.r.t. state, in a single integration if possible.
+    state_vector_t computeDynamicsAndDerivativeState(const state_vector_t& state,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t,
+        state_matrix_t& dFdx) override;
+
     //! Computes the derivative w.r.t noise. Control input is generated by the system controller.
     state_matrix_t computeDerivativeNoise(const state_vector_t& state,
         const control_vector_t& control,
@@ -71,11 +107,35 @@ protected:
     //! The sensitivity approximator
     std::shared_ptr<SensitivityApprox_t> sensApprox_;
 
+    //! state and state transition matrix, integrated together
+    using augmented_state_t = Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM + 1>;
+
+    //! The linear system for the integration of the state transition matrix, if set
+    std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem_;
+
+    //! The stepper for the state and the state transition matrix
+    std::shared_ptr<ct::core::internal::StepperCTBase<augmented_state_t, SCALAR>> augmentedStepper_;
+
     //! Derivative w.r.t. noise.
     state_matrix_t dFdv_;
 
     //! Integrator.
     ct::core::Integrator<STATE_DIM, SCALAR> integrator_;
+
+    //! Integration type.
+    ct::core::IntegrationType intType_;
+
+    //! Batch integrators, one per thread. The first one integrates the system itself, the others integrate clones.
+    std::vector<std::shared_ptr<ct::core::IntegratorBatch<STATE_DIM, SCALAR>>> batchIntegrators_;
+
+    //! The constant controllers of the systems integrated by the batch integrators
+    std::vector<std::shared_ptr<ct::core::ConstantController<STATE_DIM, CONTROL_DIM, SCALAR>>> batchControllers_;
+
+    //! The chunks of a batch, one per thread
+    std::vector<ct::core::StateVectorBatch<STATE_DIM, SCALAR>> batchChunks_;
+
+    //! Thread pool for the propagation of batches
+    std::shared_ptr<ct::core::TaskPool> taskPool_;
 };
 
 }  // namespace optcon
@@ -34,19 +34,17 @@ auto ExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::predict(c
     const ct::core::Time& dt,
     const ct::core::Time& t) -> const state_vector_t&
 {
-    // STEP 1 - compute covariance matrix prediction
+    // STEP 1 - compute state prediction (based on last state esimate but current control input)
 
     // the system is linearized at the current control input, but using the state estimate from the previous timestep.
-    state_matrix_t dFdx = this->f_->computeDerivativeState(this->x_est_, u, dt, t);
+    // System models which propagate the state transition matrix along with the state do both in a single integration.
+    state_matrix_t dFdx;
     state_matrix_t dFdv = this->f_->computeDerivativeNoise(this->x_est_, u, dt, t);
+    this->x_est_ = this->f_->computeDynamicsAndDerivativeState(this->x_est_, u, dt, t, dFdx);
 
-    // compute covariance update
+    // STEP 2 - compute covariance matrix prediction
     P_ = (dFdx * P_ * dFdx.transpose()) + dFdv * (dt * Q_) * dFdv.transpose();
 
-    // STEP 2 - compute state prediction (based on last state esimate but current control input)
-
-    this->x_est_ = this->f_->computeDynamics(this->x_est_, u, dt, t);
-
     return this->x_est_;
 }
 
@@ -0,0 +1,226 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SquareRootUnscentedKalmanFilter(
+    std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+    std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+    const state_vector_t& x0,
+    SCALAR alpha,
+    SCALAR beta,
+    SCALAR kappa,
+    const ct::core::StateMatrix<STATE_DIM, SCALAR>& P0)
+    : Base(f, h, x0), S_(P0), alpha_(alpha), beta_(beta), kappa_(kappa)
+{
+    if (S_.info() != Eigen::Success)
+        throw std::runtime_error("SquareRootUnscentedKalmanFilter : Initial covariance is not positive definite.");
+
+    // the noise square roots are computed on first use
+    Q_.setConstant(std::numeric_limits<SCALAR>::quiet_NaN());
+    R_.setConstant(std::numeric_limits<SCALAR>::quiet_NaN());
+
+    computeWeights();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SquareRootUnscentedKalmanFilter(
+    std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+    std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+    const UnscentedKalmanFilterSettings<STATE_DIM, SCALAR>& ukf_settings)
+    : SquareRootUnscentedKalmanFilter(f,
+          h,
+          ukf_settings.x0,
+          ukf_settings.alpha,
+          ukf_settings.beta,
+          ukf_settings.kappa,
+          ukf_settings.P0)
+{
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::predict(const control_vector_t& u,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    computeSigmaPoints();
+
+    // Pass all sigma points through the non-linear state transition function at once
+    sigmaStateBatch_ = sigmaStatePoints_;
+    this->f_->computeDynamicsBatch(sigmaStateBatch_, u, dt, t);
+    sigmaStatePoints_ = sigmaStateBatch_;
+
+    this->x_est_ = sigmaStatePoints_ * sigmaWeights_m_;
+
+    // The noise is usually constant, hence its square root is only recomputed on change
+    const state_matrix_t Q = this->f_->computeDerivativeNoise(this->x_est_, u, dt, t);
+    if ((Q.array() != Q_.array()).any())
+    {
+        Q_ = Q;
+        computeNoiseSquareRoot<STATE_DIM>(Q_, Q_sqrt_);
+    }
+
+    if (!computeCovarianceSquareRoot<STATE_DIM>(this->x_est_, sigmaStatePoints_, Q_sqrt_, S_))
+        throw std::runtime_error("SquareRootUnscentedKalmanFilter : Numerical error.");
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::update(const output_vector_t& z,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    // Predict measurements for each sigma point
+    SigmaPoints<OUTPUT_DIM> sigmaMeasurementPoints;
+    for (size_t i = 0; i < SigmaPointCount; ++i)
+        sigmaMeasurementPoints.col(i) = this->h_->computeMeasurement(sigmaStatePoints_.col(i), t);
+
+    const ct::core::OutputVector<OUTPUT_DIM, SCALAR> y = sigmaMeasurementPoints * sigmaWeights_m_;
+
+    const Covariance<OUTPUT_DIM> R = this->h_->computeDerivativeNoise(this->x_est_, t);
+    if ((R.array() != R_.array()).any())
+    {
+        R_ = R;
+        computeNoiseSquareRoot<OUTPUT_DIM>(R_, R_sqrt_);
+    }
+
+    // Square root of the innovation covariance
+    CovarianceSquareRoot<OUTPUT_DIM> S_yy;
+    if (!computeCovarianceSquareRoot<OUTPUT_DIM>(y, sigmaMeasurementPoints, R_sqrt_, S_yy))
+        throw std::runtime_error("SquareRootUnscentedKalmanFilter : Numerical error.");
+
+    const Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> P_xy = (sigmaStatePoints_.colwise() - this->x_est_) *
+                                                              sigmaWeights_c_.asDiagonal() *
+                                                              (sigmaMeasurementPoints.colwise() - y).transpose();
+
+    // K = P_xy (S_yy S_yy^T)^-1 by two triangular solves
+    const Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> K = S_yy.solve(P_xy.transpose()).transpose();
+
+    // Update state
+    this->x_est_ += K * (z - y);
+
+    // Update state covariance, P -= (K S_yy) (K S_yy)^T by successive rank-1 downdates
+    const Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> U = K * S_yy.matrixL();
+    for (size_t i = 0; i < OUTPUT_DIM; ++i)
+    {
+        S_.rankUpdate(U.col(i), SCALAR(-1.0));
+        if (S_.info() != Eigen::Success)
+            throw std::runtime_error("SquareRootUnscentedKalmanFilter : Numerical error.");
+    }
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getCovariance() const
+    -> state_matrix_t
+{
+    return S_.reconstructedMatrix();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getCovarianceSquareRoot() const
+    -> const CovarianceSquareRoot<STATE_DIM>&
+{
+    return S_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeSigmaPoints()
+{
+    const Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM> _S = S_.matrixL().toDenseMatrix();
+
+    // Set left "block" (first column)
+    sigmaStatePoints_.template leftCols<1>() = this->x_est_;
+    // Set center block with x + gamma_ * S
+    sigmaStatePoints_.template block<STATE_DIM, STATE_DIM>(0, 1) = (gamma_ * _S).colwise() + this->x_est_;
+    // Set right block with x - gamma_ * S
+    sigmaStatePoints_.template rightCols<STATE_DIM>() = (-gamma_ * _S).colwise() + this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+template <size_t SIZE>
+bool SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeCovarianceSquareRoot(
+    const Eigen::Matrix<SCALAR, SIZE, 1>& mean,
+    const SigmaPoints<SIZE>& sigmaPoints,
+    const Covariance<SIZE>& noiseSquareRoot,
+    CovarianceSquareRoot<SIZE>& S)
+{
+    static constexpr size_t DeviationCount = SigmaPointCount - 1;
+
+    // A^T A = sum_i W_i (X_i - mean) (X_i - mean)^T + Q for i > 0
+    Eigen::Matrix<SCALAR, DeviationCount + SIZE, SIZE> A;
+    A.template topRows<DeviationCount>() =
+        sigmaWeights_c_.template tail<DeviationCount>().cwiseSqrt().asDiagonal() *
+        (sigmaPoints.template rightCols<DeviationCount>().colwise() - mean).transpose();
+    A.template bottomRows<SIZE>() = noiseSquareRoot.transpose();
+
+    // A = Q R, hence A^T A = R^T R
+    Eigen::HouseholderQR<Eigen::Matrix<SCALAR, DeviationCount + SIZE, SIZE>> qr(A);
+    Covariance<SIZE> R = qr.matrixQR().template topRows<SIZE>().template triangularView<Eigen::Upper>();
+
+    // make the diagonal positive, flipping the sign of a row of R does not change R^T R
+    for (size_t i = 0; i < SIZE; ++i)
+        if (R(i, i) < SCALAR(0.0))
+            R.row(i) *= SCALAR(-1.0);
+
+    S.setU(R);
+
+    // the weight of the center point may be negative
+    S.rankUpdate(sigmaPoints.col(0) - mean, sigmaWeights_c_[0]);
+
+    return S.info() == Eigen::Success;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+template <size_t SIZE>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeNoiseSquareRoot(
+    const Covariance<SIZE>& Q,
+    Covariance<SIZE>& B)
+{
+    // Q = P^T L D L^T P, which also exists for semi-definite noise, e.g. noise on a subset of the states
+    Eigen::LDLT<Covariance<SIZE>> ldlt(Q);
+    B = ldlt.matrixL();
+    B = B * ldlt.vectorD().cwiseMax(SCALAR(0.0)).cwiseSqrt().asDiagonal();
+    B = ldlt.transpositionsP().transpose() * B;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeWeights()
+{
+    SCALAR L = SCALAR(STATE_DIM);
+    lambda_ = alpha_ * alpha_ * (L + kappa_) - L;
+    gamma_ = std::sqrt(L + lambda_);
+
+    // Make sure L != -lambda_ to avoid division by zero
+    assert(std::abs(L + lambda_) > 1e-6);
+
+    // Make sure L != -kappa_ to avoid division by zero
+    assert(std::abs(L + kappa_) > 1e-6);
+
+    SCALAR W_m_0 = lambda_ / (L + lambda_);
+    SCALAR W_c_0 = W_m_0 + (SCALAR(1) - alpha_ * alpha_ + beta_);
+    SCALAR W_i = SCALAR(1) / (SCALAR(2) * alpha_ * alpha_ * (L + kappa_));
+
+    // Make sure W_i > 0 to avoid square-root of negative number
+    assert(W_i > SCALAR(0));
+
+    sigmaWeights_m_[0] = W_m_0;
+    sigmaWeights_c_[0] = W_c_0;
+
+    for (size_t i = 1; i < SigmaPointCount; ++i)
+    {
+        sigmaWeights_m_[i] = W_i;
+        sigmaWeights_c_[i] = W_i;
+    }
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <limits>
+
+#include "UnscentedKalmanFilter.h"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup Filter
+ *
+ * \brief Square-root form of the Unscented Kalman Filter. Instead of the covariance, the filter keeps its Cholesky
+ *        factor \f$ S \f$ with \f$ P = S S^T \f$. The factor is propagated by a QR decomposition of the weighted sigma
+ *        point deviations and rank-1 updates, hence the covariance is never refactorized and stays positive definite
+ *        by construction. All sigma points are propagated in one call to SystemModelBase::computeDynamicsBatch().
+ *
+ * @tparam STATE_DIM
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR = double>
+class SquareRootUnscentedKalmanFilter final : public EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Base = EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>;
+    using typename Base::control_vector_t;
+    using typename Base::output_matrix_t;
+    using typename Base::output_vector_t;
+    using typename Base::state_matrix_t;
+    using typename Base::state_vector_t;
+
+    static constexpr size_t SigmaPointCount = 2 * STATE_DIM + 1;
+
+    template <size_t SIZE>
+    using SigmaPoints = Eigen::Matrix<SCALAR, SIZE, SigmaPointCount>;
+
+    template <size_t SIZE>
+    using Covariance = Eigen::Matrix<SCALAR, SIZE, SIZE>;
+
+    template <size_t SIZE>
+    using CovarianceSquareRoot = Cholesky<Eigen::Matrix<SCALAR, SIZE, SIZE>>;
+
+    //! Constructor.
+    SquareRootUnscentedKalmanFilter(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+        std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+        const state_vector_t& x0 = state_vector_t::Zero(),
+        SCALAR alpha = SCALAR(1.0),
+        SCALAR beta = SCALAR(2.0),
+        SCALAR kappa = SCALAR(0.0),
+        const ct::core::StateMatrix<STATE_DIM, SCALAR>& P0 = ct::core::StateMatrix<STATE_DIM, SCALAR>::Identity());
+
+    //! Constructor from settings.
+    SquareRootUnscentedKalmanFilter(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+        std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+        const UnscentedKalmanFilterSettings<STATE_DIM, SCALAR>& ukf_settings);
+
+    //! Estimator predict method.
+    const state_vector_t& predict(const control_vector_t& u,
+        const ct::core::Time& dt,
+        const ct::core::Time& t) override;
+
+    //! Estimator update method.
+    const state_vector_t& update(const output_vector_t& y, const ct::core::Time& dt, const ct::core::Time& t) override;
+
+    //! Covariance getter, reconstructed from its square root.
+    state_matrix_t getCovariance() const;
+
+    //! Covariance square root getter.
+    const CovarianceSquareRoot<STATE_DIM>& getCovarianceSquareRoot() const;
+
+    //! Compute sigma points from current state and covariance square root.
+    void computeSigmaPoints();
+
+    /*!
+     * \brief Compute the square root of the covariance of sigma points with additive noise. The QR decomposition of
+     *        the weighted deviations and the noise square root yields the factor, the deviation of the center point is
+     *        added by a rank-1 update since its weight may be negative.
+     */
+    template <size_t SIZE>
+    bool computeCovarianceSquareRoot(const Eigen::Matrix<SCALAR, SIZE, 1>& mean,
+        const SigmaPoints<SIZE>& sigmaPoints,
+        const Covariance<SIZE>& noiseSquareRoot,
+        CovarianceSquareRoot<SIZE>& S);
+
+    //! Compute a square root \f$ B \f$ with \f$ B B^T = Q \f$ of a positive semi-definite noise covariance.
+    template <size_t SIZE>
+    void computeNoiseSquareRoot(const Covariance<SIZE>& Q, Covariance<SIZE>& B);
+
+    //! Compute weights of sigma points.
+    void computeWeights();
+
+private:
+    CovarianceSquareRoot<STATE_DIM> S_;                         //! Covariance square root.
+    Eigen::Matrix<SCALAR, SigmaPointCount, 1> sigmaWeights_m_;  //! Sigma measurement weights.
+    Eigen::Matrix<SCALAR, SigmaPointCount, 1> sigmaWeights_c_;  //! Sigma covariance weights.
+    SigmaPoints<STATE_DIM> sigmaStatePoints_;                   //! Sigma points.
+    ct::core::StateVectorBatch<STATE_DIM, SCALAR> sigmaStateBatch_;  //! Sigma points for the batch propagation.
+    state_matrix_t Q_;                    //! Process noise covariance of the last prediction.
+    state_matrix_t Q_sqrt_;               //! Square root of the process noise covariance.
+    Covariance<OUTPUT_DIM> R_;            //! Measurement noise covariance of the last update.
+    Covariance<OUTPUT_DIM> R_sqrt_;       //! Square root of the measurement noise covariance.
+    SCALAR alpha_;  //! Scaling parameter for spread of sigma points (usually \f$ 1E-4 \leq \alpha \leq 1 \f$)
+    SCALAR beta_;   //! Parameter for prior knowledge about the distribution (\f$ \beta = 2 \f$ is optimal for Gaussian)
+    SCALAR kappa_;  //! Secondary scaling parameter (usually 0)
+    SCALAR gamma_;  //! \f$ \gamma = \sqrt{L + \lambda} \f$ with \f$ L \f$ being the state dimensionality
+    SCALAR lambda_;  //! \f$ \lambda = \alpha^2 ( L + \kappa ) - L\f$ with \f$ L \f$ being the state dimensionality
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -35,12 +35,37 @@ public:
         const Time_t dt,
         Time_t t) = 0;
 
+    /*!
+     * \brief Propagates a batch of states, one state per column, with the same control input. The default
+     *        implementation calls computeDynamics() for every column. Overload this function to propagate the batch in
+     *        one integration, e.g. for the sigma points of an unscented transform.
+     */
+    virtual void computeDynamicsBatch(ct::core::StateVectorBatch<STATE_DIM, SCALAR>& states,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t)
+    {
+        for (int i = 0; i < states.cols(); ++i)
+            states.col(i) = computeDynamics(states.col(i), control, dt, t);
+    }
+
     //! Computes the derivative w.r.t state.
     virtual state_matrix_t computeDerivativeState(const state_vector_t& state,
         const control_vector_t& control,
         const Time_t dt,
         Time_t t) = 0;
 
+    //! Propagates the system and computes the derivative w.r.t. state at the initial state, in this order by default.
+    virtual state_vector_t computeDynamicsAndDerivativeState(const state_vector_t& state,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t,
+        state_matrix_t& dFdx)
+    {
+        dFdx = computeDerivativeState(state, control, dt, t);
+        return computeDynamics(state, control, dt, t);
+    }
+
     //! Computes the derivative w.r.t noise.
     virtual state_matrix_t computeDerivativeNoise(const state_vector_t& state,
         const control_vector_t& control,
@@ -60,8 +60,9 @@ UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::UnscentedKalm
     SCALAR beta,
     SCALAR kappa,
     const ct::core::StateMatrix<STATE_DIM, SCALAR>& P0)
-    : Base(f, h, x0), alpha_(alpha), beta_(beta), kappa_(kappa), P_(P0)
+    : Base(f, h, x0), P_(P0), alpha_(alpha), beta_(beta), kappa_(kappa)
 {
+    computeWeights();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
@@ -70,11 +71,12 @@ UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::UnscentedKalm
     std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
     const UnscentedKalmanFilterSettings<STATE_DIM, SCALAR>& ukf_settings)
     : Base(f, h, ukf_settings.x0),
+      P_(ukf_settings.P0),
       alpha_(ukf_settings.alpha),
       beta_(ukf_settings.beta),
-      kappa_(ukf_settings.kappa),
-      P_(ukf_settings.P0)
+      kappa_(ukf_settings.kappa)
 {
+    computeWeights();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
@@ -231,7 +233,7 @@ void UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeW
     sigmaWeights_m_[0] = W_m_0;
     sigmaWeights_c_[0] = W_c_0;
 
-    for (int i = 1; i < SigmaPointCount; ++i)
+    for (size_t i = 1; i < SigmaPointCount; ++i)
     {
         sigmaWeights_m_[i] = W_i;
         sigmaWeights_c_[i] = W_i;
@@ -244,10 +246,9 @@ void UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeS
     const ct::core::Time& dt,
     const ct::core::Time& t)
 {
-    for (size_t i = 0; i < SigmaPointCount; ++i)
-    {
-        sigmaStatePoints_.col(i) = this->f_->computeDynamics(sigmaStatePoints_.col(i), u, dt, t);
-    }
+    sigmaStateBatch_ = sigmaStatePoints_;
+    this->f_->computeDynamicsBatch(sigmaStateBatch_, u, dt, t);
+    sigmaStatePoints_ = sigmaStateBatch_;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
@@ -264,7 +265,7 @@ void UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeS
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
 template <size_t DIM>
 auto UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computePredictionFromSigmaPoints(
-    const SigmaPoints<DIM>& sigmaPoints) -> state_vector_t
+    const SigmaPoints<DIM>& sigmaPoints) -> Eigen::Matrix<SCALAR, DIM, 1>
 {
     // Use efficient matrix x vector computation
     return sigmaPoints * sigmaWeights_m_;
@@ -136,10 +136,7 @@ public:
     //! Compute weights of sigma points.
     void computeWeights();
 
-    /*!
-     * \brief Propagate sigma points through the system dynamics. Using CTSystemModel here will not provide a desired
-     *        effect since it disregards the control input u.
-     */
+    //! Propagate all sigma points through the system dynamics in one batch.
     void computeSigmaPointTransition(const ct::core::ControlVector<CONTROL_DIM, SCALAR>& u,
         const ct::core::Time& dt,
         const ct::core::Time& t);
@@ -149,13 +146,14 @@ public:
 
     //! Make a prediction based on sigma points.
     template <size_t DIM>
-    state_vector_t computePredictionFromSigmaPoints(const SigmaPoints<DIM>& sigmaPoints);
+    Eigen::Matrix<SCALAR, DIM, 1> computePredictionFromSigmaPoints(const SigmaPoints<DIM>& sigmaPoints);
 
 private:
     state_matrix_t P_;                                          //! Covariance matrix.
     Eigen::Matrix<SCALAR, SigmaPointCount, 1> sigmaWeights_m_;  //! Sigma measurement weights.
     Eigen::Matrix<SCALAR, SigmaPointCount, 1> sigmaWeights_c_;  //! Sigma covariance weights.
     SigmaPoints<STATE_DIM> sigmaStatePoints_;                   //! Sigma points.
+    ct::core::StateVectorBatch<STATE_DIM, SCALAR> sigmaStateBatch_;  //! Sigma points for the batch propagation.
     SCALAR alpha_;  //! Scaling parameter for spread of sigma points (usually \f$ 1E-4 \leq \alpha \leq 1 \f$)
     SCALAR beta_;   //! Parameter for prior knowledge about the distribution (\f$ \beta = 2 \f$ is optimal for Gaussian)
     SCALAR kappa_;  //! Secondary scaling parameter (usually 0)
@@ -16,5 +16,6 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "LTIMeasurementModel.h"
 #include "MeasurementModelBase.h"
 #include "SteadyStateKalmanFilter.h"
+#include "SquareRootUnscentedKalmanFilter.h"
 #include "SystemModelBase.h"
 #include "UnscentedKalmanFilter.h"
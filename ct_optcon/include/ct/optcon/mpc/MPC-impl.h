@@ -22,7 +22,10 @@ MPC<OPTCON_SOLVER>::MPC(const OptConProblem_t& problem,
       forwardIntegrator_(dynamics_, mpcsettings.stateForwardIntegratorType_),
       firstRun_(true),
       runCallCounter_(0),
-      policyHandler_(new PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>())
+      policyHandler_(new PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>()),
+      realTimeIterationPending_(false),
+      dtPostTruncation_(0.0),
+      realTimeIterationPolicy_ts_(0.0)
 {
     checkSettings(mpcsettings);
 
@@ -143,6 +146,10 @@ void MPC<OPTCON_SOLVER>::prepareIteration(const Scalar_t& extTime)
 
     runCallCounter_++;
 
+    // the feedback phase of a real-time iteration only updated the first control, the remaining stages are done here
+    Scalar_t completedPolicy_ts;
+    completePendingRealTimeIteration(completedPolicy_ts);
+
     const Scalar_t currTimeHorizon = solver_.getTimeHorizon();
     Scalar_t newTimeHorizon;
 
@@ -205,6 +212,8 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
 
         // get optimized policy and state trajectory from OptConSolver
         currentPolicy_ = solver_.getSolution();
+        realTimeIterationPending_ = solver_.getSettings().realTimeIteration;
+        dtPostTruncation_ = 0.0;
 
         // obtain the time which passed since the previous successful solve
         Scalar_t dtp = timeKeeper_.timeSincePreviousSuccessfulSolve(x_ts);
@@ -225,10 +234,19 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
                 // the time which was effectively truncated away (e.g. discrete-time case)
                 Scalar_t dt_truncated_eff;
 
-                policyHandler_->truncateSolutionFront(dt_post_truncation, currentPolicy_, dt_truncated_eff);
-
-                // update policy timestamp with the truncated time
-                newPolicy_ts += dt_truncated_eff;
+                // a real-time iteration only updated the first control so far, which the truncation could cut away.
+                // Hence it is deferred until all stages are updated, see completeRealTimeIteration().
+                if (realTimeIterationPending_)
+                {
+                    dtPostTruncation_ = dt_post_truncation;
+                }
+                else
+                {
+                    policyHandler_->truncateSolutionFront(dt_post_truncation, currentPolicy_, dt_truncated_eff);
+
+                    // update policy timestamp with the truncated time
+                    newPolicy_ts += dt_truncated_eff;
+                }
             }
             else if (t_forward_stop_ >= dtp && !firstRun_)
             {
@@ -262,14 +280,52 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
         firstRun_ = false;
     }
 
+    realTimeIterationPolicy_ts_ = newPolicy_ts;
+
     return solveSuccessful;
 }
 
 
+template <typename OPTCON_SOLVER>
+bool MPC<OPTCON_SOLVER>::completeRealTimeIteration(Policy_t& newPolicy, Scalar_t& newPolicy_ts)
+{
+    if (!completePendingRealTimeIteration(newPolicy_ts))
+        return false;
+
+    newPolicy = currentPolicy_;
+    return true;
+}
+
+
+template <typename OPTCON_SOLVER>
+bool MPC<OPTCON_SOLVER>::completePendingRealTimeIteration(Scalar_t& newPolicy_ts)
+{
+    if (!realTimeIterationPending_)
+        return false;
+
+    realTimeIterationPending_ = false;
+
+    solver_.getBackend()->completeRealTimeIteration();
+    currentPolicy_ = solver_.getSolution();
+    newPolicy_ts = realTimeIterationPolicy_ts_;
+
+    // apply the post-truncation deferred by the feedback phase
+    if (dtPostTruncation_ > 0.0)
+    {
+        Scalar_t dt_truncated_eff;
+        policyHandler_->truncateSolutionFront(dtPostTruncation_, currentPolicy_, dt_truncated_eff);
+        newPolicy_ts += dt_truncated_eff;
+    }
+
+    return true;
+}
+
+
 template <typename OPTCON_SOLVER>
 void MPC<OPTCON_SOLVER>::resetMpc(const Scalar_t& newTimeHorizon)
 {
     firstRun_ = true;
+    realTimeIterationPending_ = false;
 
     runCallCounter_ = 0;
 
@@ -176,6 +176,21 @@ public:
             nullptr);
 
 
+    //! complete a pending real-time iteration
+    /*!
+     * The feedback phase of a real-time iteration only updates the first control of the policy returned by
+     * finishIteration(). This updates the remaining stages, applies a deferred post-truncation and returns the
+     * completed policy, such that it can be published before the next iteration. prepareIteration() does the same
+     * if this method was not called.
+     * @param newPolicy
+     *  the completed policy
+     * @param newPolicy_ts
+     *  time stamp of the completed policy
+     * @return true if a real-time iteration was pending, false otherwise (outputs untouched).
+     */
+    bool completeRealTimeIteration(Policy_t& newPolicy, Scalar_t& newPolicy_ts);
+
+
     //! reset the mpc problem and provide new problem time horizon (mandatory)
     void resetMpc(const Scalar_t& newTimeHorizon);
 
@@ -214,6 +229,9 @@ private:
 
     void checkSettings(const mpc_settings& settings);
 
+    //! complete a pending real-time iteration on the current policy, returns false if none was pending
+    bool completePendingRealTimeIteration(Scalar_t& newPolicy_ts);
+
     //! timings for pre-integration
     Scalar_t t_forward_start_;
     Scalar_t t_forward_stop_;
@@ -242,6 +260,15 @@ private:
     //! currently optimal policy, initial guess respectively
     Policy_t currentPolicy_;
 
+    //! true if the last feedback phase of a real-time iteration deferred the update of all but the first stage
+    bool realTimeIterationPending_;
+
+    //! post-truncation deferred by the feedback phase of a real-time iteration, applied once all stages are updated
+    Scalar_t dtPostTruncation_;
+
+    //! time stamp of the policy returned by the feedback phase of a real-time iteration
+    Scalar_t realTimeIterationPolicy_ts_;
+
     //! time horizon strategy, e.g. receding horizon optimal control
     std::shared_ptr<tpl::MpcTimeHorizon<Scalar_t>> timeHorizonStrategy_;
 
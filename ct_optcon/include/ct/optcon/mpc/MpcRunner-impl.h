@@ -0,0 +1,201 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <typename OPTCON_SOLVER>
+MpcRunner<OPTCON_SOLVER>::MpcRunner(const OptConProblem_t& problem,
+    const typename OPTCON_SOLVER::Settings_t& solverSettings,
+    const mpc_settings& mpcsettings,
+    std::shared_ptr<PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>> customPolicyHandler,
+    std::shared_ptr<tpl::MpcTimeHorizon<Scalar_t>> customTimeHorizon)
+    : mpc_(problem, solverSettings, mpcsettings, customPolicyHandler, customTimeHorizon),
+      hasPolicy_(false),
+      newMeasurement_(false),
+      running_(false),
+      nPublished_(0)
+{
+}
+
+
+template <typename OPTCON_SOLVER>
+MpcRunner<OPTCON_SOLVER>::~MpcRunner()
+{
+    stop();
+}
+
+
+template <typename OPTCON_SOLVER>
+typename MpcRunner<OPTCON_SOLVER>::MPC_t& MpcRunner<OPTCON_SOLVER>::getMpc()
+{
+    return mpc_;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::start(const core::StateVector<STATE_DIM, Scalar_t>& x, const Scalar_t t)
+{
+    stop();
+
+    hasPolicy_ = false;
+    nPublished_ = 0;
+
+    // discard measurements and policies left over from a previous run
+    measurements_.update();
+    policies_.update();
+
+    setStateMeasurement(x, t);
+
+    mpc_.prepareIteration(t);
+
+    running_ = true;
+    solverThread_ = std::thread(&MpcRunner<OPTCON_SOLVER>::solverLoop, this);
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::stop()
+{
+    running_ = false;
+    measurementCondition_.notify_one();
+
+    if (solverThread_.joinable())
+        solverThread_.join();
+}
+
+
+template <typename OPTCON_SOLVER>
+bool MpcRunner<OPTCON_SOLVER>::isRunning() const
+{
+    return running_;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::setStateMeasurement(const core::StateVector<STATE_DIM, Scalar_t>& x, const Scalar_t t)
+{
+    StateMeasurement& measurement = measurements_.back();
+    measurement.x = x;
+    measurement.t = t;
+    measurements_.publish();
+
+    newMeasurement_ = true;
+    measurementCondition_.notify_one();
+}
+
+
+template <typename OPTCON_SOLVER>
+bool MpcRunner<OPTCON_SOLVER>::computeControl(const core::StateVector<STATE_DIM, Scalar_t>& x,
+    const Scalar_t t,
+    core::ControlVector<CONTROL_DIM, Scalar_t>& u)
+{
+    updatePolicy();
+
+    if (!hasPolicy_)
+        return false;
+
+    TimedPolicy& timedPolicy = policies_.front();
+    timedPolicy.policy.computeControl(x, std::max(t - timedPolicy.ts, Scalar_t(0.0)), u);
+    return true;
+}
+
+
+template <typename OPTCON_SOLVER>
+typename MpcRunner<OPTCON_SOLVER>::Policy_t* MpcRunner<OPTCON_SOLVER>::getPolicy(Scalar_t& policy_ts)
+{
+    updatePolicy();
+
+    if (!hasPolicy_)
+        return nullptr;
+
+    policy_ts = policies_.front().ts;
+    return &policies_.front().policy;
+}
+
+
+template <typename OPTCON_SOLVER>
+size_t MpcRunner<OPTCON_SOLVER>::getNumberOfPublishedPolicies() const
+{
+    return nPublished_;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::updatePolicy()
+{
+    if (policies_.update())
+        hasPolicy_ = true;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::solverLoop()
+{
+    Scalar_t lastMeasurementTime = std::numeric_limits<Scalar_t>::lowest();
+
+    try
+    {
+        while (running_)
+        {
+            waitForMeasurement();
+
+            // only solve if there is a measurement that has not been solved for yet
+            if (!measurements_.update())
+                continue;
+
+            const StateMeasurement& measurement = measurements_.front();
+
+            // a measurement which is not newer than the last one would repeat the previous iteration
+            if (measurement.t <= lastMeasurementTime)
+                continue;
+            lastMeasurementTime = measurement.t;
+
+            // the policy gets written to the back buffer directly, such that it is never copied again
+            TimedPolicy& timedPolicy = policies_.back();
+            bool success = mpc_.finishIteration(measurement.x, measurement.t, timedPolicy.policy, timedPolicy.ts);
+
+            if (success)
+            {
+                policies_.publish();
+                nPublished_++;
+            }
+
+            if (mpc_.timeHorizonReached())
+                break;
+
+            // a real-time iteration only updated the first control, publish again once the remaining stages are done
+            TimedPolicy& completedPolicy = policies_.back();
+            if (mpc_.completeRealTimeIteration(completedPolicy.policy, completedPolicy.ts))
+            {
+                policies_.publish();
+                nPublished_++;
+            }
+
+            mpc_.prepareIteration(measurement.t);
+        }
+    } catch (std::exception& e)
+    {
+        std::cout << "MpcRunner: solver thread terminated with exception: " << e.what() << std::endl;
+    }
+
+    running_ = false;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::waitForMeasurement()
+{
+    // the control thread notifies without taking the lock, such that it never blocks. A notification may therefore get
+    // lost between checking the flag and waiting, the timeout bounds the resulting delay.
+    std::unique_lock<std::mutex> lock(measurementMutex_);
+    measurementCondition_.wait_for(
+        lock, std::chrono::milliseconds(1), [this]() { return newMeasurement_.exchange(false) || !running_; });
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,171 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include <ct/core/common/TripleBuffer.h>
+
+#include "MPC.h"
+
+namespace ct {
+namespace optcon {
+
+
+/**
+ * \ingroup MPC
+ *
+ * \brief Runs an MPC instance asynchronously on its own solver thread.
+ *
+ *	The runner decouples a (fast) control loop from the (slow) MPC solver. The solver thread continuously picks up
+ *	the latest state measurement, runs an MPC iteration and publishes the resulting policy. The control thread hands
+ *	in state measurements through setStateMeasurement() and evaluates the latest policy through computeControl().
+ *
+ *	Measurements and policies are exchanged through lock-free triple buffers. Therefore, the control thread never
+ *	blocks on the solver, and policies are never copied on the control thread: picking up a new policy is a single
+ *	atomic index exchange.
+ *
+ *	The time stamps handed in with the measurements are forwarded to the MPC as external time stamps, see
+ *	MPC::finishIteration(). Policies are evaluated relative to the time stamp they were published with. The solver
+ *	thread sleeps until a new measurement arrives, and measurements which are not newer than the last one solved
+ *	for are skipped.
+ *
+ *	\warning setStateMeasurement() and computeControl() may only be called from one (control) thread.
+ *	The MPC instance must not be accessed through getMpc() while the runner is running.
+ *
+ *	@param OPTCON_SOLVER
+ *		the optimal control solver to be employed, for example an NLOptConSolver
+ */
+template <typename OPTCON_SOLVER>
+class MpcRunner
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t STATE_DIM = OPTCON_SOLVER::STATE_D;
+    static const size_t CONTROL_DIM = OPTCON_SOLVER::CONTROL_D;
+
+    using MPC_t = MPC<OPTCON_SOLVER>;
+    using Scalar_t = typename MPC_t::Scalar_t;
+    using Policy_t = typename MPC_t::Policy_t;
+    using OptConProblem_t = typename MPC_t::OptConProblem_t;
+
+    //! constructor, the arguments are forwarded to the MPC instance, see MPC::MPC()
+    MpcRunner(const OptConProblem_t& problem,
+        const typename OPTCON_SOLVER::Settings_t& solverSettings,
+        const mpc_settings& mpcsettings = mpc_settings(),
+        std::shared_ptr<PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>> customPolicyHandler = nullptr,
+        std::shared_ptr<tpl::MpcTimeHorizon<Scalar_t>> customTimeHorizon = nullptr);
+
+    //! destructor, stops the solver thread
+    ~MpcRunner();
+
+    MpcRunner(const MpcRunner&) = delete;
+    MpcRunner& operator=(const MpcRunner&) = delete;
+
+    //! access to the MPC instance, e.g. to set an initial guess. Only to be used while the runner is not running.
+    MPC_t& getMpc();
+
+    /*!
+     * \brief start the solver thread
+     *
+     * Prepares the first MPC iteration and starts solving on the given measurement.
+     * @param x initial state measurement
+     * @param t time stamp of the initial state measurement
+     */
+    void start(const core::StateVector<STATE_DIM, Scalar_t>& x, const Scalar_t t);
+
+    //! stop the solver thread. Waits for the current MPC iteration to finish.
+    void stop();
+
+    //! true while the solver thread is running. The thread stops by itself once the MPC time horizon is reached.
+    bool isRunning() const;
+
+    /*!
+     * \brief hand a new state measurement to the solver thread. Never blocks.
+     * @param x the measured state
+     * @param t time stamp of the measurement (external time in seconds)
+     */
+    void setStateMeasurement(const core::StateVector<STATE_DIM, Scalar_t>& x, const Scalar_t t);
+
+    /*!
+     * \brief evaluate the latest published policy. Never blocks and does not copy the policy.
+     * @param x the current state
+     * @param t the current time (external time in seconds)
+     * @param u the resulting control action
+     * @return false if no policy has been published yet, in which case u is not touched
+     */
+    bool computeControl(const core::StateVector<STATE_DIM, Scalar_t>& x,
+        const Scalar_t t,
+        core::ControlVector<CONTROL_DIM, Scalar_t>& u);
+
+    /*!
+     * \brief the latest published policy. Only to be called from the control thread.
+     *
+     * The pointer stays valid until the next call to computeControl() or getPolicy().
+     * @param policy_ts the time stamp of the policy
+     * @return the policy, nullptr if no policy has been published yet
+     */
+    Policy_t* getPolicy(Scalar_t& policy_ts);
+
+    //! number of policies published by the solver thread since start()
+    size_t getNumberOfPublishedPolicies() const;
+
+private:
+    struct StateMeasurement
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        core::StateVector<STATE_DIM, Scalar_t> x;
+        Scalar_t t = 0.0;
+    };
+
+    struct TimedPolicy
+    {
+        Policy_t policy;
+        Scalar_t ts = 0.0;
+    };
+
+    //! the main loop of the solver thread
+    void solverLoop();
+
+    //! block the solver thread until a new measurement has been published or the runner is stopped
+    void waitForMeasurement();
+
+    //! fetch the latest policy on the control thread
+    void updatePolicy();
+
+    //! the mpc instance, exclusively used by the solver thread while running
+    MPC_t mpc_;
+
+    //! measurements, produced by the control thread and consumed by the solver thread
+    core::TripleBuffer<StateMeasurement> measurements_;
+
+    //! policies, produced by the solver thread and consumed by the control thread
+    core::TripleBuffer<TimedPolicy> policies_;
+
+    //! true once the control thread has picked up a policy
+    bool hasPolicy_;
+
+    //! wakes up the solver thread on new measurements
+    std::mutex measurementMutex_;
+    std::condition_variable measurementCondition_;
+    std::atomic_bool newMeasurement_;
+
+    std::atomic_bool running_;
+    std::atomic_size_t nPublished_;
+
+    std::thread solverThread_;
+};
+
+
+}  // namespace optcon
+}  // namespace ct
@@ -39,6 +39,7 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCB
       K_(0),
       substepsX_(new StateSubsteps),
       substepsU_(new ControlSubsteps),
+      lineSearchWorkspaces_(settings.nThreads + 1),
       d_norm_(0.0),
       e_box_norm_(0.0),
       e_gen_norm_(0.0),
@@ -55,7 +56,11 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCB
       inputBoxConstraints_(settings.nThreads + 1, nullptr),  // initialize constraints with null
       stateBoxConstraints_(settings.nThreads + 1, nullptr),  // initialize constraints with null
       generalConstraints_(settings.nThreads + 1, nullptr),   // initialize constraints with null
-      lqpCounter_(0)
+      lqpCounter_(0),
+      realTimeIterationPrepared_(false),
+      realTimeIterationPending_(false),
+      heapAllocationsPrevious_(ct::core::HeapAllocationCounter::get()),
+      prunedLineSearchCandidates_(0)
 {
     Eigen::initParallel();
 
@@ -147,6 +152,9 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         throw std::runtime_error("initial control guess to short");
     }
 
+    // the new guess replaces the solution a pending real-time iteration update would apply to
+    realTimeIterationPending_ = false;
+
     u_ff_ = initialGuess.uff();
     L_ = initialGuess.K();
     x_ = initialGuess.x_ref();
@@ -196,6 +204,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         throw std::runtime_error("negative or zero time steps specified");
 
     K_ = numStages;
+    realTimeIterationPending_ = false;
 
     t_ = TimeArray(settings_.dt, K_ + 1, 0.0);
 
@@ -215,6 +224,9 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     substepsX_->resize(K_ + 1);
     substepsU_->resize(K_ + 1);
 
+    for (auto& workspace : lineSearchWorkspaces_)
+        workspace.resize(K_);
+
     resetDefects();
 
     systemInterface_->changeNumStages(K_);
@@ -242,7 +254,10 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         x_.resize(1);
 
     x_[0] = x0;
-    reset();  // since initial state changed, we have to start fresh, i.e. with a rollout
+
+    // in a real-time iteration, the new initial state is accounted for by the feedback phase
+    if (!(settings_.realTimeIteration && realTimeIterationPrepared_))
+        reset();  // since initial state changed, we have to start fresh, i.e. with a rollout
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -402,6 +417,11 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         lqocSolver_ = std::shared_ptr<GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(
             new GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>());
     }
+    else if (settings.lqocp_solver == NLOptConSettings::LQOCP_SOLVER::PARTITIONED_RICCATI_SOLVER)
+    {
+        lqocSolver_ = std::shared_ptr<PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(
+            new PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>());
+    }
     else if (settings.lqocp_solver == NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER)
     {
 #ifdef HPIPM
@@ -441,7 +461,9 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     StateVectorArray& xShot,  //! the value at the end of each integration interval
     StateSubsteps& substepsX,
     ControlSubsteps& substepsU,
-    std::atomic_bool* terminationFlag) const
+    std::atomic_bool* terminationFlag,
+    scalar_t* stageCostSum,
+    const scalar_t stageCostBound) const
 {
     const int K_local = K_;
 
@@ -515,6 +537,21 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         // get substeps for later sensitvity calculation
         systemInterface_->getSubstates(substepsX[i], threadId);
         systemInterface_->getSubcontrols(substepsU[i], threadId);
+
+        // state and control of stage i are final now
+        if (stageCostSum)
+        {
+            costFunctions_[threadId]->setCurrentStateAndControl(x_local[i], u_local[i], settings_.dt * i);
+            *stageCostSum += costFunctions_[threadId]->evaluateIntermediate();
+            // a candidate whose merit equals the bound can still be accepted by the Armijo rule
+            if (*stageCostSum > stageCostBound || std::isnan(*stageCostSum))
+            {
+                if (settings_.lineSearchSettings.debugPrint)
+                    std::cout << "[LineSearch]: aborting rollout at stage " << i << std::endl;
+                prunedLineSearchCandidates_++;
+                return false;
+            }
+        }
     }
 
     return true;
@@ -552,6 +589,60 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     return true;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutShotsWithCostBound(
+    size_t threadId,
+    ControlVectorArray& u_ff_local,
+    StateVectorArray& x_local,
+    const StateVectorArray& x_ref_lqr,
+    StateVectorArray& xShot,
+    StateVectorArray& d,
+    StateSubsteps& substepsX,
+    ControlSubsteps& substepsU,
+    const scalar_t meritBound,
+    scalar_t& intermediateCost,
+    std::atomic_bool* terminationFlag) const
+{
+    //! make sure all intermediate entries in the defect trajectory are zero
+    d.setConstant(state_vector_t::Zero());
+
+    scalar_t stageCostSum = 0.0;
+    scalar_t defectNorm = 0.0;
+
+    for (int k = 0; k < K_; k = k + getNumStepsPerShot())
+    {
+        // the remaining stage costs, the terminal cost and the constraint violations are non-negative, hence the
+        // stage costs are checked against the bound stage by stage within the shot
+        const scalar_t stageCostBound = (meritBound - settings_.meritFunctionRho * defectNorm) / settings_.dt;
+
+        bool dynamicsGood = rolloutSingleShot(threadId, k, u_ff_local, x_local, x_ref_lqr, xShot, substepsX, substepsU,
+            terminationFlag, &stageCostSum, stageCostBound);
+
+        if (!dynamicsGood)
+            return false;
+
+        computeSingleDefect(k, x_local, xShot, d);
+
+        const int K_stop = std::min(K_, k + getNumStepsPerShot());
+        for (int i = k; i < K_stop; i++)
+            defectNorm += d[i].template lpNorm<1>();
+
+        // the defect at the end of the shot may exceed the bound
+        const scalar_t meritLowerBound = stageCostSum * settings_.dt + settings_.meritFunctionRho * defectNorm;
+        if (meritLowerBound > meritBound || std::isnan(meritLowerBound))
+        {
+            if (settings_.lineSearchSettings.debugPrint)
+                std::cout << "[LineSearch]: aborting rollout at stage " << K_stop << ", merit lower bound "
+                          << meritLowerBound << " exceeds " << meritBound << std::endl;
+            prunedLineSearchCandidates_++;
+            return false;
+        }
+    }
+
+    intermediateCost = stageCostSum * settings_.dt;
+    return true;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeSingleDefect(size_t k,
     const StateVectorArray& x_local,
@@ -706,18 +797,15 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     // feed current state and control to cost function
     costFunctions_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], dt * k);
 
-    // By using the following order of evaluations, we avoid caching matrices
-    // second derivative w.r.t state
-    p.Q_[k] = costFunctions_[threadId]->stateSecondDerivativeIntermediate() * dt;
-    // second derivative w.r.t control
-    p.R_[k] = costFunctions_[threadId]->controlSecondDerivativeIntermediate() * dt;
-    // cross terms
-    p.P_[k] = costFunctions_[threadId]->stateControlDerivativeIntermediate() * dt;
+    // evaluate all cost terms and their derivatives in a single sweep
+    QuadraticCostApproximation<STATE_DIM, CONTROL_DIM, SCALAR> costApproximation;
+    costFunctions_[threadId]->evaluateIntermediateQuadraticApproximation(costApproximation);
 
-    // derivative of cost with respect to state
-    p.qv_[k] = costFunctions_[threadId]->stateDerivativeIntermediate() * dt;
-    // derivative of cost with respect to control
-    p.rv_[k] = costFunctions_[threadId]->controlDerivativeIntermediate() * dt;
+    p.Q_[k] = costApproximation.stateSecondDerivative * dt;
+    p.R_[k] = costApproximation.controlSecondDerivative * dt;
+    p.P_[k] = costApproximation.stateControlDerivative * dt;
+    p.qv_[k] = costApproximation.stateDerivative * dt;
+    p.rv_[k] = costApproximation.controlDerivative * dt;
 
     // p.q_[k] = ... // not evaluated since we don't need it in GNMS/iLQR -- WARNING, potentially implement when using a different QP solver
 }
@@ -803,8 +891,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         p.ng_[k] = generalConstraints_[threadId]->getIntermediateConstraintsCount();
         if (p.ng_[k] > 0)
         {
-            p.C_[k] = generalConstraints_[threadId]->jacobianStateIntermediate();
-            p.D_[k] = generalConstraints_[threadId]->jacobianInputIntermediate();
+            generalConstraints_[threadId]->jacobiansIntermediate(p.C_[k], p.D_[k]);
 
             Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g_eval = generalConstraints_[threadId]->evaluateIntermediate();
 
@@ -816,32 +903,30 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::initializeCostToGo()
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::initializeCostToGo(size_t threadId)
 {
     LQOCProblem_t& p = *lqocProblem_;
 
     // feed current state and control to cost function
-    costFunctions_[settings_.nThreads]->setCurrentStateAndControl(x_[K_], control_vector_t::Zero(), settings_.dt * K_);
+    costFunctions_[threadId]->setCurrentStateAndControl(x_[K_], control_vector_t::Zero(), settings_.dt * K_);
 
     // derivative of terminal cost with respect to state
-    p.Q_[K_] = costFunctions_[settings_.nThreads]->stateSecondDerivativeTerminal();
-    p.qv_[K_] = costFunctions_[settings_.nThreads]->stateDerivativeTerminal();
+    p.Q_[K_] = costFunctions_[threadId]->stateSecondDerivativeTerminal();
+    p.qv_[K_] = costFunctions_[threadId]->stateDerivativeTerminal();
     // p.q_[K_] = ... // omitted since not needed in GNMS/ILQR -- WARNING, potentially implement when using a different QP solver
 
     // init terminal general constraints, if any
-    if (generalConstraints_[settings_.nThreads] != nullptr)
+    if (generalConstraints_[threadId] != nullptr)
     {
-        p.ng_[K_] = generalConstraints_[settings_.nThreads]->getTerminalConstraintsCount();
+        p.ng_[K_] = generalConstraints_[threadId]->getTerminalConstraintsCount();
         if (p.ng_[K_] > 0)
         {
-            p.C_[K_] = generalConstraints_[settings_.nThreads]->jacobianStateTerminal();
-            p.D_[K_] = generalConstraints_[settings_.nThreads]->jacobianInputTerminal();
+            generalConstraints_[threadId]->jacobiansTerminal(p.C_[K_], p.D_[K_]);
 
-            Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g_eval =
-                generalConstraints_[settings_.nThreads]->evaluateTerminal();
+            Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g_eval = generalConstraints_[threadId]->evaluateTerminal();
 
-            p.d_lb_[K_] = generalConstraints_[settings_.nThreads]->getLowerBoundsTerminal() - g_eval;
-            p.d_ub_[K_] = generalConstraints_[settings_.nThreads]->getUpperBoundsTerminal() - g_eval;
+            p.d_lb_[K_] = generalConstraints_[threadId]->getLowerBoundsTerminal() - g_eval;
+            p.d_ub_[K_] = generalConstraints_[threadId]->getUpperBoundsTerminal() - g_eval;
         }
     }
 }
@@ -849,6 +934,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::printSummary()
 {
+    const size_t heapAllocations = ct::core::HeapAllocationCounter::get() - heapAllocationsPrevious_;
+
     SCALAR d_norm_l1 = computeDefectsNorm<1>(d_);
     SCALAR d_norm_l2 = computeDefectsNorm<2>(d_);
     SCALAR totalCost = intermediateCostBest_ + finalCostBest_;
@@ -860,7 +947,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
                         settings_.meritFunctionRhoConstraints * (e_box_norm_ + e_gen_norm_);
 
     SCALAR smallestEigenvalue = 0.0;
-    if (settings_.recordSmallestEigenvalue && settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+    if (settings_.recordSmallestEigenvalue && settings_.lqocp_solver != Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
     {
         smallestEigenvalue = lqocSolver_->getSmallestEigenvalue();
     }
@@ -880,15 +967,21 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     summaryAllIterations_.stepSizes.push_back(alphaBest_);
     summaryAllIterations_.smallestEigenvalues.push_back(smallestEigenvalue);
 
+    summaryAllIterations_.heapAllocations.push_back(heapAllocations);
+    summaryAllIterations_.prunedLineSearchCandidates.push_back(prunedLineSearchCandidates_.exchange(0));
+
     if (settings_.printSummary)
         summaryAllIterations_.printSummaryLastIteration();
 
     //! @todo the printing of the smallest eigenvalue is hacky
     if (settings_.printSummary && settings_.recordSmallestEigenvalue &&
-        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+        settings_.lqocp_solver != Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
     {
         std::cout << std::setprecision(15) << "smallest eigenvalue this iteration: " << smallestEigenvalue << std::endl;
     }
+
+    // do not count the allocations of the summary itself
+    heapAllocationsPrevious_ = ct::core::HeapAllocationCounter::get();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -1016,6 +1109,9 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     u_ff_prev_ = u_ff_;
     x_prev_ = x_;
 
+    // a no-op once the containers have been reserved
+    reserveSubsteps();
+
 
     if (settings_.lineSearchSettings.type == LineSearchSettings::TYPE::NONE)  // do full step updates
     {
@@ -1106,18 +1202,14 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::executeLineSearch(const size_t threadId,
     const scalar_t alpha,
-    ct::core::StateVectorArray<STATE_DIM, SCALAR>& x_alpha,
-    ct::core::StateVectorArray<STATE_DIM, SCALAR>& x_shot_alpha,
-    ct::core::StateVectorArray<STATE_DIM, SCALAR>& defects_recorded,
-    ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>& u_alpha,
+    LineSearchWorkspace& workspace,
     scalar_t& intermediateCost,
     scalar_t& finalCost,
     scalar_t& defectNorm,
     scalar_t& e_box_norm,
     scalar_t& e_gen_norm,
-    StateSubsteps& substepsX,
-    ControlSubsteps& substepsU,
-    std::atomic_bool* terminationFlag) const
+    std::atomic_bool* terminationFlag,
+    const scalar_t meritBound) const
 {
     intermediateCost = std::numeric_limits<scalar_t>::max();
     finalCost = std::numeric_limits<scalar_t>::max();
@@ -1128,22 +1220,37 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     if (terminationFlag && *terminationFlag)
         return;
 
-    // update feedforward with weighting alpha
-    u_alpha = delta_u_ff_ * alpha + u_ff_prev_;
+    StateVectorArray& x_alpha = workspace.x;
+    ControlVectorArray& u_alpha = workspace.u_ff;
 
-    // update state decision variables with weighting alpha
-    x_alpha = delta_x_ * alpha + x_prev_;
+    // update feedforward with weighting alpha
+    for (int k = 0; k < K_; k++)
+        u_alpha[k] = delta_u_ff_[k] * alpha + u_ff_prev_[k];
 
-    // update x_lqr reference
-    ct::core::StateVectorArray<STATE_DIM, SCALAR> x_ref_lqr = delta_x_ref_lqr_ * alpha + x_prev_;
+    // update state decision variables and x_lqr reference with weighting alpha
+    for (int k = 0; k <= K_; k++)
+    {
+        x_alpha[k] = delta_x_[k] * alpha + x_prev_[k];
+        workspace.x_ref_lqr[k] = delta_x_ref_lqr_[k] * alpha + x_prev_[k];
+    }
 
     if (terminationFlag && *terminationFlag)
         return;
 
+    const bool boundCost =
+        settings_.lineSearchSettings.costBounding && (meritBound < std::numeric_limits<scalar_t>::max());
+
     bool dynamicsGood;
+    scalar_t intermediateCostBounded = std::numeric_limits<scalar_t>::max();
 
-    dynamicsGood = rolloutShotsSingleThreaded(threadId, 0 /*first index*/, K_ - 1 /*last index*/, u_alpha, x_alpha,
-        x_ref_lqr, x_shot_alpha, defects_recorded, substepsX, substepsU, terminationFlag);
+    if (boundCost)
+        dynamicsGood = rolloutShotsWithCostBound(threadId, u_alpha, x_alpha, workspace.x_ref_lqr, workspace.xShot,
+            workspace.d, *workspace.substepsX, *workspace.substepsU, meritBound, intermediateCostBounded,
+            terminationFlag);
+    else
+        dynamicsGood = rolloutShotsSingleThreaded(threadId, 0 /*first index*/, K_ - 1 /*last index*/, u_alpha,
+            x_alpha, workspace.x_ref_lqr, workspace.xShot, workspace.d, *workspace.substepsX, *workspace.substepsU,
+            terminationFlag);
 
     if (terminationFlag && *terminationFlag)
         return;
@@ -1152,12 +1259,21 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     if (dynamicsGood)
     {
         //! compute defects norm
-        defectNorm = computeDefectsNorm<1>(defects_recorded);
+        defectNorm = computeDefectsNorm<1>(workspace.d);
 
         if (terminationFlag && *terminationFlag)
             return;
 
-        computeCostsOfTrajectory(threadId, x_alpha, u_alpha, intermediateCost, finalCost);
+        if (boundCost)
+        {
+            // the intermediate cost has been accumulated during the rollout already
+            intermediateCost = intermediateCostBounded;
+            costFunctions_[threadId]->setCurrentStateAndControl(
+                x_alpha[K_], control_vector_t::Zero(), settings_.dt * K_);
+            finalCost = costFunctions_[threadId]->evaluateTerminal();
+        }
+        else
+            computeCostsOfTrajectory(threadId, x_alpha, u_alpha, intermediateCost, finalCost);
 
         if (terminationFlag && *terminationFlag)
             return;
@@ -1176,13 +1292,60 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     {
         if (settings_.debugPrint)
         {
-            std::string msg = std::string("dynamics not good, thread: ") + std::to_string(threadId);
+            std::string msg = std::string("dynamics not good or rollout aborted, thread: ") + std::to_string(threadId);
             std::cout << msg << std::endl;
         }
     }
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::acceptLineSearchWorkspace(
+    LineSearchWorkspace& workspace)
+{
+    x_.swap(workspace.x);
+    xShot_.swap(workspace.xShot);
+    u_ff_.swap(workspace.u_ff);
+    d_.swap(workspace.d);
+    substepsX_.swap(workspace.substepsX);
+    substepsU_.swap(workspace.substepsU);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::reserveSubsteps()
+{
+    size_t numSubsteps = 0;
+    for (int k = 0; k < K_; k++)
+    {
+        if ((*substepsX_)[k])
+            numSubsteps = std::max(numSubsteps, (*substepsX_)[k]->size());
+        if ((*substepsU_)[k])
+            numSubsteps = std::max(numSubsteps, (*substepsU_)[k]->size());
+    }
+
+    if (numSubsteps == 0)
+        return;
+
+    for (auto& workspace : lineSearchWorkspaces_)
+    {
+        for (int k = 0; k < K_; k++)
+        {
+            StateVectorArrayPtr& x = (*workspace.substepsX)[k];
+            ControlVectorArrayPtr& u = (*workspace.substepsU)[k];
+            if (!x)
+                x = StateVectorArrayPtr(new StateVectorArray);
+            if (!u)
+                u = ControlVectorArrayPtr(new ControlVectorArray);
+            x->reserve(numSubsteps);
+            u->reserve(numSubsteps);
+        }
+    }
+
+    systemInterface_->reserveSubsteps(numSubsteps);
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::acceptStep(const SCALAR alpha,
     const SCALAR intermediateCost,
@@ -1281,8 +1444,9 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 {
     lqpCounter_++;
 
-    // if solver is HPIPM, there's nothing to prepare
-    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
+    // if solver is HPIPM or the partitioned Riccati solver, there's nothing to prepare
+    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER ||
+        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::PARTITIONED_RICCATI_SOLVER)
     {
         // do nothing
     }
@@ -1305,8 +1469,9 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 {
     lqpCounter_++;
 
-    // if solver is HPIPM, solve the full problem
-    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
+    // if solver is HPIPM or the partitioned Riccati solver, solve the full problem
+    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER ||
+        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::PARTITIONED_RICCATI_SOLVER)
     {
         solveFullLQProblem();
     }
@@ -1324,6 +1489,20 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutAndPrepareSolveLQProblem(
+    size_t startIndex,
+    bool rollout)
+{
+    if (rollout)
+        rolloutShots(startIndex, K_ - 1);
+
+    computeLQApproximation(startIndex, K_ - 1);
+
+    prepareSolveLQProblem(startIndex);
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solveFullLQProblem()
 {
@@ -1373,12 +1552,15 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     finalCostBest_ = std::numeric_limits<scalar_t>::infinity();
     intermediateCostPrevious_ = std::numeric_limits<scalar_t>::infinity();
     finalCostPrevious_ = std::numeric_limits<scalar_t>::infinity();
+    realTimeIterationPrepared_ = false;
+    realTimeIterationPending_ = false;
     resetDefects();
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::extractSolution()
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::extractSolution(
+    const state_vector_t& dx0)
 {
     L_.setConstant(core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR>::Zero());  // TODO should eventually go away
     x_ref_lqr_ = x_;
@@ -1393,13 +1575,20 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     *  case: Closed-loop Single Shooting:           compute and retrieve dx, du, L
     *  case: Closed-loop GNMS(M):                   compute and retrieve dx, du, L
     */
+    auto computeStatesAndControls = [this, &dx0]() {
+        if (dx0.isZero(0))
+            lqocSolver_->computeStatesAndControls();
+        else
+            lqocSolver_->forwardSubstitution(dx0);
+    };
+
     switch (settings_.nlocp_algorithm)
     {
         case NLOptConSettings::NLOCP_ALGORITHM::GNMS:
         case NLOptConSettings::NLOCP_ALGORITHM::GNMS_M_OL:
         case NLOptConSettings::NLOCP_ALGORITHM::SS_OL:
         {
-            lqocSolver_->computeStatesAndControls();
+            computeStatesAndControls();
             delta_u_ff_ = lqocSolver_->getSolutionControl();
             delta_x_ = lqocSolver_->getSolutionState();
             delta_x_ref_lqr_.setConstant(ct::core::StateVector<STATE_DIM, SCALAR>::Zero());
@@ -1417,7 +1606,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         }
         case NLOptConSettings::NLOCP_ALGORITHM::MS_ILQR:
         {
-            lqocSolver_->computeStatesAndControls();
+            computeStatesAndControls();
             delta_x_ = lqocSolver_->getSolutionState();
             delta_x_ref_lqr_.setConstant(ct::core::StateVector<STATE_DIM, SCALAR>::Zero());
             lqocSolver_->compute_lv();
@@ -1429,7 +1618,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         case NLOptConSettings::NLOCP_ALGORITHM::SS_CL:
         case NLOptConSettings::NLOCP_ALGORITHM::GNMS_M_CL:
         {
-            lqocSolver_->computeStatesAndControls();
+            computeStatesAndControls();
             delta_u_ff_ = lqocSolver_->getSolutionControl();
             delta_x_ = lqocSolver_->getSolutionState();
             delta_x_ref_lqr_ = delta_x_;
@@ -1443,6 +1632,93 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::prepareRealTimeIteration()
+{
+    if (!settings_.realTimeIteration)
+        throw std::runtime_error("prepareRealTimeIteration() requires NLOptConSettings::realTimeIteration.");
+
+    completeRealTimeIteration();
+
+    resetDefects();
+
+    setInputBoxConstraintsForLQOCProblem();
+    setStateBoxConstraintsForLQOCProblem();
+
+    // including stage 0, which gets linearized around the initial state of the warm-start
+    if (settings_.pipelinedMultipleShooting)
+        rolloutAndPrepareSolveLQProblem(0, true);
+    else
+    {
+        rolloutShots(0, K_ - 1);
+        computeLQApproximation(0, K_ - 1);
+        prepareSolveLQProblem(0);
+    }
+
+    updateCosts();
+    computeDefectsNorm();
+
+    x0RealTimeIteration_ = x_[0];
+    realTimeIterationPrepared_ = true;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::feedbackRealTimeIteration()
+{
+    if (!realTimeIterationPrepared_)
+        throw std::runtime_error("feedbackRealTimeIteration() called without prior prepareRealTimeIteration().");
+
+    realTimeIterationPrepared_ = false;
+
+    dx0RealTimeIteration_ = x_[0] - x0RealTimeIteration_;
+    u0RealTimeIteration_ = u_ff_[0];
+
+    // first stage of the forward substitution, du_0 = lv_0 + L_0 * dx_0
+    const feedback_matrix_t& L0 = lqocSolver_->getSolutionFeedback()[0];
+    switch (settings_.nlocp_algorithm)
+    {
+        case NLOptConSettings::NLOCP_ALGORITHM::MS_ILQR:
+        {
+            // the feedback term is part of the policy
+            u_ff_[0] += lqocSolver_->get_lv()[0];
+            L_[0] = L0;
+            break;
+        }
+        case NLOptConSettings::NLOCP_ALGORITHM::GNMS_M_CL:
+        {
+            u_ff_[0] += lqocSolver_->get_lv()[0] + L0 * dx0RealTimeIteration_;
+            L_[0] = L0;
+            break;
+        }
+        default:
+            u_ff_[0] += lqocSolver_->get_lv()[0] + L0 * dx0RealTimeIteration_;
+    }
+
+    realTimeIterationPending_ = true;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::completeRealTimeIteration()
+{
+    if (!realTimeIterationPending_)
+        return false;
+
+    realTimeIterationPending_ = false;
+
+    // go back to the linearization point, the full step then lands exactly on the new initial state
+    x_[0] = x0RealTimeIteration_;
+    u_ff_[0] = u0RealTimeIteration_;
+
+    extractSolution(dx0RealTimeIteration_);
+
+    doFullStepUpdate();
+
+    return true;
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::doFullStepUpdate()
 {
@@ -1671,5 +1947,12 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getSe
     return settings_;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+auto NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getLQOCSolver() const
+    -> const std::shared_ptr<LQOCSolver_t>&
+{
+    return lqocSolver_;
+}
+
 }  // namespace optcon
 }  // namespace ct
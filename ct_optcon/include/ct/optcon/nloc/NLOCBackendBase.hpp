@@ -13,6 +13,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/optcon/problem/LQOCProblem.hpp>
 
 #include <ct/optcon/solver/lqp/GNRiccatiSolver.hpp>
+#include <ct/optcon/solver/lqp/PartitionedRiccatiSolver.hpp>
 #include <ct/optcon/solver/lqp/HPIPMInterface.hpp>
 
 #include <ct/optcon/solver/NLOptConSettings.hpp>
@@ -132,6 +133,9 @@ public:
     //! get the current SLQsolver settings
     const Settings_t& getSettings() const;
 
+    //! get the solver for the linear-quadratic subproblems
+    const std::shared_ptr<LQOCSolver_t>& getLQOCSolver() const;
+
     /*!
      * Set the initial guess used by the solver (not all solvers might support initial guesses)
      */
@@ -315,11 +319,43 @@ public:
      */
     virtual void solveFullLQProblem();
 
+    /*!
+     * rollout the shots starting at or after startIndex (optional), compute the LQ approximation and perform the
+     * prepare stage of the LQ solver for all stages from startIndex to the end of the horizon.
+     * The default implementation executes these phases one after the other, backends may overlap them.
+     */
+    virtual void rolloutAndPrepareSolveLQProblem(size_t startIndex, bool rollout);
+
     /**
      * @brief extract relevant quantities for the following rollout/solution update step from the LQ solver
      * @note not all algorithms require all data updates, hence the separation.
+     * @param dx0 increment of the initial state since the LQ problem was set up, only non-zero in real-time iterations
+     */
+    void extractSolution(const state_vector_t& dx0 = state_vector_t::Zero());
+
+    /*!
+     * @brief preparation phase of a real-time iteration, see NLOptConSettings::realTimeIteration
+     *
+     * Rolls out all shots, computes the LQ approximation of all stages and runs the full Riccati backward sweep
+     * around the current initial state. None of this depends on the next initial state measurement.
+     */
+    void prepareRealTimeIteration();
+
+    /*!
+     * @brief feedback phase of a real-time iteration
+     *
+     * Substitutes the difference between the initial state set through changeInitialState() and the one the
+     * iteration was prepared for into the feedback law of the first stage and updates the first control only. The
+     * effort is independent of the horizon length. The remaining stages of the solution still hold the previous
+     * iterate until completeRealTimeIteration() is called, at the latest by the next prepareRealTimeIteration().
+     */
+    void feedbackRealTimeIteration();
+
+    /*!
+     * @brief forward substitution through the remaining stages and full step update deferred by the feedback phase
+     * @return true if there was a deferred update, false if there was nothing to complete
      */
-    void extractSolution();
+    bool completeRealTimeIteration();
 
     //! compute costs of solution candidate
     void updateCosts();
@@ -372,6 +408,25 @@ public:
         ControlSubsteps& substepsU,
         std::atomic_bool* terminationFlag = nullptr) const;
 
+    /*!
+     * @brief single threaded rollout of all shots which accumulates the intermediate cost and defects on the fly
+     *
+     * Since the stage costs are assumed non-negative, the partial merit is a lower bound on the final merit. The
+     * rollout is aborted as soon as it exceeds meritBound, in which case the candidate cannot be accepted anyway.
+     * @return false if the dynamics are unstable or the rollout got aborted
+     */
+    bool rolloutShotsWithCostBound(size_t threadId,
+        ControlVectorArray& u_ff_local,
+        StateVectorArray& x_local,
+        const StateVectorArray& x_ref_lqr,
+        StateVectorArray& xShot,
+        StateVectorArray& d,
+        StateSubsteps& substepsX,
+        ControlSubsteps& substepsU,
+        const scalar_t meritBound,
+        scalar_t& intermediateCost,
+        std::atomic_bool* terminationFlag = nullptr) const;
+
     //! performLineSearch: execute the line search, possibly with different threading schemes
     virtual SCALAR performLineSearch() = 0;
 
@@ -383,7 +438,13 @@ public:
     const SummaryAllIterations<SCALAR>& getSummary() const;
 
 protected:
-    //! integrate the individual shots
+    /*!
+     * @brief integrate the individual shots
+     *
+     * If stageCostSum is given, the stage costs of the shot are added to it stage by stage and the rollout is aborted
+     * as soon as the sum reaches stageCostBound.
+     * @return false if the dynamics are unstable or the rollout got aborted
+     */
     bool rolloutSingleShot(const size_t threadId,
         const size_t k,
         ControlVectorArray& u_ff_local,
@@ -392,7 +453,9 @@ protected:
         StateVectorArray& xShot,
         StateSubsteps& substepsX,
         ControlSubsteps& substepsU,
-        std::atomic_bool* terminationFlag = nullptr) const;
+        std::atomic_bool* terminationFlag = nullptr,
+        scalar_t* stageCostSum = nullptr,
+        const scalar_t stageCostBound = std::numeric_limits<scalar_t>::max()) const;
 
 
     //! computes the defect between shot and trajectory
@@ -436,8 +499,9 @@ protected:
     /*!
      * This function initializes the cost-to-go function at time K.
      *
+     * @param threadId thread-local cost function and constraints to use
      */
-    void initializeCostToGo();
+    void initializeCostToGo(size_t threadId);
 
     //! Computes cost to go
     /*!
@@ -497,21 +561,67 @@ protected:
         const ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>& u_local,
         scalar_t& e_tot) const;
 
-    //! Check if controller with particular alpha is better
+    /*!
+     * @brief memory for evaluating a line search candidate
+     *
+     * The backend owns one workspace per thread, which is sized on changeTimeHorizon() and reused for every line search
+     * candidate. If a candidate is accepted, its trajectories are swapped with the current solution, such that the
+     * workspace afterwards holds the previous solution and no memory is allocated in either case.
+     */
+    struct LineSearchWorkspace
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        LineSearchWorkspace() : substepsX(new StateSubsteps), substepsU(new ControlSubsteps) {}
+
+        //! resize all trajectories for a problem with K stages
+        void resize(int K)
+        {
+            x.resize(K + 1);
+            xShot.resize(K + 1);
+            d.resize(K + 1);
+            x_ref_lqr.resize(K + 1);
+            u_ff.resize(K);
+            substepsX->resize(K + 1);
+            substepsU->resize(K + 1);
+        }
+
+        StateVectorArray x;
+        StateVectorArray xShot;
+        StateVectorArray d;
+        StateVectorArray x_ref_lqr;
+        ControlVectorArray u_ff;
+        StateSubstepsPtr substepsX;
+        ControlSubstepsPtr substepsU;
+    };
+
+    //! Check if controller with particular alpha is better, the trajectories of the candidate are stored in workspace
+    /*!
+     * If cost bounding is enabled in the line search settings, the rollout is aborted once the candidate's merit
+     * provably exceeds meritBound.
+     */
     void executeLineSearch(const size_t threadId,
         const scalar_t alpha,
-        ct::core::StateVectorArray<STATE_DIM, SCALAR>& x_recorded,
-        ct::core::StateVectorArray<STATE_DIM, SCALAR>& x_shot_recorded,
-        ct::core::StateVectorArray<STATE_DIM, SCALAR>& defects_recorded,
-        ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>& u_recorded,
+        LineSearchWorkspace& workspace,
         scalar_t& intermediateCost,
         scalar_t& finalCost,
         scalar_t& defectNorm,
         scalar_t& e_box_norm,
         scalar_t& e_gen_norm,
-        StateSubsteps& substepsX,
-        ControlSubsteps& substepsU,
-        std::atomic_bool* terminationFlag = nullptr) const;
+        std::atomic_bool* terminationFlag = nullptr,
+        const scalar_t meritBound = std::numeric_limits<scalar_t>::max()) const;
+
+    //! make the line search candidate in the workspace the current solution
+    void acceptLineSearchWorkspace(LineSearchWorkspace& workspace);
+
+    /*!
+     * \brief reserve the substep containers of all workspaces and integrators for the recorded number of substeps
+     *
+     * The number of substeps per stage is only known after the first rollout. The substep containers are swapped
+     * between the integrators and the stages of the workspaces, hence all of them need to be reserved up front,
+     * independent of which threads get to integrate which stage.
+     */
+    void reserveSubsteps();
 
 
     //! in case of line-search compute new merit and check if to accept step. Returns true if accept step
@@ -577,6 +687,9 @@ protected:
     StateSubstepsPtr substepsX_;    //! state substeps recorded by integrator during rollouts
     ControlSubstepsPtr substepsU_;  //! control substeps recorded by integrator during rollouts
 
+    //! line search memory, one instance per thread
+    std::vector<LineSearchWorkspace, Eigen::aligned_allocator<LineSearchWorkspace>> lineSearchWorkspaces_;
+
     SCALAR d_norm_;      //! sum of the norms of all defects (internal constraint)
     SCALAR e_box_norm_;  //! sum of the norms of all box constraint violations
     SCALAR e_gen_norm_;  //! sum of the norms of all general constraint violations
@@ -614,11 +727,26 @@ protected:
     //! a counter used to identify lqp problems in derived classes, i.e. for thread management in MP
     size_t lqpCounter_;
 
+    //! initial state around which the current real-time iteration was prepared
+    state_vector_t x0RealTimeIteration_;
+    bool realTimeIterationPrepared_;
+
+    //! initial state increment and first control before the feedback phase, kept for the deferred update
+    state_vector_t dx0RealTimeIteration_;
+    control_vector_t u0RealTimeIteration_;
+    bool realTimeIterationPending_;
+
     //! The policy. currently only for returning the result, should eventually replace L_ and u_ff_ (todo)
     NLOCBackendBase::Policy_t policy_;
 
     SummaryAllIterations<SCALAR> summaryAllIterations_;
 
+    //! value of the heap allocation counter when the previous summary was recorded
+    size_t heapAllocationsPrevious_;
+
+    //! number of line search rollouts aborted by the cost bound since the previous summary was recorded
+    mutable std::atomic<size_t> prunedLineSearchCandidates_;
+
     //! if building with MATLAB support, include matfile
 #ifdef MATLAB
     matlab::MatFile matFile_;
@@ -18,6 +18,20 @@ NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCBac
     startupRoutine();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCBackendMP(
+    const OptConProblem_t& optConProblem,
+    const NLOptConSettings& settings,
+    const std::shared_ptr<ct::core::TaskPool>& taskPool)
+    : Base(optConProblem, settings), taskPool_(taskPool)
+{
+    // the thread-local instances of the base class are indexed by the thread ids of the pool
+    if (!taskPool_ || taskPool_->getNumThreads() != static_cast<size_t>(this->settings_.nThreads))
+        throw std::runtime_error("NLOCBackendMP: the task pool needs to have settings.nThreads workers.");
+
+    startupRoutine();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCBackendMP(
     const OptConProblem_t& optConProblem,
@@ -33,178 +47,79 @@ NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCBac
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::~NLOCBackendMP()
 {
-    shutdownRoutine();
+#ifdef DEBUG_PRINT_MP
+    std::cout << "Shutting down task pool" << std::endl;
+#endif  // DEBUG_PRINT_MP
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::startupRoutine()
 {
-    launchWorkerThreads();
-}
+    if (!taskPool_)
+        taskPool_ = std::shared_ptr<ct::core::TaskPool>(new ct::core::TaskPool(this->settings_.nThreads));
 
+    alphaExpOfThread_.resize(taskPool_->getNumThreads() + 1);
+    candidateTerminated_ = std::vector<std::atomic_bool>(taskPool_->getNumThreads() + 1);
 
-template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::shutdownRoutine()
-{
-    workersActive_ = false;
-    workerTask_ = SHUTDOWN;
-    workerWakeUpCondition_.notify_all();
+    shareTaskPool();
 
 #ifdef DEBUG_PRINT_MP
-    std::cout << "Shutting down workers" << std::endl;
-#endif  // DEBUG_PRINT_MP
-
-    for (size_t i = 0; i < workerThreads_.size(); i++)
-    {
-        workerThreads_[i].join();
-    }
-
-#ifdef DEBUG_PRINT_MP
-    std::cout << "All workers shut down" << std::endl;
-#endif  // DEBUG_PRINT_MP
+    printString("[MP]: Launched task pool with " + std::to_string(taskPool_->getNumThreads()) + " workers.");
+#endif  //DEBUG_PRINT_MP
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::threadWork(size_t threadId)
+void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::configure(
+    const typename Base::Settings_t& settings)
 {
-#ifdef DEBUG_PRINT_MP
-    printString("[Thread " + std::to_string(threadId) + "]: launched");
-#endif  // DEBUG_PRINT_MP
-
-
-    // local variables
-    int workerTask_local = IDLE;
-    size_t uniqueProcessID = 0;
-    size_t iteration_local = this->iteration_;
-    size_t lqpCounter_local = this->lqpCounter_;
+    Base::configure(settings);
 
+    // the LQ solver gets replaced on every configuration
+    shareTaskPool();
+}
 
-    while (workersActive_)
-    {
-        workerTask_local = workerTask_.load();
-        iteration_local = this->iteration_;
-        lqpCounter_local = this->lqpCounter_;
-
-#ifdef DEBUG_PRINT_MP
-        printString("[Thread " + std::to_string(threadId) + "]: previous procId: " + std::to_string(uniqueProcessID) +
-                    ", current procId: " +
-                    std::to_string(generateUniqueProcessID(iteration_local, (int)workerTask_local, lqpCounter_local)));
-#endif
-
-
-        /*!
-         * We want to put the worker to sleep if
-         * - the workerTask_ is IDLE
-         * - or we are finished but workerTask_ is not yet reset, thus the process ID is still the same
-         * */
-        if (workerTask_local == IDLE ||
-            uniqueProcessID == generateUniqueProcessID(iteration_local, (int)workerTask_local, lqpCounter_local))
-        {
-#ifdef DEBUG_PRINT_MP
-            printString("[Thread " + std::to_string(threadId) + "]: going to sleep !");
-#endif
-
-            // sleep until the state is not IDLE any more and we have a different process ID than before
-            std::unique_lock<std::mutex> waitLock(workerWakeUpMutex_);
-            while (workerTask_ == IDLE || (uniqueProcessID == generateUniqueProcessID(this->iteration_,
-                                                                  (int)workerTask_.load(), this->lqpCounter_)))
-            {
-                workerWakeUpCondition_.wait(waitLock);
-            }
-            waitLock.unlock();
 
-            workerTask_local = workerTask_.load();
-            iteration_local = this->iteration_;
-            lqpCounter_local = this->lqpCounter_;
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::shareTaskPool()
+{
+    auto partitionedSolver =
+        std::dynamic_pointer_cast<PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(this->lqocSolver_);
 
-#ifdef DEBUG_PRINT_MP
-            printString("[Thread " + std::to_string(threadId) + "]: woke up !");
-#endif  // DEBUG_PRINT_MP
-        }
+    // the base class configures the solver before the task pool exists
+    if (partitionedSolver && taskPool_)
+        partitionedSolver->setTaskPool(taskPool_);
+}
 
-        if (!workersActive_)
-        {
-#ifdef DEBUG_PRINT_MP
-            printString("Breaking - workers are not active !");
-#endif  // DEBUG_PRINT_MP
-            break;
-        }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::shared_ptr<ct::core::TaskPool>&
+NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getTaskPool() const
+{
+    return taskPool_;
+}
 
-        switch (workerTask_local)
-        {
-            case LINE_SEARCH:
-            {
-#ifdef DEBUG_PRINT_MP
-                printString("[Thread " + std::to_string(threadId) + "]: now busy with LINE_SEARCH !");
-#endif  // DEBUG_PRINT_MP
-                lineSearchWorker(threadId);
-                uniqueProcessID = generateUniqueProcessID(iteration_local, LINE_SEARCH, lqpCounter_local);
-                break;
-            }
-            case ROLLOUT_SHOTS:
-            {
-#ifdef DEBUG_PRINT_MP
-                printString("[Thread " + std::to_string(threadId) + "]: now doing shot rollouts !");
-#endif  // DEBUG_PRINT_MP
-                rolloutShotWorker(threadId);
-                uniqueProcessID = generateUniqueProcessID(iteration_local, ROLLOUT_SHOTS, lqpCounter_local);
-                break;
-            }
-            case COMPUTE_LQ_PROBLEM:
-            {
-#ifdef DEBUG_PRINT_MP
-                printString("[Thread " + std::to_string(threadId) + "]: now doing LQ approximation !");
-#endif  // DEBUG_PRINT_MP
-                computeLQProblemWorker(threadId);
-                uniqueProcessID = generateUniqueProcessID(iteration_local, COMPUTE_LQ_PROBLEM, lqpCounter_local);
-                break;
-            }
-            case SHUTDOWN:
-            {
-#ifdef DEBUG_PRINT_MP
-                printString("[Thread " + std::to_string(threadId) + "]: now shutting down !");
-#endif  // DEBUG_PRINT_MP
-                return;
-                break;
-            }
-            case IDLE:
-            {
-#ifdef DEBUG_PRINT_MP
-                printString("[Thread " + std::to_string(threadId) + "]: is idle. Now going to sleep.");
-#endif  // DEBUG_PRINT_MP
-                break;
-            }
-            default:
-            {
-                printString("[Thread " + std::to_string(threadId) + "]: WARNING: Worker has unknown task !");
-                break;
-            }
-        }
-    }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::disableEigenThreading()
+{
+    // Eigen multi-threading is a global setting, only touch it if it was enabled
+    if (this->settings_.nThreadsEigen > 1)
+        Eigen::setNbThreads(1);
 #ifdef DEBUG_PRINT_MP
-    printString("[Thread " + std::to_string(threadId) + "]: shut down.");
-#endif  // DEBUG_PRINT_MP
+    printString("[MP]: Restricting Eigen to " + std::to_string(Eigen::nbThreads()) + " threads.");
+#endif  //DEBUG_PRINT_MP
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::launchWorkerThreads()
+void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::restoreEigenThreading()
 {
+    if (this->settings_.nThreadsEigen > 1)
+        Eigen::setNbThreads(this->settings_.nThreadsEigen);
 #ifdef DEBUG_PRINT_MP
-    printString("[MP]: Going to launch worker threads!");
-    std::cout << workersActive_.load() << std::endl;
+    printString("[MP]: Restoring " + std::to_string(Eigen::nbThreads()) + " Eigen threads.");
 #endif  //DEBUG_PRINT_MP
-
-    workersActive_ = true;
-    workerTask_ = IDLE;
-
-    for (int i = 0; i < (int)this->settings_.nThreads; i++)
-    {
-        workerThreads_.push_back(std::thread(&NLOCBackendMP::threadWork, this, i));
-    }
 }
 
 
@@ -214,17 +129,17 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
 {
     // fill terminal cost
     if (lastIndex == (static_cast<size_t>(this->K_) - 1))
-        this->initializeCostToGo();
+        this->initializeCostToGo(this->settings_.nThreads);
 
     /*
 	 * In special cases, this function may be called for a single index, e.g. for the unconstrained GNMS real-time iteration scheme.
-	 * Then, don't wake up workers, but do single-threaded computation for that single index, and return.
+	 * Then, don't dispatch tasks, but do single-threaded computation for that single index, and return.
 	 */
     if (lastIndex == firstIndex)
     {
 #ifdef DEBUG_PRINT_MP
         printString("[MP]: do single threaded LQ approximation for single index " + std::to_string(firstIndex) +
-                    ". Not waking up workers.");
+                    ". Not dispatching tasks.");
 #endif  //DEBUG_PRINT_MP
         this->executeLQApproximation(this->settings_.nThreads, firstIndex);
         if (this->generalConstraints_[this->settings_.nThreads] != nullptr)
@@ -233,78 +148,21 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
     }
 
     /*
-	 * In case of multiple points to perform LQ-approximation, start multi-threading:
+	 * In case of multiple points to perform LQ-approximation, distribute chunks of stages over the task pool.
+	 * The stages are handed out backwards.
 	 */
-    Eigen::setNbThreads(1);  // disable Eigen multi-threading
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Restricting Eigen to " + std::to_string(Eigen::nbThreads()) + " threads.");
-#endif  //DEBUG_PRINT_MP
-
-    kTaken_ = 0;
-    kCompleted_ = 0;
-    KMax_ = lastIndex;
-    KMin_ = firstIndex;
-
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Waking up workers to do LQ approximation.");
-#endif  //DEBUG_PRINT_MP
-    workerTask_ = COMPUTE_LQ_PROBLEM;
-    workerWakeUpCondition_.notify_all();
+    disableEigenThreading();
 
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Will sleep now until done with LQ approximation.");
-#endif  //DEBUG_PRINT_MP
-
-    std::unique_lock<std::mutex> waitLock(kCompletedMutex_);
-    kCompletedCondition_.wait(waitLock, [this] { return kCompleted_.load() > KMax_ - KMin_; });
-    waitLock.unlock();
-    workerTask_ = IDLE;
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Woke up again, should have computed LQ approximation now.");
-#endif  //DEBUG_PRINT_MP
-
-
-    Eigen::setNbThreads(this->settings_.nThreadsEigen);  // restore Eigen multi-threading
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Restoring " + std::to_string(Eigen::nbThreads()) + " Eigen threads.");
-#endif  //DEBUG_PRINT_MP
-}
-
-
-template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeLQProblemWorker(size_t threadId)
-{
-    while (true)
-    {
-        const size_t k = kTaken_++;
-
-        if (k > KMax_ - KMin_)
-        {
-#ifdef DEBUG_PRINT_MP
-            if ((k + 1) % 100 == 0)
-                printString("k > KMax_ - KMin_ with k =  " + std::to_string(k) + " and KMax_ is " +
-                            std::to_string(KMax_) + " and KMin_ is " + std::to_string(KMin_));
-#endif
-
-            //kCompleted_++;
-            if (kCompleted_.load() > KMax_ - KMin_)
-                kCompletedCondition_.notify_all();
-            return;
-        }
-
-#ifdef DEBUG_PRINT_MP
-        if ((k + 1) % 100 == 0)
-            printString("[Thread " + std::to_string(threadId) + "]: Building LQ problem for index k " +
-                        std::to_string(KMax_ - k));
-#endif
+    taskPool_->parallelFor(firstIndex, lastIndex,
+        [this](size_t threadId, size_t k) {
+            this->executeLQApproximation(threadId, k);
 
-        this->executeLQApproximation(threadId, KMax_ - k);
+            if (this->generalConstraints_[threadId] != nullptr)
+                this->computeLinearizedConstraints(threadId, k);
+        },
+        0 /* automatic chunk size */, true /* backwards */);
 
-        if (this->generalConstraints_[threadId] != nullptr)
-            this->computeLinearizedConstraints(threadId, KMax_ - k);  // linearize constraints backwards
-
-        kCompleted_++;
-    }
+    restoreEigenThreading();
 }
 
 
@@ -314,13 +172,13 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::ro
 {
     /*!
 	 * In special cases, this function may be called for a single index, e.g. for the unconstrained GNMS real-time iteration scheme.
-	 * Then, don't wake up workers, but do single-threaded computation for that single index, and return.
+	 * Then, don't dispatch tasks, but do single-threaded computation for that single index, and return.
 	 */
     if (lastIndex == firstIndex)
     {
 #ifdef DEBUG_PRINT_MP
         printString("[MP]: do single threaded shot rollout for single index " + std::to_string(firstIndex) +
-                    ". Not waking up workers.");
+                    ". Not dispatching tasks.");
 #endif  //DEBUG_PRINT_MP
 
         this->rolloutSingleShot(this->settings_.nThreads, firstIndex, this->u_ff_, this->x_, this->x_ref_lqr_,
@@ -330,85 +188,120 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::ro
         return;
     }
 
-    /*!
-	 * In case of multiple points to be linearized, start multi-threading:
-	 */
-    Eigen::setNbThreads(1);  // disable Eigen multi-threading
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Restricting Eigen to " + std::to_string(Eigen::nbThreads()) + " threads.");
-#endif  //DEBUG_PRINT_MP
-
+    //! only rollout when we're meeting the beginning of a shot
+    const size_t stepsPerShot = (size_t)this->getNumStepsPerShot();
+    const size_t firstShot = (firstIndex + stepsPerShot - 1) / stepsPerShot;
+    const size_t lastShot = lastIndex / stepsPerShot;
 
-    kTaken_ = 0;
-    kCompleted_ = 0;
-    KMax_ = lastIndex;
-    KMin_ = firstIndex;
+    if (lastShot < firstShot)
+        return;
 
+    disableEigenThreading();
 
-#ifdef DEBUG_PRINT_MP
-    std::cout << "[MP]: Waking up workers to do shot rollouts." << std::endl;
-#endif  //DEBUG_PRINT_MP
-    workerTask_ = ROLLOUT_SHOTS;
-    workerWakeUpCondition_.notify_all();
+    // every shot is one task, shots are usually expensive enough to not require chunking
+    taskPool_->parallelFor(firstShot, lastShot,
+        [this, stepsPerShot](size_t threadId, size_t shot) {
+            const size_t kShot = shot * stepsPerShot;
 
-#ifdef DEBUG_PRINT_MP
-    std::cout << "[MP]: Will sleep now until we have rolled out all shots." << std::endl;
-#endif  //DEBUG_PRINT_MP
+            this->rolloutSingleShot(threadId, kShot, this->u_ff_, this->x_, this->x_ref_lqr_, this->xShot_,
+                *this->substepsX_, *this->substepsU_);
 
-    std::unique_lock<std::mutex> waitLock(kCompletedMutex_);
-    kCompletedCondition_.wait(waitLock, [this] { return kCompleted_.load() > KMax_ - KMin_; });
-    waitLock.unlock();
-    workerTask_ = IDLE;
-#ifdef DEBUG_PRINT_MP
-    std::cout << "[MP]: Woke up again, should have rolled out all shots now." << std::endl;
-#endif  //DEBUG_PRINT_MP
+            this->computeSingleDefect(kShot, this->x_, this->xShot_, this->d_);
+        },
+        1, true /* backwards */);
 
-    Eigen::setNbThreads(this->settings_.nThreadsEigen);  // restore Eigen multi-threading
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Restoring " + std::to_string(Eigen::nbThreads()) + " Eigen threads.");
-#endif  //DEBUG_PRINT_MP
+    restoreEigenThreading();
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutShotWorker(size_t threadId)
+void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutAndPrepareSolveLQProblem(
+    size_t startIndex,
+    bool rollout)
 {
-    while (true)
+    const size_t K = static_cast<size_t>(this->K_);
+
+    // HPIPM solves the full problem at once, there is no backward sweep to overlap with
+    if (!this->settings_.pipelinedMultipleShooting ||
+        this->settings_.lqocp_solver != NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER || startIndex >= K)
     {
-        size_t k = kTaken_++;
+        Base::rolloutAndPrepareSolveLQProblem(startIndex, rollout);
+        return;
+    }
 
-        if (k > KMax_ - KMin_)
-        {
-            if (kCompleted_.load() > KMax_ - KMin_)
-                kCompletedCondition_.notify_all();
-            return;
-        }
+    const size_t stepsPerShot = (size_t)this->getNumStepsPerShot();
+    const size_t firstShot = startIndex / stepsPerShot;
+    const size_t lastShot = (K - 1) / stepsPerShot;
 
-        size_t kShot = (KMax_ - k);
-        if (kShot % ((size_t)this->getNumStepsPerShot()) ==
-            0)  //! only rollout when we're meeting the beginning of a shot
-        {
-#ifdef DEBUG_PRINT_MP
-            if ((k + 1) % 100 == 0)
-                printString("[Thread " + std::to_string(threadId) + "]: rolling out shot with index " +
-                            std::to_string(KMax_ - k));
-#endif
+    this->lqpCounter_++;
+    this->lqocSolver_->setProblem(this->lqocProblem_);
 
-            this->rolloutSingleShot(threadId, kShot, this->u_ff_, this->x_, this->x_ref_lqr_, this->xShot_,
-                *this->substepsX_, *this->substepsU_);
+    // one latch per shot, it opens once the shot is rolled out and all its stages are linearized
+    if (shotDone_.size() != lastShot + 1)
+        shotDone_ = std::vector<ct::core::TaskLatch>(lastShot + 1);
 
-            this->computeSingleDefect(kShot, this->x_, this->xShot_, this->d_);
-        }
+    disableEigenThreading();
 
-        kCompleted_++;
+    // dispatch the shots backwards, such that the tail is available to the backward sweep first
+    for (size_t shot = lastShot + 1; shot-- > firstShot;)
+    {
+        taskPool_->submit(
+            [this, shot, lastShot, stepsPerShot, startIndex, rollout, K](size_t threadId) {
+                const size_t kShot = shot * stepsPerShot;
+                const size_t kEnd = std::min(kShot + stepsPerShot, K);
+
+                //! only rollout when we're meeting the beginning of a shot
+                if (rollout && kShot >= startIndex)
+                {
+                    this->rolloutSingleShot(threadId, kShot, this->u_ff_, this->x_, this->x_ref_lqr_, this->xShot_,
+                        *this->substepsX_, *this->substepsU_);
+
+                    this->computeSingleDefect(kShot, this->x_, this->xShot_, this->d_);
+                }
+
+                for (size_t k = std::max(kShot, startIndex); k < kEnd; k++)
+                {
+                    this->executeLQApproximation(threadId, k);
+
+                    if (this->generalConstraints_[threadId] != nullptr)
+                        this->computeLinearizedConstraints(threadId, k);
+                }
+
+                // the terminal cost requires the terminal state, which is only available after the last shot
+                if (shot == lastShot)
+                    this->initializeCostToGo(threadId);
+            },
+            shotDone_[shot]);
     }
+
+    /*
+     * Backward sweep on the calling thread. The calling thread does not help out with the shot tasks, since it would
+     * pick them from the back of the deques, i.e. from the beginning of the horizon, and thereby stall the sweep.
+     */
+    const bool onWorker = taskPool_->getCurrentThreadId() < taskPool_->getNumThreads();
+    for (size_t shot = lastShot + 1; shot-- > firstShot;)
+    {
+        // a worker of a shared pool must not block, otherwise the pool may run out of threads for the shot tasks
+        if (onWorker)
+            taskPool_->wait(shotDone_[shot]);
+        else
+            shotDone_[shot].wait();
+
+        const int kFirst = static_cast<int>(std::max(shot * stepsPerShot, startIndex));
+        const int kLast = static_cast<int>(std::min((shot + 1) * stepsPerShot, K)) - 1;
+
+        for (int k = kLast; k >= kFirst; k--)
+            this->lqocSolver_->solveSingleStage(k);
+    }
+
+    restoreEigenThreading();
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 SCALAR NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::performLineSearch()
 {
-    Eigen::setNbThreads(1);  // disable Eigen multi-threading
+    disableEigenThreading();
 
     alphaProcessed_.clear();
     alphaTaken_ = 0;
@@ -416,23 +309,22 @@ SCALAR NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     alphaExpBest_ = this->settings_.lineSearchSettings.maxIterations;
     alphaExpMax_ = this->settings_.lineSearchSettings.maxIterations;
     alphaProcessed_.resize(this->settings_.lineSearchSettings.maxIterations, 0);
+    std::fill(alphaExpOfThread_.begin(), alphaExpOfThread_.end(), alphaExpMax_);
     lowestCostPrevious_ = this->lowestCost_;
 
 #ifdef DEBUG_PRINT_MP
-    std::cout << "[MP]: Waking up workers." << std::endl;
+    std::cout << "[MP]: Dispatching line search tasks." << std::endl;
 #endif  //DEBUG_PRINT_MP
-    workerTask_ = LINE_SEARCH;
-    workerWakeUpCondition_.notify_all();
+
+    // one task per thread, every task keeps on taking the next step size until the best one is found
+    ct::core::TaskLatch latch;
+    const size_t nTasks = std::min<size_t>(alphaExpMax_, taskPool_->getNumThreads() + 1);
+    for (size_t i = 0; i < nTasks; i++)
+        taskPool_->submit([this](size_t threadId) { lineSearchWorker(threadId); }, latch);
+    taskPool_->wait(latch);
 
 #ifdef DEBUG_PRINT_MP
-    std::cout << "[MP]: Will sleep now until done line search." << std::endl;
-#endif  //DEBUG_PRINT_MP
-    std::unique_lock<std::mutex> waitLock(alphaBestFoundMutex_);
-    alphaBestFoundCondition_.wait(waitLock, [this] { return alphaBestFound_.load(); });
-    waitLock.unlock();
-    workerTask_ = IDLE;
-#ifdef DEBUG_PRINT_MP
-    std::cout << "[MP]: Woke up again, should have results now." << std::endl;
+    std::cout << "[MP]: Line search tasks completed, should have results now." << std::endl;
 #endif  //DEBUG_PRINT_MP
 
     double alphaBest = 0.0;
@@ -442,10 +334,7 @@ SCALAR NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
                     std::pow(this->settings_.lineSearchSettings.n_alpha, alphaExpBest_);
     }
 
-    Eigen::setNbThreads(this->settings_.nThreadsEigen);  // restore Eigen multi-threading
-#ifdef DEBUG_PRINT_MP
-    printString("[MP]: Restoring " + std::to_string(Eigen::nbThreads()) + " Eigen threads.");
-#endif  //DEBUG_PRINT_MP
+    restoreEigenThreading();
 
     // update norms, as they are typically different from the pure lqoc solver updates
     this->lu_norm_ = this->template computeDiscreteArrayNorm<ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>, 2>(
@@ -477,6 +366,17 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
             return;
         }
 
+        lineSearchResultMutex_.lock();
+        // a larger step size has been accepted already, this and all remaining candidates would lose against it
+        if (alphaExp > alphaExpBest_)
+        {
+            lineSearchResultMutex_.unlock();
+            return;
+        }
+        alphaExpOfThread_[threadId] = alphaExp;
+        candidateTerminated_[threadId] = false;
+        lineSearchResultMutex_.unlock();
+
         //! convert to real alpha
         double alpha =
             this->settings_.lineSearchSettings.alpha_0 * std::pow(this->settings_.lineSearchSettings.n_alpha, alphaExp);
@@ -488,29 +388,21 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
         SCALAR defectNorm = std::numeric_limits<SCALAR>::max();
         SCALAR e_box_norm = std::numeric_limits<SCALAR>::max();
         SCALAR e_gen_norm = std::numeric_limits<SCALAR>::max();
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_shot_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> defects_recorded(
-            this->K_ + 1, ct::core::StateVector<STATE_DIM, SCALAR>::Zero());
-        ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u_recorded(this->K_);
-        typename Base::StateSubstepsPtr substepsX =
-            typename Base::StateSubstepsPtr(new typename Base::StateSubsteps(this->K_ + 1));
-        typename Base::ControlSubstepsPtr substepsU =
-            typename Base::ControlSubstepsPtr(new typename Base::ControlSubsteps(this->K_ + 1));
-
-        this->executeLineSearch(threadId, alpha, x_search, x_shot_search, defects_recorded, u_recorded,
-            intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, *substepsX, *substepsU, &alphaBestFound_);
+        typename Base::LineSearchWorkspace& workspace = this->lineSearchWorkspaces_[threadId];
+
+        this->executeLineSearch(threadId, alpha, workspace, intermediateCost, finalCost, defectNorm, e_box_norm,
+            e_gen_norm, &candidateTerminated_[threadId], lowestCostPrevious_);
 
         lineSearchResultMutex_.lock();
-        
+
         // check for step acceptance and get new merit/cost
-        bool stepAccepted =
-            this->acceptStep(alpha, intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, lowestCostPrevious_, cost);
+        bool stepAccepted = this->acceptStep(
+            alpha, intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, lowestCostPrevious_, cost);
 
         if (stepAccepted)
         {
-            // make sure we do not alter an existing result
-            if (alphaBestFound_)
+            // make sure we do not alter an existing result or replace a larger accepted step size
+            if (alphaBestFound_ || alphaExp > alphaExpBest_)
             {
                 lineSearchResultMutex_.unlock();
                 break;
@@ -534,12 +426,12 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
             this->e_box_norm_ = e_box_norm;
             this->e_gen_norm_ = e_gen_norm;
             this->lowestCost_ = cost;
-            this->x_.swap(x_search);
-            this->xShot_.swap(x_shot_search);
-            this->u_ff_.swap(u_recorded);
-            this->d_.swap(defects_recorded);
-            this->substepsX_ = substepsX;
-            this->substepsU_ = substepsU;
+            this->acceptLineSearchWorkspace(workspace);
+
+            // cancel all candidates with smaller step sizes, they cannot replace this one anymore
+            for (size_t i = 0; i < candidateTerminated_.size(); i++)
+                if (alphaExpOfThread_[i] > alphaExp)
+                    candidateTerminated_[i] = true;
         }
         else
         {
@@ -577,22 +469,14 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::li
         if (allPreviousAlphasProcessed)
         {
             alphaBestFound_ = true;
-            alphaBestFoundCondition_.notify_all();
+            for (auto& flag : candidateTerminated_)
+                flag = true;
         }
 
         lineSearchResultMutex_.unlock();
     }
 }
 
-template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
-size_t NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::generateUniqueProcessID(
-    const size_t& iterateNo,
-    const int workerState,
-    const size_t resetCount)
-{
-    return (10e12 * (resetCount + 1) + 10e6 * (workerState + 1) + iterateNo + 1);
-}
-
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::printString(const std::string& text)
 {
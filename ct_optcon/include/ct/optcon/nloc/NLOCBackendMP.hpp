@@ -8,9 +8,10 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <iostream>
 #include <memory>
-#include <thread>
+#include <atomic>
 #include <mutex>
-#include <condition_variable>
+
+#include <ct/core/common/TaskPool.h>
 
 #include "NLOCBackendBase.hpp"
 #include <ct/optcon/solver/NLOptConSettings.hpp>
@@ -21,6 +22,9 @@ namespace optcon {
 
 /*!
  * NLOC Backend for the multi-threaded case
+ *
+ * Shot rollouts, the LQ approximation and the line search are executed on a work-stealing task pool with
+ * settings.nThreads workers. The calling thread helps out while waiting for a parallel phase to complete.
  */
 template <size_t STATE_DIM,
     size_t CONTROL_DIM,
@@ -38,6 +42,14 @@ public:
 
     NLOCBackendMP(const OptConProblem_t& optConProblem, const NLOptConSettings& settings);
 
+    /*!
+     * constructor running the parallel phases on an existing task pool, e.g. one pool shared by many backends
+     * @param taskPool pool with settings.nThreads workers
+     */
+    NLOCBackendMP(const OptConProblem_t& optConProblem,
+        const NLOptConSettings& settings,
+        const std::shared_ptr<ct::core::TaskPool>& taskPool);
+
 
     NLOCBackendMP(const OptConProblem_t& optConProblem,
         const std::string& settingsFile,
@@ -47,94 +59,67 @@ public:
     //! destructor
     virtual ~NLOCBackendMP();
 
+    //! configure the solver, a parallel LQ solver gets to run on the task pool of this backend
+    virtual void configure(const typename Base::Settings_t& settings) override;
+
+    //! get the task pool that executes the parallel phases of this backend
+    const std::shared_ptr<ct::core::TaskPool>& getTaskPool() const;
+
 protected:
     virtual void computeLQApproximation(size_t firstIndex, size_t lastIndex) override;
 
     virtual void rolloutShots(size_t firstIndex, size_t lastIndex) override;
 
+    /*!
+     * Pipelined multiple-shooting variant, active if settings.pipelinedMultipleShooting is set and the GNRiccati solver
+     * is used. Every shot is one task which rolls out the shot and linearizes its stages. The calling thread performs the
+     * Riccati backward sweep starting from the tail and processes every shot as soon as its task has completed.
+     */
+    virtual void rolloutAndPrepareSolveLQProblem(size_t startIndex, bool rollout) override;
+
     SCALAR performLineSearch() override;
 
 private:
-    enum WORKER_STATE
-    {
-        IDLE,
-        LINE_SEARCH,
-        ROLLOUT_SHOTS,
-        COMPUTE_LQ_PROBLEM,
-        SHUTDOWN
-    };
-
     void startupRoutine();
 
-    void shutdownRoutine();
+    //! hand the task pool to the LQ solver if it can make use of it
+    void shareTaskPool();
 
-    //! Launch all worker thread
-    /*!
-	  Initializes and launches all worker threads
-	 */
-    void launchWorkerThreads();
+    //! restrict Eigen to a single thread while the task pool is busy (only if Eigen multi-threading is enabled)
+    void disableEigenThreading();
 
-    //! Main function of thread worker
-    /*!
-	  Includes all tasks that a worker will execute
-	 */
-    void threadWork(size_t threadId);
+    //! restore the number of Eigen threads after a parallel section
+    void restoreEigenThreading();
 
     //! Line search for new controller using multi-threading
     /*!
 	  Line searches for the best controller in update direction. If line search is disabled, it just takes the suggested update step.
+	  Executed as task in the task pool, every task keeps taking the next step size until a best step size is found.
+	  Once a step size is accepted, candidates with smaller step sizes are cancelled through their termination flag.
 	 */
     void lineSearchWorker(size_t threadId);
 
-    //! Creates the linear quadratic problem
-    /*!
-	  This function calculates the quadratic costs as provided by the costFunction pointer as well as the linearized dynamics.
-
-	  \param k step k
-	 */
-    void computeLQProblemWorker(size_t threadId);
-
-    //! rolls out a shot and computes the defect
-    void rolloutShotWorker(size_t threadId);
-
-    /*! heuristic that generates a unique id for a process, such that we can manage the tasks.
-	 * Generates a unique identifiers for task, iteration:
-	 * @todo replace by proper hash
-	 * */
-    size_t generateUniqueProcessID(const size_t& iterateNo, const int workerState, const size_t resetCount);
-
     //! wrapper method for nice debug printing
     void printString(const std::string& text);
 
-    std::vector<std::thread> workerThreads_;
-    std::atomic_bool workersActive_;
-    std::atomic_int workerTask_;
-
-    std::mutex workerWakeUpMutex_;
-    std::condition_variable workerWakeUpCondition_;
-
-    std::mutex kCompletedMutex_;
-    std::condition_variable kCompletedCondition_;
-
-    std::mutex kCompletedMutexCost_;
-    std::condition_variable kCompletedConditionCost_;
+    //! work-stealing pool shared by rollouts, LQ approximation and line search
+    std::shared_ptr<ct::core::TaskPool> taskPool_;
 
     std::mutex lineSearchResultMutex_;
-    std::mutex alphaBestFoundMutex_;
-    std::condition_variable alphaBestFoundCondition_;
 
     std::atomic_size_t alphaTaken_;
-    size_t alphaMax_;
     size_t alphaExpBest_;
     size_t alphaExpMax_;
     std::atomic_bool alphaBestFound_;
     std::vector<size_t> alphaProcessed_;
 
-    std::atomic_size_t kTaken_;
-    std::atomic_size_t kCompleted_;
+    //! step size exponent each thread is currently evaluating, guarded by lineSearchResultMutex_
+    std::vector<size_t> alphaExpOfThread_;
+    //! per-thread termination flags, set once the candidate of that thread cannot be the best step size anymore
+    std::vector<std::atomic_bool> candidateTerminated_;
 
-    size_t KMax_;
-    size_t KMin_;
+    //! per-shot latches of the pipelined multiple-shooting sweep, sized to the number of shots
+    std::vector<ct::core::TaskLatch> shotDone_;
 
     SCALAR lowestCostPrevious_;
 };
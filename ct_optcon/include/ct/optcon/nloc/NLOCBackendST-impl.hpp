@@ -40,7 +40,7 @@ void NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
     size_t lastIndex)
 {
     if (lastIndex == static_cast<size_t>(this->K_) - 1)
-        this->initializeCostToGo();
+        this->initializeCostToGo(this->settings_.nThreads);
 
     for (size_t k = firstIndex; k <= lastIndex; k++)
     {
@@ -93,20 +93,10 @@ SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         SCALAR e_box_norm = std::numeric_limits<SCALAR>::max();
         SCALAR e_gen_norm = std::numeric_limits<SCALAR>::max();
 
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_shot_search(this->K_ + 1);
-        ct::core::StateVectorArray<STATE_DIM, SCALAR> defects_recorded(
-            this->K_ + 1, ct::core::StateVector<STATE_DIM, SCALAR>::Zero());
-        ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u_recorded(this->K_);
+        typename Base::LineSearchWorkspace& workspace = this->lineSearchWorkspaces_[this->settings_.nThreads];
 
-        typename Base::StateSubstepsPtr substepsX =
-            typename Base::StateSubstepsPtr(new typename Base::StateSubsteps(this->K_ + 1));
-        typename Base::ControlSubstepsPtr substepsU =
-            typename Base::ControlSubstepsPtr(new typename Base::ControlSubsteps(this->K_ + 1));
-
-
-        this->executeLineSearch(this->settings_.nThreads, alpha, x_search, x_shot_search, defects_recorded, u_recorded,
-            intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, *substepsX, *substepsU);
+        this->executeLineSearch(this->settings_.nThreads, alpha, workspace, intermediateCost, finalCost, defectNorm,
+            e_box_norm, e_gen_norm, nullptr, this->lowestCost_);
 
         // compute new merit and check for step acceptance
         bool stepAccepted =
@@ -145,9 +135,9 @@ SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
             // compute update norms separately, as they are typically different from pure lqoc solver updates
             this->lu_norm_ =
                 this->template computeDiscreteArrayNorm<ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>, 2>(
-                    u_recorded, this->u_ff_prev_);
+                    workspace.u_ff, this->u_ff_prev_);
             this->lx_norm_ = this->template computeDiscreteArrayNorm<ct::core::StateVectorArray<STATE_DIM, SCALAR>, 2>(
-                x_search, this->x_prev_);
+                workspace.x, this->x_prev_);
 
             alphaBest = alpha;
             this->intermediateCostBest_ = intermediateCost;
@@ -155,14 +145,9 @@ SCALAR NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
             this->d_norm_ = defectNorm;
             this->e_box_norm_ = e_box_norm;
             this->e_gen_norm_ = e_gen_norm;
-            this->x_prev_ = x_search;
+            this->x_prev_ = workspace.x;
             this->lowestCost_ = cost;
-            this->x_.swap(x_search);
-            this->xShot_.swap(x_shot_search);
-            this->u_ff_.swap(u_recorded);
-            this->d_.swap(defects_recorded);
-            this->substepsX_ = substepsX;
-            this->substepsU_ = substepsU;
+            this->acceptLineSearchWorkspace(workspace);
             break;
         }
     }  // end while
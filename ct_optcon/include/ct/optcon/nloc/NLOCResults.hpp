@@ -42,6 +42,12 @@ struct SummaryAllIterations
     //! smallest eigenvalues
     std::vector<SCALAR> smallestEigenvalues;
 
+    //! number of heap allocations per iteration, only recorded if ct::core::HeapAllocationCounter is enabled
+    std::vector<size_t> heapAllocations;
+
+    //! number of line search candidates aborted by the cost bound per iteration
+    std::vector<size_t> prunedLineSearchCandidates;
+
     //! print summary of the last iteration with desired numeric precision
     template <int NUM_PRECISION = 12>
     void printSummaryLastIteration()
@@ -60,6 +66,8 @@ struct SummaryAllIterations
         std::cout << std::setprecision(NUM_PRECISION) << "total lx norm:\t" << lx_norms.back() << std::endl;
         std::cout << std::setprecision(NUM_PRECISION) << "total lu norm:\t" << lu_norms.back() << std::endl;
         std::cout << std::setprecision(NUM_PRECISION) << "step-size:\t" << stepSizes.back() << std::endl;
+        if (ct::core::HeapAllocationCounter::isEnabled())
+            std::cout << "heap allocs:\t" << heapAllocations.back() << std::endl;
         std::cout << "                   ===========" << std::endl;
         std::cout << std::endl;
     }
@@ -84,6 +92,8 @@ struct SummaryAllIterations
         matFile_.put("merits", merits);
         matFile_.put("stepSizes", stepSizes);
         matFile_.put("smallestEigenvalues", smallestEigenvalues);
+        matFile_.put("heapAllocations", heapAllocations);
+        matFile_.put("prunedLineSearchCandidates", prunedLineSearchCandidates);
         matFile_.close();
 #endif
     }
@@ -53,32 +53,48 @@ void MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
     int K = this->backend_->getNumSteps();
     int K_shot = this->backend_->getNumStepsPerShot();
 
-    // if first iteration, compute shots and rollout and cost!
-    if (this->backend_->iteration() == 0)
+    if (this->backend_->getSettings().pipelinedMultipleShooting)
     {
-        this->backend_->rolloutShots(K_shot, K - 1);
+        // if first iteration, compute shots and rollout, overlapped with the LQ approximation and the prepare stage
+        auto start = std::chrono::steady_clock::now();
+        this->backend_->rolloutAndPrepareSolveLQProblem(K_shot, this->backend_->iteration() == 0);
+        this->backend_->setInputBoxConstraintsForLQOCProblem();
+        this->backend_->setStateBoxConstraintsForLQOCProblem();
+        auto end = std::chrono::steady_clock::now();
+        if (debugPrint)
+            std::cout << "[MultipleShooting]: pipelined LQ approximation and prepare phase from index " << K_shot
+                      << " to N-1 took " << std::chrono::duration<double, std::milli>(end - start).count() << " ms"
+                      << std::endl;
+    }
+    else
+    {
+        // if first iteration, compute shots and rollout and cost!
+        if (this->backend_->iteration() == 0)
+        {
+            this->backend_->rolloutShots(K_shot, K - 1);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        this->backend_->setInputBoxConstraintsForLQOCProblem();
+        this->backend_->setStateBoxConstraintsForLQOCProblem();
+        this->backend_->computeLQApproximation(K_shot, K - 1);
+        auto end = std::chrono::steady_clock::now();
+        auto diff = end - start;
+        if (debugPrint)
+            std::cout << "[MultipleShooting]: computing LQ Approximation from index " << K_shot << " to N-1 took "
+                      << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
+
+        if (debugPrint)
+            std::cout << "[MultipleShooting]: Solving prepare stage of LQOC Problem" << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        this->backend_->prepareSolveLQProblem(K_shot);
+        end = std::chrono::steady_clock::now();
+        diff = end - start;
+        if (debugPrint)
+            std::cout << "[MultipleShooting]: Prepare phase of LQOC problem took "
+                      << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
     }
-
-    auto start = std::chrono::steady_clock::now();
-    this->backend_->setInputBoxConstraintsForLQOCProblem();
-    this->backend_->setStateBoxConstraintsForLQOCProblem();
-    this->backend_->computeLQApproximation(K_shot, K - 1);
-    auto end = std::chrono::steady_clock::now();
-    auto diff = end - start;
-    if (debugPrint)
-        std::cout << "[MultipleShooting]: computing LQ Approximation from index " << K_shot << " to N-1 took "
-                  << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
-
-    if (debugPrint)
-        std::cout << "[MultipleShooting]: Solving prepare stage of LQOC Problem" << std::endl;
-
-    start = std::chrono::steady_clock::now();
-    this->backend_->prepareSolveLQProblem(K_shot);
-    end = std::chrono::steady_clock::now();
-    diff = end - start;
-    if (debugPrint)
-        std::cout << "[MultipleShooting]: Prepare phase of LQOC problem took "
-                  << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
 
     auto endPrepare = std::chrono::steady_clock::now();
     if (debugPrint)
@@ -175,33 +191,64 @@ void MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
 
     this->backend_->checkProblem();
 
+    if (this->backend_->getSettings().realTimeIteration)
+    {
+        this->backend_->prepareRealTimeIteration();
+
+        // in a real-time iteration, the summary is recorded here, such that the feedback phase stays minimal
+        this->backend_->printSummary();
+
+        auto endPrepare = std::chrono::steady_clock::now();
+        if (debugPrint)
+            std::cout << "[MultipleShooting-MPC]: real-time iteration preparation (rollout, LQ approximation and "
+                         "backward sweep of all stages) took "
+                      << std::chrono::duration<double, std::milli>(endPrepare - startPrepare).count() << " ms"
+                      << std::endl;
+        return;
+    }
+
     int K = this->backend_->getNumSteps();
     int K_shot = this->backend_->getNumStepsPerShot();
 
     this->backend_->resetDefects();
 
-    this->backend_->rolloutShots(K_shot, K - 1);
-
-    auto start = std::chrono::steady_clock::now();
-    this->backend_->setInputBoxConstraintsForLQOCProblem();
-    this->backend_->setStateBoxConstraintsForLQOCProblem();
-    this->backend_->computeLQApproximation(K_shot, K - 1);
-    auto end = std::chrono::steady_clock::now();
-    auto diff = end - start;
-    if (debugPrint)
-        std::cout << "[MultipleShooting-MPC]: computing LQ approximation from index " << K_shot << " to N-1 took "
-                  << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
-
-    if (debugPrint)
-        std::cout << "[MultipleShooting-MPC]: Solving prepare stage of LQOC Problem" << std::endl;
+    if (this->backend_->getSettings().pipelinedMultipleShooting)
+    {
+        auto start = std::chrono::steady_clock::now();
+        this->backend_->rolloutAndPrepareSolveLQProblem(K_shot, true);
+        this->backend_->setInputBoxConstraintsForLQOCProblem();
+        this->backend_->setStateBoxConstraintsForLQOCProblem();
+        auto end = std::chrono::steady_clock::now();
+        if (debugPrint)
+            std::cout << "[MultipleShooting-MPC]: pipelined rollout, LQ approximation and prepare phase from index "
+                      << K_shot << " to N-1 took " << std::chrono::duration<double, std::milli>(end - start).count()
+                      << " ms" << std::endl;
+    }
+    else
+    {
+        this->backend_->rolloutShots(K_shot, K - 1);
 
-    start = std::chrono::steady_clock::now();
-    this->backend_->prepareSolveLQProblem(K_shot);
-    end = std::chrono::steady_clock::now();
-    diff = end - start;
-    if (debugPrint)
-        std::cout << "[MultipleShooting-MPC]: Prepare phase of LQOC problem took "
-                  << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
+        auto start = std::chrono::steady_clock::now();
+        this->backend_->setInputBoxConstraintsForLQOCProblem();
+        this->backend_->setStateBoxConstraintsForLQOCProblem();
+        this->backend_->computeLQApproximation(K_shot, K - 1);
+        auto end = std::chrono::steady_clock::now();
+        auto diff = end - start;
+        if (debugPrint)
+            std::cout << "[MultipleShooting-MPC]: computing LQ approximation from index " << K_shot << " to N-1 took "
+                      << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
+
+        if (debugPrint)
+            std::cout << "[MultipleShooting-MPC]: Solving prepare stage of LQOC Problem" << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        this->backend_->prepareSolveLQProblem(K_shot);
+        end = std::chrono::steady_clock::now();
+        diff = end - start;
+        if (debugPrint)
+            std::cout << "[MultipleShooting-MPC]: Prepare phase of LQOC problem took "
+                      << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
+    }
 
 
     auto endPrepare = std::chrono::steady_clock::now();
@@ -222,6 +269,21 @@ bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
 
     auto startFinish = std::chrono::steady_clock::now();
 
+    if (this->backend_->getSettings().realTimeIteration)
+    {
+        this->backend_->feedbackRealTimeIteration();
+        this->backend_->iteration()++;
+
+        if (debugPrint)
+        {
+            auto endFinish = std::chrono::steady_clock::now();
+            std::cout << "[MultipleShooting-MPC]: real-time iteration feedback took "
+                      << std::chrono::duration<double, std::milli>(endFinish - startFinish).count() << " ms"
+                      << std::endl;
+        }
+        return true;
+    }
+
 
     this->backend_->rolloutShots(0, K_shot - 1);
     this->backend_->updateCosts();         //! todo: replace by a simple sum after computeQuadraticCostsAround....
@@ -73,11 +73,17 @@ public:
     /*!
      * requirements: no line-search, end with update-step of controls and state, no rollout after update steps.
      * Therefore: rollout->linearize->solve
+     * With NLOptConSettings::realTimeIteration, all stages including the first one are handled here, after applying
+     * the update of the remaining stages deferred by the previous feedback phase.
      */
     virtual void prepareMPCIteration() override;
 
 
     //! finish iteration, dedicated to MPC
+    /*!
+     * With NLOptConSettings::realTimeIteration, this only substitutes the new initial state into the feedback law of
+     * the first stage and updates the first control, see NLOCBackendBase::feedbackRealTimeIteration().
+     */
     virtual bool finishMPCIteration() override;
 };
 
@@ -182,7 +182,6 @@ public:
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
 
         // important initialization
-        constraintHessianTot_.resize(numOptVar, numOptVar);
         constraintHessianSparsity_.resize(numOptVar, numOptVar);
 
         std::vector<Eigen::Triplet<SCALAR>, Eigen::aligned_allocator<Eigen::Triplet<SCALAR>>> triplets;
@@ -198,6 +197,22 @@ public:
 
         // fill in values in total constraint Hessian
         constraintHessianSparsity_.setFromTriplets(triplets.begin(), triplets.end());
+        constraintHessianSparsity_.makeCompressed();
+
+        // map the non-zeros of every constraint term to their position in the combined Hessian
+        hessianScatterMaps_.resize(constraints_.size());
+        for (size_t c = 0; c < constraints_.size(); c++)
+        {
+            const Eigen::VectorXi& iRowSub = constraints_[c]->iRowHessian();
+            const Eigen::VectorXi& jColSub = constraints_[c]->jColHessian();
+
+            hessianScatterMaps_[c].resize(iRowSub.rows());
+            for (int i = 0; i < iRowSub.rows(); i++)
+            {
+                const SCALAR* entry = &constraintHessianSparsity_.coeffRef(iRowSub(i), jColSub(i));
+                hessianScatterMaps_[c](i) = static_cast<int>(entry - constraintHessianSparsity_.valuePtr());
+            }
+        }
 
 
         iRowHessianStdVec_.clear();
@@ -224,44 +239,35 @@ public:
     /**
     * @brief      Evaluates the constraint Hessian
     *
+    * The values of the constraint terms get accumulated along the scatter maps computed in getSparsityPatternHessian(),
+    * hence the ordering of hes matches the sparsity pattern returned there.
+    *
     * @param[in]  optVec       The optimization variables
     * @param[in]  lambda       multipliers for Hessian matrix
-    * @param[out] hes          The cost Hessian matrix coefficients
+    * @param[out] hes          The constraint Hessian matrix coefficients
     */
-    Eigen::VectorXd sparseHessianValues(const Eigen::VectorXd& optVec, const Eigen::VectorXd& lambda)
+    void sparseHessianValues(const Eigen::VectorXd& optVec, const Eigen::VectorXd& lambda, Eigen::VectorXd& hes)
     {
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
 
-        std::vector<Eigen::Triplet<SCALAR>, Eigen::aligned_allocator<Eigen::Triplet<SCALAR>>> triplets;
+        hes.setZero(jColHessianStdVec_.size());
 
         size_t count = 0;
         for (size_t c = 0; c < constraints_.size(); c++)
         {
             // count the constraint size to hand over correct portion of multiplier vector lambda
             size_t c_nel = constraints_[c]->getConstraintSize();
-            Eigen::VectorXd hessianSubValues;
-            constraints_[c]->sparseHessianValues(optVec, lambda.segment(count, c_nel), hessianSubValues);
+            constraints_[c]->sparseHessianValues(optVec, lambda.segment(count, c_nel), hessianSubValues_);
             count += c_nel;
 
-            // add the evaluated sub-hessian elements as triplets
-            for (int i = 0; i < hessianSubValues.rows(); i++)
-                triplets.push_back(Eigen::Triplet<SCALAR>(
-                    constraints_[c]->iRowHessian()(i), constraints_[c]->jColHessian()(i), hessianSubValues(i)));
+            // add the evaluated sub-hessian elements at their position in the combined Hessian
+            for (int i = 0; i < hessianSubValues_.rows(); i++)
+                hes(hessianScatterMaps_[c](i)) += hessianSubValues_(i);
         }
-
-        // combine all triplets into the sparse constraint Hessian
-        constraintHessianTot_.setFromTriplets(triplets.begin(), triplets.end());
-
-        // triangular-view required (todo: need better in-place assignment)
-        constraintHessianTot_ = constraintHessianTot_.template triangularView<Eigen::Lower>();
-
-        size_t nele_constraint_hes = jColHessianStdVec_.size();
-        return Eigen::VectorXd(Eigen::Map<Eigen::VectorXd>(constraintHessianTot_.valuePtr(), nele_constraint_hes, 1));
 #else
         throw std::runtime_error(
             "sparseHessianValues only available for Eigen 3.3 and newer. Please use BFGS Hessian approx or upgrade "
             "Eigen version.");
-        return Eigen::VectorXd::Zero();
 #endif
     }
 
@@ -291,8 +297,11 @@ protected:
     std::vector<int> iRowHessianStdVec_;
     std::vector<int> jColHessianStdVec_;
 
+    //! positions of the Hessian non-zeros of every constraint term in the combined Hessian
+    std::vector<Eigen::VectorXi> hessianScatterMaps_;
+    Eigen::VectorXd hessianSubValues_;
+
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
-    Eigen::SparseMatrix<SCALAR> constraintHessianTot_;
     Eigen::SparseMatrix<SCALAR>
         constraintHessianSparsity_;  // helper to calculate sparsity and number of non-zero elements
 #endif
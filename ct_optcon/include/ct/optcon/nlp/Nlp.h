@@ -130,37 +130,20 @@ public:
         omega << obj_fac;
 
         // evaluate Hessian values
-        Eigen::VectorXd hessianCostValues, hessianConstraintsValues;
+        costEvaluator_->sparseHessianValues(optVariables_->getOptimizationVars(), omega, hessianCostValues_);
+        constraints_->sparseHessianValues(optVariables_->getOptimizationVars(), lambda, hessianConstraintsValues_);
 
-        costEvaluator_->sparseHessianValues(optVariables_->getOptimizationVars(), omega, hessianCostValues);
+        // accumulate the values in the solver's ordering, along the scatter maps set up in getNonZeroHessianCount().
+        // Entries in the strict upper triangle are not part of the solver's Hessian (symmetry) and are mapped to -1.
+        hes.setZero();
 
-        hessianConstraintsValues = constraints_->sparseHessianValues(optVariables_->getOptimizationVars(), lambda);
+        for (int i = 0; i < hessianCostMap_.rows(); i++)
+            if (hessianCostMap_(i) >= 0)
+                hes(hessianCostMap_(i)) += hessianCostValues_(i);
 
-
-        // collect all Hessian values (from both constraints and cost) in one vector of triplets
-        // here, we re-use the the sparsity information collected in getNonZeroHessianCount()
-        std::vector<Eigen::Triplet<SCALAR>, Eigen::aligned_allocator<Eigen::Triplet<SCALAR>>> triplets;
-        triplets.reserve(iRowHessianCost_.rows() + iRowHessianConstraints_.rows());
-
-        for (int i = 0; i < iRowHessianCost_.rows(); i++)
-        {
-            triplets.push_back(Eigen::Triplet<SCALAR>(iRowHessianCost_(i), jColHessianCost_(i), hessianCostValues(i)));
-        }
-        for (int i = 0; i < iRowHessianConstraints_.rows(); i++)
-        {
-            triplets.push_back(Eigen::Triplet<SCALAR>(
-                iRowHessianConstraints_(i), jColHessianConstraints_(i), hessianConstraintsValues(i)));
-        }
-
-        // setting the sparse Hessian from Eigen-triplets automatically resolves (e.g. adds) entries at same indices
-        Hessian_eval_.setFromTriplets(triplets.begin(), triplets.end());
-
-        // IPOPT and SNOPT only expect a triangular Hessian matrix (symmetry)
-        // enforce triangular view
-        // todo: is there a nicer in-place conversion to triangularView?
-        Hessian_eval_ = Hessian_eval_.template triangularView<Eigen::Lower>();
-
-        hes = Eigen::Map<Eigen::VectorXd>(Hessian_eval_.valuePtr(), nele_hes, 1);
+        for (int i = 0; i < hessianConstraintsMap_.rows(); i++)
+            if (hessianConstraintsMap_(i) >= 0)
+                hes(hessianConstraintsMap_(i)) += hessianConstraintsValues_(i);
 
 #else
         throw std::runtime_error(
@@ -245,7 +228,6 @@ public:
 
         // the sparse Eigen-matrices need to be resized properly, which happens in this step.
         // todo: need to assert that getNonZeroHessianCount() gets called before the first call to a Hessian evaluation.
-        Hessian_eval_.resize(optVariables_->size(), optVariables_->size());
         Hessian_sparsity_.resize(optVariables_->size(), optVariables_->size());
 
         iRowHessianCost_.setZero();
@@ -279,6 +261,11 @@ public:
         // enforce triangular view
         // todo: is there a nicer in-place conversion to triangularView?
         Hessian_sparsity_ = Hessian_sparsity_.template triangularView<Eigen::Lower>();
+        Hessian_sparsity_.makeCompressed();
+
+        // map the cost and constraint non-zeros to their position in the combined Hessian
+        computeHessianScatterMap(iRowHessianCost_, jColHessianCost_, hessianCostMap_);
+        computeHessianScatterMap(iRowHessianConstraints_, jColHessianConstraints_, hessianConstraintsMap_);
 
         // lastly, collect and combine the sparsity as filled into the helper-matrix and store in Eigen::Vectors.
         std::vector<int> iRowHessianStdVec;
@@ -487,6 +474,27 @@ public:
 
 
 protected:
+#if EIGEN_VERSION_AT_LEAST(3, 3, 0)
+    /**
+     * @brief      Computes the positions of Hessian non-zeros in the combined, lower triangular Hessian
+     *
+     * @param[in]  iRow  The row indices of the non-zeros
+     * @param[in]  jCol  The column indices of the non-zeros
+     * @param[out] map   The positions in the values of Hessian_sparsity_, -1 for entries in the strict upper triangle
+     */
+    void computeHessianScatterMap(const Eigen::VectorXi& iRow, const Eigen::VectorXi& jCol, Eigen::VectorXi& map)
+    {
+        map.resize(iRow.rows());
+        for (int i = 0; i < iRow.rows(); i++)
+        {
+            if (iRow(i) >= jCol(i))
+                map(i) = static_cast<int>(&Hessian_sparsity_.coeffRef(iRow(i), jCol(i)) - Hessian_sparsity_.valuePtr());
+            else
+                map(i) = -1;
+        }
+    }
+#endif
+
     //! Ptr to cost evaluator, which approximates the cost evaluation for the discrete problem
     std::shared_ptr<DiscreteCostEvaluatorBase<SCALAR>> costEvaluator_;
 
@@ -497,7 +505,6 @@ protected:
     std::shared_ptr<DiscreteConstraintContainerBase<SCALAR>> constraints_;
 
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
-    Eigen::SparseMatrix<SCALAR> Hessian_eval_;
     Eigen::SparseMatrix<SCALAR> Hessian_sparsity_;  // this is just a helper data structure
 #endif
 
@@ -506,6 +513,12 @@ protected:
 
     //! combined Hessian sparsity pattern gets stored here
     Eigen::VectorXi iRowHessian_, jColHessian_;
+
+    //! positions of the cost and constraint Hessian non-zeros in the combined Hessian
+    Eigen::VectorXi hessianCostMap_, hessianConstraintsMap_;
+
+    //! buffers for the cost and constraint Hessian values
+    Eigen::VectorXd hessianCostValues_, hessianConstraintsValues_;
 };
 }  // namespace tpl
 
@@ -34,7 +34,9 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "solver/OptConSolver.h"
 #include "solver/lqp/HPIPMInterface.hpp"
 #include "solver/lqp/GNRiccatiSolver.hpp"
+#include "solver/lqp/PartitionedRiccatiSolver.hpp"
 #include "solver/NLOptConSolver.hpp"
+#include "solver/NLOptConBatchSolver.hpp"
 #include "solver/NLOptConSettings.hpp"
 
 #include "lqr/riccati/CARE.hpp"
@@ -46,6 +48,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include "mpc/MpcSettings.h"
 #include "mpc/MPC.h"
+#include "mpc/MpcRunner.h"
 #include "mpc/timehorizon/MpcTimeHorizon.h"
 #include "mpc/policyhandler/PolicyHandler.h"
 #include "mpc/policyhandler/default/StateFeedbackPolicyHandler.h"
@@ -31,7 +31,9 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "solver/OptConSolver.h"
 #include "solver/lqp/HPIPMInterface.hpp"
 #include "solver/lqp/GNRiccatiSolver.hpp"
+#include "solver/lqp/PartitionedRiccatiSolver.hpp"
 #include "solver/NLOptConSolver.hpp"
+#include "solver/NLOptConBatchSolver.hpp"
 
 #include "lqr/riccati/CARE.hpp"
 #include "lqr/riccati/DARE.hpp"
@@ -42,6 +44,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include "mpc/MpcSettings.h"
 #include "mpc/MPC.h"
+#include "mpc/MpcRunner.h"
 #include "mpc/timehorizon/MpcTimeHorizon.h"
 #include "mpc/policyhandler/PolicyHandler.h"
 #include "mpc/policyhandler/default/StateFeedbackPolicyHandler.h"
@@ -60,8 +63,10 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "problem/LQOCProblem-impl.hpp"
 
 #include "solver/lqp/GNRiccatiSolver-impl.hpp"
+#include "solver/lqp/PartitionedRiccatiSolver-impl.hpp"
 #include "solver/lqp/HPIPMInterface-impl.hpp"
 #include "solver/NLOptConSolver-impl.hpp"
+#include "solver/NLOptConBatchSolver-impl.hpp"
 
 #include "lqr/riccati/CARE-impl.hpp"
 #include "lqr/riccati/DARE-impl.hpp"
@@ -75,6 +80,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "nloc/algorithms/SingleShooting-impl.hpp"
 
 #include "mpc/MPC-impl.h"
+#include "mpc/MpcRunner-impl.h"
 #include "mpc/timehorizon/MpcTimeHorizon-impl.h"
 #include "mpc/policyhandler/PolicyHandler-impl.h"
 #include "mpc/policyhandler/default/StateFeedbackPolicyHandler-impl.h"
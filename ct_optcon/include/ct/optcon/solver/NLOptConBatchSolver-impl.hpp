@@ -0,0 +1,264 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOptConBatchSolver(
+    const OptConProblemArray& optConProblems,
+    const Settings_t& settings)
+    : taskPool_(new ct::core::TaskPool(settings.nThreads))
+{
+    initialize(optConProblems, settings);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOptConBatchSolver(
+    const OptConProblemArray& optConProblems,
+    const Settings_t& settings,
+    const std::shared_ptr<ct::core::TaskPool>& taskPool)
+    : taskPool_(taskPool)
+{
+    if (!taskPool_)
+        throw std::runtime_error("NLOptConBatchSolver: task pool must not be null.");
+
+    initialize(optConProblems, settings);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::initialize(
+    const OptConProblemArray& optConProblems,
+    const Settings_t& settings)
+{
+    // all backends index their thread-local instances by the ids of the shared pool
+    Settings_t problemSettings = settings;
+    problemSettings.nThreads = static_cast<int>(taskPool_->getNumThreads());
+    problemSettings.nThreadsEigen = 1;
+
+    maxIterations_ = settings.max_iterations;
+
+    backends_.reserve(optConProblems.size());
+    algorithms_.reserve(optConProblems.size());
+    for (size_t i = 0; i < optConProblems.size(); i++)
+    {
+        backends_.push_back(std::shared_ptr<Backend_t>(
+            new NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>(
+                optConProblems[i], problemSettings, taskPool_)));
+
+        if (settings.isSingleShooting())
+            algorithms_.push_back(std::shared_ptr<Algorithm_t>(
+                new SingleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>(
+                    backends_.back(), problemSettings)));
+        else
+            algorithms_.push_back(std::shared_ptr<Algorithm_t>(
+                new MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>(
+                    backends_.back(), problemSettings)));
+
+        if (backends_[i]->getNumSteps() != backends_[0]->getNumSteps())
+            throw std::runtime_error("NLOptConBatchSolver: all problems need to have the same number of stages.");
+    }
+
+    const int K = backends_.empty() ? 0 : backends_[0]->getNumSteps();
+    x_.assign(K + 1, core::StateVectorBatch<STATE_DIM, SCALAR>(static_cast<int>(backends_.size())));
+    u_.assign(K, core::ControlVectorBatch<CONTROL_DIM, SCALAR>(static_cast<int>(backends_.size())));
+    for (size_t i = 0; i < backends_.size(); i++)
+        storeSolution(i);
+
+    costs_.resize(backends_.size(), std::numeric_limits<SCALAR>::max());
+    iterations_.resize(backends_.size(), 0);
+    active_.resize(backends_.size(), 1);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setInitialGuess(size_t i,
+    const Policy_t& initialGuess)
+{
+    algorithms_.at(i)->setInitialGuess(initialGuess);
+    costs_[i] = backends_[i]->getCost();
+    iterations_[i] = 0;
+    active_[i] = 1;
+    storeSolution(i);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setInitialGuesses(
+    const PolicyArray& initialGuesses)
+{
+    if (initialGuesses.size() != backends_.size())
+        throw std::runtime_error("NLOptConBatchSolver: number of initial guesses does not match number of problems.");
+
+    if (backends_.empty())
+        return;
+
+    // setting the initial guess involves a rollout, hence it is worth doing it in parallel
+    taskPool_->parallelFor(0, backends_.size() - 1,
+        [&](size_t threadId, size_t i) { setInitialGuess(i, initialGuesses[i]); }, 1);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::runIteration()
+{
+    if (backends_.empty())
+        return false;
+
+    /*
+     * Problems may take very different times per iteration, hence hand them out one by one. The parallel phases of an
+     * iteration are submitted to the same pool, so idle workers pick up rollouts and LQ approximations of any problem.
+     */
+    taskPool_->parallelFor(0, backends_.size() - 1,
+        [this](size_t threadId, size_t i) {
+            if (!active_[i])
+                return;
+
+            bool foundBetter = algorithms_[i]->runIteration();
+
+            iterations_[i]++;
+            costs_[i] = backends_[i]->getCost();
+            active_[i] = (foundBetter && (int)iterations_[i] < maxIterations_) ? 1 : 0;
+            storeSolution(i);
+        },
+        1);
+
+    for (size_t i = 0; i < active_.size(); i++)
+        if (active_[i])
+            return true;
+
+    return false;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solve()
+{
+    std::fill(iterations_.begin(), iterations_.end(), 0);
+    std::fill(active_.begin(), active_.end(), maxIterations_ > 0 ? 1 : 0);
+
+    while (runIteration())
+    {
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+size_t NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::size() const
+{
+    return backends_.size();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+typename NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::Backend_t&
+NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getBackend(size_t i)
+{
+    return *backends_.at(i);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+typename NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::PolicyArray
+NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getSolutions()
+{
+    PolicyArray solutions;
+    solutions.reserve(backends_.size());
+    for (size_t i = 0; i < backends_.size(); i++)
+        solutions.push_back(backends_[i]->getSolution());
+    return solutions;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+typename NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::StateTrajectoryArray
+NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getStateTrajectories() const
+{
+    StateTrajectoryArray trajectories;
+    trajectories.reserve(backends_.size());
+    for (size_t i = 0; i < backends_.size(); i++)
+        trajectories.push_back(backends_[i]->getStateTrajectory());
+    return trajectories;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+typename NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::ControlTrajectoryArray
+NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getControlTrajectories() const
+{
+    ControlTrajectoryArray trajectories;
+    trajectories.reserve(backends_.size());
+    for (size_t i = 0; i < backends_.size(); i++)
+        trajectories.push_back(backends_[i]->getControlTrajectory());
+    return trajectories;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+auto NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getStates() const
+    -> const StateVectorBatchArray&
+{
+    return x_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+auto NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getControls() const
+    -> const ControlVectorBatchArray&
+{
+    return u_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::vector<SCALAR>& NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getCosts()
+    const
+{
+    return costs_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::vector<size_t>& NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getIterations()
+    const
+{
+    return iterations_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::vector<size_t>& NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getActive()
+    const
+{
+    return active_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+const std::shared_ptr<ct::core::TaskPool>&
+NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getTaskPool() const
+{
+    return taskPool_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConBatchSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::storeSolution(size_t i)
+{
+    const Policy_t& policy = backends_[i]->getSolution();
+
+    for (size_t k = 0; k < x_.size(); k++)
+        x_[k].col(i) = policy.x_ref()[k];
+
+    for (size_t k = 0; k < u_.size(); k++)
+        u_[k].col(i) = policy.uff()[k];
+}
+
+}  // namespace optcon
+}  // namespace ct
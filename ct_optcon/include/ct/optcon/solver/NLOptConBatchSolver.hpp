@@ -0,0 +1,149 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/core/common/TaskPool.h>
+
+#include "NLOptConSolver.hpp"
+
+namespace ct {
+namespace optcon {
+
+
+/*!
+ * \ingroup OptConSolver
+ *
+ * \brief Solves a batch of independent nonlinear optimal control problems of identical dimensions on one task pool
+ *
+ * Every problem is handled by an NLOCBackendMP and its NLOCAlgorithm. All backends run their parallel phases on a
+ * single work-stealing pool with settings.nThreads workers, and the iterations of the problems are tasks on the same
+ * pool. Hence the shot rollouts, LQ approximations and line search candidates of all problems are scheduled together,
+ * instead of N thread pools competing for the same cores.
+ *
+ * The optimized states and controls are kept in struct-of-arrays layout: for every stage there is one batch with a
+ * column per problem, such that a quantity of all problems is stored contiguously. Per-problem costs, iteration counts
+ * and convergence flags are kept in one array per quantity.
+ *
+ * \note the problems may differ in initial state, dynamics and cost function, but they need to have the same number
+ * of stages and they share the solver settings. Problems which stop improving or hit settings.max_iterations drop
+ * out of the batch individually.
+ */
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t P_DIM = STATE_DIM / 2,
+    size_t V_DIM = STATE_DIM / 2,
+    typename SCALAR = double,
+    bool CONTINUOUS = true>
+class NLOptConBatchSolver
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS> Backend_t;
+    typedef NLOCAlgorithm<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS> Algorithm_t;
+    typedef typename Backend_t::OptConProblem_t OptConProblem_t;
+    typedef typename Backend_t::Policy_t Policy_t;
+    typedef NLOptConSettings Settings_t;
+
+    typedef std::vector<OptConProblem_t, Eigen::aligned_allocator<OptConProblem_t>> OptConProblemArray;
+    typedef std::vector<Policy_t, Eigen::aligned_allocator<Policy_t>> PolicyArray;
+    typedef std::vector<core::StateTrajectory<STATE_DIM, SCALAR>,
+        Eigen::aligned_allocator<core::StateTrajectory<STATE_DIM, SCALAR>>>
+        StateTrajectoryArray;
+    typedef std::vector<core::ControlTrajectory<CONTROL_DIM, SCALAR>,
+        Eigen::aligned_allocator<core::ControlTrajectory<CONTROL_DIM, SCALAR>>>
+        ControlTrajectoryArray;
+    typedef std::vector<core::StateVectorBatch<STATE_DIM, SCALAR>,
+        Eigen::aligned_allocator<core::StateVectorBatch<STATE_DIM, SCALAR>>>
+        StateVectorBatchArray;
+    typedef std::vector<core::ControlVectorBatch<CONTROL_DIM, SCALAR>,
+        Eigen::aligned_allocator<core::ControlVectorBatch<CONTROL_DIM, SCALAR>>>
+        ControlVectorBatchArray;
+
+    /*!
+     * \brief constructor
+     * @param optConProblems the problems to solve
+     * @param settings settings shared by all problems, settings.nThreads determines the number of pool workers
+     */
+    NLOptConBatchSolver(const OptConProblemArray& optConProblems, const Settings_t& settings);
+
+    //! constructor sharing an existing task pool
+    NLOptConBatchSolver(const OptConProblemArray& optConProblems,
+        const Settings_t& settings,
+        const std::shared_ptr<ct::core::TaskPool>& taskPool);
+
+    //! set the initial guess for problem i
+    void setInitialGuess(size_t i, const Policy_t& initialGuess);
+
+    //! set the initial guesses for all problems
+    void setInitialGuesses(const PolicyArray& initialGuesses);
+
+    /*!
+     * \brief run a single iteration of all problems which are still active
+     * @return true if at least one problem is still active afterwards
+     */
+    bool runIteration();
+
+    //! iterate until all problems have converged or reached the maximum number of iterations
+    void solve();
+
+    //! number of problems in the batch
+    size_t size() const;
+
+    //! access to the backend of problem i, e.g. to change its initial state between solves
+    Backend_t& getBackend(size_t i);
+
+    //! the solutions of all problems
+    PolicyArray getSolutions();
+
+    //! the optimized state trajectories of all problems
+    StateTrajectoryArray getStateTrajectories() const;
+
+    //! the optimized control trajectories of all problems
+    ControlTrajectoryArray getControlTrajectories() const;
+
+    //! the optimized states, one batch per stage with the state of problem i in column i
+    const StateVectorBatchArray& getStates() const;
+
+    //! the optimized feedforward controls, one batch per stage with the control of problem i in column i
+    const ControlVectorBatchArray& getControls() const;
+
+    //! the costs of all problems after the last iteration
+    const std::vector<SCALAR>& getCosts() const;
+
+    //! the number of iterations run on every problem since the last solve()
+    const std::vector<size_t>& getIterations() const;
+
+    //! 1 for every problem which would still be iterated by runIteration(), 0 otherwise
+    const std::vector<size_t>& getActive() const;
+
+    //! the task pool which executes the iterations
+    const std::shared_ptr<ct::core::TaskPool>& getTaskPool() const;
+
+private:
+    void initialize(const OptConProblemArray& optConProblems, const Settings_t& settings);
+
+    //! copy the current solution of problem i into column i of the state and control batches
+    void storeSolution(size_t i);
+
+    std::shared_ptr<ct::core::TaskPool> taskPool_;
+
+    std::vector<std::shared_ptr<Backend_t>> backends_;
+    std::vector<std::shared_ptr<Algorithm_t>> algorithms_;
+
+    int maxIterations_;
+
+    StateVectorBatchArray x_;
+    ControlVectorBatchArray u_;
+
+    std::vector<SCALAR> costs_;
+    std::vector<size_t> iterations_;
+    std::vector<size_t> active_;
+};
+
+
+}  // namespace optcon
+}  // namespace ct
@@ -49,6 +49,7 @@ struct LineSearchSettings
           alpha_max(1.0),
           n_alpha(0.5),
           armijo_parameter(0.01),
+          costBounding(false),
           debugPrint(false)
     {
     }
@@ -63,6 +64,7 @@ struct LineSearchSettings
     double
         n_alpha; /*!< Factor by which the step size alpha gets scaled after each iteration. Usually 0.5 is a good value. */
     double armijo_parameter; /*!< "Control Parameter" in Armijo line search condition. */
+    bool costBounding; /*!< Abort rollouts once their partial merit exceeds the previous merit. Requires non-negative costs. */
     bool debugPrint;         /*!< Print out debug information during line-search*/
 
 
@@ -78,6 +80,7 @@ struct LineSearchSettings
         std::cout << "alpha_max:\t" << alpha_max << std::endl;
         std::cout << "n_alpha:\t" << n_alpha << std::endl;
         std::cout << "armijo_parameter:\t" << armijo_parameter << std::endl;
+        std::cout << "costBounding:\t" << costBounding << std::endl;
         std::cout << "debugPrint:\t" << debugPrint << std::endl;
         std::cout << "              =======" << std::endl;
         std::cout << std::endl;
@@ -138,6 +141,13 @@ struct LineSearchSettings
         {
         }
 
+        try
+        {
+            costBounding = pt.get<bool>(ns + ".costBounding");
+        } catch (...)
+        {
+        }
+
         if (verbose)
         {
             std::cout << "Loaded line search settings from " << filename << ": " << std::endl;
@@ -154,16 +164,18 @@ struct LineSearchSettings
 struct LQOCSolverSettings
 {
 public:
-    LQOCSolverSettings() : lqoc_debug_print(false), num_lqoc_iterations(10) {}
+    LQOCSolverSettings() : lqoc_debug_print(false), num_lqoc_iterations(10), riccati_square_root(false) {}
 
     bool lqoc_debug_print;
-    int num_lqoc_iterations;  //! number of allowed sub-iterations of LQOC solver per NLOC main iteration
+    int num_lqoc_iterations;   //! number of allowed sub-iterations of LQOC solver per NLOC main iteration
+    bool riccati_square_root;  //! use Cholesky factorizations and symmetric rank updates in the Riccati solvers
 
     void print() const
     {
         std::cout << "======================= LQOCSolverSettings =====================" << std::endl;
         std::cout << "num_lqoc_iterations: \t" << num_lqoc_iterations << std::endl;
         std::cout << "lqoc_debug_print: \t" << lqoc_debug_print << std::endl;
+        std::cout << "riccati_square_root: \t" << riccati_square_root << std::endl;
     }
 
     void load(const std::string& filename, bool verbose = true, const std::string& ns = "lqoc_solver_settings")
@@ -186,6 +198,12 @@ public:
         } catch (...)
         {
         }
+        try
+        {
+            riccati_square_root = pt.get<bool>(ns + ".riccati_square_root");
+        } catch (...)
+        {
+        }
     }
 };
 
@@ -215,7 +233,8 @@ public:
     enum LQOCP_SOLVER
     {
         GNRICCATI_SOLVER = 0,
-        HPIPM_SOLVER = 1
+        HPIPM_SOLVER = 1,
+        PARTITIONED_RICCATI_SOLVER = 2  //! parallel-in-time Riccati solver, uses nThreads worker threads
     };
 
     using APPROXIMATION = typename core::SensitivityApproximationSettings::APPROXIMATION;
@@ -244,6 +263,8 @@ public:
           recordSmallestEigenvalue(false),
           nThreads(4),
           nThreadsEigen(4),
+          pipelinedMultipleShooting(false),
+          realTimeIteration(false),
           lineSearchSettings(),
           debugPrint(false),
           printSummary(true),
@@ -272,6 +293,8 @@ public:
     int nThreads;                   //! number of threads, for MP version
     size_t
         nThreadsEigen;  //! number of threads for eigen parallelization (applies both to MP and ST) Note. in order to activate Eigen parallelization, compile with '-fopenmp'
+    bool pipelinedMultipleShooting;  //! overlap shot rollouts, LQ approximation and the Riccati backward sweep (MP, GNMS, GNRiccati only)
+    bool realTimeIteration;  //! MPC: solve the full LQ problem in the preparation phase, only substitute the new initial state in the feedback phase (multiple shooting, GNRiccati only)
     LineSearchSettings lineSearchSettings;  //! the line search settings
     LQOCSolverSettings lqoc_solver_settings;
     bool debugPrint;
@@ -328,6 +351,8 @@ public:
         std::cout << "epsilon:\t" << epsilon << std::endl;
         std::cout << "nThreads:\t" << nThreads << std::endl;
         std::cout << "nThreadsEigen:\t" << nThreadsEigen << std::endl;
+        std::cout << "pipelinedMultipleShooting:\t" << pipelinedMultipleShooting << std::endl;
+        std::cout << "realTimeIteration:\t" << realTimeIteration << std::endl;
         std::cout << "loggingPrefix:\t" << loggingPrefix << std::endl;
         std::cout << "debugPrint:\t" << debugPrint << std::endl;
         std::cout << "printSummary:\t" << printSummary << std::endl;
@@ -377,6 +402,22 @@ public:
             return false;
         }
 
+        if (realTimeIteration && (isSingleShooting() || lqocp_solver != GNRICCATI_SOLVER))
+        {
+            std::cout << "Invalid parameter: realTimeIteration requires a multiple-shooting algorithm and the "
+                         "GNRiccati solver."
+                      << std::endl;
+            return false;
+        }
+
+        if (pipelinedMultipleShooting && (isSingleShooting() || lqocp_solver != GNRICCATI_SOLVER))
+        {
+            std::cout << "Invalid parameter: pipelinedMultipleShooting requires a multiple-shooting algorithm and the "
+                         "GNRiccati solver."
+                      << std::endl;
+            return false;
+        }
+
         if (nThreads > 100 || nThreadsEigen > 100)
         {
             std::cout << "Number of threads should not exceed 100." << std::endl;
@@ -504,6 +545,18 @@ public:
         {
         }
         try
+        {
+            pipelinedMultipleShooting = pt.get<bool>(ns + ".pipelinedMultipleShooting");
+        } catch (...)
+        {
+        }
+        try
+        {
+            realTimeIteration = pt.get<bool>(ns + ".realTimeIteration");
+        } catch (...)
+        {
+        }
+        try
         {
             recordSmallestEigenvalue = pt.get<bool>(ns + ".recordSmallestEigenvalue");
         } catch (...)
@@ -678,10 +731,12 @@ private:
 
     //! mappings for linear-quadratic solver types
     std::map<LQOCP_SOLVER, std::string> lqocSolverToString = {
-        {GNRICCATI_SOLVER, "GNRICCATI_SOLVER"}, {HPIPM_SOLVER, "HPIPM_SOLVER"}};
+        {GNRICCATI_SOLVER, "GNRICCATI_SOLVER"}, {HPIPM_SOLVER, "HPIPM_SOLVER"},
+        {PARTITIONED_RICCATI_SOLVER, "PARTITIONED_RICCATI_SOLVER"}};
 
     std::map<std::string, LQOCP_SOLVER> stringToLqocSolver = {
-        {"GNRICCATI_SOLVER", GNRICCATI_SOLVER}, {"HPIPM_SOLVER", HPIPM_SOLVER}};
+        {"GNRICCATI_SOLVER", GNRICCATI_SOLVER}, {"HPIPM_SOLVER", HPIPM_SOLVER},
+        {"PARTITIONED_RICCATI_SOLVER", PARTITIONED_RICCATI_SOLVER}};
 };
 }  // namespace optcon
 }  // namespace ct
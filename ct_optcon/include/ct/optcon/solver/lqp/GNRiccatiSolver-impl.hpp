@@ -54,10 +54,18 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::configure(const NLOptConSe
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeStatesAndControls()
+{
+    // the initial state increment is zero for a fixed initial state
+    forwardSubstitution(core::StateVector<STATE_DIM, SCALAR>::Zero());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::forwardSubstitution(
+    const core::StateVector<STATE_DIM, SCALAR>& dx0)
 {
     LQOCProblem_t& p = *this->lqocProblem_;
 
-    this->x_sol_[0].setZero();  // should always be zero (fixed init state)
+    this->x_sol_[0] = dx0;
 
     for (int k = 0; k < this->lqocProblem_->getNumberOfStages(); k++)
     {
@@ -124,6 +132,12 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::changeNumberOfStages(int N
     sv_.resize(N + 1);
     S_.resize(N + 1);
 
+    W_.resize(N);
+    Sb_.resize(N);
+    U_.resize(N + 1);
+    cholesky_.resize(N, false);
+    factorized_.resize(N + 1, false);
+
     N_ = N;
 }
 
@@ -140,14 +154,23 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::initializeCostToGo()
 
     S_[N] = p.Q_[N];
     sv_[N] = p.qv_[N];
+    factorized_[N] = false;
 }
 
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeCostToGo(size_t k)
 {
+    if (cholesky_[k])
+    {
+        computeCostToGoCholesky(k);
+        return;
+    }
+
     LQOCProblem_t& p = *this->lqocProblem_;
 
+    factorized_[k] = false;
+
     S_[k] = p.Q_[k];
     S_[k].noalias() += p.A_[k].transpose() * S_[k + 1] * p.A_[k];
     S_[k].noalias() -= this->L_[k].transpose() * Hi_[k] * this->L_[k];
@@ -164,6 +187,21 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeCostToGo(size_t k)
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
 {
+    designController(k, eigenvalueSolver_, smallestEigenvalue_);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k,
+    EigenvalueSolver& eigenvalueSolver,
+    SCALAR& smallestEigenvalue)
+{
+    // the square-root variant cannot provide eigenvalues
+    cholesky_[k] = settings_.lqoc_solver_settings.riccati_square_root && !settings_.recordSmallestEigenvalue &&
+                   designControllerCholesky(k);
+    if (cholesky_[k])
+        return;
+
     LQOCProblem_t& p = *this->lqocProblem_;
 
     gv_[k] = p.rv_[k];
@@ -188,11 +226,11 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
         if (settings_.recordSmallestEigenvalue)
         {
             // compute eigenvalues with eigenvectors enabled
-            eigenvalueSolver_.compute(Hi_[k], Eigen::ComputeEigenvectors);
-            const ControlMatrix& V = eigenvalueSolver_.eigenvectors().real();
-            const ControlVector& lambda = eigenvalueSolver_.eigenvalues();
+            eigenvalueSolver.compute(Hi_[k], Eigen::ComputeEigenvectors);
+            const ControlMatrix& V = eigenvalueSolver.eigenvectors().real();
+            const ControlVector& lambda = eigenvalueSolver.eigenvalues();
 
-            smallestEigenvalue_ = std::min(smallestEigenvalue_, lambda.minCoeff());
+            smallestEigenvalue = std::min(smallestEigenvalue, lambda.minCoeff());
 
             // Corrected Eigenvalue Matrix
             ControlMatrix D = ControlMatrix::Zero();
@@ -228,13 +266,13 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
     else
     {
         // compute eigenvalues with eigenvectors enabled
-        eigenvalueSolver_.compute(H_[k], Eigen::ComputeEigenvectors);
-        const ControlMatrix& V = eigenvalueSolver_.eigenvectors().real();
-        const ControlVector& lambda = eigenvalueSolver_.eigenvalues();
+        eigenvalueSolver.compute(H_[k], Eigen::ComputeEigenvectors);
+        const ControlMatrix& V = eigenvalueSolver.eigenvectors().real();
+        const ControlVector& lambda = eigenvalueSolver.eigenvalues();
 
         if (settings_.recordSmallestEigenvalue)
         {
-            smallestEigenvalue_ = std::min(smallestEigenvalue_, lambda.minCoeff());
+            smallestEigenvalue = std::min(smallestEigenvalue, lambda.minCoeff());
         }
 
         // Corrected Eigenvalue Matrix
@@ -260,6 +298,99 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designControllerCholesky(size_t k)
+{
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM + STATE_DIM, CONTROL_DIM + STATE_DIM> JointMatrix;
+
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    // the factor S = U^T U is propagated from stage k+1. It is only computed here at the end of the horizon, at the
+    // segment boundaries of the partitioned solver and after stages which used the regular design.
+    StateMatrix U_boundary;
+    if (!factorized_[k + 1])
+    {
+        Eigen::LLT<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> S_llt(S_[k + 1]);
+        if (S_llt.info() != Eigen::Success)
+            return false;
+        U_boundary = S_llt.matrixU().toDenseMatrix();
+    }
+    const StateMatrix& U = factorized_[k + 1] ? U_[k + 1] : U_boundary;
+
+    Eigen::Matrix<SCALAR, STATE_DIM, CONTROL_DIM + STATE_DIM> UBA;
+    UBA.template leftCols<CONTROL_DIM>().noalias() = U.template triangularView<Eigen::Upper>() * p.B_[k];
+    UBA.template rightCols<STATE_DIM>().noalias() = U.template triangularView<Eigen::Upper>() * p.A_[k];
+    Sb_[k].noalias() = U.template triangularView<Eigen::Upper>() * p.b_[k];
+    Sb_[k] = U.template triangularView<Eigen::Upper>().transpose() * Sb_[k];
+
+    gv_[k] = p.rv_[k];
+    gv_[k].noalias() += p.B_[k].transpose() * (sv_[k + 1] + Sb_[k]);
+
+    // M = [R P; P^T Q] + [B A]^T S [B A] = [H G; G^T Q + A^T S A], lower triangle only
+    JointMatrix M;
+    M.template topLeftCorner<CONTROL_DIM, CONTROL_DIM>() = p.R_[k];
+    M.template bottomLeftCorner<STATE_DIM, CONTROL_DIM>() = p.P_[k].transpose();
+    M.template bottomRightCorner<STATE_DIM, STATE_DIM>() = p.Q_[k];
+    M.template selfadjointView<Eigen::Lower>().rankUpdate(UBA.transpose());
+
+    // mirror the lower triangle, such that H_[k] and Hi_[k] are complete symmetric matrices like in the regular design
+    M.template triangularView<Eigen::StrictlyUpper>() = M.transpose();
+
+    H_[k] = M.template topLeftCorner<CONTROL_DIM, CONTROL_DIM>();
+    G_[k] = M.template bottomLeftCorner<STATE_DIM, CONTROL_DIM>().transpose();
+
+    if (settings_.fixedHessianCorrection)
+    {
+        if (settings_.epsilon > 1e-10)
+            M.template topLeftCorner<CONTROL_DIM, CONTROL_DIM>().diagonal().array() += settings_.epsilon;
+    }
+    else
+    {
+        // the eigenvalue correction only leaves H unchanged if H - epsilon * I is positive definite
+        Eigen::LLT<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> clip_llt(
+            H_[k] - settings_.epsilon * ControlMatrix::Identity());
+        if (clip_llt.info() != Eigen::Success)
+            return false;
+    }
+    Hi_[k] = M.template topLeftCorner<CONTROL_DIM, CONTROL_DIM>();
+
+    // M = [L_H 0; W^T L_S] [L_H^T W; 0 L_S^T], where L_S L_S^T = S_[k] is the Schur complement of H
+    Eigen::LLT<JointMatrix> M_llt(M);
+    if (M_llt.info() != Eigen::Success)
+        return false;
+
+    const JointMatrix& L = M_llt.matrixLLT();
+    const auto L_H = L.template topLeftCorner<CONTROL_DIM, CONTROL_DIM>().template triangularView<Eigen::Lower>();
+
+    W_[k] = L.template bottomLeftCorner<STATE_DIM, CONTROL_DIM>().transpose();
+    U_[k] = L.template bottomRightCorner<STATE_DIM, STATE_DIM>().template triangularView<Eigen::Lower>().transpose()
+                .toDenseMatrix();
+
+    // calculate FB gain update
+    this->L_[k] = -L_H.transpose().solve(W_[k]);
+
+    // calculate FF update
+    this->lv_[k] = -L_H.transpose().solve(L_H.solve(gv_[k]));
+
+    return true;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeCostToGoCholesky(size_t k)
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    // the factor of S_[k] is a by-product of the design of stage k
+    factorized_[k] = true;
+    S_[k].noalias() = U_[k].template triangularView<Eigen::Upper>().transpose() * U_[k];
+
+    sv_[k] = p.qv_[k];
+    sv_[k].noalias() += p.A_[k].transpose() * (sv_[k + 1] + Sb_[k]);
+    sv_[k].noalias() += G_[k].transpose() * this->lv_[k];
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::logToMatlab()
 {
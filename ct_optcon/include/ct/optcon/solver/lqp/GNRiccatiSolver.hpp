@@ -34,12 +34,15 @@ public:
     typedef ct::core::ControlVector<CONTROL_DIM, SCALAR> ControlVector;
     typedef ct::core::ControlMatrix<CONTROL_DIM, SCALAR> ControlMatrix;
     typedef ct::core::ControlMatrixArray<CONTROL_DIM, SCALAR> ControlMatrixArray;
+    typedef ct::core::StateControlMatrix<STATE_DIM, CONTROL_DIM, SCALAR> StateControlMatrix;
     typedef ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> StateControlMatrixArray;
     typedef ct::core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR> FeedbackArray;
 
     typedef ct::core::StateVectorArray<STATE_DIM, SCALAR> StateVectorArray;
     typedef ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> ControlVectorArray;
 
+    typedef Eigen::SelfAdjointEigenSolver<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> EigenvalueSolver;
+
     GNRiccatiSolver(const std::shared_ptr<LQOCProblem_t>& lqocProblem = nullptr);
 
     GNRiccatiSolver(int N);
@@ -54,6 +57,8 @@ public:
 
     virtual void computeStatesAndControls() override;
 
+    virtual void forwardSubstitution(const core::StateVector<STATE_DIM, SCALAR>& dx0) override;
+
     virtual void computeFeedbackMatrices() override;
 
     virtual void compute_lv() override;
@@ -75,6 +80,21 @@ protected:
 
     void designController(size_t k);
 
+    //! design the controller for stage k with a given eigenvalue solver, allows designing several stages concurrently
+    void designController(size_t k, EigenvalueSolver& eigenvalueSolver, SCALAR& smallestEigenvalue);
+
+    /*!
+     * square-root variant of designController(). A single Cholesky factorization of [H G; G^T Q + A^T S A] yields the
+     * factor of H_[k] and the factor of S_[k] as its Schur complement, so the factor of S_[k+1] is propagated backwards
+     * instead of being refactorized per stage.
+     * @return false if a factorization fails or if the eigenvalue correction would modify H_[k], then the regular
+     * design has to be used
+     */
+    bool designControllerCholesky(size_t k);
+
+    //! square-root variant of computeCostToGo(), reconstructs S_[k] from the factor computed in the design of stage k
+    void computeCostToGoCholesky(size_t k);
+
     void logToMatlab();
 
     NLOptConSettings settings_;
@@ -90,12 +110,19 @@ protected:
     StateVectorArray sv_;
     StateMatrixArray S_;
 
+    //! square-root Riccati quantities, L_H is the lower Cholesky factor of H_[k]
+    FeedbackArray W_;               // L_H^-1 * G_k
+    StateVectorArray Sb_;           // S_[k+1] * b_k
+    StateMatrixArray U_;            // upper Cholesky factor of S_[k]
+    std::vector<char> cholesky_;    // true if stage k was designed by the square-root variant
+    std::vector<char> factorized_;  // true if U_[k] is the factor of the current S_[k]
+
     int N_;
 
     SCALAR smallestEigenvalue_;
 
     //! Eigenvalue solver, used for inverting the Hessian and for regularization
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> eigenvalueSolver_;
+    EigenvalueSolver eigenvalueSolver_;
 
 //! if building with MATLAB support, include matfile
 #ifdef MATLAB_FULL_LOG
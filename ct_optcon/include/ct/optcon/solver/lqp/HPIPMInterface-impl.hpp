@@ -60,13 +60,7 @@ void createConstraintsMasks(const int num_con, B& lb, B& ub, M& lb_mask, M& ub_m
 
 template <int STATE_DIM, int CONTROL_DIM>
 HPIPMInterface<STATE_DIM, CONTROL_DIM>::HPIPMInterface()
-    : N_(-1),
-      settings_(NLOptConSettings()),
-      dim_mem_(nullptr),
-      qp_mem_(nullptr),
-      qp_sol_mem_(nullptr),
-      ipm_arg_mem_(nullptr),
-      ipm_mem_(nullptr)
+    : N_(-1), settings_(NLOptConSettings()), arena_(nullptr), arena_size_(0)
 {
     hb0_.setZero();
     hr0_.setZero();
@@ -83,8 +77,6 @@ HPIPMInterface<STATE_DIM, CONTROL_DIM>::~HPIPMInterface()
 template <int STATE_DIM, int CONTROL_DIM>
 void HPIPMInterface<STATE_DIM, CONTROL_DIM>::initializeAndAllocate()
 {
-    freeHpipmMemory();
-
     if (settings_.lqoc_solver_settings.lqoc_debug_print)
     {
         std::cout << "HPIPM allocating memory for QP with time horizon: " << N_ << std::endl;
@@ -95,17 +87,98 @@ void HPIPMInterface<STATE_DIM, CONTROL_DIM>::initializeAndAllocate()
         }
     }
 
-    // allocate ocp dimensions
-    dim_size_ = d_ocp_qp_dim_memsize(N_);
-    dim_mem_ = malloc(dim_size_);
-    d_ocp_qp_dim_create(N_, &dim_, dim_mem_);
-    d_ocp_qp_dim_set_all(
+    // the memory size of the HPIPM structures depends on the dimensions and the ipm arguments, which themselves live
+    // in the arena. If the arena needs to grow, all structures are created again in the new memory.
+    while (!createHpipmStructures())
+    {
+    }
+
+    setHpipmProblemData();
+
+    if (settings_.lqoc_solver_settings.lqoc_debug_print)
+        std::cout << "HPIPM arena size: " << arena_size_ << std::endl;
+}
+
+
+template <int STATE_DIM, int CONTROL_DIM>
+bool HPIPMInterface<STATE_DIM, CONTROL_DIM>::createHpipmStructures()
+{
+    // all blocks start on a cache line
+    auto aligned = [](int size) { return (static_cast<size_t>(size) + 63) / 64 * 64; };
+
+    // ocp dimensions
+    dim_size_ = ::d_ocp_qp_dim_memsize(N_);
+    size_t offset = aligned(dim_size_);
+    if (!reserveArena(offset))
+        return false;
+    ::d_ocp_qp_dim_create(N_, &dim_, arena_);
+    ::d_ocp_qp_dim_set_all(
         nx_.data(), nu_.data(), nbx_.data(), nbu_.data(), ng_.data(), nsbx_.data(), nsbu_.data(), nsg_.data(), &dim_);
 
-    // allocate ocp qp
-    int qp_size = ::d_ocp_qp_memsize(&dim_);
-    qp_mem_ = malloc(qp_size);
-    ::d_ocp_qp_create(&dim_, &qp_, qp_mem_);
+    // ipm arg, qp and solution only depend on the dimensions
+    const int ipm_arg_size = ::d_ocp_qp_ipm_arg_memsize(&dim_);
+    const int qp_size = ::d_ocp_qp_memsize(&dim_);
+    const int qp_sol_size = ::d_ocp_qp_sol_memsize(&dim_);
+    if (!reserveArena(offset + aligned(ipm_arg_size) + aligned(qp_size) + aligned(qp_sol_size)))
+        return false;
+
+    ::d_ocp_qp_ipm_arg_create(&dim_, &arg_, arena_ + offset);
+    offset += aligned(ipm_arg_size);
+    ::d_ocp_qp_ipm_arg_set_default(mode_, &arg_);
+    ::d_ocp_qp_ipm_arg_set_iter_max(&settings_.lqoc_solver_settings.num_lqoc_iterations, &arg_);
+
+    ::d_ocp_qp_create(&dim_, &qp_, arena_ + offset);
+    offset += aligned(qp_size);
+
+    ::d_ocp_qp_sol_create(&dim_, &qp_sol_, arena_ + offset);
+    offset += aligned(qp_sol_size);
+
+    // the workspace additionally depends on the ipm arguments
+    const int ipm_size = ::d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
+    if (!reserveArena(offset + aligned(ipm_size)))
+        return false;
+    ::d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, arena_ + offset);
+
+    if (settings_.lqoc_solver_settings.lqoc_debug_print)
+    {
+        std::cout << "HPIPM qp_size: " << qp_size << std::endl;
+        std::cout << "HPIPM qp_sol_size: " << qp_sol_size << std::endl;
+        std::cout << "HPIPM ipm_arg_size: " << ipm_arg_size << std::endl;
+        std::cout << "HPIPM ipm_size: " << ipm_size << std::endl;
+    }
+
+    return true;
+}
+
+
+template <int STATE_DIM, int CONTROL_DIM>
+bool HPIPMInterface<STATE_DIM, CONTROL_DIM>::reserveArena(size_t size)
+{
+    if (size <= arena_size_)
+        return true;
+
+    freeHpipmMemory();
+    arena_ = static_cast<char*>(malloc(size));
+    if (arena_ == nullptr)
+        throw std::bad_alloc();
+    arena_size_ = size;
+    return false;
+}
+
+
+template <int STATE_DIM, int CONTROL_DIM>
+void HPIPMInterface<STATE_DIM, CONTROL_DIM>::freeHpipmMemory()
+{
+    free(arena_);
+    arena_ = nullptr;
+    arena_size_ = 0;
+}
+
+
+template <int STATE_DIM, int CONTROL_DIM>
+void HPIPMInterface<STATE_DIM, CONTROL_DIM>::setHpipmProblemData()
+{
+    // HPIPM packs the data into its internal (blasfeo) format, the pointers refer directly to the LQOCProblem
     ::d_ocp_qp_set_all(hA_.data(), hB_.data(), hb_.data(), hQ_.data(), hS_.data(), hR_.data(), hq_.data(), hr_.data(),
         hidxbx_.data(), hlbx_.data(), hubx_.data(), hidxbu_.data(), hlbu_.data(), hubu_.data(),  // box constraints
         hC_.data(), hD_.data(), hlg_.data(), hug_.data(),                                        // gen constraints
@@ -128,48 +201,6 @@ void HPIPMInterface<STATE_DIM, CONTROL_DIM>::initializeAndAllocate()
         ::d_ocp_qp_set_lbu_mask(ii, hlbu_mask_[ii], &qp_);
         ::d_ocp_qp_set_ubu_mask(ii, hubu_mask_[ii], &qp_);
     }
-
-    // allocation for solution
-    int qp_sol_size = ::d_ocp_qp_sol_memsize(&dim_);
-    qp_sol_mem_ = malloc(qp_sol_size);
-    ::d_ocp_qp_sol_create(&dim_, &qp_sol_, qp_sol_mem_);
-
-    // ipm arg
-    int ipm_arg_size = ::d_ocp_qp_ipm_arg_memsize(&dim_);
-    ipm_arg_mem_ = malloc(ipm_arg_size);
-    ::d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipm_arg_mem_);
-
-    ::d_ocp_qp_ipm_arg_set_default(mode_, &arg_);
-    ::d_ocp_qp_ipm_arg_set_iter_max(&settings_.lqoc_solver_settings.num_lqoc_iterations, &arg_);
-
-    // create workspace
-    int ipm_size = ::d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
-    ipm_mem_ = malloc(ipm_size);
-    ::d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipm_mem_);
-
-
-    if (settings_.lqoc_solver_settings.lqoc_debug_print)
-    {
-        std::cout << "HPIPM qp_size: " << qp_size << std::endl;
-        std::cout << "HPIPM qp_sol_size: " << qp_sol_size << std::endl;
-        std::cout << "HPIPM ipm_arg_size: " << ipm_arg_size << std::endl;
-        std::cout << "HPIPM ipm_size: " << ipm_size << std::endl;
-    }
-}
-
-template <int STATE_DIM, int CONTROL_DIM>
-void HPIPMInterface<STATE_DIM, CONTROL_DIM>::freeHpipmMemory()
-{
-    free(dim_mem_);
-    free(qp_mem_);
-    free(qp_sol_mem_);
-    free(ipm_arg_mem_);
-    free(ipm_mem_);
-    dim_mem_ = nullptr;
-    qp_mem_ = nullptr;
-    qp_sol_mem_ = nullptr;
-    ipm_arg_mem_ = nullptr;
-    ipm_mem_ = nullptr;
 }
 
 
@@ -384,45 +415,17 @@ void HPIPMInterface<STATE_DIM, CONTROL_DIM>::setProblemImpl(
     // check if the number of stages N changed and adapt problem dimensions
     bool dimsChanged = changeProblemSize(lqocProblem);
 
-    // WARNING: the allocation should in practice not have to happen during the loop.
-    // If possible, prefer receding horizon MPC problems.
-    // If the number of stages has changed, however, the problem needs to be re-built:
+    // If the dimensions changed, the HPIPM structures need to be re-built. This only allocates memory if the
+    // horizon or the number of constraints grew beyond the size of the arena.
 
     // setup unconstrained part of problem
     setupCostAndDynamics(lqocProblem->A_, lqocProblem->B_, lqocProblem->b_, lqocProblem->P_, lqocProblem->qv_,
         lqocProblem->Q_, lqocProblem->rv_, lqocProblem->R_);
 
     if (dimsChanged)
-    {
         initializeAndAllocate();
-    }
     else
-    {
-        // we need to call the setters to transform our data into HPIPM interal structures
-        ::d_ocp_qp_set_all(hA_.data(), hB_.data(), hb_.data(), hQ_.data(), hS_.data(), hR_.data(), hq_.data(),
-            hr_.data(), hidxbx_.data(), hlbx_.data(), hubx_.data(), hidxbu_.data(), hlbu_.data(), hubu_.data(),
-            hC_.data(), hD_.data(), hlg_.data(), hug_.data(), hZl_.data(), hZu_.data(), hzl_.data(), hzu_.data(),
-            hidxs_.data(), hlls_.data(), hlus_.data(), &qp_);
-
-        // set constraint maskings for unbounded dimensions
-        for (int ii = 0; ii <= N_; ii++)
-        {
-            // masks for general constraints
-            ::d_ocp_qp_set_lg_mask(ii, hlg_mask_[ii], &qp_);
-            ::d_ocp_qp_set_ug_mask(ii, hug_mask_[ii], &qp_);
-
-            // masks for state box constraints
-            ::d_ocp_qp_set_lbx_mask(ii, hlbx_mask_[ii], &qp_);
-            ::d_ocp_qp_set_ubx_mask(ii, hubx_mask_[ii], &qp_);
-        }
-        for (int ii = 0; ii < N_; ii++)
-        {
-            // masks for input box constraints
-            ::d_ocp_qp_set_lbu_mask(ii, hlbu_mask_[ii], &qp_);
-            ::d_ocp_qp_set_ubu_mask(ii, hubu_mask_[ii], &qp_);
-        }
-        // TODO: combine all the above into one convenience method
-    }
+        setHpipmProblemData();
 }
 
 
@@ -459,9 +462,9 @@ bool HPIPMInterface<STATE_DIM, CONTROL_DIM>::configureInputBoxConstraints(
             hubu_[i] = lqocProblem->u_ub_[i].data();
             hidxbu_[i] = lqocProblem->u_I_[i].data();
 
-            // create masks for box constraints
-            hlbu_mask_Eigen_[i] = Eigen::VectorXd(nbu_[i]);
-            hubu_mask_Eigen_[i] = Eigen::VectorXd(nbu_[i]);
+            // create masks for box constraints, resizing does not allocate if the number of constraints is unchanged
+            hlbu_mask_Eigen_[i].resize(nbu_[i]);
+            hubu_mask_Eigen_[i].resize(nbu_[i]);
             createConstraintsMasks(
                 nbu_[i], lqocProblem->u_lb_[i], lqocProblem->u_ub_[i], hlbu_mask_Eigen_[i], hubu_mask_Eigen_[i]);
 
@@ -517,9 +520,9 @@ bool HPIPMInterface<STATE_DIM, CONTROL_DIM>::configureStateBoxConstraints(
             hubx_[i] = lqocProblem->x_ub_[i].data();
             hidxbx_[i] = lqocProblem->x_I_[i].data();
 
-            // create masks for box constraints
-            hlbx_mask_Eigen_[i] = Eigen::VectorXd(nbx_[i]);
-            hubx_mask_Eigen_[i] = Eigen::VectorXd(nbx_[i]);
+            // create masks for box constraints, resizing does not allocate if the number of constraints is unchanged
+            hlbx_mask_Eigen_[i].resize(nbx_[i]);
+            hubx_mask_Eigen_[i].resize(nbx_[i]);
             createConstraintsMasks(
                 nbx_[i], lqocProblem->x_lb_[i], lqocProblem->x_ub_[i], hlbx_mask_Eigen_[i], hubx_mask_Eigen_[i]);
 
@@ -575,9 +578,9 @@ bool HPIPMInterface<STATE_DIM, CONTROL_DIM>::configureGeneralConstraints(
         lqocProblem->d_lb_[i].resize(lqocProblem->ng_[i], 1);
         lqocProblem->d_ub_[i].resize(lqocProblem->ng_[i], 1);
 
-        // resize constraint mask data
-        hlg_mask_Eigen_[i] = Eigen::VectorXd(ng_[i]);
-        hug_mask_Eigen_[i] = Eigen::VectorXd(ng_[i]);
+        // resize constraint mask data (does not allocate if the number of constraints is unchanged)
+        hlg_mask_Eigen_[i].resize(ng_[i]);
+        hug_mask_Eigen_[i].resize(ng_[i]);
 
         // set pointers to hpipm-style box constraint boundaries and sparsity pattern
         if (i == 0)
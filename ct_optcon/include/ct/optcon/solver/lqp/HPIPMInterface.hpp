@@ -106,6 +106,9 @@ public:
     //! override this method to catch corner case with lv being incompatible with constraints
     virtual const ct::core::ControlVectorArray<CONTROL_DIM>& get_lv() override;
 
+    //! size in bytes of the memory arena holding all HPIPM structures
+    size_t getWorkspaceSize() const { return arena_size_; }
+
 private:
     void setSolverDimensions(const int N, const int nbu = 0, const int nbx = 0, const int ng = 0);
 
@@ -161,6 +164,18 @@ private:
     //! frees memory allocated for the HPIPM data structures
     void freeHpipmMemory();
 
+    /*!
+     * @brief create all HPIPM structures inside the memory arena
+     * @return false if the arena had to grow, in which case all structures need to be created again
+     */
+    bool createHpipmStructures();
+
+    //! make sure the arena holds at least the given number of bytes, returns false if it had to be reallocated
+    bool reserveArena(size_t size);
+
+    //! hand the current problem data and constraint masks over to the HPIPM qp structure
+    void setHpipmProblemData();
+
     //! horizon length
     int N_;
 
@@ -236,22 +251,25 @@ private:
     //! settings from NLOptConSolver
     NLOptConSettings settings_;
 
+    /*!
+     * single memory arena holding the dimensions, the qp, its solution, the ipm arguments and the ipm workspace.
+     * The arena is only reallocated if the horizon or the number of constraints grows, re-solving a problem of the
+     * same (or smaller) size does not allocate memory.
+     */
+    char* arena_;
+    size_t arena_size_;
+
     //! ocp qp dimensions
     int dim_size_;
-    void* dim_mem_;
     struct d_ocp_qp_dim dim_;
 
-    void* qp_mem_;
     struct d_ocp_qp qp_;
 
-    void* qp_sol_mem_;
     struct d_ocp_qp_sol qp_sol_;
 
-    void* ipm_arg_mem_;
     struct d_ocp_qp_ipm_arg arg_;
 
     // workspace
-    void* ipm_mem_;
     struct d_ocp_qp_ipm_ws workspace_;
     int hpipm_status_;  // status code after solving
 
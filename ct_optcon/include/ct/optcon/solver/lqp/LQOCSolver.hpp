@@ -80,6 +80,16 @@ public:
 
     //! extract the solution (can be overriden if additional extraction steps required in specific solver)
     virtual void computeStatesAndControls() = 0;
+
+    /*!
+     * extract the solution for a non-zero increment of the initial state, by forward substitution through the
+     * feedback law of a completed backward pass. Only available for solvers based on a Riccati recursion.
+     * @param dx0 the increment of the initial state
+     */
+    virtual void forwardSubstitution(const core::StateVector<STATE_DIM, SCALAR>& dx0)
+    {
+        throw std::runtime_error("forwardSubstitution not available for this solver.");
+    }
     //! return solution for state
     const ct::core::StateVectorArray<STATE_DIM, SCALAR>& getSolutionState() { return x_sol_; }
     //! return solution for control
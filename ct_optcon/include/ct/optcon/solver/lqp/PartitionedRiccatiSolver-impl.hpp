@@ -0,0 +1,243 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::PartitionedRiccatiSolver(
+    const std::shared_ptr<LQOCProblem_t>& lqocProblem)
+    : Base(lqocProblem)
+{
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::setTaskPool(
+    const std::shared_ptr<ct::core::TaskPool>& taskPool)
+{
+    taskPool_ = taskPool;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+const std::shared_ptr<ct::core::TaskPool>& PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::getTaskPool()
+    const
+{
+    return taskPool_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+int PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::getNumberOfSegments(int N) const
+{
+    if (!taskPool_)
+        return 1;
+
+    const int maxSegments = static_cast<int>(taskPool_->getNumThreads()) + 1;
+    return std::max(1, std::min(maxSegments, N / minSegmentLength));
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solve()
+{
+    const int N = this->lqocProblem_->getNumberOfStages();
+
+    if (!taskPool_)
+        taskPool_ = std::shared_ptr<ct::core::TaskPool>(
+            new ct::core::TaskPool(static_cast<size_t>(std::max(0, this->settings_.nThreads))));
+
+    const int P = getNumberOfSegments(N);
+    if (P <= 1)
+    {
+        Base::solve();
+        return;
+    }
+
+    if (A_seg_.size() < static_cast<size_t>(P))
+    {
+        A_seg_.resize(P);
+        b_seg_.resize(P);
+        C_seg_.resize(P);
+        s_seg_.resize(P);
+        J_seg_.resize(P);
+    }
+
+    this->initializeCostToGo();
+
+    std::vector<SCALAR> smallestEigenvalues(P, std::numeric_limits<SCALAR>::infinity());
+    std::vector<EigenvalueSolver, Eigen::aligned_allocator<EigenvalueSolver>> eigenvalueSolvers(P);
+    std::atomic_bool condensationFailed(false);
+    std::atomic_bool clipped(false);
+
+    // phase 1: condense all segments but the last one, which is solved directly from the terminal cost
+    taskPool_->parallelFor(0, P - 1,
+        [&](size_t threadId, size_t p) {
+            const int k0 = segmentStart(static_cast<int>(p), P, N);
+            const int k1 = segmentStart(static_cast<int>(p) + 1, P, N);
+
+            if (p == static_cast<size_t>(P - 1))
+                solveSegment(k0, k1, eigenvalueSolvers[p], smallestEigenvalues[p]);
+            else if (!condenseSegment(p, k0, k1))
+                condensationFailed = true;
+        },
+        1, true /* backwards */);
+
+    if (condensationFailed)
+    {
+        Base::solve();
+        return;
+    }
+
+    // phase 2: propagate the cost-to-go over the segment boundaries
+    for (int p = P - 2; p >= 1; p--)
+        applySegment(p, segmentStart(p, P, N), segmentStart(p + 1, P, N));
+
+    // phase 3: regular Riccati recursion within the remaining segments
+    taskPool_->parallelFor(0, P - 2,
+        [&](size_t threadId, size_t p) {
+            const int k0 = segmentStart(static_cast<int>(p), P, N);
+            const int k1 = segmentStart(static_cast<int>(p) + 1, P, N);
+            solveSegment(k0, k1, eigenvalueSolvers[p], smallestEigenvalues[p]);
+
+            if (!this->settings_.fixedHessianCorrection && !isUnclipped(k0, k1))
+                clipped = true;
+        },
+        1);
+
+    // the condensed cost-to-go is only exact if the eigenvalue correction did not modify any condensed stage
+    if (clipped)
+    {
+        Base::solve();
+        return;
+    }
+
+    this->smallestEigenvalue_ = *std::min_element(smallestEigenvalues.begin(), smallestEigenvalues.end());
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::condenseSegment(size_t p, int k0, int k1)
+{
+    LQOCProblem_t& lqp = *this->lqocProblem_;
+
+    StateMatrix& A = A_seg_[p];
+    StateVector& b = b_seg_[p];
+    StateMatrix& C = C_seg_[p];
+    StateVector& s = s_seg_[p];
+    StateMatrix& J = J_seg_[p];
+
+    // the fixed Hessian correction adds epsilon to R + B'SB, i.e. it is a correction of R
+    const SCALAR epsilon =
+        (this->settings_.fixedHessianCorrection && this->settings_.epsilon > 1e-10) ? this->settings_.epsilon : 0.0;
+
+    for (int k = k1 - 1; k >= k0; k--)
+    {
+        // eliminate the control and the state-control cross terms of stage k
+        Eigen::LLT<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> R_llt(
+            lqp.R_[k] + epsilon * Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>::Identity());
+        if (R_llt.info() != Eigen::Success)
+            return false;
+
+        const Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> Rinv_P = R_llt.solve(lqp.P_[k]);
+        const Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> Rinv_Bt = R_llt.solve(lqp.B_[k].transpose());
+        const Eigen::Matrix<SCALAR, CONTROL_DIM, 1> Rinv_rv = R_llt.solve(lqp.rv_[k]);
+
+        const StateMatrix A_k = lqp.A_[k] - lqp.B_[k] * Rinv_P;
+        const StateVector b_k = lqp.b_[k] - lqp.B_[k] * Rinv_rv;
+        const StateMatrix C_k = lqp.B_[k] * Rinv_Bt;
+        const StateVector s_k = lqp.qv_[k] - lqp.P_[k].transpose() * Rinv_rv;
+        const StateMatrix J_k = lqp.Q_[k] - lqp.P_[k].transpose() * Rinv_P;
+
+        if (k == k1 - 1)
+        {
+            A = A_k;
+            b = b_k;
+            C = C_k;
+            s = s_k;
+            J = J_k;
+            continue;
+        }
+
+        // combine the element of stage k with the element of the stages (k, k1)
+        const StateMatrix M = (StateMatrix::Identity() + C_k * J).partialPivLu().inverse();
+        const StateMatrix AM = A * M;
+        const StateMatrix MA_k = M * A_k;
+
+        const StateVector s_new = MA_k.transpose() * (s + J * b_k) + s_k;
+        const StateMatrix J_new = MA_k.transpose() * J * A_k + J_k;
+        const StateVector b_new = AM * (b_k - C_k * s) + b;
+        const StateMatrix C_new = AM * C_k * A.transpose() + C;
+
+        A = AM * A_k;
+        b = b_new;
+        C = 0.5 * (C_new + C_new.transpose());
+        s = s_new;
+        J = 0.5 * (J_new + J_new.transpose());
+    }
+
+    return true;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::applySegment(size_t p, int k0, int k1)
+{
+    const StateMatrix& S = this->S_[k1];
+    const StateVector& sv = this->sv_[k1];
+
+    const StateMatrix MA = (StateMatrix::Identity() + C_seg_[p] * S).partialPivLu().solve(A_seg_[p]);
+
+    this->S_[k0] = MA.transpose() * S * A_seg_[p] + J_seg_[p];
+    this->S_[k0] = 0.5 * (this->S_[k0] + this->S_[k0].transpose()).eval();
+
+    this->sv_[k0] = MA.transpose() * (sv + S * b_seg_[p]) + s_seg_[p];
+    this->factorized_[k0] = false;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::isUnclipped(int k0, int k1) const
+{
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM> ControlMatrix;
+
+    // the eigenvalues are clipped to epsilon, H - epsilon * I is positive definite if none of them was
+    for (int k = k0; k < k1; k++)
+    {
+        Eigen::LLT<ControlMatrix> llt(this->H_[k] - this->settings_.epsilon * ControlMatrix::Identity());
+        if (llt.info() != Eigen::Success)
+            return false;
+    }
+    return true;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void PartitionedRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solveSegment(int k0,
+    int k1,
+    EigenvalueSolver& eigenvalueSolver,
+    SCALAR& smallestEigenvalue)
+{
+    for (int k = k1 - 1; k >= k0; k--)
+    {
+        this->designController(k, eigenvalueSolver, smallestEigenvalue);
+
+        // the cost-to-go at the segment start is shared with the previous segment, which may still read it
+        if (k > k0)
+            this->computeCostToGo(k);
+    }
+
+    // the last segment is solved while the others are still condensing, it provides the first boundary cost-to-go
+    if (k0 > 0 && k1 == this->lqocProblem_->getNumberOfStages())
+        this->computeCostToGo(k0);
+}
+
+
+}  // namespace optcon
+}  // namespace ct
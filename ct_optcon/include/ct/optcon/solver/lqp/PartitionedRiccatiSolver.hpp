@@ -0,0 +1,107 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/core/common/TaskPool.h>
+
+#include "GNRiccatiSolver.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \brief Parallel-in-time Riccati solver for unconstrained linear-quadratic optimal control problems
+ *
+ * The horizon is partitioned into P consecutive segments which are processed concurrently on a task pool:
+ *
+ * 1. every segment except the last condenses its stages into a single element, which describes how the cost-to-go
+ *    at the end of the segment maps to the cost-to-go at its beginning. At the same time, the last segment runs the
+ *    regular Riccati recursion starting from the terminal cost.
+ * 2. the cost-to-go at the segment boundaries is obtained by applying the condensed elements from the tail to the
+ *    head, which is a short sequential sweep over P-1 elements.
+ * 3. all remaining segments run the regular Riccati recursion starting from their boundary cost-to-go.
+ *
+ * The condensation follows the associative formulation of the LQ backward pass in
+ * S. Sarkka and A. F. Garcia-Fernandez, "Temporal Parallelization of Dynamic Programming and Linear Quadratic
+ * Control", IEEE TAC 2022. Feedback gains and feedforward terms are designed by the GNRiccatiSolver kernels.
+ *
+ * The Hessian regularization of the sequential solver is reproduced as follows:
+ * - with NLOptConSettings::fixedHessianCorrection, adding epsilon to H = R + B'SB is the same as adding it to R, hence
+ *   the condensation uses the regularized R and L_, lv_ are identical to the sequential solver up to round-off.
+ * - otherwise, the sequential solver clips the eigenvalues of H to epsilon, which depends on the cost-to-go and
+ *   cannot be condensed. The condensation assumes that no clipping is necessary, which is verified on the H of all
+ *   condensed stages once the boundary cost-to-go is known. If any of them has an eigenvalue below epsilon, the
+ *   solver falls back to the sequential recursion.
+ *
+ * The segments run on the task pool passed through setTaskPool(), e.g. the one of NLOCBackendMP. A dedicated pool with
+ * NLOptConSettings::nThreads workers is only spawned if none is set at the first call to solve().
+ *
+ * \note the condensation requires positive definite (regularized) control weights R. If an R is not positive
+ * definite, the solver falls back to the sequential recursion. The stage-wise interface solveSingleStage() is always
+ * sequential.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class PartitionedRiccatiSolver : public GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR> Base;
+    typedef typename Base::LQOCProblem_t LQOCProblem_t;
+    typedef typename Base::StateMatrix StateMatrix;
+    typedef typename Base::StateMatrixArray StateMatrixArray;
+    typedef typename Base::StateVectorArray StateVectorArray;
+    typedef typename Base::EigenvalueSolver EigenvalueSolver;
+
+    typedef ct::core::StateVector<STATE_DIM, SCALAR> StateVector;
+
+    //! minimum number of stages per segment, shorter segments do not pay off the condensation overhead
+    static const int minSegmentLength = 8;
+
+    PartitionedRiccatiSolver(const std::shared_ptr<LQOCProblem_t>& lqocProblem = nullptr);
+
+    virtual ~PartitionedRiccatiSolver() = default;
+
+    virtual void solve() override;
+
+    //! share an existing task pool instead of spawning a dedicated one
+    void setTaskPool(const std::shared_ptr<ct::core::TaskPool>& taskPool);
+
+    //! the task pool the segments run on, nullptr before the first solve() if none was set
+    const std::shared_ptr<ct::core::TaskPool>& getTaskPool() const;
+
+    //! the number of segments used for a problem with N stages
+    int getNumberOfSegments(int N) const;
+
+protected:
+    //! condense the stages [k0, k1) into the element of segment p. Returns false if an R is not positive definite
+    bool condenseSegment(size_t p, int k0, int k1);
+
+    //! compute the cost-to-go at k0 from the cost-to-go at k1 using the condensed element of segment p
+    void applySegment(size_t p, int k0, int k1);
+
+    //! regular Riccati recursion for the stages [k0, k1), the cost-to-go at k1 must be available
+    void solveSegment(int k0, int k1, EigenvalueSolver& eigenvalueSolver, SCALAR& smallestEigenvalue);
+
+    //! true if the eigenvalue correction left the H of all stages in [k0, k1) unchanged
+    bool isUnclipped(int k0, int k1) const;
+
+    //! first stage of segment p
+    int segmentStart(int p, int P, int N) const { return (p * N) / P; }
+
+    std::shared_ptr<ct::core::TaskPool> taskPool_;
+
+    //! condensed segment elements, see Sarkka and Garcia-Fernandez
+    StateMatrixArray A_seg_;
+    StateVectorArray b_seg_;
+    StateMatrixArray C_seg_;
+    StateVectorArray s_seg_;
+    StateMatrixArray J_seg_;
+};
+
+
+}  // namespace optcon
+}  // namespace ct
@@ -146,7 +146,11 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     StateVectorArrayPtr& subStepsX,
     const size_t threadId)
 {
-    subStepsX = discretizers_[threadId]->getSubstates();
+    // swap with the recorder instead of copying, the recorder clears the previous substeps of the stage on its next
+    // reset and records into their memory
+    if (!subStepsX)
+        subStepsX = StateVectorArrayPtr(new StateVectorArray);
+    subStepsX->swap(*discretizers_[threadId]->getSubstates());
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -154,7 +158,17 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
     ControlVectorArrayPtr& subStepsU,
     const size_t threadId)
 {
-    subStepsU = discretizers_[threadId]->getSubcontrols();
+    if (!subStepsU)
+        subStepsU = ControlVectorArrayPtr(new ControlVectorArray);
+    subStepsU->swap(*discretizers_[threadId]->getSubcontrols());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::reserveSubsteps(
+    const size_t numSubsteps)
+{
+    for (auto& discretizer : discretizers_)
+        discretizer->reserveSubsteps(numSubsteps);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -50,8 +50,10 @@ public:
     typedef ct::core::Sensitivity<STATE_DIM, CONTROL_DIM, SCALAR> Sensitivity_t;
     typedef std::shared_ptr<Sensitivity_t> SensitivityPtr;
 
+    typedef typename Base::StateVectorArray StateVectorArray;
     typedef typename Base::StateVectorArrayPtr StateVectorArrayPtr;
     typedef typename Base::StateSubstepsPtr StateSubstepsPtr;
+    typedef typename Base::ControlVectorArray ControlVectorArray;
     typedef typename Base::ControlVectorArrayPtr ControlVectorArrayPtr;
     typedef typename Base::ControlSubstepsPtr ControlSubstepsPtr;
 
@@ -109,6 +111,7 @@ public:
 
     virtual void getSubstates(StateVectorArrayPtr& subStepsX, const size_t threadId) override;
     virtual void getSubcontrols(ControlVectorArrayPtr& subStepsU, const size_t threadId) override;
+    virtual void reserveSubsteps(const size_t numSubsteps) override;
 
     virtual void setSubstepTrajectoryReference(const StateSubstepsPtr& xSubsteps,
         const ControlSubstepsPtr& uSubsteps,
@@ -104,8 +104,12 @@ public:
     virtual void changeNonlinearSystem(const typename optConProblem_t::DynamicsPtr_t& dyn) = 0;
     virtual void changeLinearSystem(const typename optConProblem_t::LinearPtr_t& lin) = 0;
 
+    //! move the substeps recorded during the last propagation on threadId into subStepsX, without copying them
     virtual void getSubstates(StateVectorArrayPtr& subStepsX, const size_t threadId) {}
+    //! move the subcontrols recorded during the last propagation on threadId into subStepsU, without copying them
     virtual void getSubcontrols(ControlVectorArrayPtr& subStepsU, const size_t threadId) {}
+    //! reserve memory for recording numSubsteps substeps per propagation on every thread
+    virtual void reserveSubsteps(const size_t numSubsteps) {}
     virtual void setSubstepTrajectoryReference(const StateSubstepsPtr& xSubsteps,
         const ControlSubstepsPtr& uSubsteps,
         const size_t threadId){};
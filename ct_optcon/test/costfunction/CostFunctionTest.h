@@ -338,6 +338,67 @@ TEST(CostFunctionTest, TrackingTermTest)
     ASSERT_TRUE(costFunction->controlDerivativeIntermediateTest());
 }
 
+/*!
+ * Test that the single-sweep quadratic approximation matches the individual evaluations of the cost function
+ */
+TEST(CostFunctionTest, QuadraticApproximationTest)
+{
+    const size_t nTests = 10;
+
+    CostFunctionAnalytical<state_dim, control_dim> costFunction;
+
+    Eigen::Matrix<double, state_dim, state_dim> Q = Eigen::Matrix<double, state_dim, state_dim>::Random();
+    Eigen::Matrix<double, control_dim, control_dim> R = Eigen::Matrix<double, control_dim, control_dim>::Random();
+    Eigen::Matrix<double, control_dim, state_dim> P = Eigen::Matrix<double, control_dim, state_dim>::Random();
+
+    core::StateTrajectory<state_dim> stateTraj;
+    core::ControlTrajectory<control_dim> controlTraj;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        stateTraj.push_back(core::StateVector<state_dim>::Random(), double(i), true);
+        controlTraj.push_back(core::ControlVector<control_dim>::Random(), double(i), true);
+    }
+
+    // a set of tracking terms, one of them with a non-trivial time activation
+    for (size_t i = 0; i < 3; i++)
+    {
+        std::shared_ptr<TermQuadTracking<state_dim, control_dim>> trackingTerm(
+            new TermQuadTracking<state_dim, control_dim>(
+                Q, R, core::InterpolationType::LIN, core::InterpolationType::ZOH, i > 0));
+        trackingTerm->setStateAndControlReference(stateTraj, controlTraj);
+        costFunction.addIntermediateTerm(trackingTerm);
+    }
+    costFunction.getIntermediateTermById(1)->setTimeActivation(
+        std::shared_ptr<core::tpl::LinearActivation<double>>(
+            new core::tpl::LinearActivation<double>(0.0, 10.0, 0.3, 0.5)));
+
+    // terms which rely on the default single-sweep implementation
+    costFunction.addIntermediateTerm(
+        std::shared_ptr<TermQuadMult<state_dim, control_dim>>(new TermQuadMult<state_dim, control_dim>(Q, R)));
+    costFunction.addIntermediateTerm(
+        std::shared_ptr<TermMixed<state_dim, control_dim>>(new TermMixed<state_dim, control_dim>(P)));
+
+    CostFunctionQuadratic<state_dim, control_dim>::approximation_t approx;
+
+    for (size_t i = 0; i < nTests; i++)
+    {
+        core::StateVector<state_dim> x = core::StateVector<state_dim>::Random();
+        core::ControlVector<control_dim> u = core::ControlVector<control_dim>::Random();
+        double t = 1.5 * i;
+
+        costFunction.setCurrentStateAndControl(x, u, t);
+        costFunction.evaluateIntermediateQuadraticApproximation(approx);
+
+        ASSERT_NEAR(approx.value, costFunction.evaluateIntermediate(), 1e-9);
+        ASSERT_TRUE(approx.stateDerivative.isApprox(costFunction.stateDerivativeIntermediate(), 1e-9));
+        ASSERT_TRUE(approx.controlDerivative.isApprox(costFunction.controlDerivativeIntermediate(), 1e-9));
+        ASSERT_TRUE(approx.stateSecondDerivative.isApprox(costFunction.stateSecondDerivativeIntermediate(), 1e-9));
+        ASSERT_TRUE(
+            approx.controlSecondDerivative.isApprox(costFunction.controlSecondDerivativeIntermediate(), 1e-9));
+        ASSERT_TRUE(approx.stateControlDerivative.isApprox(costFunction.stateControlDerivativeIntermediate(), 1e-9));
+    }
+}
+
 /*!
  * Test the TermSmoothAbs term for first and second order derivatives
  */
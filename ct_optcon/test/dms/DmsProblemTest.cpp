@@ -0,0 +1,325 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Evaluates the NLP callbacks of the DMS problem directly, hence these tests do not require an NLP solver.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+const size_t state_dim = 2;
+const size_t control_dim = 1;
+
+typedef DmsProblem<state_dim, control_dim> DmsProblem_t;
+typedef DmsProblem_t::OptConProblem_t OptConProblem_t;
+
+//! an oscillator counting its dynamics evaluations
+class CountingOscillator : public SecondOrderSystem
+{
+public:
+    CountingOscillator() : SecondOrderSystem(3.0, 0.1), count_(0) {}
+    CountingOscillator(const CountingOscillator& arg) : SecondOrderSystem(arg), count_(0) {}
+    CountingOscillator* clone() const override { return new CountingOscillator(*this); }
+    void computeControlledDynamics(const StateVector<state_dim>& state,
+        const double& t,
+        const ControlVector<control_dim>& control,
+        StateVector<state_dim>& derivative) override
+    {
+        count_++;
+        SecondOrderSystem::computeControlledDynamics(state, t, control, derivative);
+    }
+
+    size_t count_;
+};
+
+//! sets up a DMS problem for the oscillator, one counting system per shot
+std::shared_ptr<DmsProblem_t> createProblem(const DmsSettings& settings,
+    std::vector<std::shared_ptr<CountingOscillator>>& systems)
+{
+    std::vector<OptConProblem_t::DynamicsPtr_t> systemPtrs;
+    std::vector<OptConProblem_t::LinearPtr_t> linearPtrs;
+    std::vector<OptConProblem_t::CostFunctionPtr_t> costPtrs;
+
+    Eigen::Matrix2d Q;
+    Q << 1.0, 0.0, 0.0, 10.0;
+    Eigen::Matrix<double, 1, 1> R;
+    R << 0.1;
+    StateVector<state_dim> x_final;
+    x_final << 2.0, -1.0;
+
+    systems.clear();
+    for (size_t i = 0; i < settings.N_; i++)
+    {
+        systems.push_back(std::shared_ptr<CountingOscillator>(new CountingOscillator()));
+        systemPtrs.push_back(systems.back());
+        linearPtrs.push_back(std::shared_ptr<LinearSystem<state_dim, control_dim>>(
+            new SystemLinearizer<state_dim, control_dim>(std::shared_ptr<SecondOrderSystem>(new SecondOrderSystem(3.0, 0.1)))));
+        costPtrs.push_back(std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>>(
+            new CostFunctionQuadraticSimple<state_dim, control_dim>(
+                Q, R, x_final, ControlVector<control_dim>::Zero(), x_final, Q)));
+    }
+
+    return std::shared_ptr<DmsProblem_t>(new DmsProblem_t(settings, systemPtrs, linearPtrs, costPtrs,
+        std::vector<OptConProblem_t::ConstraintPtr_t>(), std::vector<OptConProblem_t::ConstraintPtr_t>(),
+        std::vector<OptConProblem_t::ConstraintPtr_t>(), StateVector<state_dim>::Zero()));
+}
+
+//! sets new optimization variables and evaluates the constraints
+Eigen::VectorXd evaluateConstraints(DmsProblem_t& problem, const Eigen::VectorXd& x)
+{
+    Eigen::Map<const Eigen::VectorXd> xMap(x.data(), x.size());
+    problem.extractOptimizationVars(xMap, true);
+
+    Eigen::VectorXd g(problem.getConstraintsCount());
+    Eigen::Map<Eigen::VectorXd> gMap(g.data(), g.size());
+    problem.evaluateConstraints(gMap);
+    return g;
+}
+
+//! the number of dynamics evaluations of every shot
+std::vector<size_t> getCounts(const std::vector<std::shared_ptr<CountingOscillator>>& systems)
+{
+    std::vector<size_t> counts;
+    for (const auto& system : systems)
+        counts.push_back(system->count_);
+    return counts;
+}
+
+//! the shots integrated since the counts were taken
+std::vector<size_t> getIntegratedShots(const std::vector<std::shared_ptr<CountingOscillator>>& systems,
+    const std::vector<size_t>& countsBefore)
+{
+    std::vector<size_t> shots;
+    for (size_t i = 0; i < systems.size(); i++)
+        if (systems[i]->count_ != countsBefore[i])
+            shots.push_back(i);
+    return shots;
+}
+
+TEST(DmsProblemTest, onlyShotsWithChangedVariablesAreIntegrated)
+{
+    for (DmsSettings::SplineType_t splineType : {DmsSettings::ZERO_ORDER_HOLD, DmsSettings::PIECEWISE_LINEAR})
+    {
+        DmsSettings settings;
+        settings.N_ = 5;
+        settings.T_ = 2.5;
+        settings.dt_sim_ = 0.05;
+        settings.splineType_ = splineType;
+
+        std::vector<std::shared_ptr<CountingOscillator>> systems;
+        std::shared_ptr<DmsProblem_t> problem = createProblem(settings, systems);
+
+        Eigen::VectorXd x = Eigen::VectorXd::Random(problem->getVarCount());
+        evaluateConstraints(*problem, x);
+        for (size_t i = 0; i < settings.N_; i++)
+            ASSERT_GT(systems[i]->count_, 0u);
+
+        // unchanged variables do not trigger any integration
+        std::vector<size_t> counts = getCounts(systems);
+        evaluateConstraints(*problem, x);
+        ASSERT_TRUE(getIntegratedShots(systems, counts).empty());
+
+        // the variables are ordered as pairs (s_i, q_i)
+        const size_t shot = 2;
+        const size_t stateIndex = shot * (state_dim + control_dim);
+        const size_t controlIndex = stateIndex + state_dim;
+
+        counts = getCounts(systems);
+        x(stateIndex) += 0.1;
+        evaluateConstraints(*problem, x);
+        ASSERT_EQ(getIntegratedShots(systems, counts), std::vector<size_t>({shot}));
+
+        // with linear splines, q_i also enters the shot before
+        counts = getCounts(systems);
+        x(controlIndex) += 0.1;
+        evaluateConstraints(*problem, x);
+        if (splineType == DmsSettings::ZERO_ORDER_HOLD)
+            ASSERT_EQ(getIntegratedShots(systems, counts), std::vector<size_t>({shot}));
+        else
+            ASSERT_EQ(getIntegratedShots(systems, counts), std::vector<size_t>({shot - 1, shot}));
+
+        // a new time grid invalidates all shots
+        counts = getCounts(systems);
+        problem->changeTimeHorizon(3.0);
+        evaluateConstraints(*problem, x);
+        ASSERT_EQ(getIntegratedShots(systems, counts).size(), settings.N_);
+    }
+}
+
+//! the constraint Jacobian as dense matrix
+Eigen::MatrixXd evaluateConstraintJacobian(DmsProblem_t& problem)
+{
+    const size_t nnz = problem.getNonZeroJacobianCount();
+    Eigen::VectorXi iRow(nnz), jCol(nnz);
+    Eigen::VectorXd values(nnz);
+    Eigen::Map<Eigen::VectorXi> iRowMap(iRow.data(), nnz), jColMap(jCol.data(), nnz);
+    Eigen::Map<Eigen::VectorXd> valuesMap(values.data(), nnz);
+    problem.getSparsityPatternJacobian(nnz, iRowMap, jColMap);
+    problem.evaluateConstraintJacobian(nnz, valuesMap);
+
+    Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(problem.getConstraintsCount(), problem.getVarCount());
+    for (size_t k = 0; k < nnz; k++)
+        jacobian(iRow(k), jCol(k)) += values(k);
+    return jacobian;
+}
+
+TEST(DmsProblemTest, adaptiveSensitivitiesMatchFiniteDifferences)
+{
+    for (DmsSettings::SplineType_t splineType : {DmsSettings::ZERO_ORDER_HOLD, DmsSettings::PIECEWISE_LINEAR})
+    {
+        DmsSettings settings;
+        settings.N_ = 5;
+        settings.T_ = 5.0;
+        settings.dt_sim_ = 0.1;
+        settings.splineType_ = splineType;
+        settings.costEvaluationType_ = DmsSettings::FULL;
+        settings.integrationType_ = DmsSettings::RK5;
+        settings.absErrTol_ = 1e-9;
+        settings.relErrTol_ = 1e-9;
+
+        std::vector<std::shared_ptr<CountingOscillator>> systems;
+        std::shared_ptr<DmsProblem_t> problem = createProblem(settings, systems);
+
+        const size_t nVar = problem->getVarCount();
+        Eigen::VectorXd x = Eigen::VectorXd::Random(nVar);
+
+        evaluateConstraints(*problem, x);
+        const Eigen::MatrixXd jacobian = evaluateConstraintJacobian(*problem);
+        Eigen::VectorXd gradient(nVar);
+        Eigen::Map<Eigen::VectorXd> gradientMap(gradient.data(), nVar);
+        problem->evaluateCostGradient(nVar, gradientMap);
+
+        // the adaptive integration is tight enough for its step selection not to spoil the central differences
+        const double eps = 1e-6;
+        for (size_t j = 0; j < nVar; j++)
+        {
+            Eigen::VectorXd xPlus = x, xMinus = x;
+            xPlus(j) += eps;
+            xMinus(j) -= eps;
+
+            const Eigen::VectorXd gPlus = evaluateConstraints(*problem, xPlus);
+            const double costPlus = problem->evaluateCostFun();
+            const Eigen::VectorXd gMinus = evaluateConstraints(*problem, xMinus);
+            const double costMinus = problem->evaluateCostFun();
+
+            ASSERT_LT((jacobian.col(j) - (gPlus - gMinus) / (2.0 * eps)).cwiseAbs().maxCoeff(), 1e-5);
+            ASSERT_NEAR(gradient(j), (costPlus - costMinus) / (2.0 * eps), 1e-4);
+        }
+    }
+}
+
+TEST(DmsProblemTest, adaptiveIntegrationTerminatesOnNonFiniteState)
+{
+    DmsSettings settings;
+    settings.N_ = 5;
+    settings.T_ = 5.0;
+    settings.dt_sim_ = 0.1;
+    settings.costEvaluationType_ = DmsSettings::FULL;
+    settings.integrationType_ = DmsSettings::RK5;
+
+    std::vector<std::shared_ptr<CountingOscillator>> systems;
+    std::shared_ptr<DmsProblem_t> problem = createProblem(settings, systems);
+
+    // a NaN state of shot 2 is propagated to its continuity constraint, cost and derivatives
+    const size_t shot = 2;
+    Eigen::VectorXd x = Eigen::VectorXd::Random(problem->getVarCount());
+    x(shot * (state_dim + control_dim)) = std::numeric_limits<double>::quiet_NaN();
+
+    const Eigen::VectorXd g = evaluateConstraints(*problem, x);
+    ASSERT_TRUE(g.array().isNaN().any());
+    ASSERT_TRUE(std::isnan(problem->evaluateCostFun()));
+    ASSERT_TRUE(evaluateConstraintJacobian(*problem).array().isNaN().any());
+
+    // a finite state recovers
+    x(shot * (state_dim + control_dim)) = 0.0;
+    ASSERT_TRUE(evaluateConstraints(*problem, x).allFinite());
+    ASSERT_TRUE(std::isfinite(problem->evaluateCostFun()));
+}
+
+TEST(DmsProblemTest, adaptiveIntegrationRespectsMaximumStepCount)
+{
+    ControlVector<control_dim> u = ControlVector<control_dim>::Zero();
+    std::shared_ptr<SecondOrderSystem> system(new SecondOrderSystem(3.0, 0.1));
+    system->setController(
+        std::shared_ptr<ConstantController<state_dim, control_dim>>(new ConstantController<state_dim, control_dim>(u)));
+    SensitivityIntegratorCT<state_dim, control_dim> integrator(system, RK5VARIABLE);
+
+    StateVectorArray<state_dim> stateTrajectory;
+    TimeArray timeTrajectory;
+
+    StateVector<state_dim> x;
+    x << 1.0, 0.0;
+    ASSERT_TRUE(integrator.integrateAdaptive(x, 0.0, 5.0, 0.1, 1e-9, 1e-9, stateTrajectory, timeTrajectory));
+    ASSERT_TRUE(x.allFinite());
+    ASSERT_GT(stateTrajectory.size(), 4u);
+
+    x << 1.0, 0.0;
+    ASSERT_FALSE(integrator.integrateAdaptive(x, 0.0, 5.0, 0.1, 1e-9, 1e-9, stateTrajectory, timeTrajectory, 3));
+    ASSERT_TRUE(x.array().isNaN().all());
+
+    StateMatrix<state_dim> dX0;
+    integrator.integrateSensitivityDX0(dX0, 0.0, 50, 0.1);
+    ASSERT_TRUE(dX0.array().isNaN().all());
+}
+
+TEST(DmsProblemTest, multiThreadedShotEvaluationMatchesSingleThreaded)
+{
+    for (DmsSettings::IntegrationType_t integrationType : {DmsSettings::RK4, DmsSettings::RK5})
+    {
+        DmsSettings settings;
+        settings.N_ = 7;
+        settings.T_ = 3.5;
+        settings.dt_sim_ = 0.05;
+        settings.costEvaluationType_ = DmsSettings::FULL;
+        settings.integrationType_ = integrationType;
+
+        DmsSettings settingsMT = settings;
+        settingsMT.nThreads_ = 4;
+
+        std::vector<std::shared_ptr<CountingOscillator>> systems, systemsMT;
+        std::shared_ptr<DmsProblem_t> problem = createProblem(settings, systems);
+        std::shared_ptr<DmsProblem_t> problemMT = createProblem(settingsMT, systemsMT);
+
+        const size_t nVar = problem->getVarCount();
+        for (size_t iteration = 0; iteration < 3; iteration++)
+        {
+            const Eigen::VectorXd x = Eigen::VectorXd::Random(nVar);
+
+            ASSERT_EQ(evaluateConstraints(*problem, x), evaluateConstraints(*problemMT, x));
+            ASSERT_EQ(problem->evaluateCostFun(), problemMT->evaluateCostFun());
+            ASSERT_EQ(evaluateConstraintJacobian(*problem), evaluateConstraintJacobian(*problemMT));
+
+            Eigen::VectorXd gradient(nVar), gradientMT(nVar);
+            Eigen::Map<Eigen::VectorXd> gradientMap(gradient.data(), nVar), gradientMTMap(gradientMT.data(), nVar);
+            problem->evaluateCostGradient(nVar, gradientMap);
+            problemMT->evaluateCostGradient(nVar, gradientMTMap);
+            ASSERT_EQ(gradient, gradientMT);
+        }
+    }
+}
+
+TEST(DmsProblemTest, shotEvaluatorRequiresOneThread)
+{
+    typedef ShotEvaluator<state_dim, control_dim> ShotEvaluator_t;
+
+    DmsSettings settings;
+    settings.nThreads_ = 0;
+    ASSERT_THROW(ShotEvaluator_t(std::vector<std::shared_ptr<ShotEvaluator_t::ShotContainer_t>>(), settings),
+        std::runtime_error);
+
+    settings.nThreads_ = 1;
+    ShotEvaluator_t shotEvaluator(std::vector<std::shared_ptr<ShotEvaluator_t::ShotContainer_t>>(), settings);
+    shotEvaluator.evaluateSensitivities();
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
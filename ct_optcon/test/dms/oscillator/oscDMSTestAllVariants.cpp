@@ -110,38 +110,41 @@ TEST(DmsTest, OscillatorDmsTestAllVariants)
 {
     for (int splineType = 0; splineType < DmsSettings::SplineType::num_types_splining; splineType++)
     {
-        for (int costEvalT = 0; costEvalT < DmsSettings::CostEvaluationType::num_types_costevaluation; costEvalT++)
+        for (int integrationT = DmsSettings::RK4; integrationT <= DmsSettings::RK5; integrationT++)
         {
-            DmsSettings settings;
-            settings.N_ = 25;
-            settings.T_ = 5.0;
-            settings.nThreads_ = 1;
-            settings.splineType_ = static_cast<DmsSettings::SplineType>(splineType);                 // ZOH, PWL
-            settings.costEvaluationType_ = static_cast<DmsSettings::CostEvaluationType>(costEvalT);  // SIMPLE, FULL
-            settings.objectiveType_ = static_cast<DmsSettings::ObjectiveType>(0);  // keep grid, opt. grid
-            settings.h_min_ = 0.1;
-            settings.integrationType_ = DmsSettings::RK4;
-            settings.dt_sim_ = 0.01;
-            settings.absErrTol_ = 1e-6;
-            settings.relErrTol_ = 1e-6;
+            for (int costEvalT = 0; costEvalT < DmsSettings::CostEvaluationType::num_types_costevaluation; costEvalT++)
+            {
+                DmsSettings settings;
+                settings.N_ = 25;
+                settings.T_ = 5.0;
+                settings.nThreads_ = 1;
+                settings.splineType_ = static_cast<DmsSettings::SplineType>(splineType);                 // ZOH, PWL
+                settings.costEvaluationType_ = static_cast<DmsSettings::CostEvaluationType>(costEvalT);  // SIMPLE, FULL
+                settings.objectiveType_ = static_cast<DmsSettings::ObjectiveType>(0);  // keep grid, opt. grid
+                settings.h_min_ = 0.1;
+                settings.integrationType_ = static_cast<DmsSettings::IntegrationType>(integrationT);  // RK4, RK5
+                settings.dt_sim_ = 0.01;
+                settings.absErrTol_ = 1e-6;
+                settings.relErrTol_ = 1e-6;
 
 #ifdef BUILD_WITH_SNOPT_SUPPORT
-            NlpSolverSettings nlpsettings;
-            nlpsettings.solverType_ = ct::optcon::NlpSolverType::SNOPT;
-            settings.solverSettings_ = nlpsettings;
-            OscillatorDms oscDms;
-            oscDms.initialize(settings);
-            oscDms.getSolution();
+                NlpSolverSettings nlpsettings;
+                nlpsettings.solverType_ = ct::optcon::NlpSolverType::SNOPT;
+                settings.solverSettings_ = nlpsettings;
+                OscillatorDms oscDms;
+                oscDms.initialize(settings);
+                oscDms.getSolution();
 #endif
 
 #ifdef BUILD_WITH_IPOPT_SUPPORT
-            NlpSolverSettings nlpsettings_ipopt;
-            nlpsettings_ipopt.solverType_ = ct::optcon::NlpSolverType::IPOPT;
-            settings.solverSettings_ = nlpsettings_ipopt;
-            OscillatorDms oscDms_ipopt;
-            oscDms_ipopt.initialize(settings);
-            oscDms_ipopt.getSolution();
+                NlpSolverSettings nlpsettings_ipopt;
+                nlpsettings_ipopt.solverType_ = ct::optcon::NlpSolverType::IPOPT;
+                settings.solverSettings_ = nlpsettings_ipopt;
+                OscillatorDms oscDms_ipopt;
+                oscDms_ipopt.initialize(settings);
+                oscDms_ipopt.getSolution();
 #endif
+            }
         }
     }
 }
@@ -0,0 +1,109 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+#include "PendulumVanDerPol.h"
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+typedef CTSystemModel<state_dim, control_dim> SystemModel;
+
+std::shared_ptr<LinearSystem<state_dim, control_dim>> createLinearSystem()
+{
+    return std::shared_ptr<LinearSystem<state_dim, control_dim>>(
+        new SystemLinearizer<state_dim, control_dim>(std::shared_ptr<PendulumVanDerPol>(new PendulumVanDerPol())));
+}
+
+//! a system model integrating the state and the state transition matrix together
+std::shared_ptr<SystemModel> createFusedSystemModel(const IntegrationType intType)
+{
+    return std::shared_ptr<SystemModel>(new SystemModel(std::shared_ptr<PendulumVanDerPol>(new PendulumVanDerPol()),
+        createLinearSystem(), StateMatrix<state_dim>::Identity(), intType));
+}
+
+TEST(ExtendedKalmanFilterTest, fusedDerivativeMatchesFiniteDifferences)
+{
+    StateVector<state_dim> x;
+    x << 0.3, -1.0, 0.8, 0.2;
+    ControlVector<control_dim> u;
+    u << 0.5;
+    const double dt = 0.01;
+    const double t = 0.2;
+    const double h = 1e-6;
+
+    for (IntegrationType intType : {EULERCT, RK4CT})
+    {
+        std::shared_ptr<SystemModel> f = createFusedSystemModel(intType);
+
+        StateMatrix<state_dim> A;
+        const StateVector<state_dim> x_next = f->computeDynamicsAndDerivativeState(x, u, dt, t, A);
+
+        ASSERT_LT((x_next - f->computeDynamics(x, u, dt, t)).array().abs().maxCoeff(), 1e-14);
+        ASSERT_LT((f->computeDerivativeState(x, u, dt, t) - A).array().abs().maxCoeff(), 1e-14);
+
+        // central differences of the propagated state
+        StateMatrix<state_dim> A_fd;
+        for (size_t j = 0; j < state_dim; ++j)
+        {
+            StateVector<state_dim> x_plus = x;
+            StateVector<state_dim> x_minus = x;
+            x_plus(j) += h;
+            x_minus(j) -= h;
+            A_fd.col(j) = (f->computeDynamics(x_plus, u, dt, t) - f->computeDynamics(x_minus, u, dt, t)) / (2.0 * h);
+        }
+
+        ASSERT_LT((A - A_fd).array().abs().maxCoeff(), 1e-8);
+    }
+}
+
+TEST(ExtendedKalmanFilterTest, fusedSystemModelMatchesSensitivityApproximation)
+{
+    const double dt = 0.01;
+
+    // with forward Euler, the integrated state transition matrix is I + dt * A, just as the sensitivity approximation
+    std::shared_ptr<SystemModel::SensitivityApprox_t> sensApprox(new SystemModel::SensitivityApprox_t(
+        dt, createLinearSystem(), SensitivityApproximationSettings::APPROXIMATION::FORWARD_EULER));
+    std::shared_ptr<SystemModel> f_ref(new SystemModel(std::shared_ptr<PendulumVanDerPol>(new PendulumVanDerPol()),
+        sensApprox, StateMatrix<state_dim>::Identity(), EULERCT));
+    std::shared_ptr<SystemModel> f = createFusedSystemModel(EULERCT);
+
+    Eigen::Matrix<double, output_dim, state_dim> C;
+    C << 1, 0, 0, 0, 0, 0, 1, 0.5;
+    std::shared_ptr<LinearMeasurementModel<output_dim, state_dim>> h(
+        new LTIMeasurementModel<output_dim, state_dim>(C, Eigen::Matrix2d::Identity()));
+
+    const StateMatrix<state_dim> Q = 0.01 * StateMatrix<state_dim>::Identity();
+    const OutputMatrix<output_dim> R = 0.1 * OutputMatrix<output_dim>::Identity();
+    StateVector<state_dim> x0;
+    x0 << 0.5, 0.0, 1.0, 0.0;
+
+    ExtendedKalmanFilter<state_dim, control_dim, output_dim> ekf_ref(
+        f_ref, h, Q, R, x0, StateMatrix<state_dim>::Identity());
+    ExtendedKalmanFilter<state_dim, control_dim, output_dim> ekf(f, h, Q, R, x0, StateMatrix<state_dim>::Identity());
+
+    ControlVector<control_dim> u;
+    OutputVector<output_dim> z;
+    for (int k = 0; k < 100; ++k)
+    {
+        u << std::sin(0.1 * k);
+        ekf_ref.predict(u, dt, k * dt);
+        ekf.predict(u, dt, k * dt);
+        ASSERT_LT((ekf.getEstimate() - ekf_ref.getEstimate()).array().abs().maxCoeff(), 1e-12);
+
+        z << std::cos(0.3 * k), 0.5 * std::sin(0.2 * k);
+        ekf_ref.update(z, dt, k * dt);
+        ekf.update(z, dt, k * dt);
+        ASSERT_LT((ekf.getEstimate() - ekf_ref.getEstimate()).array().abs().maxCoeff(), 1e-12);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,29 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+const size_t state_dim = 4;
+const size_t control_dim = 1;
+const size_t output_dim = 2;
+
+//! a damped pendulum driven by the control, coupled to a Van der Pol oscillator
+class PendulumVanDerPol : public ct::core::ControlledSystem<state_dim, control_dim>
+{
+public:
+    PendulumVanDerPol() = default;
+    PendulumVanDerPol(const PendulumVanDerPol& arg) : ct::core::ControlledSystem<state_dim, control_dim>(arg) {}
+    PendulumVanDerPol* clone() const override { return new PendulumVanDerPol(*this); }
+    void computeControlledDynamics(const ct::core::StateVector<state_dim>& x,
+        const double& t,
+        const ct::core::ControlVector<control_dim>& u,
+        ct::core::StateVector<state_dim>& derivative) override
+    {
+        derivative(0) = x(1);
+        derivative(1) = -std::sin(x(0)) - 0.1 * x(1) + u(0);
+        derivative(2) = x(3);
+        derivative(3) = 0.5 * (1.0 - x(2) * x(2)) * x(3) - x(2) + 0.2 * x(0) * x(0);
+    }
+};
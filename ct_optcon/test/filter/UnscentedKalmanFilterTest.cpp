@@ -0,0 +1,118 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+#include "PendulumVanDerPol.h"
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+std::shared_ptr<CTSystemModel<state_dim, control_dim>> createSystemModel(const StateMatrix<state_dim>& Q)
+{
+    return std::shared_ptr<CTSystemModel<state_dim, control_dim>>(
+        new CTSystemModel<state_dim, control_dim>(std::shared_ptr<PendulumVanDerPol>(new PendulumVanDerPol()),
+            std::shared_ptr<CTSystemModel<state_dim, control_dim>::SensitivityApprox_t>(), Q, RK4CT));
+}
+
+//! runs predict and update steps with a fixed control and measurement sequence and records the estimates
+template <class FILTER>
+StateVectorArray<state_dim> runFilter(FILTER& filter)
+{
+    const double dt = 0.05;
+    StateVectorArray<state_dim> estimates;
+    ControlVector<control_dim> u;
+    OutputVector<output_dim> z;
+    for (int k = 0; k < 100; ++k)
+    {
+        u << std::sin(0.1 * k);
+        filter.predict(u, dt, k * dt);
+        z << std::cos(0.3 * k), 0.5 * std::sin(0.2 * k);
+        filter.update(z, dt, k * dt);
+        estimates.push_back(filter.getEstimate());
+    }
+    return estimates;
+}
+
+TEST(UnscentedKalmanFilterTest, squareRootMatchesStandardFilter)
+{
+    Eigen::Matrix<double, output_dim, state_dim> C;
+    C << 1, 0, 0, 0, 0, 0, 1, 0.5;
+    std::shared_ptr<LinearMeasurementModel<output_dim, state_dim>> h(
+        new LTIMeasurementModel<output_dim, state_dim>(C, 0.1 * Eigen::Matrix2d::Identity()));
+
+    StateVector<state_dim> x0;
+    x0 << 0.5, 0.0, 1.0, 0.0;
+    StateMatrix<state_dim> P0 = StateMatrix<state_dim>::Identity();
+    P0(0, 1) = P0(1, 0) = 0.3;
+
+    // full process noise, and noise on the velocities only
+    StateMatrix<state_dim> Q_full = 0.01 * StateMatrix<state_dim>::Identity();
+    StateMatrix<state_dim> Q_partial = StateMatrix<state_dim>::Zero();
+    Q_partial(1, 1) = 0.01;
+    Q_partial(3, 3) = 0.02;
+
+    for (const StateMatrix<state_dim>& Q : {Q_full, Q_partial})
+    {
+        // alpha < 1 yields a negative weight of the center sigma point, hence a rank-1 downdate
+        for (double alpha : {1.0, 0.5, 0.01})
+        {
+            for (size_t nThreads : {1, 3})
+            {
+                std::shared_ptr<CTSystemModel<state_dim, control_dim>> f_ref = createSystemModel(Q);
+                std::shared_ptr<CTSystemModel<state_dim, control_dim>> f = createSystemModel(Q);
+                f->setNumThreads(nThreads);
+
+                UnscentedKalmanFilter<state_dim, control_dim, output_dim> ukf(f_ref, h, x0, alpha, 2.0, 0.0, P0);
+                SquareRootUnscentedKalmanFilter<state_dim, control_dim, output_dim> srukf(
+                    f, h, x0, alpha, 2.0, 0.0, P0);
+
+                const StateVectorArray<state_dim> x_ref = runFilter(ukf);
+                const StateVectorArray<state_dim> x = runFilter(srukf);
+
+                ASSERT_EQ(x.size(), x_ref.size());
+                for (size_t k = 0; k < x.size(); ++k)
+                    ASSERT_LT((x[k] - x_ref[k]).array().abs().maxCoeff(), 1e-9);
+
+                // the covariance stays symmetric positive definite by construction
+                Eigen::LLT<Eigen::Matrix4d> llt(srukf.getCovariance());
+                ASSERT_EQ(llt.info(), Eigen::Success);
+            }
+        }
+    }
+}
+
+TEST(UnscentedKalmanFilterTest, batchPropagationMatchesSingleStates)
+{
+    StateVectorBatch<state_dim> states = StateVectorBatch<state_dim>::Base::Random(state_dim, 9);
+    const StateVectorBatch<state_dim> initialStates = states;
+
+    ControlVector<control_dim> u;
+    u << 0.3;
+    const double dt = 0.1;
+
+    for (size_t nThreads : {1, 2, 4, 16})
+    {
+        std::shared_ptr<CTSystemModel<state_dim, control_dim>> f =
+            createSystemModel(StateMatrix<state_dim>::Identity());
+        f->setNumThreads(nThreads);
+
+        states = initialStates;
+        f->computeDynamicsBatch(states, u, dt, 0.0);
+
+        for (int i = 0; i < states.cols(); ++i)
+        {
+            const StateVector<state_dim> x_ref = f->computeDynamics(initialStates.col(i), u, dt, 0.0);
+            ASSERT_LT((states.col(i) - x_ref).array().abs().maxCoeff(), 1e-14);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
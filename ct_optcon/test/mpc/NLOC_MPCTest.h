@@ -9,6 +9,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #pragma once
 
 #include <chrono>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include "mpcTestSettings.h"
@@ -350,6 +351,370 @@ TEST(MPCTestB, NLOC_MPC_DoublePrecision)
 }
 
 
+/**
+ * Run the MPC asynchronously on its own thread while a 1 kHz control loop consumes the published policies
+ */
+TEST(MPCTestC, MpcRunner)
+{
+    typedef tpl::LinearOscillator<double> LinearOscillator;
+    typedef tpl::LinearOscillatorLinear<double> LinearOscillatorLinear;
+
+    try
+    {
+        Eigen::Vector2d x_final;
+        x_final << 20, 0;
+
+        StateVector<state_dim> x0;
+        x0.setRandom();
+
+        ct::core::Time timeHorizon = 3.0;
+
+        shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+        shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+        shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+            tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+        optConProblem.setTimeHorizon(timeHorizon);
+        optConProblem.setInitialState(x0);
+
+        NLOptConSettings nloc_settings;
+        nloc_settings.dt = 0.01;
+        nloc_settings.K_sim = 1;
+        nloc_settings.max_iterations = 10;
+        nloc_settings.min_cost_improvement = 1e-10;
+        nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+        nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+        nloc_settings.integrator = ct::core::IntegrationType::EULER;
+        nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::ILQR;
+        nloc_settings.nThreads = 1;
+        nloc_settings.nThreadsEigen = 1;
+        nloc_settings.printSummary = false;
+
+        int K = nloc_settings.computeK(timeHorizon);
+
+        FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+        ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+        StateVectorArray<state_dim> x_ref(K + 1, x0);
+        ct::core::StateFeedbackController<state_dim, control_dim> initController(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+        NLOptConSolver<state_dim, control_dim> initSolver(optConProblem, nloc_settings);
+        initSolver.setInitialGuess(initController);
+        initSolver.solve();
+        ct::core::StateTrajectory<state_dim> perfectStateTrajectory = initSolver.getStateTrajectory();
+
+        NLOptConSettings nloc_settings_mpc = nloc_settings;
+        nloc_settings_mpc.max_iterations = 1;
+
+        ct::optcon::mpc_settings settings;
+        settings.stateForwardIntegration_ = true;
+        settings.stateForwardIntegratorType_ = nloc_settings.integrator;
+        settings.stateForwardIntegration_dt_ = nloc_settings.dt;
+        settings.postTruncation_ = false;
+        settings.measureDelay_ = false;
+        settings.fixedDelayUs_ = 10000;
+        settings.mpc_mode = ct::optcon::MPC_MODE::FIXED_FINAL_TIME;
+        settings.coldStart_ = false;
+        settings.useExternalTiming_ = true;
+
+        MpcRunner<NLOptConSolver<state_dim, control_dim>> runner(optConProblem, nloc_settings_mpc, settings);
+        runner.getMpc().setInitialGuess(initSolver.getSolution());
+
+        ControlVector<control_dim> u;
+        StateVector<state_dim> x = x0;
+        StateVector<state_dim> xdot;
+
+        // no policy available before the runner has been started
+        ASSERT_FALSE(runner.computeControl(x, 0.0, u));
+
+        const auto startTime = std::chrono::steady_clock::now();
+        auto elapsed = [&startTime]() {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        };
+
+        runner.start(x, 0.0);
+        ASSERT_TRUE(runner.isRunning());
+
+        // measurements which are not newer than the initial one do not trigger further iterations
+        while (runner.getNumberOfPublishedPolicies() == 0 && runner.isRunning())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for (size_t i = 0; i < 10; i++)
+        {
+            runner.setStateMeasurement(x, 0.0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_EQ(runner.getNumberOfPublishedPolicies(), 1u);
+
+        // simulate the system in real-time, using whatever policy is the latest one
+        const double dt_control = 0.001;
+        double t = 0.0;
+        size_t nControlled = 0;
+        while (t < 1.0 && runner.isRunning())
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int>(1e6 * dt_control)));
+            const double t_now = elapsed();
+
+            if (runner.computeControl(x, t_now, u))
+            {
+                system->computeControlledDynamics(x, t_now, u, xdot);
+                x += (t_now - t) * xdot;
+                nControlled++;
+            }
+
+            t = t_now;
+            runner.setStateMeasurement(x, t);
+        }
+
+        runner.stop();
+        ASSERT_FALSE(runner.isRunning());
+
+        ASSERT_GT(runner.getNumberOfPublishedPolicies(), 5u);
+        ASSERT_GT(nControlled, 100u);
+
+        double policy_ts;
+        ASSERT_TRUE(runner.getPolicy(policy_ts) != nullptr);
+        ASSERT_LE(policy_ts, t + 1e-6 * settings.fixedDelayUs_);
+
+        // the closed loop follows the open-loop optimal trajectory
+        ASSERT_LT(std::fabs((perfectStateTrajectory.eval(t) - x)(0)), 1.0);
+        ASSERT_LT(std::fabs((perfectStateTrajectory.eval(t) - x)(1)), 2.0);
+
+    } catch (std::exception& e)
+    {
+        std::cout << "caught exception: " << e.what() << std::endl;
+        FAIL();
+    }
+}
+
+
+/**
+ * For a linear system with quadratic cost, a real-time iteration solves the LQ problem exactly, hence its feedback
+ * phase has to produce the same first control as a regular MPC iteration on the new initial state, and the deferred
+ * update of the remaining stages has to produce the same policy
+ */
+TEST(MPCTestD, RealTimeIteration)
+{
+    typedef tpl::LinearOscillator<double> LinearOscillator;
+    typedef tpl::LinearOscillatorLinear<double> LinearOscillatorLinear;
+
+    try
+    {
+        Eigen::Vector2d x_final;
+        x_final << 20, 0;
+
+        StateVector<state_dim> x0;
+        x0.setRandom();
+
+        ct::core::Time timeHorizon = 3.0;
+
+        shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+        shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+        shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+            tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+        optConProblem.setTimeHorizon(timeHorizon);
+        optConProblem.setInitialState(x0);
+
+        NLOptConSettings nloc_settings;
+        nloc_settings.dt = 0.01;
+        nloc_settings.K_sim = 1;
+        nloc_settings.max_iterations = 1;
+        nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+        nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+        nloc_settings.integrator = ct::core::IntegrationType::EULER;
+        nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+        nloc_settings.nThreads = 1;
+        nloc_settings.nThreadsEigen = 1;
+        nloc_settings.printSummary = false;
+
+        NLOptConSettings nloc_settings_rti = nloc_settings;
+        nloc_settings_rti.realTimeIteration = true;
+        ASSERT_TRUE(nloc_settings_rti.parametersOk());
+
+        // real-time iterations are not available for single shooting
+        NLOptConSettings nloc_settings_invalid = nloc_settings_rti;
+        nloc_settings_invalid.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::ILQR;
+        ASSERT_FALSE(nloc_settings_invalid.parametersOk());
+
+        ct::optcon::mpc_settings settings;
+        settings.stateForwardIntegration_ = false;
+        settings.postTruncation_ = false;
+        settings.measureDelay_ = false;
+        settings.fixedDelayUs_ = 20000;
+        settings.mpc_mode = ct::optcon::MPC_MODE::FIXED_FINAL_TIME;
+        settings.coldStart_ = false;
+        settings.useExternalTiming_ = true;
+
+        int K = nloc_settings.computeK(timeHorizon);
+        FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+        ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+        StateVectorArray<state_dim> x_ref(K + 1, x0);
+        ct::core::StateFeedbackController<state_dim, control_dim> initController(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+        MPC<NLOptConSolver<state_dim, control_dim>> mpc(optConProblem, nloc_settings, settings);
+        MPC<NLOptConSolver<state_dim, control_dim>> mpcRti(optConProblem, nloc_settings_rti, settings);
+        mpc.setInitialGuess(initController);
+        mpcRti.setInitialGuess(initController);
+
+        ct::core::StateFeedbackController<state_dim, control_dim> policy, policyRti;
+        ct::core::Time ts, tsRti;
+
+        for (int i = 0; i < 20; i++)
+        {
+            const double t = i * 1e-6 * settings.fixedDelayUs_;
+
+            mpc.prepareIteration(t);
+            mpcRti.prepareIteration(t);
+
+            // the measured state deviates from the predicted one, which the feedback phase needs to account for
+            if (i > 0)
+                x0 = policy.getReferenceStateTrajectory().eval(1e-6 * settings.fixedDelayUs_) +
+                     0.1 * StateVector<state_dim>::Random();
+
+            mpc.finishIteration(x0, t, policy, ts);
+            mpcRti.finishIteration(x0, t, policyRti, tsRti);
+
+            ASSERT_NEAR(ts, tsRti, 1e-12);
+            ASSERT_EQ(policy.uff().size(), policyRti.uff().size());
+            ASSERT_LT((policyRti.x_ref()[0] - x0).norm(), 1e-10);
+            ASSERT_LT((policy.uff()[0] - policyRti.uff()[0]).norm(), 1e-6);
+
+            // the feedback phase only updated the first control, the remaining stages follow on completion
+            ASSERT_TRUE(mpcRti.getSolver().getBackend()->completeRealTimeIteration());
+            ASSERT_FALSE(mpcRti.getSolver().getBackend()->completeRealTimeIteration());
+            const ct::core::StateFeedbackController<state_dim, control_dim>& policyCompleted =
+                mpcRti.getSolver().getSolution();
+
+            ASSERT_LT((policyCompleted.x_ref()[0] - x0).norm(), 1e-10);
+            for (size_t k = 0; k < policy.uff().size(); k++)
+            {
+                ASSERT_LT((policy.uff()[k] - policyCompleted.uff()[k]).norm(), 1e-6);
+                ASSERT_LT((policy.x_ref()[k + 1] - policyCompleted.x_ref()[k + 1]).norm(), 1e-6);
+            }
+        }
+
+    } catch (std::exception& e)
+    {
+        std::cout << "caught exception: " << e.what() << std::endl;
+        FAIL();
+    }
+}
+
+
+/**
+ * With post-truncation, the feedback phase of a real-time iteration must not truncate away the freshly computed first
+ * control. The truncation is deferred to the completion, which then produces the policy of a regular MPC iteration.
+ */
+TEST(MPCTestD, RealTimeIterationPostTruncation)
+{
+    typedef tpl::LinearOscillator<double> LinearOscillator;
+    typedef tpl::LinearOscillatorLinear<double> LinearOscillatorLinear;
+
+    try
+    {
+        Eigen::Vector2d x_final;
+        x_final << 20, 0;
+
+        StateVector<state_dim> x0;
+        x0.setRandom();
+
+        ct::core::Time timeHorizon = 3.0;
+
+        shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+        shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+        shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+            tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+        ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+        optConProblem.setTimeHorizon(timeHorizon);
+        optConProblem.setInitialState(x0);
+
+        NLOptConSettings nloc_settings;
+        nloc_settings.dt = 0.01;
+        nloc_settings.K_sim = 1;
+        nloc_settings.max_iterations = 1;
+        nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+        nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+        nloc_settings.integrator = ct::core::IntegrationType::EULER;
+        nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+        nloc_settings.nThreads = 1;
+        nloc_settings.nThreadsEigen = 1;
+        nloc_settings.printSummary = false;
+
+        NLOptConSettings nloc_settings_rti = nloc_settings;
+        nloc_settings_rti.realTimeIteration = true;
+
+        // the measurements arrive later than the delay assumed when preparing, hence the iterations get post-truncated
+        ct::optcon::mpc_settings settings;
+        settings.stateForwardIntegration_ = false;
+        settings.postTruncation_ = true;
+        settings.measureDelay_ = false;
+        settings.fixedDelayUs_ = 10000;
+        settings.mpc_mode = ct::optcon::MPC_MODE::FIXED_FINAL_TIME;
+        settings.coldStart_ = false;
+        settings.useExternalTiming_ = true;
+        const double dt_measurement = 0.03;
+
+        int K = nloc_settings.computeK(timeHorizon);
+        FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+        ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+        StateVectorArray<state_dim> x_ref(K + 1, x0);
+        ct::core::StateFeedbackController<state_dim, control_dim> initController(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+        MPC<NLOptConSolver<state_dim, control_dim>> mpc(optConProblem, nloc_settings, settings);
+        MPC<NLOptConSolver<state_dim, control_dim>> mpcRti(optConProblem, nloc_settings_rti, settings);
+        mpc.setInitialGuess(initController);
+        mpcRti.setInitialGuess(initController);
+
+        ct::core::StateFeedbackController<state_dim, control_dim> policy, policyRti, policyCompleted;
+        ct::core::Time ts, tsRti, tsCompleted;
+
+        size_t nTruncated = 0;
+        for (int i = 0; i < 20; i++)
+        {
+            const double t = i * dt_measurement;
+            const double t_prepare = std::max(0.0, t - dt_measurement);
+
+            mpc.prepareIteration(t_prepare);
+            mpcRti.prepareIteration(t_prepare);
+
+            if (i > 0)
+                x0 = policy.x_ref()[0] + 0.1 * StateVector<state_dim>::Random();
+
+            ASSERT_TRUE(mpc.finishIteration(x0, t, policy, ts));
+            ASSERT_TRUE(mpcRti.finishIteration(x0, t, policyRti, tsRti));
+
+            // the feedback phase keeps the fresh first control, which is the one of the untruncated solution
+            ASSERT_LT((policyRti.x_ref()[0] - x0).norm(), 1e-10);
+            const size_t nFront = policyRti.uff().size() - policy.uff().size();
+            ASSERT_NEAR(ts - tsRti, nFront * nloc_settings.dt, 1e-10);
+            if (nFront > 0)
+                nTruncated++;
+
+            // the completion applies the deferred truncation
+            ASSERT_TRUE(mpcRti.completeRealTimeIteration(policyCompleted, tsCompleted));
+            ASSERT_FALSE(mpcRti.completeRealTimeIteration(policyCompleted, tsCompleted));
+
+            ASSERT_NEAR(ts, tsCompleted, 1e-12);
+            ASSERT_EQ(policy.uff().size(), policyCompleted.uff().size());
+            for (size_t k = 0; k < policy.uff().size(); k++)
+            {
+                ASSERT_LT((policy.uff()[k] - policyCompleted.uff()[k]).norm(), 1e-6);
+                ASSERT_LT((policy.x_ref()[k] - policyCompleted.x_ref()[k]).norm(), 1e-6);
+            }
+        }
+
+        ASSERT_GT(nTruncated, 0u);
+
+    } catch (std::exception& e)
+    {
+        std::cout << "caught exception: " << e.what() << std::endl;
+        FAIL();
+    }
+}
+
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
@@ -0,0 +1,153 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+// instrument malloc and friends for this executable, must precede all other includes
+#define CT_INSTRUMENT_HEAP_ALLOCATIONS
+#include <ct/core/common/HeapAllocationCounter.h>
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "../testSystems/LinearOscillator.h"
+
+using namespace ct::core;
+using namespace ct::optcon;
+using namespace ct::optcon::example;
+
+
+TEST(HeapAllocationTest, counterIsEnabled)
+{
+    const size_t before = HeapAllocationCounter::get();
+    std::vector<double> v(100);
+    StateVectorArray<state_dim> x(10);
+    const size_t after = HeapAllocationCounter::get();
+
+    ASSERT_TRUE(HeapAllocationCounter::isEnabled());
+    ASSERT_GE(after - before, 2u);
+    ASSERT_EQ(v.size(), x.size() * 10);
+}
+
+
+TEST(HeapAllocationTest, alignedAllocationsAreCounted)
+{
+    size_t before = HeapAllocationCounter::get();
+    void* ptr = nullptr;
+    ASSERT_EQ(posix_memalign(&ptr, 64, 128), 0);
+    ASSERT_EQ(HeapAllocationCounter::get() - before, 1u);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0u);
+    free(ptr);
+
+    before = HeapAllocationCounter::get();
+    ptr = aligned_alloc(64, 128);
+    ASSERT_EQ(HeapAllocationCounter::get() - before, 1u);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0u);
+    free(ptr);
+}
+
+
+TEST(HeapAllocationTest, batchDynamics)
+{
+    ControlVector<control_dim> u = ControlVector<control_dim>::Ones();
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator());
+    system->setController(std::shared_ptr<ConstantController<state_dim, control_dim>>(
+        new ConstantController<state_dim, control_dim>(u)));
+
+    StateVectorBatch<state_dim> states = StateVectorBatch<state_dim>::Random(state_dim, 32);
+    StateVectorBatch<state_dim> derivatives;
+
+    // the first evaluation sizes the buffers
+    system->computeDynamicsBatch(states, 0.0, derivatives);
+
+    const size_t before = HeapAllocationCounter::get();
+    for (size_t i = 0; i < 10; i++)
+        system->computeDynamicsBatch(states, 0.0, derivatives);
+    ASSERT_EQ(HeapAllocationCounter::get() - before, 0u);
+}
+
+
+/*!
+ * Run repeated NLOC iterations on a problem of constant size and check that neither the rollouts, nor the LQ
+ * approximation, nor the LQ solution, nor the line search allocate once the first iteration has sized all buffers.
+ */
+TEST(HeapAllocationTest, steadyStateIterations)
+{
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOptConSolver;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> initState;
+    initState.setZero();
+    initState(1) = 1.0;
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = ct::core::IntegrationType::RK4CT;
+    nloc_settings.K_sim = 2;
+    nloc_settings.printSummary = false;
+    nloc_settings.recordSmallestEigenvalue = false;
+
+    for (auto algorithm : {NLOptConSettings::NLOCP_ALGORITHM::GNMS, NLOptConSettings::NLOCP_ALGORITHM::ILQR})
+    {
+        for (bool useSensitivityIntegrator : {true, false})
+        {
+            for (int nThreads : {1, 4})
+            {
+                for (int lineSearchType : {0, 1})
+                {
+                    nloc_settings.nlocp_algorithm = algorithm;
+                    nloc_settings.useSensitivityIntegrator = useSensitivityIntegrator;
+                    nloc_settings.nThreads = nThreads;
+                    nloc_settings.lineSearchSettings.type = static_cast<LineSearchSettings::TYPE>(lineSearchType);
+
+                    std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(
+                        new LinearOscillator());
+                    std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(
+                        new LinearOscillatorLinear());
+                    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+                        ct::optcon::example::tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+                    ct::core::Time tf = 1.0;
+                    size_t nSteps = nloc_settings.computeK(tf);
+
+                    StateVectorArray<state_dim> x0(nSteps + 1, initState);
+                    ControlVectorArray<control_dim> u0(nSteps, ControlVector<control_dim>::Zero());
+                    FeedbackArray<state_dim, control_dim> u0_fb(
+                        nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+                    NLOptConSolver::Policy_t initController(x0, u0, u0_fb, nloc_settings.dt);
+
+                    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+                        tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+                    NLOptConSolver solver(optConProblem, nloc_settings);
+                    solver.setInitialGuess(initController);
+
+                    const size_t nIterations = 6;
+                    for (size_t i = 0; i < nIterations; i++)
+                        solver.runIteration();
+
+                    const std::vector<size_t>& allocations = solver.getBackend()->getSummary().heapAllocations;
+                    ASSERT_EQ(allocations.size(), nIterations);
+
+                    // only the first iteration may allocate
+                    for (size_t i = 1; i < nIterations; i++)
+                        ASSERT_EQ(allocations[i], 0u) << "algorithm " << static_cast<int>(algorithm)
+                                                      << ", sensitivity integrator " << useSensitivityIntegrator
+                                                      << ", nThreads " << nThreads << ", line search "
+                                                      << lineSearchType << ", iteration " << i;
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -171,6 +171,158 @@ TEST(LinearSystemsTest, NLOCSolverTest)
 }  // end TEST
 
 
+/*!
+ * Check that the pipelined multiple-shooting mode, which overlaps shot rollouts, LQ approximation and the Riccati
+ * backward sweep, yields the same result as the sequential execution of these phases.
+ */
+TEST(LinearSystemsTest, PipelinedMultipleShootingTest)
+{
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOptConSolver;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> initState;
+    initState.setZero();
+    initState(1) = 1.0;
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.epsilon = 0.0;
+    nloc_settings.dt = 0.01;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULERCT;
+    nloc_settings.printSummary = false;
+
+    for (auto alg : {NLOptConSettings::NLOCP_ALGORITHM::GNMS, NLOptConSettings::NLOCP_ALGORITHM::MS_ILQR})
+    {
+        nloc_settings.nlocp_algorithm = alg;
+
+        for (size_t nThreads = 1; nThreads < 5; nThreads = nThreads + 3)
+        {
+            nloc_settings.nThreads = nThreads;
+
+            for (size_t kshot = 1; kshot < 11; kshot = kshot + 9)
+            {
+                nloc_settings.K_shot = kshot;
+
+                ct::core::Time tf = 1.0;
+                size_t nSteps = nloc_settings.computeK(tf);
+
+                StateVectorArray<state_dim> x0(nSteps + 1, initState);
+                ControlVector<control_dim> uff;
+                uff << kStiffness * initState(0);
+                ControlVectorArray<control_dim> u0(nSteps, uff);
+                FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+                NLOptConSolver::Policy_t initController(x0, u0, u0_fb, nloc_settings.dt);
+
+                std::vector<NLOptConSolver::Policy_t> solutions;
+
+                for (int pipelined = 0; pipelined <= 1; pipelined++)
+                {
+                    nloc_settings.pipelinedMultipleShooting = bool(pipelined);
+
+                    shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new LinearOscillator());
+                    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear());
+                    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+                        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+                    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+                        tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+                    NLOptConSolver solver(optConProblem, nloc_settings);
+                    solver.configure(nloc_settings);
+                    solver.setInitialGuess(initController);
+
+                    solver.runIteration();
+                    solver.runIteration();
+
+                    const SummaryAllIterations<double>& summary = solver.getBackend()->getSummary();
+                    ASSERT_LT(summary.lx_norms.back(), 1e-10);
+                    ASSERT_LT(summary.lu_norms.back(), 1e-10);
+                    ASSERT_LT(summary.defect_l2_norms.back(), 1e-10);
+
+                    solutions.push_back(solver.getSolution());
+                }
+
+                ASSERT_EQ(solutions[0].x_ref().size(), solutions[1].x_ref().size());
+                for (size_t i = 0; i < solutions[0].x_ref().size(); i++)
+                    ASSERT_LT((solutions[0].x_ref()[i] - solutions[1].x_ref()[i]).norm(), 1e-9);
+                for (size_t i = 0; i < solutions[0].uff().size(); i++)
+                    ASSERT_LT((solutions[0].uff()[i] - solutions[1].uff()[i]).norm(), 1e-9);
+            }
+        }
+    }
+}
+
+
+/*!
+ * The partitioned Riccati solver of a multi-threaded solver runs on the task pool of the backend and solves the linear
+ * problem in one iteration.
+ */
+TEST(LinearSystemsTest, PartitionedRiccatiSolverTest)
+{
+    typedef NLOptConSolver<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOptConSolver;
+    typedef NLOCBackendMP<state_dim, control_dim, state_dim / 2, state_dim / 2> NLOCBackendMP;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> initState;
+    initState.setZero();
+    initState(1) = 1.0;
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.epsilon = 0.0;
+    nloc_settings.dt = 0.01;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::PARTITIONED_RICCATI_SOLVER;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.integrator = ct::core::IntegrationType::EULERCT;
+    nloc_settings.nThreads = 3;
+    nloc_settings.printSummary = false;
+
+    ct::core::Time tf = 1.0;
+    size_t nSteps = nloc_settings.computeK(tf);
+
+    StateVectorArray<state_dim> x0(nSteps + 1, initState);
+    ControlVectorArray<control_dim> u0(nSteps, ControlVector<control_dim>::Zero());
+    FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+    NLOptConSolver::Policy_t initController(x0, u0, u0_fb, nloc_settings.dt);
+
+    shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new LinearOscillator());
+    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear());
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+        tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+    NLOptConSolver solver(optConProblem, nloc_settings);
+
+    // also after reconfiguring, which replaces the LQ solver
+    for (int configure = 0; configure <= 1; configure++)
+    {
+        if (configure)
+            solver.configure(nloc_settings);
+
+        auto backend = std::dynamic_pointer_cast<NLOCBackendMP>(solver.getBackend());
+        auto lqocSolver =
+            std::dynamic_pointer_cast<PartitionedRiccatiSolver<state_dim, control_dim>>(backend->getLQOCSolver());
+        ASSERT_TRUE(backend && lqocSolver);
+        ASSERT_EQ(lqocSolver->getTaskPool(), backend->getTaskPool());
+    }
+
+    solver.setInitialGuess(initController);
+    solver.runIteration();
+    solver.runIteration();
+
+    const SummaryAllIterations<double>& summary = solver.getBackend()->getSummary();
+    ASSERT_LT(summary.lx_norms.back(), 1e-10);
+    ASSERT_LT(summary.lu_norms.back(), 1e-10);
+}
+
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
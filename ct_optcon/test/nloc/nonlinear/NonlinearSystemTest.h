@@ -5,6 +5,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <chrono>
 #include <fenv.h>
+#include <numeric>
 
 #include <gtest/gtest.h>
 
@@ -116,6 +117,191 @@ TEST(NLOCTest, NonlinearSystemAlgorithmComparison)
         ASSERT_NEAR(uRollout_gnms[i](0), uRollout_ilqr[i](0), 1e-4);
     }
 }
+
+/*!
+ * Check that aborting line search rollouts based on a lower bound of their merit, and cancelling candidates which
+ * cannot win anymore, does not change the solution.
+ */
+TEST(NLOCTest, LineSearchCostBounding)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    // multiple shooting and single shooting, where the rollout is aborted within the only shot
+    for (std::string algorithm : {"gnms", "ilqr"})
+    {
+        NLOptConSettings settings;
+        settings.load(configFile, true, algorithm);
+        settings.lineSearchSettings.type = LineSearchSettings::TYPE::SIMPLE;
+        settings.lineSearchSettings.maxIterations = 10;
+
+        ct::core::Time tf = 3.0;
+        ct::core::loadScalar(configFile, "timeHorizon", tf);
+        size_t nSteps = settings.computeK(tf);
+
+        // perturb the guess away from the equilibrium, such that the line search has to reject candidates
+        ControlVector<control_dim> uff_init_guess;
+        uff_init_guess << -1.1 * (x_0(0) + 1) * x_0(0);
+        ControlVectorArray<control_dim> u0(nSteps, uff_init_guess);
+        StateVectorArray<state_dim> x0(nSteps + 1, x_0);
+        FeedbackArray<state_dim, control_dim> u0_fb(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero());
+        NLOptConSolver::Policy_t initController(x0, u0, u0_fb, settings.dt);
+
+        for (int nThreads : {1, 4})
+        {
+            settings.nThreads = nThreads;
+
+            std::vector<NLOptConSolver::Policy_t> solutions;
+            std::vector<std::vector<double>> stepSizes;
+
+            for (int costBounding = 0; costBounding <= 1; costBounding++)
+            {
+                settings.lineSearchSettings.costBounding = bool(costBounding);
+
+                std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+                std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+                std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+                    new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+                ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+                    tf, x0[0], nonlinearSystem, costFunction, analyticLinearSystem);
+
+                NLOptConSolver solver(optConProblem, settings);
+                solver.setInitialGuess(initController);
+                solver.solve();
+
+                solutions.push_back(solver.getSolution());
+                stepSizes.push_back(solver.getBackend()->getSummary().stepSizes);
+
+                const std::vector<size_t>& pruned = solver.getBackend()->getSummary().prunedLineSearchCandidates;
+                const size_t nPruned = std::accumulate(pruned.begin(), pruned.end(), size_t(0));
+                if (costBounding)
+                    ASSERT_GT(nPruned, 0u);
+                else
+                    ASSERT_EQ(nPruned, 0u);
+            }
+
+            ASSERT_EQ(stepSizes[0], stepSizes[1]);
+            for (size_t i = 0; i < solutions[0].x_ref().size(); i++)
+                ASSERT_NEAR(solutions[0].x_ref()[i](0), solutions[1].x_ref()[i](0), 1e-10);
+            for (size_t i = 0; i < solutions[0].uff().size(); i++)
+                ASSERT_NEAR(solutions[0].uff()[i](0), solutions[1].uff()[i](0), 1e-10);
+        }
+    }
+}
+
+
+/*!
+ * Solve a batch of problems with different initial states on a shared task pool and compare with solving every
+ * problem with its own solver.
+ */
+TEST(NLOCTest, BatchSolver)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0> NLOptConSolver;
+    typedef NLOptConBatchSolver<state_dim, control_dim, 1, 0> NLOptConBatchSolver;
+
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    NLOptConSettings settings;
+    settings.load(configFile, true, "gnms");
+    settings.lineSearchSettings.type = LineSearchSettings::TYPE::SIMPLE;
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+    size_t nSteps = settings.computeK(tf);
+
+    const size_t nProblems = 7;
+
+    NLOptConBatchSolver::OptConProblemArray problems;
+    NLOptConBatchSolver::PolicyArray initialGuesses;
+
+    for (size_t i = 0; i < nProblems; i++)
+    {
+        Eigen::Matrix<double, 1, 1> x_0;
+        x_0 << 0.05 * i;
+
+        std::shared_ptr<ControlledSystem<state_dim, control_dim>> nonlinearSystem(new Dynamics);
+        std::shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearizedSystem);
+        std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+            new CostFunctionAnalytical<state_dim, control_dim>(costFunctionFile));
+
+        problems.push_back(ContinuousOptConProblem<state_dim, control_dim>(
+            tf, x_0, nonlinearSystem, costFunction, analyticLinearSystem));
+
+        ControlVector<control_dim> uff_init_guess;
+        uff_init_guess << -(x_0(0) + 1) * x_0(0);
+        initialGuesses.push_back(NLOptConSolver::Policy_t(StateVectorArray<state_dim>(nSteps + 1, x_0),
+            ControlVectorArray<control_dim>(nSteps, uff_init_guess),
+            FeedbackArray<state_dim, control_dim>(nSteps, FeedbackMatrix<state_dim, control_dim>::Zero()),
+            settings.dt));
+    }
+
+    // the pipelined backward sweep of every backend waits for its shot tasks on the shared pool
+    for (int pipelined = 0; pipelined <= 1; pipelined++)
+    {
+        settings.pipelinedMultipleShooting = bool(pipelined);
+
+        for (int nThreads : {1, 3})
+        {
+            settings.nThreads = nThreads;
+
+            NLOptConBatchSolver batchSolver(problems, settings);
+            ASSERT_EQ(batchSolver.size(), nProblems);
+            ASSERT_EQ(batchSolver.getTaskPool()->getNumThreads(), (size_t)nThreads);
+
+            // all backends run on the pool of the batch solver
+            for (size_t i = 0; i < nProblems; i++)
+            {
+                auto backend = dynamic_cast<NLOCBackendMP<state_dim, control_dim, 1, 0>*>(&batchSolver.getBackend(i));
+                ASSERT_TRUE(backend != nullptr);
+                ASSERT_EQ(backend->getTaskPool(), batchSolver.getTaskPool());
+            }
+
+            batchSolver.setInitialGuesses(initialGuesses);
+            batchSolver.solve();
+
+            NLOptConBatchSolver::StateTrajectoryArray xBatch = batchSolver.getStateTrajectories();
+            NLOptConBatchSolver::ControlTrajectoryArray uBatch = batchSolver.getControlTrajectories();
+
+            NLOptConSettings singleSettings = settings;
+            singleSettings.nThreads = 1;
+
+            for (size_t i = 0; i < nProblems; i++)
+            {
+                ASSERT_EQ(batchSolver.getActive()[i], 0u);
+
+                NLOptConSolver solver(problems[i], singleSettings);
+                solver.setInitialGuess(initialGuesses[i]);
+                solver.solve();
+
+                ASSERT_NEAR(batchSolver.getCosts()[i], solver.getCost(), 1e-12);
+
+                StateTrajectory<state_dim> x = solver.getStateTrajectory();
+                ControlTrajectory<control_dim> u = solver.getControlTrajectory();
+                ASSERT_EQ(x.size(), xBatch[i].size());
+                ASSERT_EQ(x.size(), batchSolver.getStates().size());
+                ASSERT_EQ(u.size(), batchSolver.getControls().size());
+                for (size_t k = 0; k < x.size(); k++)
+                {
+                    ASSERT_NEAR(x[k](0), xBatch[i][k](0), 1e-12);
+                    ASSERT_NEAR(x[k](0), batchSolver.getStates()[k](0, i), 1e-12);
+                }
+                for (size_t k = 0; k < u.size(); k++)
+                {
+                    ASSERT_NEAR(u[k](0), uBatch[i][k](0), 1e-12);
+                    ASSERT_NEAR(u[k](0), batchSolver.getControls()[k](0, i), 1e-12);
+                }
+            }
+        }
+    }
+}
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
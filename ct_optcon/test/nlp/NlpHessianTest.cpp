@@ -0,0 +1,233 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Checks the sparse Hessian values of a small NLP, scattered along the maps of Nlp and
+ * DiscreteConstraintContainerBase, against its dense Hessian. Hence these tests do not require an NLP solver.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+using namespace ct::optcon;
+
+const size_t n = 3;
+
+//! f(x) = x0^2 x1 + 0.5 x2^2, reporting both off-diagonal entries
+class TestCost : public DiscreteCostEvaluatorBase
+{
+public:
+    double eval() override { return 0.0; }
+    void evalGradient(size_t grad_length, Eigen::Map<Eigen::VectorXd>& grad) override { grad.setZero(); }
+    void getSparsityPatternHessian(Eigen::VectorXi& iRow, Eigen::VectorXi& jCol) override
+    {
+        iRow.resize(4);
+        jCol.resize(4);
+        iRow << 0, 1, 0, 2;
+        jCol << 0, 0, 1, 2;
+    }
+    void sparseHessianValues(const Eigen::VectorXd& x, const Eigen::VectorXd& omega, Eigen::VectorXd& hes) override
+    {
+        hes.resize(4);
+        hes << 2.0 * x(1), 2.0 * x(0), 2.0 * x(0), 1.0;
+        hes *= omega(0);
+    }
+
+    static Eigen::MatrixXd dense(const Eigen::VectorXd& x)
+    {
+        Eigen::MatrixXd H = Eigen::MatrixXd::Zero(n, n);
+        H(0, 0) = 2.0 * x(1);
+        H(1, 0) = H(0, 1) = 2.0 * x(0);
+        H(2, 2) = 1.0;
+        return H;
+    }
+};
+
+//! constraint terms only need to provide their Hessian for these tests
+class TestConstraintBase : public DiscreteConstraintBase
+{
+public:
+    Eigen::VectorXd eval() override { return Eigen::VectorXd::Zero(getConstraintSize()); }
+    Eigen::VectorXd evalSparseJacobian() override { return Eigen::VectorXd(); }
+    size_t getNumNonZerosJacobian() override { return 0; }
+    void genSparsityPattern(Eigen::VectorXi& iRow_vec, Eigen::VectorXi& jCol_vec) override {}
+    Eigen::VectorXd getLowerBound() override { return Eigen::VectorXd::Zero(getConstraintSize()); }
+    Eigen::VectorXd getUpperBound() override { return Eigen::VectorXd::Zero(getConstraintSize()); }
+};
+
+//! g(x) = x0 x2, reporting both off-diagonal entries
+class TestConstraintA : public TestConstraintBase
+{
+public:
+    size_t getConstraintSize() override { return 1; }
+    void genSparsityPatternHessian(Eigen::VectorXi& iRow, Eigen::VectorXi& jCol) override
+    {
+        iRow.resize(2);
+        jCol.resize(2);
+        iRow << 2, 0;
+        jCol << 0, 2;
+    }
+    void sparseHessianValues(const Eigen::VectorXd& x, const Eigen::VectorXd& lambda, Eigen::VectorXd& hes) override
+    {
+        hes.setConstant(2, lambda(0));
+    }
+
+    static Eigen::MatrixXd dense(const Eigen::VectorXd& x, const Eigen::VectorXd& lambda)
+    {
+        Eigen::MatrixXd H = Eigen::MatrixXd::Zero(n, n);
+        H(2, 0) = H(0, 2) = lambda(0);
+        return H;
+    }
+};
+
+//! g(x) = [x1^2, x0 x1 + x0 x2], reporting the lower triangle only
+class TestConstraintB : public TestConstraintBase
+{
+public:
+    size_t getConstraintSize() override { return 2; }
+    void genSparsityPatternHessian(Eigen::VectorXi& iRow, Eigen::VectorXi& jCol) override
+    {
+        iRow.resize(3);
+        jCol.resize(3);
+        iRow << 1, 1, 2;
+        jCol << 1, 0, 0;
+    }
+    void sparseHessianValues(const Eigen::VectorXd& x, const Eigen::VectorXd& lambda, Eigen::VectorXd& hes) override
+    {
+        hes.resize(3);
+        hes << 2.0 * lambda(0), lambda(1), lambda(1);
+    }
+
+    static Eigen::MatrixXd dense(const Eigen::VectorXd& x, const Eigen::VectorXd& lambda)
+    {
+        Eigen::MatrixXd H = Eigen::MatrixXd::Zero(n, n);
+        H(1, 1) = 2.0 * lambda(0);
+        H(1, 0) = H(0, 1) = lambda(1);
+        H(2, 0) = H(0, 2) = lambda(1);
+        return H;
+    }
+};
+
+class TestConstraintContainer : public DiscreteConstraintContainerBase
+{
+public:
+    TestConstraintContainer()
+    {
+        constraints_.push_back(std::make_shared<TestConstraintA>());
+        constraints_.push_back(std::make_shared<TestConstraintB>());
+    }
+    void prepareEvaluation() override {}
+    void prepareJacobianEvaluation() override {}
+};
+
+class TestNlp : public Nlp
+{
+public:
+    TestNlp()
+    {
+        optVariables_ = std::make_shared<OptVector>(n);
+        costEvaluator_ = std::make_shared<TestCost>();
+        constraints_ = std::make_shared<TestConstraintContainer>();
+    }
+    void updateProblem() override {}
+
+    const Eigen::VectorXi& hessianCostMap() const { return hessianCostMap_; }
+    const Eigen::VectorXi& hessianConstraintsMap() const { return hessianConstraintsMap_; }
+    std::shared_ptr<DiscreteConstraintContainerBase> constraints() { return constraints_; }
+};
+
+
+TEST(NlpHessianTest, ScatterMapTest)
+{
+    TestNlp nlp;
+    const size_t nele_hes = nlp.getNonZeroHessianCount();
+
+    // (0,0), (1,0), (2,0), (1,1), (2,2)
+    ASSERT_EQ(nele_hes, 5u);
+
+    // entries in the strict upper triangle are not scattered into the solver's Hessian
+    ASSERT_EQ(nlp.hessianCostMap().rows(), 4);
+    EXPECT_EQ(nlp.hessianCostMap()(2), -1);
+    for (int i : {0, 1, 3})
+        EXPECT_GE(nlp.hessianCostMap()(i), 0);
+
+    // the constraint container keeps both triangles, its upper entry (0,2) gets dropped
+    ASSERT_EQ(nlp.hessianConstraintsMap().rows(), 4);
+    EXPECT_EQ((nlp.hessianConstraintsMap().array() < 0).count(), 1);
+}
+
+TEST(NlpHessianTest, ConstraintContainerTest)
+{
+    TestNlp nlp;
+    nlp.getNonZeroHessianCount();
+
+    for (size_t trial = 0; trial < 10; trial++)
+    {
+        const Eigen::VectorXd x = Eigen::VectorXd::Random(n);
+        const Eigen::VectorXd lambda = Eigen::VectorXd::Random(3);
+
+        const Eigen::MatrixXd dense =
+            TestConstraintA::dense(x, lambda.head<1>()) + TestConstraintB::dense(x, lambda.tail<2>());
+
+        Eigen::VectorXi iRow, jCol;
+        nlp.constraints()->getSparsityPatternHessian(iRow, jCol, n);
+        Eigen::VectorXd hes;
+        nlp.constraints()->sparseHessianValues(x, lambda, hes);
+
+        // (2,0) of A accumulates with (2,0) of B, while (0,2) is only reported by A
+        ASSERT_EQ(hes.rows(), 4);
+        for (int i = 0; i < hes.rows(); i++)
+        {
+            if (iRow(i) >= jCol(i))
+                EXPECT_NEAR(hes(i), dense(iRow(i), jCol(i)), 1e-12);
+            else
+                EXPECT_NEAR(hes(i), lambda(0), 1e-12);
+        }
+    }
+}
+
+TEST(NlpHessianTest, LagrangianHessianTest)
+{
+    TestNlp nlp;
+    const size_t nele_hes = nlp.getNonZeroHessianCount();
+
+    Eigen::VectorXi iRowVec(nele_hes), jColVec(nele_hes);
+    Eigen::Map<Eigen::VectorXi> iRow(iRowVec.data(), nele_hes), jCol(jColVec.data(), nele_hes);
+    nlp.getSparsityPatternHessian(nele_hes, iRow, jCol);
+
+    for (size_t trial = 0; trial < 10; trial++)
+    {
+        Eigen::VectorXd x = Eigen::VectorXd::Random(n);
+        Eigen::VectorXd lambdaVec = Eigen::VectorXd::Random(3);
+        const double obj_fac = trial % 2 ? 1.0 : 0.5;
+
+        Eigen::Map<const Eigen::VectorXd> xMap(x.data(), n);
+        nlp.extractOptimizationVars(xMap, true);
+
+        Eigen::VectorXd hesVec(nele_hes);
+        Eigen::Map<Eigen::VectorXd> hes(hesVec.data(), nele_hes);
+        Eigen::Map<const Eigen::VectorXd> lambda(lambdaVec.data(), 3);
+        nlp.evaluateHessian(nele_hes, hes, obj_fac, lambda);
+
+        const Eigen::MatrixXd dense = obj_fac * TestCost::dense(x) + TestConstraintA::dense(x, lambdaVec.head<1>()) +
+                                      TestConstraintB::dense(x, lambdaVec.tail<2>());
+
+        // the solver's Hessian is the lower triangle of the dense Hessian
+        Eigen::MatrixXd lower = Eigen::MatrixXd::Zero(n, n);
+        for (size_t i = 0; i < nele_hes; i++)
+        {
+            ASSERT_GE(iRow(i), jCol(i));
+            lower(iRow(i), jCol(i)) += hes(i);
+        }
+        EXPECT_TRUE(lower.isApprox(Eigen::MatrixXd(dense.triangularView<Eigen::Lower>()), 1e-12));
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
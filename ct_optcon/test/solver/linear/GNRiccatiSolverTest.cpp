@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "RandomLQOCProblem.h"
+
+using namespace ct;
+using namespace ct::optcon;
+
+const size_t state_dim = 6;
+const size_t control_dim = 3;
+
+typedef LQOCProblem<state_dim, control_dim> LQOCProblem_t;
+
+//! solve a problem with the given solver and settings, and compare against the regular Riccati solver
+void compareToRegularRiccati(std::shared_ptr<LQOCProblem_t> problem,
+    LQOCSolver<state_dim, control_dim>& solver,
+    NLOptConSettings settings)
+{
+    GNRiccatiSolver<state_dim, control_dim> riccati;
+    settings.lqoc_solver_settings.riccati_square_root = false;
+    riccati.configure(settings);
+    riccati.setProblem(problem);
+    riccati.solve();
+    riccati.computeStatesAndControls();
+
+    solver.setProblem(problem);
+    solver.solve();
+    solver.computeStatesAndControls();
+
+    const int N = problem->getNumberOfStages();
+    for (int k = 0; k < N; k++)
+    {
+        ASSERT_LT((solver.getSolutionFeedback()[k] - riccati.getSolutionFeedback()[k]).array().abs().maxCoeff(), 1e-8);
+        ASSERT_LT((solver.get_lv()[k] - riccati.get_lv()[k]).array().abs().maxCoeff(), 1e-8);
+        ASSERT_LT((solver.getSolutionControl()[k] - riccati.getSolutionControl()[k]).array().abs().maxCoeff(), 1e-8);
+    }
+    for (int k = 0; k <= N; k++)
+        ASSERT_LT((solver.getSolutionState()[k] - riccati.getSolutionState()[k]).array().abs().maxCoeff(), 1e-8);
+}
+
+
+TEST(GNRiccatiSolverTest, squareRootRiccati)
+{
+    for (bool fixedHessianCorrection : {false, true})
+    {
+        NLOptConSettings settings;
+        settings.fixedHessianCorrection = fixedHessianCorrection;
+        settings.lqoc_solver_settings.riccati_square_root = true;
+
+        std::shared_ptr<LQOCProblem_t> problem(new LQOCProblem_t(50));
+        example::createRandomProblem(*problem);
+
+        GNRiccatiSolver<state_dim, control_dim> squareRoot;
+        squareRoot.configure(settings);
+        compareToRegularRiccati(problem, squareRoot, settings);
+
+        // a singular terminal cost cannot be factorized, the last stage falls back to the regular design
+        problem->Q_[50].setZero();
+        compareToRegularRiccati(problem, squareRoot, settings);
+    }
+}
+
+
+TEST(GNRiccatiSolverTest, squareRootRiccatiEigenvalueCorrection)
+{
+    NLOptConSettings settings;
+    settings.fixedHessianCorrection = false;
+    settings.lqoc_solver_settings.riccati_square_root = true;
+
+    std::shared_ptr<LQOCProblem_t> problem(new LQOCProblem_t(50));
+    example::createRandomProblem(*problem);
+
+    GNRiccatiSolver<state_dim, control_dim> squareRoot;
+    squareRoot.configure(settings);
+
+    // an indefinite Hessian has to be corrected by clipping its eigenvalues, which the Cholesky design cannot do.
+    // Without input and cross terms, H = R and the clipped stage leaves the cost-to-go positive definite.
+    problem->B_[25].setZero();
+    problem->P_[25].setZero();
+    problem->R_[25] = core::ControlMatrix<control_dim>::Identity();
+    problem->R_[25](control_dim - 1, control_dim - 1) = -1.0;
+    compareToRegularRiccati(problem, squareRoot, settings);
+
+    // a positive definite Hessian is clipped as well if one of its eigenvalues is smaller than epsilon
+    example::createRandomProblem(*problem);
+    settings.epsilon = 1e2;
+    squareRoot.configure(settings);
+    compareToRegularRiccati(problem, squareRoot, settings);
+}
+
+
+TEST(GNRiccatiSolverTest, squareRootPartitionedRiccati)
+{
+    NLOptConSettings settings;
+    settings.nThreads = 3;
+    settings.lqoc_solver_settings.riccati_square_root = true;
+
+    std::shared_ptr<LQOCProblem_t> problem(new LQOCProblem_t(100));
+    example::createRandomProblem(*problem);
+
+    PartitionedRiccatiSolver<state_dim, control_dim> partitioned;
+    partitioned.configure(settings);
+    compareToRegularRiccati(problem, partitioned, settings);
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
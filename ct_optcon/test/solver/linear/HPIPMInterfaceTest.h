@@ -12,6 +12,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
  */
 
 #include "../../testSystems/LinkedMasses.h"
+#include "RandomLQOCProblem.h"
 
 TEST(HPIPMInterfaceTest, compareSolvers)
 {
@@ -113,3 +114,45 @@ TEST(HPIPMInterfaceTest, compareSolvers)
         ASSERT_LT((lv_sol_hpipm[i] - lv_sol_gnriccati[i]).array().abs().maxCoeff(), 1e-6);
     }
 }
+
+
+TEST(HPIPMInterfaceTest, reuseWorkspace)
+{
+    const size_t state_dim = 4;
+    const size_t control_dim = 2;
+    typedef ct::optcon::LQOCProblem<state_dim, control_dim> LQOCProblem_t;
+
+    ct::optcon::HPIPMInterface<state_dim, control_dim> hpipm;
+
+    auto solveAndCompare = [&](int N) {
+        std::shared_ptr<LQOCProblem_t> problem(new LQOCProblem_t(N));
+        ct::optcon::example::createRandomProblem(*problem);
+
+        ct::optcon::GNRiccatiSolver<state_dim, control_dim> gnriccati;
+        gnriccati.setProblem(problem);
+        gnriccati.solve();
+        gnriccati.computeStatesAndControls();
+
+        hpipm.setProblem(problem);
+        hpipm.solve();
+        hpipm.computeStatesAndControls();
+
+        for (int i = 0; i < N; i++)
+            ASSERT_LT((hpipm.getSolutionControl()[i] - gnriccati.getSolutionControl()[i]).array().abs().maxCoeff(),
+                1e-6);
+    };
+
+    solveAndCompare(20);
+    const size_t workspaceSize = hpipm.getWorkspaceSize();
+    ASSERT_GT(workspaceSize, 0u);
+
+    // same and shorter horizons are solved inside the existing arena
+    solveAndCompare(20);
+    ASSERT_EQ(hpipm.getWorkspaceSize(), workspaceSize);
+    solveAndCompare(10);
+    ASSERT_EQ(hpipm.getWorkspaceSize(), workspaceSize);
+
+    // a longer horizon grows the arena
+    solveAndCompare(40);
+    ASSERT_GT(hpipm.getWorkspaceSize(), workspaceSize);
+}
@@ -0,0 +1,159 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "RandomLQOCProblem.h"
+
+using namespace ct;
+using namespace ct::optcon;
+
+const size_t state_dim = 4;
+const size_t control_dim = 2;
+
+TEST(PartitionedRiccatiSolverTest, compareToSequentialRiccati)
+{
+    for (int N : {1, 9, 40, 257})
+    {
+        std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+        example::createRandomProblem(*problem);
+
+        GNRiccatiSolver<state_dim, control_dim> riccati;
+        riccati.setProblem(problem);
+        riccati.solve();
+        riccati.computeStatesAndControls();
+
+        for (int nThreads : {0, 1, 3, 7})
+        {
+            NLOptConSettings settings;
+            settings.nThreads = nThreads;
+
+            PartitionedRiccatiSolver<state_dim, control_dim> partitioned;
+            partitioned.configure(settings);
+            partitioned.setProblem(problem);
+            partitioned.solve();
+            partitioned.computeStatesAndControls();
+
+            const auto& L_ref = riccati.getSolutionFeedback();
+            const auto& L = partitioned.getSolutionFeedback();
+            const auto& lv_ref = riccati.get_lv();
+            const auto& lv = partitioned.get_lv();
+            const auto& x_ref = riccati.getSolutionState();
+            const auto& x = partitioned.getSolutionState();
+
+            for (int k = 0; k < N; k++)
+            {
+                ASSERT_LT((L[k] - L_ref[k]).array().abs().maxCoeff(), 1e-8);
+                ASSERT_LT((lv[k] - lv_ref[k]).array().abs().maxCoeff(), 1e-8);
+            }
+            for (int k = 0; k <= N; k++)
+                ASSERT_LT((x[k] - x_ref[k]).array().abs().maxCoeff(), 1e-8);
+        }
+    }
+}
+
+TEST(PartitionedRiccatiSolverTest, fallbackForSingularControlWeights)
+{
+    const int N = 64;
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    example::createRandomProblem(*problem);
+    problem->R_[N / 3].setZero();  // H = R + B'SB remains positive definite, but R cannot be condensed
+
+    GNRiccatiSolver<state_dim, control_dim> riccati;
+    riccati.setProblem(problem);
+    riccati.solve();
+
+    NLOptConSettings settings;
+    settings.nThreads = 3;
+    PartitionedRiccatiSolver<state_dim, control_dim> partitioned;
+    partitioned.configure(settings);
+    partitioned.setProblem(problem);
+    partitioned.solve();
+
+    for (int k = 0; k < N; k++)
+        ASSERT_LT((partitioned.getSolutionFeedback()[k] - riccati.getSolutionFeedback()[k]).array().abs().maxCoeff(),
+            1e-8);
+}
+
+
+TEST(PartitionedRiccatiSolverTest, hessianRegularization)
+{
+    const int N = 64;
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    example::createRandomProblem(*problem);
+
+    // a fixed correction is condensed exactly, the eigenvalue correction with a large epsilon clips some stages and
+    // requires the sequential fallback, with a small epsilon it does not modify any stage
+    for (bool fixedHessianCorrection : {true, false})
+    {
+        for (double epsilon : {1e-6, 0.5, 1e3})
+        {
+            NLOptConSettings settings;
+            settings.nThreads = 3;
+            settings.fixedHessianCorrection = fixedHessianCorrection;
+            settings.epsilon = epsilon;
+
+            GNRiccatiSolver<state_dim, control_dim> riccati;
+            riccati.configure(settings);
+            riccati.setProblem(problem);
+            riccati.solve();
+
+            PartitionedRiccatiSolver<state_dim, control_dim> partitioned;
+            partitioned.configure(settings);
+            partitioned.setProblem(problem);
+            partitioned.solve();
+
+            for (int k = 0; k < N; k++)
+            {
+                ASSERT_LT(
+                    (partitioned.getSolutionFeedback()[k] - riccati.getSolutionFeedback()[k]).array().abs().maxCoeff(),
+                    1e-8);
+                ASSERT_LT((partitioned.get_lv()[k] - riccati.get_lv()[k]).array().abs().maxCoeff(), 1e-8);
+            }
+        }
+    }
+}
+
+TEST(PartitionedRiccatiSolverTest, sharedTaskPool)
+{
+    const int N = 64;
+    std::shared_ptr<LQOCProblem<state_dim, control_dim>> problem(new LQOCProblem<state_dim, control_dim>(N));
+    example::createRandomProblem(*problem);
+
+    NLOptConSettings settings;
+    settings.nThreads = 1;
+
+    std::shared_ptr<ct::core::TaskPool> taskPool(new ct::core::TaskPool(3));
+
+    PartitionedRiccatiSolver<state_dim, control_dim> partitioned;
+    partitioned.configure(settings);
+    partitioned.setTaskPool(taskPool);
+    partitioned.setProblem(problem);
+    partitioned.solve();
+
+    // the number of segments follows the shared pool, not the settings
+    ASSERT_EQ(partitioned.getTaskPool(), taskPool);
+    ASSERT_EQ(partitioned.getNumberOfSegments(N), 4);
+
+    // without a shared pool, a dedicated one is spawned on the first solve
+    PartitionedRiccatiSolver<state_dim, control_dim> dedicated;
+    dedicated.configure(settings);
+    ASSERT_FALSE(dedicated.getTaskPool());
+    dedicated.setProblem(problem);
+    dedicated.solve();
+    ASSERT_EQ(dedicated.getTaskPool()->getNumThreads(), 1u);
+
+    for (int k = 0; k < N; k++)
+        ASSERT_LT((partitioned.getSolutionFeedback()[k] - dedicated.getSolutionFeedback()[k]).array().abs().maxCoeff(),
+            1e-8);
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
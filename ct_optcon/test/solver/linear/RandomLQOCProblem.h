@@ -0,0 +1,42 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+//! fill a time-varying LQ problem with random, well-conditioned data
+template <int STATE_DIM, int CONTROL_DIM>
+void createRandomProblem(LQOCProblem<STATE_DIM, CONTROL_DIM>& p)
+{
+    const int N = p.getNumberOfStages();
+
+    for (int k = 0; k < N; k++)
+    {
+        p.A_[k] = core::StateMatrix<STATE_DIM>::Identity() + 0.1 * core::StateMatrix<STATE_DIM>::Random();
+        p.B_[k] = core::StateControlMatrix<STATE_DIM, CONTROL_DIM>::Random();
+        p.b_[k] = 0.1 * core::StateVector<STATE_DIM>::Random();
+
+        core::StateMatrix<STATE_DIM> Q_sqrt = core::StateMatrix<STATE_DIM>::Random();
+        p.Q_[k] = Q_sqrt * Q_sqrt.transpose() + core::StateMatrix<STATE_DIM>::Identity();
+        p.qv_[k] = core::StateVector<STATE_DIM>::Random();
+
+        core::ControlMatrix<CONTROL_DIM> R_sqrt = core::ControlMatrix<CONTROL_DIM>::Random();
+        p.R_[k] = R_sqrt * R_sqrt.transpose() + core::ControlMatrix<CONTROL_DIM>::Identity();
+        p.rv_[k] = core::ControlVector<CONTROL_DIM>::Random();
+        p.P_[k] = 0.1 * core::FeedbackMatrix<STATE_DIM, CONTROL_DIM>::Random();
+    }
+
+    core::StateMatrix<STATE_DIM> Q_sqrt = core::StateMatrix<STATE_DIM>::Random();
+    p.Q_[N] = Q_sqrt * Q_sqrt.transpose() + core::StateMatrix<STATE_DIM>::Identity();
+    p.qv_[N] = core::StateVector<STATE_DIM>::Random();
+}
+
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
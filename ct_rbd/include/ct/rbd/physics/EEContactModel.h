@@ -61,6 +61,8 @@ template <class Kinematics>
 class EEContactModel
 {
 public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
     static const size_t NUM_EE = Kinematics::NUM_EE;
     static const size_t NJOINTS = Kinematics::NJOINTS;
 
@@ -70,6 +72,7 @@ public:
 
     typedef std::array<bool, NUM_EE> ActiveMap;
     typedef typename Kinematics::EEForceLinear EEForceLinear;
+    typedef typename Kinematics::KinematicsCache_t KinematicsCache;
     typedef std::array<EEForceLinear, NUM_EE> EEForcesLinear;
 
     typedef Eigen::Matrix<SCALAR, 3, 1> Vector3s;
@@ -145,6 +148,20 @@ public:
 	 * @return End-effector forces expressed in the world frame
 	 */
     EEForcesLinear computeContactForces(const RBDState<NJOINTS, SCALAR>& state)
+    {
+        kinematics_->updateKinematicsCache(state.jointPositions(), kinematicsCache_);
+
+        return computeContactForces(state, kinematicsCache_);
+    }
+
+    /**
+	 * \brief Computes the contact forces given a state of the robot and its kinematics. Returns forces expressed in the
+	 * world frame
+	 * @param state The state of the robot
+	 * @param cache The kinematics of the state, see Kinematics::updateKinematicsCache(). Can be reused afterwards.
+	 * @return End-effector forces expressed in the world frame
+	 */
+    EEForcesLinear computeContactForces(const RBDState<NJOINTS, SCALAR>& state, KinematicsCache& cache)
     {
         EEForcesLinear eeForces;
 
@@ -152,11 +169,11 @@ public:
         {
             if (EEactive_[i])
             {
-                Vector3s eePenetration = computePenetration(i, state.basePose(), state.jointPositions());
+                Vector3s eePenetration = computePenetration(i, state.basePose(), cache);
 
                 if (eeInContact(eePenetration))
                 {
-                    Velocity3S eeVelocity = kinematics_->getEEVelocityInWorld(i, state);
+                    Velocity3S eeVelocity = kinematics_->getEEVelocityInWorld(i, state, cache);
                     eeForces[i] = computeEEForce(eePenetration, eeVelocity);
                 }
                 else
@@ -195,14 +212,14 @@ private:
 	 * \brief Computes the surface penetration. Currently assumes the surface is at height z = 0.
 	 * @param eeId ID of the end-effector
 	 * @param basePose Position of the robot base
-	 * @param jointPosition Joint position of the robot
+	 * @param cache kinematics of the current joint positions
 	 * @return Penetration in world coordinates
 	 */
     Vector3s computePenetration(const size_t& eeId,
         const tpl::RigidBodyPose<SCALAR>& basePose,
-        const typename JointState<NJOINTS, SCALAR>::Position& jointPosition)
+        const KinematicsCache& cache)
     {
-        Position3S pos = kinematics_->getEEPositionInWorld(eeId, basePose, jointPosition);
+        Position3S pos = kinematics_->getEEPositionInWorld(eeId, basePose, cache);
 
         // we currently assume flat ground at height zero penetration is only z height
         Vector3s penetration;
@@ -293,6 +310,8 @@ private:
     SCALAR zOffset_;  //!< vertical offset of the contact pane
 
     ActiveMap EEactive_;  //!< stores which endeffectors are active, i.e. can make contact
+
+    KinematicsCache kinematicsCache_;  //!< kinematics of the last state, if not provided by the caller
 };
 }  // namespace rbd
 }  // namespace ct
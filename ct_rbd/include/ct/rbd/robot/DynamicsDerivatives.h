@@ -0,0 +1,384 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+namespace ct {
+namespace rbd {
+
+/**
+ * \brief Analytical first-order derivatives of the inverse and forward dynamics of a fixed-base robot
+ *
+ * The derivatives of the recursive Newton-Euler algorithm (RNEA) \f$ \tau = ID(q, \dot{q}, \ddot{q}) \f$ are computed
+ * with the base-frame formulation of Carpentier and Mansard, "Analytical Derivatives of Rigid Body Dynamics
+ * Algorithms", RSS 2018. All spatial quantities are expressed in the base frame, where a variation of \f$ q_j \f$
+ * rotates the subtree of joint \f$ j \f$ about its motion subspace \f$ S_j \f$. One forward pass computes the link
+ * velocities, accelerations and inertias, one backward pass accumulates them over the subtrees, hence the derivative
+ * \f$ \partial \tau_k / \partial q_j \f$ and \f$ \partial \tau_k / \partial \dot{q}_j \f$ of every pair of joints on a
+ * common path is a few spatial products. The same passes yield the joint space inertia matrix
+ * \f$ M = \partial \tau / \partial \ddot{q} \f$ from the composite rigid body inertias.
+ *
+ * The forward dynamics derivatives follow from differentiating \f$ \tau = ID(q, \dot{q}, FD(q, \dot{q}, \tau)) \f$:
+ * \f[
+ *  \frac{\partial \ddot{q}}{\partial q} = -M^{-1} \frac{\partial \tau}{\partial q}, \qquad
+ *  \frac{\partial \ddot{q}}{\partial \dot{q}} = -M^{-1} \frac{\partial \tau}{\partial \dot{q}}, \qquad
+ *  \frac{\partial \ddot{q}}{\partial \tau} = M^{-1}
+ * \f]
+ * with the inverse dynamics derivatives evaluated at \f$ \ddot{q} = FD(q, \dot{q}, \tau) \f$, which is obtained from
+ * the same factorization of \f$ M \f$. The kinematics and the factorization only depend on \f$ q \f$ and are computed
+ * once per linearization point.
+ *
+ * The kinematic tree is taken from the robot definition, which has to specify the RobCoGen name of every link
+ * (CT_Lx_NAME) and, for branched robots or prismatic joints, the parent of every link (CT_Lx_PARENT) and the joint
+ * type (CT_Lx_IS_PRISMATIC), see robcogenHelpers.h. Since a missing definition silently describes a serial chain of
+ * revolute joints, the constructor checks the tree against the generated joint space inertia matrix and throws if
+ * they do not match.
+ *
+ * @tparam RBDDynamics the Dynamics of the robot
+ */
+template <class RBDDynamics>
+class DynamicsDerivatives
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static_assert(!RBDDynamics::FB, "DynamicsDerivatives only supports fixed-base systems.");
+
+    static const size_t NJOINTS = RBDDynamics::NJOINTS;
+
+    typedef typename RBDDynamics::SCALAR SCALAR;
+    typedef typename RBDDynamics::JointState_t JointState_t;
+    typedef typename RBDDynamics::JointAcceleration_t JointAcceleration_t;
+    typedef typename RBDDynamics::ExtLinkForces_t ExtLinkForces_t;
+    typedef typename RBDDynamics::control_vector_t control_vector_t;
+    typedef Eigen::Matrix<SCALAR, NJOINTS, NJOINTS> joint_matrix_t;
+
+    /**
+	 * @brief constructor
+	 * @param dynamics the dynamics of the robot
+	 */
+    DynamicsDerivatives(const std::shared_ptr<RBDDynamics>& dynamics = std::shared_ptr<RBDDynamics>(new RBDDynamics()))
+        : dynamics_(dynamics), kinematicsValid_(false)
+    {
+        for (size_t i = 0; i < NJOINTS; i++)
+        {
+            parent_[i] = static_cast<int>(UTILS::getParentLinkById(i + 1)) - 1;
+            if (parent_[i] >= static_cast<int>(i))
+                throw std::runtime_error("DynamicsDerivatives: every link must have a lower ID than its children.");
+
+            axis_[i] = UTILS::isPrismaticJointById(i + 1) ? iit::rbd::LZ : iit::rbd::AZ;
+        }
+
+        // gravity is accounted for by an upwards acceleration of the base, as in the RobCoGen inverse dynamics
+        gravity_.setZero();
+        gravity_(iit::rbd::LZ) = SCALAR(iit::rbd::g);
+
+        checkKinematicTree();
+    }
+
+    //! deep copy, such that copies can be used in parallel
+    DynamicsDerivatives(const DynamicsDerivatives& other)
+        : dynamics_(new RBDDynamics(*other.dynamics_)),
+          parent_(other.parent_),
+          axis_(other.axis_),
+          gravity_(other.gravity_),
+          kinematicsValid_(false)
+    {
+    }
+
+    /**
+	 * @brief Computes the derivatives of the fixed-base inverse dynamics
+	 * @param[in] x joint state
+	 * @param[in] qdd joint accelerations
+	 * @param[in] force external link forces
+	 * @param[out] dTau_dq derivative of the joint torques with respect to the joint positions
+	 * @param[out] dTau_dqd derivative of the joint torques with respect to the joint velocities
+	 * @param[out] dTau_dqdd derivative of the joint torques with respect to the joint accelerations
+	 */
+    void computeIDDerivatives(const JointState_t& x,
+        const JointAcceleration_t& qdd,
+        const ExtLinkForces_t& force,
+        joint_matrix_t& dTau_dq,
+        joint_matrix_t& dTau_dqd,
+        joint_matrix_t& dTau_dqdd)
+    {
+        updateKinematics(x);
+        updateAccelerations(qdd.getAcceleration(), force);
+        computeStateDerivatives(dTau_dq, dTau_dqd);
+
+        dTau_dqdd = M_;
+    }
+
+    /**
+	 * @brief Computes the derivatives of the fixed-base forward dynamics
+	 * @param[in] x joint state
+	 * @param[in] u joint torques
+	 * @param[in] force external link forces
+	 * @param[out] dQdd_dq derivative of the joint accelerations with respect to the joint positions
+	 * @param[out] dQdd_dqd derivative of the joint accelerations with respect to the joint velocities
+	 * @param[out] dQdd_du derivative of the joint accelerations with respect to the joint torques
+	 */
+    void computeFDDerivatives(const JointState_t& x,
+        const control_vector_t& u,
+        const ExtLinkForces_t& force,
+        joint_matrix_t& dQdd_dq,
+        joint_matrix_t& dQdd_dqd,
+        joint_matrix_t& dQdd_du)
+    {
+        updateKinematics(x);
+
+        // the inverse dynamics at zero joint accelerations are the bias forces
+        updateAccelerations(joint_vector_t::Zero(), force);
+        const joint_vector_t qdd = llt_.solve(u - tau_);
+
+        updateAccelerations(qdd, force);
+        computeStateDerivatives(dTau_dq_, dTau_dqd_);
+
+        dQdd_dq = -llt_.solve(dTau_dq_);
+        dQdd_dqd = -llt_.solve(dTau_dqd_);
+        dQdd_du = Minv_;
+    }
+
+    /**
+	 * @brief Computes the derivative of the fixed-base forward dynamics with respect to the joint torques. The inverse
+	 * of the joint space inertia matrix is reused if it was computed for the same joint positions before.
+	 * @param[in] x joint state
+	 * @param[out] dQdd_du the inverse of the joint space inertia matrix
+	 */
+    void computeFDControlDerivative(const JointState_t& x, joint_matrix_t& dQdd_du)
+    {
+        updateInertia(x.getPositions());
+        dQdd_du = Minv_;
+    }
+
+    RBDDynamics& dynamics() { return *dynamics_; }
+    const RBDDynamics& dynamics() const { return *dynamics_; }
+
+private:
+    typedef typename RBDDynamics::ROBCOGEN ROBCOGEN;
+    typedef typename ROBCOGEN::UTILS UTILS;
+    typedef Eigen::Matrix<SCALAR, NJOINTS, 1> joint_vector_t;
+    typedef Eigen::Matrix<SCALAR, 6, 1> Vector6;
+    typedef Eigen::Matrix<SCALAR, 6, 6> Matrix6;
+
+    static Vector6 motionCross(const Vector6& v, const Vector6& m)
+    {
+        Matrix6 vx = Matrix6::Zero();
+        iit::rbd::motionCrossProductMx<SCALAR>(v, vx);
+        return vx * m;
+    }
+
+    static Vector6 forceCross(const Vector6& v, const Vector6& f)
+    {
+        Matrix6 vx = Matrix6::Zero();
+        iit::rbd::forceCrossProductMx<SCALAR>(v, vx);
+        return vx * f;
+    }
+
+    //! compares the joint space inertia matrix of the tree against the generated one in a generic configuration
+    void checkKinematicTree()
+    {
+        const joint_vector_t q = joint_vector_t::LinSpaced(NJOINTS, SCALAR(0.3), SCALAR(1.3));
+        updateInertia(q);
+
+        const joint_matrix_t M = dynamics_->kinematics().robcogen().jSim().update(q);
+        if ((M_ - M).norm() > SCALAR(1e-8) * (SCALAR(1.0) + M.norm()))
+            throw std::runtime_error(
+                "DynamicsDerivatives: the kinematic tree does not match the robot, check CT_Lx_PARENT and "
+                "CT_Lx_IS_PRISMATIC in the robot definition.");
+    }
+
+    //! link transforms and inertias, composite inertias and the factorization of the joint space inertia matrix
+    void updateInertia(const joint_vector_t& q)
+    {
+        if (kinematicsValid_ && q == q_)
+            return;
+
+        ROBCOGEN& robcogen = dynamics_->kinematics().robcogen();
+
+        for (size_t i = 0; i < NJOINTS; i++)
+        {
+            // base_X_link maps motion vectors from link to base coordinates, its inverse is link_X_base
+            const Matrix6 X = UTILS::getTransformBaseLinkById(robcogen.motionTransforms(), i + 1, q);
+            const Eigen::Matrix<SCALAR, 3, 3> Rt = X.template topLeftCorner<3, 3>().transpose();
+            linkXBase_[i].setZero();
+            linkXBase_[i].template topLeftCorner<3, 3>() = Rt;
+            linkXBase_[i].template bottomRightCorner<3, 3>() = Rt;
+            linkXBase_[i].template bottomLeftCorner<3, 3>() = -Rt * X.template bottomLeftCorner<3, 3>() * Rt;
+
+            S_.col(i) = X.col(axis_[i]);
+            I_[i] = linkXBase_[i].transpose() * UTILS::getInertiaLinkById(robcogen.inertiaProperties(), i + 1) *
+                    linkXBase_[i];
+            IC_[i] = I_[i];
+        }
+
+        for (size_t i = NJOINTS; i-- > 0;)
+            if (parent_[i] >= 0)
+                IC_[parent_[i]] += IC_[i];
+
+        // M_kj = S_k^T IC_k S_j if joint j supports joint k, IC_k being the composite inertia of the subtree of k
+        M_.setZero();
+        for (size_t j = 0; j < NJOINTS; j++)
+        {
+            const Vector6 F = IC_[j] * S_.col(j);
+            M_(j, j) = S_.col(j).dot(F);
+            for (int k = parent_[j]; k >= 0; k = parent_[k])
+            {
+                M_(k, j) = S_.col(k).dot(F);
+                M_(j, k) = M_(k, j);
+            }
+        }
+
+        llt_.compute(M_);
+        Minv_ = llt_.solve(joint_matrix_t::Identity());
+
+        q_ = q;
+        kinematicsValid_ = true;
+    }
+
+    //! forward pass of the link velocities, backward pass of the subtree momenta
+    void updateKinematics(const JointState_t& x)
+    {
+        updateInertia(x.getPositions());
+        qd_ = x.getVelocities();
+
+        for (size_t i = 0; i < NJOINTS; i++)
+        {
+            v_.col(i) = S_.col(i) * qd_(i);
+            if (parent_[i] >= 0)
+                v_.col(i) += v_.col(parent_[i]);
+
+            Matrix6 vxm = Matrix6::Zero();
+            Matrix6 vxf = Matrix6::Zero();
+            iit::rbd::motionCrossProductMx<SCALAR>(v_.col(i), vxm);
+            iit::rbd::forceCrossProductMx<SCALAR>(v_.col(i), vxf);
+
+            H_.col(i) = I_[i] * v_.col(i);
+            C_[i] = vxf * I_[i] - I_[i] * vxm;
+        }
+
+        for (size_t i = NJOINTS; i-- > 0;)
+        {
+            if (parent_[i] >= 0)
+            {
+                H_.col(parent_[i]) += H_.col(i);
+                C_[parent_[i]] += C_[i];
+            }
+        }
+    }
+
+    //! forward pass of the link accelerations, backward pass of the subtree forces and the joint torques
+    void updateAccelerations(const joint_vector_t& qdd, const ExtLinkForces_t& force)
+    {
+        for (size_t i = 0; i < NJOINTS; i++)
+        {
+            const Vector6 v = v_.col(i);
+            const Vector6 a_parent = parent_[i] >= 0 ? Vector6(a_.col(parent_[i])) : gravity_;
+            a_.col(i) = a_parent + S_.col(i) * qdd(i) + motionCross(v, S_.col(i)) * qd_(i);
+
+            F_.col(i) = I_[i] * a_.col(i) + forceCross(v, I_[i] * v) -
+                        linkXBase_[i].transpose() * force[static_cast<typename ROBCOGEN::LinkIdentifiers>(i + 1)];
+        }
+
+        for (size_t i = NJOINTS; i-- > 0;)
+        {
+            if (parent_[i] >= 0)
+                F_.col(parent_[i]) += F_.col(i);
+            tau_(i) = S_.col(i).dot(F_.col(i));
+        }
+    }
+
+    /*!
+     * derivatives of the inverse dynamics with respect to joint positions and velocities. For joint j with parent p
+     * and \f$ c = v_p \times S_j \f$, the subtree force of every joint k supported by j varies as
+     * \f{align*}{
+     *  \partial F_k / \partial q_j &= S_j \times^* F_k - IC_k (S_j \times a_p) + C_k c - IC_k (c \times v_p)
+     *      + c \times^* H_k \\
+     *  \partial F_k / \partial \dot{q}_j &= C_k S_j + 2 IC_k c + S_j \times^* H_k
+     * \f}
+     * with the subtree sums \f$ C_k = \sum (v_i \times^* I_i - I_i v_i \times) \f$ and momenta \f$ H_k \f$. Joints
+     * supporting j see the variation of \f$ F_j \f$. The variation \f$ S_j \times S_k \f$ of the motion subspace
+     * cancels the first term for the supported joints.
+     */
+    void computeStateDerivatives(joint_matrix_t& dTau_dq, joint_matrix_t& dTau_dqd) const
+    {
+        dTau_dq.setZero();
+        dTau_dqd.setZero();
+
+        std::array<bool, NJOINTS> supported;
+
+        for (size_t j = 0; j < NJOINTS; j++)
+        {
+            const int p = parent_[j];
+            const Vector6 S_j = S_.col(j);
+            const Vector6 v_p = p >= 0 ? Vector6(v_.col(p)) : Vector6::Zero();
+            const Vector6 a_p = p >= 0 ? Vector6(a_.col(p)) : gravity_;
+
+            const Vector6 c = motionCross(v_p, S_j);
+            const Vector6 Sxa = motionCross(S_j, a_p);
+            const Vector6 cxv = motionCross(c, v_p);
+
+            // the subtree of j
+            supported.fill(false);
+            for (size_t k = j; k < NJOINTS; k++)
+            {
+                supported[k] = (k == j) || (parent_[k] >= static_cast<int>(j) && supported[parent_[k]]);
+                if (!supported[k])
+                    continue;
+
+                const Vector6 dF_dq = -IC_[k] * (Sxa + cxv) + C_[k] * c + forceCross(c, H_.col(k));
+                const Vector6 dF_dqd = C_[k] * S_j + SCALAR(2.0) * IC_[k] * c + forceCross(S_j, H_.col(k));
+
+                dTau_dq(k, j) = S_.col(k).dot(dF_dq);
+                dTau_dqd(k, j) = S_.col(k).dot(dF_dqd);
+            }
+
+            // the path from j to the base
+            const Vector6 dF_dq = forceCross(S_j, F_.col(j)) - IC_[j] * (Sxa + cxv) + C_[j] * c +
+                                  forceCross(c, H_.col(j));
+            const Vector6 dF_dqd = C_[j] * S_j + SCALAR(2.0) * IC_[j] * c + forceCross(S_j, H_.col(j));
+
+            for (int k = p; k >= 0; k = parent_[k])
+            {
+                dTau_dq(k, j) = S_.col(k).dot(dF_dq);
+                dTau_dqd(k, j) = S_.col(k).dot(dF_dqd);
+            }
+        }
+    }
+
+    std::shared_ptr<RBDDynamics> dynamics_;
+
+    std::array<int, NJOINTS> parent_;  //! parent joint of every joint, -1 for the base
+    std::array<int, NJOINTS> axis_;    //! index of the motion subspace in the link frame
+    Vector6 gravity_;
+
+    // quantities of the linearization point, all in base coordinates
+    bool kinematicsValid_;
+    joint_vector_t q_;
+    joint_vector_t qd_;
+    std::array<Matrix6, NJOINTS> linkXBase_;
+    std::array<Matrix6, NJOINTS> I_;   //! link inertias
+    std::array<Matrix6, NJOINTS> IC_;  //! composite inertias of the subtrees
+    std::array<Matrix6, NJOINTS> C_;   //! subtree sums of v x* I - I v x
+    Eigen::Matrix<SCALAR, 6, NJOINTS> S_;
+    Eigen::Matrix<SCALAR, 6, NJOINTS> v_;
+    Eigen::Matrix<SCALAR, 6, NJOINTS> a_;
+    Eigen::Matrix<SCALAR, 6, NJOINTS> H_;  //! subtree momenta
+    Eigen::Matrix<SCALAR, 6, NJOINTS> F_;  //! subtree forces
+    joint_vector_t tau_;
+
+    joint_matrix_t M_;
+    joint_matrix_t Minv_;
+    Eigen::LLT<joint_matrix_t> llt_;
+
+    joint_matrix_t dTau_dq_;
+    joint_matrix_t dTau_dqd_;
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -13,6 +13,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "kinematics/EndEffector.h"
 #include "kinematics/FloatingBaseTransforms.h"
 #include "kinematics/InverseKinematicsBase.h"
+#include "kinematics/KinematicsCache.h"
 
 namespace ct {
 namespace rbd {
@@ -66,6 +67,7 @@ public:
     using EEForce = SpatialForceVector<SCALAR>;
     using EEForceLinear = Vector3Tpl;
     using JointState_t = JointState<NJOINTS, SCALAR>;
+    using KinematicsCache_t = KinematicsCache<NJOINTS, N_EE, SCALAR>;
 
     void initEndeffectors(std::array<EndEffector<NJOINTS, SCALAR>, NUM_EE>& endeffectors)
     {
@@ -132,6 +134,60 @@ public:
         return rbdState.base().pose().rotateBaseToInertia(eeVelocityBase);
     }
 
+    /*!
+     * \brief Computes the end-effector quantities of a joint configuration once, such that they can be reused
+     * @param jointPosition current robot joint positions
+     * @param cache the cache to fill
+     */
+    void updateKinematicsCache(const typename JointState_t::Position& jointPosition, KinematicsCache_t& cache)
+    {
+        cache.jointPositions_ = jointPosition;
+
+        for (size_t i = 0; i < NUM_EE; i++)
+        {
+            cache.eePositionsInBase_[i] = getEEPositionInBase(i, jointPosition);
+            cache.forceTransformsLinkBase_[i] =
+                robcogen().getForceTransformLinkBaseById(endEffectors_[i].getLinkId(), jointPosition);
+            cache.eeJacobianValid_[i] = false;
+        }
+    }
+
+    //! get the end-effector Jacobian in base coordinates, computed on first access for the cached configuration
+    const Jacobian& getEEJacobianInBase(size_t eeId, KinematicsCache_t& cache)
+    {
+        if (!cache.eeJacobianValid_[eeId])
+        {
+            cache.eeJacobiansInBase_[eeId] = robcogen().getJacobianBaseEEbyId(eeId, cache.jointPositions_);
+            cache.eeJacobianValid_[eeId] = true;
+        }
+
+        return cache.eeJacobiansInBase_[eeId];
+    }
+
+    //! get the end-effector velocity in base coordinates, using the cached kinematics of the state
+    Velocity3Tpl getEEVelocityInBase(size_t eeId, const RBDState<NJOINTS, SCALAR>& rbdState, KinematicsCache_t& cache)
+    {
+        Velocity3Tpl eeVelocityBase;
+        eeVelocityBase.toImplementation() =
+            (getEEJacobianInBase(eeId, cache) * rbdState.jointVelocities()).template bottomRows<3>();
+
+        // add translational velocity induced by linear base motion
+        eeVelocityBase += rbdState.base().velocities().getTranslationalVelocity();
+
+        // add translational velocity induced by angular base motion
+        eeVelocityBase +=
+            rbdState.base().velocities().getRotationalVelocity().cross(cache.eePositionsInBase_[eeId]);
+
+        return eeVelocityBase;
+    }
+
+    //! get the end-effector velocity in world coordinates, using the cached kinematics of the state
+    Velocity3Tpl getEEVelocityInWorld(size_t eeId, const RBDState<NJOINTS, SCALAR>& rbdState, KinematicsCache_t& cache)
+    {
+        Velocity3Tpl eeVelocityBase = getEEVelocityInBase(eeId, rbdState, cache);
+        return rbdState.base().pose().rotateBaseToInertia(eeVelocityBase);
+    }
+
     /*!
      * Computes the forward kinematics for the end-effector position and expresses the end-effector position in robot
      * base coordinates.
@@ -181,14 +237,13 @@ public:
         const RigidBodyPoseTpl& basePose,
         const typename JointState_t::Position& jointPosition)
     {
-        // vector from base to endeffector expressed in base frame
-        Position3Tpl B_x_EE = getEEPositionInBase(eeID, jointPosition);
-
-        // vector from base to endeffector expressed in world frame
-        Position3Tpl W_x_EE = basePose.template rotateBaseToInertia(B_x_EE);
+        return mapPositionFromBaseToWorld(basePose, getEEPositionInBase(eeID, jointPosition));
+    }
 
-        // vector from origin to endeffector = vector from origin to base + vector from base to endeffector
-        return basePose.position() + W_x_EE;
+    //! get the end-effector position in world coordinates, using the cached kinematics
+    Position3Tpl getEEPositionInWorld(size_t eeID, const RigidBodyPoseTpl& basePose, const KinematicsCache_t& cache)
+    {
+        return mapPositionFromBaseToWorld(basePose, cache.eePositionsInBase_[eeID]);
     }
 
     //! get the end-effector pose in world coordinates
@@ -263,6 +318,27 @@ public:
         return mapForceFromWorldToLink(eeForce, basePose, jointPosition, eeId);
     }
 
+    /**
+     * \brief Transforms a force applied at an end-effector and expressed in the world into the link frame the EE is
+     * rigidly connected to, using the cached kinematics.
+     * @param W_force Force expressed in world coordinates
+     * @param basePose Pose of the base (in the world)
+     * @param cache kinematics of the current joint positions, see updateKinematicsCache()
+     * @param eeId ID of the end-effector
+     * @return
+     */
+    EEForce mapForceFromWorldToLink3d(const Vector3Tpl& W_force,
+        const RigidBodyPoseTpl& basePose,
+        const KinematicsCache_t& cache,
+        size_t eeId)
+    {
+        EEForce eeForce(EEForce::Zero());
+        eeForce.force() = W_force;
+
+        return EEForce(cache.forceTransformsLinkBase_[eeId] *
+                       mapForceFromWorldToBase(eeForce, basePose, cache.eePositionsInBase_[eeId]));
+    }
+
     /**
      * \brief Transforms a force applied at an end-effector and expressed in the world into the link frame the EE is
      * rigidly connected to.
@@ -302,15 +378,9 @@ public:
         // get the link that the EE is attached to
         size_t linkId = getEndEffector(eeId).getLinkId();
 
-        // transform the force/torque to an equivalent force/torque in the base using a lever-arm for the torque
-        EEForce B_force;
-
-        B_force.force() = basePose.template rotateInertiaToBase<Vector3Tpl>(W_force.force());
-        B_force.torque() = B_x_EE.toImplementation().cross(B_force.force()) +
-                           basePose.template rotateInertiaToBase<Vector3Tpl>(W_force.torque());
-
         // transform force to link on which endeffector sits on
-        return EEForce(robcogen().getForceTransformLinkBaseById(linkId, jointPosition) * B_force);
+        return EEForce(robcogen().getForceTransformLinkBaseById(linkId, jointPosition) *
+                       mapForceFromWorldToBase(W_force, basePose, B_x_EE));
     }
 
     /**
@@ -359,6 +429,30 @@ public:
 
     RBD& robcogen() { return *rbdContainer_; }
 private:
+    //! position of the end-effector in the world, given its position in the base
+    Position3Tpl mapPositionFromBaseToWorld(const RigidBodyPoseTpl& basePose, const Position3Tpl& B_x_EE)
+    {
+        // vector from base to endeffector expressed in world frame
+        Position3Tpl W_x_EE = basePose.template rotateBaseToInertia(B_x_EE);
+
+        // vector from origin to endeffector = vector from origin to base + vector from base to endeffector
+        return basePose.position() + W_x_EE;
+    }
+
+    //! transform the force/torque to an equivalent force/torque in the base using a lever-arm for the torque
+    EEForce mapForceFromWorldToBase(const EEForce& W_force,
+        const RigidBodyPoseTpl& basePose,
+        const Position3Tpl& B_x_EE)
+    {
+        EEForce B_force;
+
+        B_force.force() = basePose.template rotateInertiaToBase<Vector3Tpl>(W_force.force());
+        B_force.torque() = B_x_EE.toImplementation().cross(B_force.force()) +
+                           basePose.template rotateInertiaToBase<Vector3Tpl>(W_force.torque());
+
+        return B_force;
+    }
+
     std::shared_ptr<RBD> rbdContainer_;
     std::array<EndEffector<NJOINTS, SCALAR>, N_EE> endEffectors_;
     FloatingBaseTransforms<RBD> floatingBaseTransforms_;
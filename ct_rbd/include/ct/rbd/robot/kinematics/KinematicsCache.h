@@ -0,0 +1,47 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include <ct/rbd/state/JointState.h>
+
+namespace ct {
+namespace rbd {
+
+/**
+ * \brief End-effector kinematics of one joint configuration
+ *
+ * Contact models, the mapping of end-effector forces to link forces and other consumers all need the same end-effector
+ * quantities for the current state. The cache gets filled once per state by Kinematics::updateKinematicsCache() and is
+ * then passed to the respective Kinematics methods instead of the joint positions, such that the forward kinematics
+ * are not evaluated repeatedly.
+ *
+ * End-effector positions and force transforms are computed for all end-effectors when updating the cache.
+ * End-effector Jacobians are only needed for some end-effectors, e.g. the ones in contact, and hence get computed on
+ * first access, see Kinematics::getEEJacobianInBase().
+ */
+template <size_t NJOINTS, size_t N_EE, typename SCALAR = double>
+struct KinematicsCache
+{
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Position3Tpl = kindr::Position<SCALAR, 3>;
+    using ForceTransform = Eigen::Matrix<SCALAR, 6, 6>;
+    using Jacobian = Eigen::Matrix<SCALAR, 6, NJOINTS>;
+
+    KinematicsCache() { eeJacobianValid_.fill(false); }
+
+    typename JointState<NJOINTS, SCALAR>::Position jointPositions_;  //! joint positions the cache was computed for
+
+    std::array<Position3Tpl, N_EE> eePositionsInBase_;         //! end-effector positions in base coordinates
+    std::array<ForceTransform, N_EE> forceTransformsLinkBase_;  //! force transforms from base to end-effector links
+    std::array<Jacobian, N_EE> eeJacobiansInBase_;              //! end-effector Jacobians in base coordinates
+    std::array<bool, N_EE> eeJacobianValid_;                    //! flags which Jacobians are computed already
+};
+
+} /* namespace rbd */
+} /* namespace ct */
@@ -65,6 +65,14 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
         ) ;                          \
     break;
 
+#define CT_RBD_INERTIA_BY_NAME(LINK_NAME) inertia.getTensor_##LINK_NAME()
+
+// This is just a helper Macro that generates a case-statement for each link to shorten the macro below.
+#define CT_RBD_CASE_HELPER_INERTIA(LINK_NAME, INDEX) \
+    case INDEX:                                      \
+        return CT_RBD_INERTIA_BY_NAME(LINK_NAME);    \
+        break;
+
 
 namespace ct {
 namespace rbd {
@@ -757,6 +765,353 @@ public:
         return jacobian;
     }
 
+    // This defines a function to get the ID of the parent of a link by ID, the base having ID 0. Unless the parent of
+    // link i is specified by CT_Li_PARENT, the links form a serial chain.
+    static size_t getParentLinkById(size_t link_id)
+    {
+        switch (link_id)
+        {
+#ifdef CT_L0_PARENT
+            case 0 + 1:
+                return CT_L0_PARENT;
+                break;
+#endif
+#ifdef CT_L1_PARENT
+            case 1 + 1:
+                return CT_L1_PARENT;
+                break;
+#endif
+#ifdef CT_L2_PARENT
+            case 2 + 1:
+                return CT_L2_PARENT;
+                break;
+#endif
+#ifdef CT_L3_PARENT
+            case 3 + 1:
+                return CT_L3_PARENT;
+                break;
+#endif
+#ifdef CT_L4_PARENT
+            case 4 + 1:
+                return CT_L4_PARENT;
+                break;
+#endif
+#ifdef CT_L5_PARENT
+            case 5 + 1:
+                return CT_L5_PARENT;
+                break;
+#endif
+#ifdef CT_L6_PARENT
+            case 6 + 1:
+                return CT_L6_PARENT;
+                break;
+#endif
+#ifdef CT_L7_PARENT
+            case 7 + 1:
+                return CT_L7_PARENT;
+                break;
+#endif
+#ifdef CT_L8_PARENT
+            case 8 + 1:
+                return CT_L8_PARENT;
+                break;
+#endif
+#ifdef CT_L9_PARENT
+            case 9 + 1:
+                return CT_L9_PARENT;
+                break;
+#endif
+#ifdef CT_L10_PARENT
+            case 10 + 1:
+                return CT_L10_PARENT;
+                break;
+#endif
+#ifdef CT_L11_PARENT
+            case 11 + 1:
+                return CT_L11_PARENT;
+                break;
+#endif
+#ifdef CT_L12_PARENT
+            case 12 + 1:
+                return CT_L12_PARENT;
+                break;
+#endif
+#ifdef CT_L13_PARENT
+            case 13 + 1:
+                return CT_L13_PARENT;
+                break;
+#endif
+#ifdef CT_L14_PARENT
+            case 14 + 1:
+                return CT_L14_PARENT;
+                break;
+#endif
+#ifdef CT_L15_PARENT
+            case 15 + 1:
+                return CT_L15_PARENT;
+                break;
+#endif
+#ifdef CT_L16_PARENT
+            case 16 + 1:
+                return CT_L16_PARENT;
+                break;
+#endif
+#ifdef CT_L17_PARENT
+            case 17 + 1:
+                return CT_L17_PARENT;
+                break;
+#endif
+#ifdef CT_L18_PARENT
+            case 18 + 1:
+                return CT_L18_PARENT;
+                break;
+#endif
+#ifdef CT_L19_PARENT
+            case 19 + 1:
+                return CT_L19_PARENT;
+                break;
+#endif
+#ifdef CT_L20_PARENT
+            case 20 + 1:
+                return CT_L20_PARENT;
+                break;
+#endif
+#ifdef CT_L21_PARENT
+            case 21 + 1:
+                return CT_L21_PARENT;
+                break;
+#endif
+#ifdef CT_L22_PARENT
+            case 22 + 1:
+                return CT_L22_PARENT;
+                break;
+#endif
+
+            default:
+                if (link_id == 0 || link_id > size_t(NJOINTS))
+                {
+                    std::cout << "getParentLinkById: requested link does not exist, requested: " << link_id
+                              << std::endl;
+                    throw std::runtime_error("getParentLinkById: requested link does not exist");
+                }
+                return link_id - 1;
+                break;
+        }
+    }
+
+    // This defines a function to check by link ID whether a link is attached to its parent by a prismatic joint.
+    // Joints are revolute unless CT_Li_IS_PRISMATIC is specified for link i.
+    static bool isPrismaticJointById(size_t link_id)
+    {
+        switch (link_id)
+        {
+#ifdef CT_L0_IS_PRISMATIC
+            case 0 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L1_IS_PRISMATIC
+            case 1 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L2_IS_PRISMATIC
+            case 2 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L3_IS_PRISMATIC
+            case 3 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L4_IS_PRISMATIC
+            case 4 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L5_IS_PRISMATIC
+            case 5 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L6_IS_PRISMATIC
+            case 6 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L7_IS_PRISMATIC
+            case 7 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L8_IS_PRISMATIC
+            case 8 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L9_IS_PRISMATIC
+            case 9 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L10_IS_PRISMATIC
+            case 10 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L11_IS_PRISMATIC
+            case 11 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L12_IS_PRISMATIC
+            case 12 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L13_IS_PRISMATIC
+            case 13 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L14_IS_PRISMATIC
+            case 14 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L15_IS_PRISMATIC
+            case 15 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L16_IS_PRISMATIC
+            case 16 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L17_IS_PRISMATIC
+            case 17 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L18_IS_PRISMATIC
+            case 18 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L19_IS_PRISMATIC
+            case 19 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L20_IS_PRISMATIC
+            case 20 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L21_IS_PRISMATIC
+            case 21 + 1:
+                return true;
+                break;
+#endif
+#ifdef CT_L22_IS_PRISMATIC
+            case 22 + 1:
+                return true;
+                break;
+#endif
+
+            default:
+                return false;
+                break;
+        }
+    }
+
+    // This defines a function to get the spatial inertia of a link by ID, expressed in the link frame. It requires
+    // the RobCoGen name of link i to be specified by CT_Li_NAME.
+    template <class INERTIA>
+    static const typename INERTIA::IMatrix& getInertiaLinkById(const INERTIA& inertia, size_t link_id)
+    {
+        switch (link_id)
+        {
+#if defined(CT_L0) && defined(CT_L0_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L0_NAME, 0 + 1)
+#endif
+#if defined(CT_L1) && defined(CT_L1_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L1_NAME, 1 + 1)
+#endif
+#if defined(CT_L2) && defined(CT_L2_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L2_NAME, 2 + 1)
+#endif
+#if defined(CT_L3) && defined(CT_L3_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L3_NAME, 3 + 1)
+#endif
+#if defined(CT_L4) && defined(CT_L4_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L4_NAME, 4 + 1)
+#endif
+#if defined(CT_L5) && defined(CT_L5_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L5_NAME, 5 + 1)
+#endif
+#if defined(CT_L6) && defined(CT_L6_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L6_NAME, 6 + 1)
+#endif
+#if defined(CT_L7) && defined(CT_L7_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L7_NAME, 7 + 1)
+#endif
+#if defined(CT_L8) && defined(CT_L8_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L8_NAME, 8 + 1)
+#endif
+#if defined(CT_L9) && defined(CT_L9_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L9_NAME, 9 + 1)
+#endif
+#if defined(CT_L10) && defined(CT_L10_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L10_NAME, 10 + 1)
+#endif
+#if defined(CT_L11) && defined(CT_L11_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L11_NAME, 11 + 1)
+#endif
+#if defined(CT_L12) && defined(CT_L12_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L12_NAME, 12 + 1)
+#endif
+#if defined(CT_L13) && defined(CT_L13_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L13_NAME, 13 + 1)
+#endif
+#if defined(CT_L14) && defined(CT_L14_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L14_NAME, 14 + 1)
+#endif
+#if defined(CT_L15) && defined(CT_L15_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L15_NAME, 15 + 1)
+#endif
+#if defined(CT_L16) && defined(CT_L16_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L16_NAME, 16 + 1)
+#endif
+#if defined(CT_L17) && defined(CT_L17_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L17_NAME, 17 + 1)
+#endif
+#if defined(CT_L18) && defined(CT_L18_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L18_NAME, 18 + 1)
+#endif
+#if defined(CT_L19) && defined(CT_L19_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L19_NAME, 19 + 1)
+#endif
+#if defined(CT_L20) && defined(CT_L20_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L20_NAME, 20 + 1)
+#endif
+#if defined(CT_L21) && defined(CT_L21_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L21_NAME, 21 + 1)
+#endif
+#if defined(CT_L22) && defined(CT_L22_NAME)
+            CT_RBD_CASE_HELPER_INERTIA(CT_L22_NAME, 22 + 1)
+#endif
+
+            default:
+                std::cout << "getInertiaLinkById: inertia of the requested link is not available, requested: "
+                          << link_id << ". Define CT_Li_NAME for all links." << std::endl;
+                throw std::runtime_error("getInertiaLinkById: inertia of the requested link is not available");
+                break;
+        }
+    }
+
 };  // class Utils
 
 
@@ -819,6 +1174,78 @@ typedef Dynamics<RobCoGenContainer, Kinematics::NUM_EE> Dynamics;
 #undef CT_L21
 #undef CT_L22
 
+#undef CT_L0_NAME
+#undef CT_L1_NAME
+#undef CT_L2_NAME
+#undef CT_L3_NAME
+#undef CT_L4_NAME
+#undef CT_L5_NAME
+#undef CT_L6_NAME
+#undef CT_L7_NAME
+#undef CT_L8_NAME
+#undef CT_L9_NAME
+#undef CT_L10_NAME
+#undef CT_L11_NAME
+#undef CT_L12_NAME
+#undef CT_L13_NAME
+#undef CT_L14_NAME
+#undef CT_L15_NAME
+#undef CT_L16_NAME
+#undef CT_L17_NAME
+#undef CT_L18_NAME
+#undef CT_L19_NAME
+#undef CT_L20_NAME
+#undef CT_L21_NAME
+#undef CT_L22_NAME
+
+#undef CT_L0_PARENT
+#undef CT_L1_PARENT
+#undef CT_L2_PARENT
+#undef CT_L3_PARENT
+#undef CT_L4_PARENT
+#undef CT_L5_PARENT
+#undef CT_L6_PARENT
+#undef CT_L7_PARENT
+#undef CT_L8_PARENT
+#undef CT_L9_PARENT
+#undef CT_L10_PARENT
+#undef CT_L11_PARENT
+#undef CT_L12_PARENT
+#undef CT_L13_PARENT
+#undef CT_L14_PARENT
+#undef CT_L15_PARENT
+#undef CT_L16_PARENT
+#undef CT_L17_PARENT
+#undef CT_L18_PARENT
+#undef CT_L19_PARENT
+#undef CT_L20_PARENT
+#undef CT_L21_PARENT
+#undef CT_L22_PARENT
+
+#undef CT_L0_IS_PRISMATIC
+#undef CT_L1_IS_PRISMATIC
+#undef CT_L2_IS_PRISMATIC
+#undef CT_L3_IS_PRISMATIC
+#undef CT_L4_IS_PRISMATIC
+#undef CT_L5_IS_PRISMATIC
+#undef CT_L6_IS_PRISMATIC
+#undef CT_L7_IS_PRISMATIC
+#undef CT_L8_IS_PRISMATIC
+#undef CT_L9_IS_PRISMATIC
+#undef CT_L10_IS_PRISMATIC
+#undef CT_L11_IS_PRISMATIC
+#undef CT_L12_IS_PRISMATIC
+#undef CT_L13_IS_PRISMATIC
+#undef CT_L14_IS_PRISMATIC
+#undef CT_L15_IS_PRISMATIC
+#undef CT_L16_IS_PRISMATIC
+#undef CT_L17_IS_PRISMATIC
+#undef CT_L18_IS_PRISMATIC
+#undef CT_L19_IS_PRISMATIC
+#undef CT_L20_IS_PRISMATIC
+#undef CT_L21_IS_PRISMATIC
+#undef CT_L22_IS_PRISMATIC
+
 #undef CT_EE0
 #undef CT_EE1
 #undef CT_EE2
@@ -927,3 +1354,5 @@ typedef Dynamics<RobCoGenContainer, Kinematics::NUM_EE> Dynamics;
 #undef CT_RBD_CASE_HELPER_ID_BASE
 #undef CT_RBD_CASE_HELPER_JOINT_BEGIN_ID_BASE
 #undef CT_RBD_CASE_HELPER_JOINT_END
+#undef CT_RBD_INERTIA_BY_NAME
+#undef CT_RBD_CASE_HELPER_INERTIA
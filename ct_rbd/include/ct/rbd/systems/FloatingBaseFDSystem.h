@@ -91,14 +91,17 @@ public:
         std::array<typename Kinematics::EEForceLinear, N_EE> eeForcesW;
         eeForcesW.fill(Kinematics::EEForceLinear::Zero());
 
+        // end-effector kinematics are shared by the contact model and the force mapping
+        dynamics_.kinematics().updateKinematicsCache(rbdCached.jointPositions(), kinematicsCache_);
+
         if (eeContactModel_)
-            eeForcesW = eeContactModel_->computeContactForces(rbdCached);
+            eeForcesW = eeContactModel_->computeContactForces(rbdCached, kinematicsCache_);
 
         if (EE_ARE_CONTROL_INPUTS)
             for (size_t i = 0; i < N_EE; i++)
                 eeForcesW[i] += control.template segment<3>(RBDDynamics::NJOINTS + i * 3);
 
-        mapEndeffectorForcesToLinkForces(rbdCached, eeForcesW, linkForces);
+        mapEndeffectorForcesToLinkForces(rbdCached, eeForcesW, linkForces, kinematicsCache_);
 
         typename RBDDynamics::RBDAcceleration_t xd;
 
@@ -117,14 +120,29 @@ public:
     void mapEndeffectorForcesToLinkForces(const typename RBDDynamics::RBDState_t& state,
         const std::array<typename Kinematics::EEForceLinear, N_EE>& eeForcesW,
         typename RBDDynamics::ExtLinkForces_t& linkForces)
+    {
+        dynamics_.kinematics().updateKinematicsCache(state.jointPositions(), kinematicsCache_);
+        mapEndeffectorForcesToLinkForces(state, eeForcesW, linkForces, kinematicsCache_);
+    }
+
+    /**
+	 * Maps the end-effector forces expressed in the world to the link frame as required by robcogen.
+	 * @param state robot state
+	 * @param control end-effector forces expressed in the world
+	 * @param linkForces forces acting on the link expressed in the link frame
+	 * @param cache kinematics of the joint positions of state, see Kinematics::updateKinematicsCache()
+	 */
+    void mapEndeffectorForcesToLinkForces(const typename RBDDynamics::RBDState_t& state,
+        const std::array<typename Kinematics::EEForceLinear, N_EE>& eeForcesW,
+        typename RBDDynamics::ExtLinkForces_t& linkForces,
+        const typename Kinematics::KinematicsCache_t& cache)
     {
         for (size_t i = 0; i < N_EE; i++)
         {
-            auto endEffector = dynamics_.kinematics().getEndEffector(i);
+            const auto& endEffector = dynamics_.kinematics().getEndEffector(i);
             size_t linkId = endEffector.getLinkId();
             linkForces[static_cast<typename RBDDynamics::ROBCOGEN::LinkIdentifiers>(linkId)] =
-                dynamics_.kinematics().mapForceFromWorldToLink3d(
-                    eeForcesW[i], state.basePose(), state.jointPositions(), i);
+                dynamics_.kinematics().mapForceFromWorldToLink3d(eeForcesW[i], state.basePose(), cache, i);
         }
     }
 
@@ -184,6 +202,8 @@ public:
 private:
     RBDDynamics dynamics_;
     std::shared_ptr<ContactModel> eeContactModel_;
+
+    typename Kinematics::KinematicsCache_t kinematicsCache_;  //!< end-effector kinematics of the current state
 };
 
 }  // namespace rbd
@@ -0,0 +1,99 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/rbd/robot/DynamicsDerivatives.h>
+
+namespace ct {
+namespace rbd {
+
+/*!
+ *  \brief Linearization of a fixed-base forward dynamics system based on DynamicsDerivatives
+ *
+ *  In contrast to RbdLinearizer, which differentiates the whole forward dynamics numerically, or generated
+ *  linearization code, the derivatives are assembled from the inverse dynamics and the joint space inertia matrix of
+ *  the robot, see DynamicsDerivatives. Hence any robot gets an accurate linearization without a code generation step.
+ *
+ *  Supports FixBaseFDSystem without actuator dynamics and without end-effector forces as control inputs.
+ */
+template <class SYSTEM>
+class FixBaseFDLinearizer : public ct::core::LinearSystem<SYSTEM::STATE_DIM, SYSTEM::CONTROL_DIM, typename SYSTEM::SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef typename SYSTEM::Dynamics Dynamics;
+    typedef typename SYSTEM::SCALAR SCALAR;
+
+    static const size_t STATE_DIM = SYSTEM::STATE_DIM;
+    static const size_t CONTROL_DIM = SYSTEM::CONTROL_DIM;
+    static const size_t NJOINTS = Dynamics::NJOINTS;
+
+    static_assert(STATE_DIM == 2 * NJOINTS && CONTROL_DIM == NJOINTS,
+        "FixBaseFDLinearizer only supports fully actuated fixed-base systems without actuator dynamics.");
+
+    typedef ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR> Base;
+
+    typedef typename Base::state_vector_t state_vector_t;
+    typedef typename Base::control_vector_t control_vector_t;
+    typedef typename Base::state_matrix_t state_matrix_t;
+    typedef typename Base::state_control_matrix_t state_control_matrix_t;
+
+    typedef DynamicsDerivatives<Dynamics> DynamicsDerivatives_t;
+
+    FixBaseFDLinearizer() : Base(ct::core::SYSTEM_TYPE::SECOND_ORDER), force_(Eigen::Matrix<SCALAR, 6, 1>::Zero())
+    {
+        dFdx_.template topLeftCorner<NJOINTS, NJOINTS>().setZero();
+        dFdx_.template topRightCorner<NJOINTS, NJOINTS>().setIdentity();
+        dFdu_.template topRows<NJOINTS>().setZero();
+    }
+
+    FixBaseFDLinearizer(const FixBaseFDLinearizer& arg)
+        : Base(arg), derivatives_(arg.derivatives_), force_(arg.force_), dFdx_(arg.dFdx_), dFdu_(arg.dFdu_)
+    {
+    }
+
+    virtual ~FixBaseFDLinearizer() override {}
+    FixBaseFDLinearizer<SYSTEM>* clone() const override { return new FixBaseFDLinearizer<SYSTEM>(*this); }
+    const state_matrix_t& getDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const SCALAR t = 0.0) override
+    {
+        typename DynamicsDerivatives_t::joint_matrix_t dQdd_du;
+        derivatives_.computeFDDerivatives(typename Dynamics::JointState_t(x), u, force_, dQdd_dq_, dQdd_dqd_, dQdd_du);
+
+        dFdx_.template bottomLeftCorner<NJOINTS, NJOINTS>() = dQdd_dq_;
+        dFdx_.template bottomRightCorner<NJOINTS, NJOINTS>() = dQdd_dqd_;
+
+        return dFdx_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const state_vector_t& x,
+        const control_vector_t& u,
+        const SCALAR t = 0.0) override
+    {
+        typename DynamicsDerivatives_t::joint_matrix_t dQdd_du;
+        derivatives_.computeFDControlDerivative(typename Dynamics::JointState_t(x), dQdd_du);
+
+        dFdu_.template bottomRows<NJOINTS>() = dQdd_du;
+
+        return dFdu_;
+    }
+
+    DynamicsDerivatives_t& derivatives() { return derivatives_; }
+private:
+    DynamicsDerivatives_t derivatives_;
+    typename Dynamics::ExtLinkForces_t force_;
+
+    state_matrix_t dFdx_;
+    state_control_matrix_t dFdu_;
+
+    typename DynamicsDerivatives_t::joint_matrix_t dQdd_dq_;
+    typename DynamicsDerivatives_t::joint_matrix_t dQdd_dqd_;
+};
+
+}  // namespace rbd
+}  // namespace ct
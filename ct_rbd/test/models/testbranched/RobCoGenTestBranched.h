@@ -0,0 +1,50 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "generated/declarations.h"
+#include "generated/jsim.h"
+#include "generated/jacobians.h"
+#include "generated/traits.h"
+#include "generated/forward_dynamics.h"
+#include "generated/inertia_properties.h"
+#include "generated/inverse_dynamics.h"
+#include "generated/transforms.h"
+#include "generated/link_data_map.h"
+
+
+// a fixed-base robot with a prismatic joint and two branches, see description/testbranched.kindsl
+#define ROBCOGEN_NS testbranched
+#define TARGET_NS TestBranched
+
+// define the links
+#define CT_BASE fr_link0
+#define CT_L0 fr_link1
+#define CT_L1 fr_link2
+#define CT_L2 fr_link3
+
+// define the names of the links in RobCoGen, e.g. for the analytical dynamics derivatives
+#define CT_L0_NAME link1
+#define CT_L1_NAME link2
+#define CT_L2_NAME link3
+
+// link3 hangs from link1, next to link2
+#define CT_L2_PARENT 1
+
+// link2 slides along link1
+#define CT_L1_IS_PRISMATIC
+
+// define single end effector on link2
+#define CT_N_EE 1
+#define CT_EE0 fr_ee
+#define CT_EE0_IS_ON_LINK 2
+#define CT_EE0_FIRST_JOINT 0
+#define CT_EE0_LAST_JOINT 1
+
+#include <ct/rbd/robot/robcogen/robcogenHelpers.h>
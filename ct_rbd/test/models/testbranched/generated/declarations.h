@@ -0,0 +1,46 @@
+#ifndef IIT_ROBOT_TESTBRANCHED_DECLARATIONS_H_
+#define IIT_ROBOT_TESTBRANCHED_DECLARATIONS_H_
+
+#include <Eigen/Dense>
+
+namespace iit {
+namespace testbranched {
+
+static const int JointSpaceDimension = 3;
+static const int jointsCount = 3;
+/** The total number of rigid bodies of this robot, including the base */
+static const int linksCount  = 4;
+
+namespace tpl {
+template <typename SCALAR>
+using Column3d = Eigen::Matrix<SCALAR, 3, 1>;
+
+template <typename SCALAR>
+using JointState = Column3d<SCALAR>;
+}
+
+using Column3d = tpl::Column3d<double>;
+typedef Column3d JointState;
+
+enum JointIdentifiers {
+    JA = 0
+    , JB
+    , JC
+};
+
+enum LinkIdentifiers {
+    LINK0 = 0
+    , LINK1
+    , LINK2
+    , LINK3
+};
+
+static const JointIdentifiers orderedJointIDs[jointsCount] =
+    {JA,JB,JC};
+
+static const LinkIdentifiers orderedLinkIDs[linksCount] =
+    {LINK0,LINK1,LINK2,LINK3};
+
+}
+}
+#endif
@@ -0,0 +1,210 @@
+#ifndef IIT_ROBOT_TESTBRANCHED_FORWARD_DYNAMICS_H_
+#define IIT_ROBOT_TESTBRANCHED_FORWARD_DYNAMICS_H_
+
+#include <Eigen/Dense>
+#include <iit/rbd/rbd.h>
+#include <iit/rbd/InertiaMatrix.h>
+#include <iit/rbd/utils.h>
+#include <iit/rbd/robcogen_commons.h>
+
+#include "declarations.h"
+#include "transforms.h"
+#include "inertia_properties.h"
+#include "link_data_map.h"
+
+namespace iit {
+namespace testbranched {
+namespace dyn {
+
+/**
+ * The Forward Dynamics routine for the robot testbranched.
+ *
+ * The Articulated-Body-Algorithm, for the two branches 'link2' (prismatic
+ * joint) and 'link3' (revolute joint) hanging from 'link1'.
+ */
+namespace tpl{
+
+template <typename TRAIT>
+class ForwardDynamics {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef typename TRAIT::Scalar SCALAR;
+    typedef iit::rbd::Core<SCALAR> CoreS;
+    typedef LinkDataMap<typename CoreS::ForceVector> ExtForces;
+    typedef typename CoreS::ForceVector Force;
+    typedef typename CoreS::VelocityVector Velocity;
+    typedef typename CoreS::VelocityVector Acceleration;
+    typedef typename CoreS::Column6D Column6DS;
+    typedef typename iit::testbranched::tpl::JointState<SCALAR> JointState;
+    typedef typename CoreS::Matrix66 Matrix66S;
+    typedef iit::rbd::tpl::InertiaMatrixDense<SCALAR> InertiaMatrix;
+    typedef iit::testbranched::tpl::MotionTransforms<TRAIT> MTransforms;
+
+public:
+    ForwardDynamics(iit::testbranched::dyn::tpl::InertiaProperties<TRAIT>& in, MTransforms& tr) :
+        inertiaProps( & in ),
+        motionTransforms( & tr )
+    {
+        link1_v.setZero();
+        link1_c.setZero();
+        link2_v.setZero();
+        link2_c.setZero();
+        link3_v.setZero();
+        link3_c.setZero();
+        vcross.setZero();
+        Ia_r.setZero();
+        Ia_p.setZero();
+    }
+
+    /**
+     * \param qdd the joint accelerations vector (output parameter).
+     * \param q the joint status vector
+     * \param qd the joint velocities vector
+     * \param tau the joint forces (torque or force)
+     * \param fext the external forces, optional. Each force must be
+     *              expressed in the reference frame of the link it is
+     *              exerted on.
+     */
+    void fd(
+        JointState& qdd, // output parameter
+        const JointState& q, const JointState& qd, const JointState& tau, const ExtForces& fext = zeroExtForces)
+    {
+        setJointStatus(q);
+        fd(qdd, qd, tau, fext);
+    }
+
+    void fd(
+        JointState& qdd, // output parameter
+        const JointState& qd, const JointState& tau, const ExtForces& fext = zeroExtForces)
+    {
+        link1_AI = inertiaProps->getTensor_link1();
+        link1_p = - fext[LINK1];
+        link2_AI = inertiaProps->getTensor_link2();
+        link2_p = - fext[LINK2];
+        link3_AI = inertiaProps->getTensor_link3();
+        link3_p = - fext[LINK3];
+
+        // ---------------------- FIRST PASS ---------------------- //
+        // + Link link1
+        link1_v(rbd::AZ) = qd(JA);
+        link1_p += iit::rbd::vxIv(qd(JA), link1_AI);
+
+        // + Link link2
+        link2_v = (motionTransforms-> fr_link2_X_fr_link1) * link1_v;
+        link2_v(rbd::LZ) += qd(JB);
+        iit::rbd::motionCrossProductMx<SCALAR>(link2_v, vcross);
+        link2_c = vcross.col(rbd::LZ) * qd(JB);
+        link2_p += iit::rbd::vxIv(link2_v, link2_AI);
+
+        // + Link link3
+        link3_v = (motionTransforms-> fr_link3_X_fr_link1) * link1_v;
+        link3_v(rbd::AZ) += qd(JC);
+        iit::rbd::motionCrossProductMx<SCALAR>(link3_v, vcross);
+        link3_c = vcross.col(rbd::AZ) * qd(JC);
+        link3_p += iit::rbd::vxIv(link3_v, link3_AI);
+
+        // ---------------------- SECOND PASS ---------------------- //
+        Matrix66S IaB;
+        Force pa;
+
+        // + Link link3
+        link3_u = tau(JC) - link3_p(rbd::AZ);
+        link3_U = link3_AI.col(rbd::AZ);
+        link3_D = link3_U(rbd::AZ);
+
+        iit::rbd::compute_Ia_revolute(link3_AI, link3_U, link3_D, Ia_r);
+        pa = link3_p + Ia_r * link3_c + link3_U * link3_u/link3_D;
+        ctransform_Ia_revolute(Ia_r, motionTransforms-> fr_link3_X_fr_link1, IaB);
+        link1_AI += IaB;
+        link1_p += (motionTransforms-> fr_link3_X_fr_link1).transpose() * pa;
+
+        // + Link link2
+        link2_u = tau(JB) - link2_p(rbd::LZ);
+        link2_U = link2_AI.col(rbd::LZ);
+        link2_D = link2_U(rbd::LZ);
+
+        iit::rbd::compute_Ia_prismatic(link2_AI, link2_U, link2_D, Ia_p);
+        pa = link2_p + Ia_p * link2_c + link2_U * link2_u/link2_D;
+        ctransform_Ia_prismatic(Ia_p, motionTransforms-> fr_link2_X_fr_link1, IaB);
+        link1_AI += IaB;
+        link1_p += (motionTransforms-> fr_link2_X_fr_link1).transpose() * pa;
+
+        // + Link link1
+        link1_u = tau(JA) - link1_p(rbd::AZ);
+        link1_U = link1_AI.col(rbd::AZ);
+        link1_D = link1_U(rbd::AZ);
+
+        // ---------------------- THIRD PASS ---------------------- //
+        link1_a = (motionTransforms-> fr_link1_X_fr_link0).col(rbd::LZ) * SCALAR(iit::rbd::g);
+        qdd(JA) = (link1_u - link1_U.dot(link1_a)) / link1_D;
+        link1_a(rbd::AZ) += qdd(JA);
+
+        link2_a = (motionTransforms-> fr_link2_X_fr_link1) * link1_a + link2_c;
+        qdd(JB) = (link2_u - link2_U.dot(link2_a)) / link2_D;
+        link2_a(rbd::LZ) += qdd(JB);
+
+        link3_a = (motionTransforms-> fr_link3_X_fr_link1) * link1_a + link3_c;
+        qdd(JC) = (link3_u - link3_U.dot(link3_a)) / link3_D;
+        link3_a(rbd::AZ) += qdd(JC);
+    }
+
+    /** Updates all the kinematics transforms used by this instance. */
+    void setJointStatus(const JointState& q) const {
+        (motionTransforms-> fr_link1_X_fr_link0)(q);
+        (motionTransforms-> fr_link2_X_fr_link1)(q);
+        (motionTransforms-> fr_link3_X_fr_link1)(q);
+    }
+
+private:
+    iit::testbranched::dyn::tpl::InertiaProperties<TRAIT>* inertiaProps;
+    MTransforms* motionTransforms;
+
+    Matrix66S vcross; // support variable
+    Matrix66S Ia_r;   // support variable, articulated inertia in the case of a revolute joint
+    Matrix66S Ia_p;   // support variable, articulated inertia in the case of a prismatic joint
+
+    // Link 'link1' :
+    Matrix66S link1_AI;
+    Velocity link1_a;
+    Velocity link1_v;
+    Velocity link1_c;
+    Force    link1_p;
+    Column6DS link1_U;
+    SCALAR link1_D;
+    SCALAR link1_u;
+    // Link 'link2' :
+    Matrix66S link2_AI;
+    Velocity link2_a;
+    Velocity link2_v;
+    Velocity link2_c;
+    Force    link2_p;
+    Column6DS link2_U;
+    SCALAR link2_D;
+    SCALAR link2_u;
+    // Link 'link3' :
+    Matrix66S link3_AI;
+    Velocity link3_a;
+    Velocity link3_v;
+    Velocity link3_c;
+    Force    link3_p;
+    Column6DS link3_U;
+    SCALAR link3_D;
+    SCALAR link3_u;
+
+private:
+    static const ExtForces zeroExtForces;
+};
+
+template <typename TRAIT>
+const typename ForwardDynamics<TRAIT>::ExtForces ForwardDynamics<TRAIT>::zeroExtForces(Force::Zero());
+
+} // namespace tpl
+
+typedef tpl::ForwardDynamics<rbd::DoubleTrait> ForwardDynamics;
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef IIT_ROBOT_TESTBRANCHED_INERTIA_PROPERTIES_H_
+#define IIT_ROBOT_TESTBRANCHED_INERTIA_PROPERTIES_H_
+
+#include <Eigen/Dense>
+#include <iit/rbd/rbd.h>
+#include <iit/rbd/InertiaMatrix.h>
+#include <iit/rbd/utils.h>
+#include <iit/rbd/traits/DoubleTrait.h>
+
+#include "declarations.h"
+
+namespace iit {
+namespace testbranched {
+/**
+ * This namespace encloses classes and functions related to the Dynamics
+ * of the robot testbranched.
+ */
+namespace dyn {
+
+using InertiaMatrix = iit::rbd::InertiaMatrixDense;
+
+namespace tpl{
+
+/**
+ * The spatial inertias of the links, expressed in the link frames. The
+ * rotational inertias are taken about the link frame origins.
+ */
+template<typename TRAIT>
+class InertiaProperties {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        typedef typename TRAIT::Scalar SCALAR;
+        typedef iit::rbd::tpl::InertiaMatrixDense<SCALAR> IMatrix;
+        typedef Eigen::Matrix<SCALAR, 3, 1> Vec3d;
+
+        InertiaProperties() {
+            com_link1 = iit::rbd::Vector3d(0.1,0.0,0.1).cast<SCALAR>();
+            tensor_link1.fill(
+                SCALAR(5.0),
+                com_link1,
+                rbd::Utils::buildInertiaTensor(
+                        SCALAR(0.1),
+                        SCALAR(0.16),
+                        SCALAR(0.09),
+                        SCALAR(0.0),
+                        SCALAR(0.05),
+                        SCALAR(0.0)) );
+
+            com_link2 = iit::rbd::Vector3d(0.0,0.0,0.2).cast<SCALAR>();
+            tensor_link2.fill(
+                SCALAR(2.0),
+                com_link2,
+                rbd::Utils::buildInertiaTensor(
+                        SCALAR(0.1),
+                        SCALAR(0.1),
+                        SCALAR(0.005),
+                        SCALAR(0.0),
+                        SCALAR(0.0),
+                        SCALAR(0.0)) );
+
+            com_link3 = iit::rbd::Vector3d(0.15,0.0,0.05).cast<SCALAR>();
+            tensor_link3.fill(
+                SCALAR(3.0),
+                com_link3,
+                rbd::Utils::buildInertiaTensor(
+                        SCALAR(0.0175),
+                        SCALAR(0.105),
+                        SCALAR(0.0975),
+                        SCALAR(0.0),
+                        SCALAR(0.0225),
+                        SCALAR(0.0)) );
+        }
+
+        const IMatrix& getTensor_link1() const { return this->tensor_link1; }
+        const IMatrix& getTensor_link2() const { return this->tensor_link2; }
+        const IMatrix& getTensor_link3() const { return this->tensor_link3; }
+        SCALAR getMass_link1() const { return this->tensor_link1.getMass(); }
+        SCALAR getMass_link2() const { return this->tensor_link2.getMass(); }
+        SCALAR getMass_link3() const { return this->tensor_link3.getMass(); }
+        const Vec3d& getCOM_link1() const { return this->com_link1; }
+        const Vec3d& getCOM_link2() const { return this->com_link2; }
+        const Vec3d& getCOM_link3() const { return this->com_link3; }
+        SCALAR getTotalMass() const { return 5.0 + 2.0 + 3.0; }
+
+    private:
+        IMatrix tensor_link1;
+        IMatrix tensor_link2;
+        IMatrix tensor_link3;
+        Vec3d com_link1;
+        Vec3d com_link2;
+        Vec3d com_link3;
+};
+
+} // namespace tpl
+
+using InertiaProperties = tpl::InertiaProperties<rbd::DoubleTrait>;
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef IIT_TESTBRANCHED_INVERSE_DYNAMICS_H_
+#define IIT_TESTBRANCHED_INVERSE_DYNAMICS_H_
+
+#include <Eigen/Dense>
+#include <iit/rbd/rbd.h>
+#include <iit/rbd/InertiaMatrix.h>
+#include <iit/rbd/utils.h>
+#include <iit/rbd/robcogen_commons.h>
+#include <iit/rbd/traits/DoubleTrait.h>
+
+#include "declarations.h"
+#include "inertia_properties.h"
+#include "transforms.h"
+#include "link_data_map.h"
+
+namespace iit {
+namespace testbranched {
+namespace dyn {
+
+/**
+ * The Inverse Dynamics routine for the robot testbranched.
+ *
+ * The recursive Newton-Euler algorithm, traversing the two branches 'link2'
+ * (prismatic joint) and 'link3' (revolute joint) hanging from 'link1'.
+ * Each external wrench must be expressed in the reference frame of the link it
+ * is excerted on.
+ */
+namespace tpl {
+
+template <typename TRAIT>
+class InverseDynamics {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef typename TRAIT::Scalar SCALAR;
+    typedef iit::rbd::Core<SCALAR> CoreS;
+    typedef typename CoreS::ForceVector Force;
+    typedef LinkDataMap<Force> ExtForces;
+    typedef typename CoreS::VelocityVector Velocity;
+    typedef typename CoreS::VelocityVector Acceleration;
+    typedef iit::rbd::tpl::InertiaMatrixDense<SCALAR> InertiaMatrix;
+    typedef iit::testbranched::tpl::JointState<SCALAR> JointState;
+    typedef typename CoreS::Matrix66 Matrix66s;
+    typedef iit::testbranched::tpl::MotionTransforms<TRAIT> MTransforms;
+    typedef InertiaProperties<TRAIT> IProperties;
+
+public:
+    InverseDynamics(IProperties& in, MTransforms& tr) :
+        inertiaProps( & in ),
+        xm( & tr ),
+        link1_I(inertiaProps->getTensor_link1() ),
+        link2_I(inertiaProps->getTensor_link2() ),
+        link3_I(inertiaProps->getTensor_link3() )
+    {
+        link1_v.setZero();
+        link2_v.setZero();
+        link3_v.setZero();
+        vcross.setZero();
+    }
+
+    /**
+     * \param[out] jForces the joint force vector required to achieve the desired accelerations
+     * \param[in] q the joint position vector
+     * \param[in] qd the joint velocity vector
+     * \param[in] qdd the desired joint acceleration vector
+     * \param[in] fext the external forces acting on the links; this parameters
+     *            defaults to zero
+     */
+    void id(
+        JointState& jForces,
+        const JointState& q, const JointState& qd, const JointState& qdd,
+        const ExtForces& fext = zeroExtForces)
+    {
+        setJointStatus(q);
+        id(jForces, qd, qdd, fext);
+    }
+
+    void id(
+        JointState& jForces,
+        const JointState& qd, const JointState& qdd,
+        const ExtForces& fext = zeroExtForces)
+    {
+        // First pass, link 'link1'
+        link1_a = (xm->fr_link1_X_fr_link0).col(iit::rbd::LZ) * SCALAR(iit::rbd::g);
+        link1_a(iit::rbd::AZ) += qdd(JA);
+        link1_v(iit::rbd::AZ) = qd(JA);   // link1_v = vJ, for the first link of a fixed base robot
+        link1_f = link1_I * link1_a + iit::rbd::vxIv(qd(JA), link1_I)  - fext[LINK1];
+
+        // First pass, link 'link2'
+        link2_v = ((xm->fr_link2_X_fr_link1) * link1_v);
+        link2_v(iit::rbd::LZ) += qd(JB);
+        iit::rbd::motionCrossProductMx<SCALAR>(link2_v, vcross);
+        link2_a = (xm->fr_link2_X_fr_link1) * link1_a + vcross.col(iit::rbd::LZ) * qd(JB);
+        link2_a(iit::rbd::LZ) += qdd(JB);
+        link2_f = link2_I * link2_a + iit::rbd::vxIv(link2_v, link2_I) - fext[LINK2];
+
+        // First pass, link 'link3'
+        link3_v = ((xm->fr_link3_X_fr_link1) * link1_v);
+        link3_v(iit::rbd::AZ) += qd(JC);
+        iit::rbd::motionCrossProductMx<SCALAR>(link3_v, vcross);
+        link3_a = (xm->fr_link3_X_fr_link1) * link1_a + vcross.col(iit::rbd::AZ) * qd(JC);
+        link3_a(iit::rbd::AZ) += qdd(JC);
+        link3_f = link3_I * link3_a + iit::rbd::vxIv(link3_v, link3_I) - fext[LINK3];
+
+        // Second pass
+        jForces(JC) = link3_f(iit::rbd::AZ);
+        link1_f = link1_f + xm->fr_link3_X_fr_link1.transpose() * link3_f;
+
+        jForces(JB) = link2_f(iit::rbd::LZ);
+        link1_f = link1_f + xm->fr_link2_X_fr_link1.transpose() * link2_f;
+
+        jForces(JA) = link1_f(iit::rbd::AZ);
+    }
+
+    /** Updates all the kinematics transforms used by the inverse dynamics routine. */
+    void setJointStatus(const JointState& q) const
+    {
+        (xm->fr_link1_X_fr_link0)(q);
+        (xm->fr_link2_X_fr_link1)(q);
+        (xm->fr_link3_X_fr_link1)(q);
+    }
+
+private:
+    IProperties* inertiaProps;
+    MTransforms* xm;
+
+private:
+    Matrix66s vcross; // support variable
+    // Link 'link1' :
+    const InertiaMatrix& link1_I;
+    Velocity      link1_v;
+    Acceleration  link1_a;
+    Force         link1_f;
+    // Link 'link2' :
+    const InertiaMatrix& link2_I;
+    Velocity      link2_v;
+    Acceleration  link2_a;
+    Force         link2_f;
+    // Link 'link3' :
+    const InertiaMatrix& link3_I;
+    Velocity      link3_v;
+    Acceleration  link3_a;
+    Force         link3_f;
+
+private:
+    static const ExtForces zeroExtForces;
+};
+
+template <typename TRAIT>
+const typename InverseDynamics<TRAIT>::ExtForces InverseDynamics<TRAIT>::zeroExtForces(Force::Zero());
+
+} // namespace tpl
+
+typedef tpl::InverseDynamics<rbd::DoubleTrait> InverseDynamics;
+
+}
+}
+}
+
+#endif
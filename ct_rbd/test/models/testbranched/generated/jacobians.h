@@ -0,0 +1,67 @@
+#ifndef TESTBRANCHED_JACOBIANS_H_
+#define TESTBRANCHED_JACOBIANS_H_
+
+#include <iit/rbd/TransformsBase.h>
+#include <iit/rbd/traits/DoubleTrait.h>
+#include "declarations.h"
+#include "transforms.h"
+
+namespace iit {
+namespace testbranched {
+
+template<typename SCALAR, int COLS, class M>
+class JacobianT : public iit::rbd::JacobianBase<tpl::JointState<SCALAR>, COLS, M>
+{};
+
+namespace tpl{
+
+/**
+ * The geometric Jacobians of the robot testbranched, expressed in base coordinates
+ */
+template <typename TRAIT>
+class Jacobians {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        typedef typename TRAIT::Scalar SCALAR;
+        typedef JointState<SCALAR> JState;
+
+        /** The Jacobian of the end-effector, which depends on the joints 'jA' and 'jB' */
+        class Type_fr_link0_J_fr_ee : public JacobianT<SCALAR, 2, Type_fr_link0_J_fr_ee>
+        {
+        public:
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            Type_fr_link0_J_fr_ee() { this->setZero(); }
+            const Type_fr_link0_J_fr_ee& update(const JState& q) {
+                typedef FrameTransforms<TRAIT> Frames;
+                const typename Frames::Matrix44 H_link1 = Frames::fr_link0_X_fr_link1(q);
+                const typename Frames::Matrix44 H_link2 = Frames::fr_link0_X_fr_link2(q);
+                const typename Frames::Matrix44 H_ee = Frames::fr_link0_X_fr_ee(q);
+
+                // revolute joint 'jA'
+                const Eigen::Matrix<SCALAR, 3, 1> zA = H_link1.template block<3,1>(0,2);
+                this->template block<3,1>(0,0) = zA;
+                this->template block<3,1>(3,0) =
+                    zA.cross(Eigen::Matrix<SCALAR, 3, 1>(H_ee.template block<3,1>(0,3) - H_link1.template block<3,1>(0,3)));
+
+                // prismatic joint 'jB'
+                this->template block<3,1>(0,1).setZero();
+                this->template block<3,1>(3,1) = H_link2.template block<3,1>(0,2);
+                return *this;
+            }
+        };
+
+    public:
+        Jacobians() {}
+        void updateParameters() {}
+    public:
+        Type_fr_link0_J_fr_ee fr_link0_J_fr_ee;
+};
+
+} //namespace tpl
+
+using Jacobians = tpl::Jacobians<rbd::DoubleTrait>;
+
+}
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef IIT_TESTBRANCHED_JSIM_H_
+#define IIT_TESTBRANCHED_JSIM_H_
+
+#include <iit/rbd/rbd.h>
+#include <iit/rbd/StateDependentMatrix.h>
+
+#include "declarations.h"
+#include "transforms.h"
+#include "inertia_properties.h"
+#include <iit/rbd/robcogen_commons.h>
+#include <iit/rbd/traits/DoubleTrait.h>
+
+namespace iit {
+namespace testbranched {
+namespace dyn {
+
+namespace tpl{
+
+/**
+ * The type of the Joint Space Inertia Matrix (JSIM) of the robot testbranched.
+ * The entry of the joints 'jB' and 'jC' is zero, since they are on different
+ * branches.
+ */
+template <class TRAIT>
+class JSIM : public iit::rbd::StateDependentMatrix<iit::testbranched::JointState, 3, 3, JSIM<TRAIT>>
+{
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    private:
+        typedef iit::rbd::StateDependentMatrix<iit::testbranched::JointState, 3, 3, JSIM<TRAIT>> Base;
+    public:
+        typedef typename TRAIT::Scalar SCALAR;
+        typedef typename Base::Index Index;
+        typedef Eigen::Matrix<SCALAR,3,3> MatrixType;
+        typedef InertiaProperties<TRAIT> IProperties;
+        typedef iit::testbranched::tpl::ForceTransforms<TRAIT> FTransforms;
+        typedef iit::rbd::tpl::InertiaMatrixDense<SCALAR> InertiaMatrix;
+
+    public:
+        JSIM(IProperties& inertiaProperties, FTransforms& forceTransforms) :
+            linkInertias(inertiaProperties),
+            frcTransf( &forceTransforms ),
+            link2_Ic(linkInertias.getTensor_link2()),
+            link3_Ic(linkInertias.getTensor_link3())
+        {
+            //Initialize the matrix itself
+            this->setZero();
+        }
+
+        const JSIM& update(const iit::testbranched::JointState& state) {
+            iit::rbd::ForceVector F;
+
+            // Precomputes only once the coordinate transforms:
+            frcTransf -> fr_link1_X_fr_link3(state);
+            frcTransf -> fr_link1_X_fr_link2(state);
+
+            // Initializes the composite inertia tensors
+            link1_Ic = linkInertias.getTensor_link1();
+
+            // "Bottom-up" loop to update the inertia-composite property of each link, for the current configuration
+
+            // Link link3:
+            iit::rbd::transformInertia(link3_Ic, frcTransf -> fr_link1_X_fr_link3, Ic_spare);
+            link1_Ic += Ic_spare;
+
+            F = link3_Ic.col(iit::rbd::AZ);
+            (*this)(JC, JC) = F(iit::rbd::AZ);
+
+            F = frcTransf -> fr_link1_X_fr_link3 * F;
+            (*this)(JC, JA) = F(iit::rbd::AZ);
+            (*this)(JA, JC) = (*this)(JC, JA);
+
+            // Link link2:
+            iit::rbd::transformInertia(link2_Ic, frcTransf -> fr_link1_X_fr_link2, Ic_spare);
+            link1_Ic += Ic_spare;
+
+            F = link2_Ic.col(iit::rbd::LZ);
+            (*this)(JB, JB) = F(iit::rbd::LZ);
+
+            F = frcTransf -> fr_link1_X_fr_link2 * F;
+            (*this)(JB, JA) = F(iit::rbd::AZ);
+            (*this)(JA, JB) = (*this)(JB, JA);
+
+            // Link link1:
+            F = link1_Ic.col(iit::rbd::AZ);
+            (*this)(JA, JA) = F(iit::rbd::AZ);
+
+            return *this;
+        }
+
+    private:
+        IProperties& linkInertias;
+        FTransforms* frcTransf;
+
+        // The composite-inertia tensor for each link
+        InertiaMatrix link1_Ic;
+        const InertiaMatrix& link2_Ic;
+        const InertiaMatrix& link3_Ic;
+        InertiaMatrix Ic_spare;
+};
+
+} // namespace tpl
+
+typedef tpl::JSIM<rbd::DoubleTrait> JSIM;
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef IIT_ROBOGEN__TESTBRANCHED_TRAITS_H_
+#define IIT_ROBOGEN__TESTBRANCHED_TRAITS_H_
+
+#include "declarations.h"
+#include "transforms.h"
+#include "inverse_dynamics.h"
+#include "forward_dynamics.h"
+#include "jsim.h"
+#include "inertia_properties.h"
+#include "jacobians.h"
+#include <iit/rbd/traits/TraitSelector.h>
+
+
+namespace iit {
+namespace testbranched {
+
+namespace tpl{
+
+template <typename SCALAR>
+struct Traits {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef SCALAR S;
+
+    typedef typename iit::rbd::tpl::TraitSelector<SCALAR>::Trait Trait;
+
+    typedef typename testbranched::tpl::JointState<SCALAR> JointState;
+
+    typedef typename testbranched::JointIdentifiers JointID;
+    typedef typename testbranched::LinkIdentifiers  LinkID;
+
+    typedef typename testbranched::tpl::HomogeneousTransforms<Trait> HomogeneousTransforms;
+    typedef typename testbranched::tpl::MotionTransforms<Trait> MotionTransforms;
+    typedef typename testbranched::tpl::ForceTransforms<Trait> ForceTransforms;
+    typedef typename testbranched::tpl::Jacobians<Trait> Jacobians;
+
+    typedef typename testbranched::dyn::tpl::InertiaProperties<Trait> InertiaProperties;
+    typedef typename testbranched::dyn::tpl::ForwardDynamics<Trait> FwdDynEngine;
+    typedef typename testbranched::dyn::tpl::InverseDynamics<Trait> InvDynEngine;
+    typedef typename testbranched::dyn::tpl::JSIM<Trait> JSIM;
+
+    static const int joints_count = testbranched::jointsCount;
+    static const int links_count  = testbranched::linksCount;
+    static const bool floating_base = false;
+
+    static inline const JointID* orderedJointIDs();
+    static inline const LinkID*  orderedLinkIDs();
+};
+
+template <typename SCALAR>
+inline const typename Traits<SCALAR>::JointID*  Traits<SCALAR>::orderedJointIDs() {
+    return testbranched::orderedJointIDs;
+}
+template <typename SCALAR>
+inline const typename Traits<SCALAR>::LinkID*  Traits<SCALAR>::orderedLinkIDs() {
+    return testbranched::orderedLinkIDs;
+}
+
+} // namespace tpl
+
+typedef tpl::Traits<double> Traits;
+
+}
+}
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef TESTBRANCHED_TRANSFORMS_H_
+#define TESTBRANCHED_TRANSFORMS_H_
+
+#include <Eigen/Dense>
+#include <iit/rbd/TransformsBase.h>
+#include "declarations.h"
+#include <iit/rbd/traits/DoubleTrait.h>
+
+namespace iit {
+namespace testbranched {
+
+namespace tpl {
+
+/**
+ * The homogeneous transforms between the frames of the robot testbranched,
+ * see description/testbranched.kindsl. All other transforms are built from these.
+ *
+ * Link 'link1' hangs from the base via the revolute joint 'jA', links 'link2'
+ * and 'link3' both hang from 'link1', via the prismatic joint 'jB' and the
+ * revolute joint 'jC' respectively. The end-effector frame 'fr_ee' is on 'link2'.
+ */
+template <typename TRAIT>
+struct FrameTransforms {
+    typedef typename TRAIT::Scalar SCALAR;
+    typedef JointState<SCALAR> JState;
+    typedef Eigen::Matrix<SCALAR, 4, 4> Matrix44;
+    typedef Eigen::Matrix<SCALAR, 3, 3> Matrix33;
+    typedef Matrix44 (*Function)(const JState&);
+
+    static Matrix44 fr_link0_X_fr_link1(const JState& q) {
+        Matrix44 H = Matrix44::Identity();
+        H(0,0) = TRAIT::cos(q(JA));
+        H(0,1) = -TRAIT::sin(q(JA));
+        H(1,0) = TRAIT::sin(q(JA));
+        H(1,1) = TRAIT::cos(q(JA));
+        H(2,3) = SCALAR(0.4);
+        return H;
+    }
+    static Matrix44 fr_link1_X_fr_link2(const JState& q) {
+        // rotation about y by PI/2, the joint slides along the z axis of link2
+        Matrix44 H = Matrix44::Zero();
+        H(0,2) = SCALAR(1.0);
+        H(1,1) = SCALAR(1.0);
+        H(2,0) = SCALAR(-1.0);
+        H(0,3) = SCALAR(0.3) + q(JB);
+        H(3,3) = SCALAR(1.0);
+        return H;
+    }
+    static Matrix44 fr_link1_X_fr_link3(const JState& q) {
+        // rotation about x by -PI/2, followed by the rotation of the joint about z
+        Matrix44 H = Matrix44::Zero();
+        H(0,0) = TRAIT::cos(q(JC));
+        H(0,1) = -TRAIT::sin(q(JC));
+        H(1,2) = SCALAR(1.0);
+        H(2,0) = -TRAIT::sin(q(JC));
+        H(2,1) = -TRAIT::cos(q(JC));
+        H(1,3) = SCALAR(0.2);
+        H(2,3) = SCALAR(0.1);
+        H(3,3) = SCALAR(1.0);
+        return H;
+    }
+    static Matrix44 fr_link2_X_fr_ee(const JState&) {
+        Matrix44 H = Matrix44::Identity();
+        H(2,3) = SCALAR(0.1);
+        return H;
+    }
+
+    static Matrix44 fr_link0_X_fr_link2(const JState& q) { return fr_link0_X_fr_link1(q) * fr_link1_X_fr_link2(q); }
+    static Matrix44 fr_link0_X_fr_link3(const JState& q) { return fr_link0_X_fr_link1(q) * fr_link1_X_fr_link3(q); }
+    static Matrix44 fr_link0_X_fr_ee(const JState& q) { return fr_link0_X_fr_link2(q) * fr_link2_X_fr_ee(q); }
+
+    static Matrix44 fr_link1_X_fr_link0(const JState& q) { return inverse(fr_link0_X_fr_link1(q)); }
+    static Matrix44 fr_link2_X_fr_link0(const JState& q) { return inverse(fr_link0_X_fr_link2(q)); }
+    static Matrix44 fr_link3_X_fr_link0(const JState& q) { return inverse(fr_link0_X_fr_link3(q)); }
+    static Matrix44 fr_link2_X_fr_link1(const JState& q) { return inverse(fr_link1_X_fr_link2(q)); }
+    static Matrix44 fr_link3_X_fr_link1(const JState& q) { return inverse(fr_link1_X_fr_link3(q)); }
+
+    static Matrix44 inverse(const Matrix44& H) {
+        Matrix44 Hinv = Matrix44::Identity();
+        Hinv.template topLeftCorner<3,3>() = H.template topLeftCorner<3,3>().transpose();
+        Hinv.template topRightCorner<3,1>() = -H.template topLeftCorner<3,3>().transpose() * H.template topRightCorner<3,1>();
+        return Hinv;
+    }
+    static Matrix33 skew(const Eigen::Matrix<SCALAR, 3, 1>& p) {
+        Matrix33 S;
+        S << SCALAR(0.0), -p(2), p(1),
+             p(2), SCALAR(0.0), -p(0),
+             -p(1), p(0), SCALAR(0.0);
+        return S;
+    }
+};
+
+/** Builds the transform for spatial motion vectors from a homogeneous transform */
+template <typename SCALAR>
+struct MotionConversion {
+    typedef Eigen::Matrix<SCALAR, 6, 6> MatrixType;
+    template <typename TRAIT>
+    static MatrixType convert(const Eigen::Matrix<SCALAR, 4, 4>& H) {
+        MatrixType X = MatrixType::Zero();
+        X.template topLeftCorner<3,3>() = H.template topLeftCorner<3,3>();
+        X.template bottomRightCorner<3,3>() = H.template topLeftCorner<3,3>();
+        X.template bottomLeftCorner<3,3>() =
+            FrameTransforms<TRAIT>::skew(H.template topRightCorner<3,1>()) * H.template topLeftCorner<3,3>();
+        return X;
+    }
+};
+
+/** Builds the transform for spatial force vectors from a homogeneous transform */
+template <typename SCALAR>
+struct ForceConversion {
+    typedef Eigen::Matrix<SCALAR, 6, 6> MatrixType;
+    template <typename TRAIT>
+    static MatrixType convert(const Eigen::Matrix<SCALAR, 4, 4>& H) {
+        MatrixType X = MatrixType::Zero();
+        X.template topLeftCorner<3,3>() = H.template topLeftCorner<3,3>();
+        X.template bottomRightCorner<3,3>() = H.template topLeftCorner<3,3>();
+        X.template topRightCorner<3,3>() =
+            FrameTransforms<TRAIT>::skew(H.template topRightCorner<3,1>()) * H.template topLeftCorner<3,3>();
+        return X;
+    }
+};
+
+template <typename SCALAR>
+struct HomogeneousConversion {
+    typedef Eigen::Matrix<SCALAR, 4, 4> MatrixType;
+    template <typename TRAIT>
+    static MatrixType convert(const Eigen::Matrix<SCALAR, 4, 4>& H) {
+        return H;
+    }
+};
+
+/**
+ * The container of the coordinate transforms of the robot testbranched, of the
+ * kind given by CONVERSION. Transforms are named after the RobCoGen convention,
+ * i.e. fr_a_X_fr_b maps coordinates of frame b to coordinates of frame a.
+ */
+template <typename TRAIT, template <typename> class CONVERSION>
+class Transforms {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef typename TRAIT::Scalar SCALAR;
+    typedef JointState<SCALAR> JState;
+    typedef CONVERSION<SCALAR> Conversion;
+    typedef typename Conversion::MatrixType MatrixType;
+    typedef FrameTransforms<TRAIT> Frames;
+
+    class Type : public iit::rbd::StateDependentMatrix<JState, MatrixType::RowsAtCompileTime,
+                     MatrixType::ColsAtCompileTime, Type>
+    {
+        typedef iit::rbd::StateDependentMatrix<JState, MatrixType::RowsAtCompileTime,
+            MatrixType::ColsAtCompileTime, Type> Base;
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        using Base::operator=;
+        explicit Type(typename Frames::Function frame) : frame_(frame) { this->setZero(); }
+        const Type& update(const JState& q) {
+            *this = Conversion::template convert<TRAIT>(frame_(q));
+            return *this;
+        }
+    private:
+        typename Frames::Function frame_;
+    };
+
+public:
+    Transforms() :
+        fr_link0_X_fr_link1(&Frames::fr_link0_X_fr_link1),
+        fr_link0_X_fr_link2(&Frames::fr_link0_X_fr_link2),
+        fr_link0_X_fr_link3(&Frames::fr_link0_X_fr_link3),
+        fr_link0_X_fr_ee(&Frames::fr_link0_X_fr_ee),
+        fr_link1_X_fr_link0(&Frames::fr_link1_X_fr_link0),
+        fr_link2_X_fr_link0(&Frames::fr_link2_X_fr_link0),
+        fr_link3_X_fr_link0(&Frames::fr_link3_X_fr_link0),
+        fr_link2_X_fr_link1(&Frames::fr_link2_X_fr_link1),
+        fr_link1_X_fr_link2(&Frames::fr_link1_X_fr_link2),
+        fr_link3_X_fr_link1(&Frames::fr_link3_X_fr_link1),
+        fr_link1_X_fr_link3(&Frames::fr_link1_X_fr_link3)
+    {}
+    void updateParameters() {}
+
+public:
+    Type fr_link0_X_fr_link1;
+    Type fr_link0_X_fr_link2;
+    Type fr_link0_X_fr_link3;
+    Type fr_link0_X_fr_ee;
+    Type fr_link1_X_fr_link0;
+    Type fr_link2_X_fr_link0;
+    Type fr_link3_X_fr_link0;
+    Type fr_link2_X_fr_link1;
+    Type fr_link1_X_fr_link2;
+    Type fr_link3_X_fr_link1;
+    Type fr_link1_X_fr_link3;
+};
+
+/** The 6-by-6 coordinates transformation matrices for spatial motion vectors */
+template <typename TRAIT>
+using MotionTransforms = Transforms<TRAIT, MotionConversion>;
+
+/** The 6-by-6 coordinates transformation matrices for spatial force vectors */
+template <typename TRAIT>
+using ForceTransforms = Transforms<TRAIT, ForceConversion>;
+
+/** The 4-by-4 homogeneous coordinates transformation matrices */
+template <typename TRAIT>
+using HomogeneousTransforms = Transforms<TRAIT, HomogeneousConversion>;
+
+} // namespace tpl
+
+using MotionTransforms = tpl::MotionTransforms<rbd::DoubleTrait>;
+using ForceTransforms = tpl::ForceTransforms<rbd::DoubleTrait>;
+using HomogeneousTransforms = tpl::HomogeneousTransforms<rbd::DoubleTrait>;
+
+}
+}
+
+#endif
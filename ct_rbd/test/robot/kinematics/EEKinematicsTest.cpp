@@ -336,6 +336,45 @@ TEST(EEKinematicsTest, torqueMappingTest)
 }
 
 
+// Test that the cached kinematics match the direct computation
+TEST(EEKinematicsTest, kinematicsCacheTest)
+{
+    RBDStateHyQ state;
+    TestHyQ::Kinematics kinematics;
+    TestHyQ::Kinematics::KinematicsCache_t cache;
+
+    const size_t nTests = 100;
+
+    for (size_t t = 0; t < nTests; t++)
+    {
+        // random configuration
+        state.setRandom();
+
+        kinematics.updateKinematicsCache(state.jointPositions(), cache);
+
+        for (size_t i = 0; i < nFeet; i++)
+        {
+            ASSERT_TRUE(kinematics.getEEPositionInWorld(i, state.basePose(), cache)
+                            .toImplementation()
+                            .isApprox(kinematics.getEEPositionInWorld(i, state.basePose(), state.jointPositions())
+                                          .toImplementation()));
+
+            // Jacobians are only computed on demand
+            ASSERT_FALSE(cache.eeJacobianValid_[i]);
+            ASSERT_TRUE(kinematics.getEEVelocityInWorld(i, state, cache)
+                            .toImplementation()
+                            .isApprox(kinematics.getEEVelocityInWorld(i, state).toImplementation()));
+            ASSERT_TRUE(cache.eeJacobianValid_[i]);
+
+            Eigen::Vector3d forceW = Eigen::Vector3d::Random();
+            ASSERT_TRUE(kinematics.mapForceFromWorldToLink3d(forceW, state.basePose(), cache, i)
+                            .isApprox(kinematics.mapForceFromWorldToLink3d(
+                                forceW, state.basePose(), state.jointPositions(), i)));
+        }
+    }
+}
+
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -18,11 +18,30 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <gtest/gtest.h>
 
 #include <ct/rbd/systems/linear/RbdLinearizer.h>
+#include <ct/rbd/systems/linear/FixBaseFDLinearizer.h>
 #include "ct/rbd/systems/FixBaseFDSystem.h"
 #include "ct/rbd/systems/FloatingBaseFDSystem.h"
 
 #include "../../models/testIrb4600/RobCoGenTestIrb4600.h"
 #include "../../models/testhyq/RobCoGenTestHyQ.h"
+#include "../../models/testbranched/RobCoGenTestBranched.h"
+
+// the same robot, defined without its branch and its prismatic joint
+#define ROBCOGEN_NS testbranched
+#define TARGET_NS TestBranchedAsSerial
+#define CT_BASE fr_link0
+#define CT_L0 fr_link1
+#define CT_L1 fr_link2
+#define CT_L2 fr_link3
+#define CT_L0_NAME link1
+#define CT_L1_NAME link2
+#define CT_L2_NAME link3
+#define CT_N_EE 1
+#define CT_EE0 fr_ee
+#define CT_EE0_IS_ON_LINK 2
+#define CT_EE0_FIRST_JOINT 0
+#define CT_EE0_LAST_JOINT 1
+#include <ct/rbd/robot/robcogen/robcogenHelpers.h>
 
 using namespace ct;
 using namespace ct::rbd;
@@ -69,6 +88,118 @@ TEST(RBDLinearizerTest, NumDiffComparisonFixedBase)
     }
 }
 
+TEST(RBDLinearizerTest, DynamicsDerivativesFixedBase)
+{
+    typedef FixBaseFDSystem<TestIrb4600::Dynamics> IrbSystem;
+
+    const size_t STATE_DIM = IrbSystem::STATE_DIM;
+    const size_t CONTROL_DIM = IrbSystem::CONTROL_DIM;
+
+    std::shared_ptr<IrbSystem> irbSystem(new IrbSystem);
+
+    FixBaseFDLinearizer<IrbSystem> fdLinearizer;
+    core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(irbSystem, true);
+
+    // clones compute the same derivatives
+    std::shared_ptr<FixBaseFDLinearizer<IrbSystem>> fdLinearizerClone(fdLinearizer.clone());
+
+    core::StateVector<STATE_DIM> x;
+    core::ControlVector<CONTROL_DIM> u;
+
+    size_t nTests = 500;
+    for (size_t i = 0; i < nTests; i++)
+    {
+        x.setRandom();
+        u.setRandom();
+
+        auto A_fd = fdLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_fd = fdLinearizer.getDerivativeControl(x, u, 0.0);
+
+        auto A_system = systemLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_system = systemLinearizer.getDerivativeControl(x, u, 0.0);
+
+        ASSERT_LT((A_fd - A_system).array().abs().maxCoeff(), 1e-5);
+        ASSERT_LT((B_fd - B_system).array().abs().maxCoeff(), 1e-4);
+
+        ASSERT_TRUE(A_fd.isApprox(fdLinearizerClone->getDerivativeState(x, u, 0.0)));
+        ASSERT_TRUE(B_fd.isApprox(fdLinearizerClone->getDerivativeControl(x, u, 0.0)));
+    }
+
+    // the inverse dynamics derivatives are consistent with the forward dynamics derivatives
+    DynamicsDerivatives<TestIrb4600::Dynamics> derivatives;
+    typedef DynamicsDerivatives<TestIrb4600::Dynamics>::joint_matrix_t joint_matrix_t;
+
+    TestIrb4600::Dynamics::JointState_t jointState(x);
+    TestIrb4600::Dynamics::ExtLinkForces_t force(Eigen::Matrix<double, 6, 1>::Zero());
+    TestIrb4600::Dynamics::JointAcceleration_t qdd;
+    irbSystem->dynamics().FixBaseForwardDynamics(jointState, u, force, qdd);
+
+    joint_matrix_t dTau_dq, dTau_dqd, dTau_dqdd;
+    derivatives.computeIDDerivatives(jointState, qdd, force, dTau_dq, dTau_dqd, dTau_dqdd);
+
+    joint_matrix_t dQdd_dq, dQdd_dqd, dQdd_du;
+    derivatives.computeFDDerivatives(jointState, u, force, dQdd_dq, dQdd_dqd, dQdd_du);
+
+    // the joint space inertia matrix from the composite inertias matches the generated one
+    ASSERT_TRUE(dTau_dqdd.isApprox(
+        irbSystem->dynamics().kinematics().robcogen().jSim().update(jointState.getPositions()), 1e-10));
+
+    ASSERT_TRUE((dTau_dqdd * dQdd_du).isApprox(joint_matrix_t::Identity(), 1e-8));
+    ASSERT_LT((dTau_dqdd * dQdd_dq + dTau_dq).array().abs().maxCoeff(), 1e-8);
+    ASSERT_LT((dTau_dqdd * dQdd_dqd + dTau_dqd).array().abs().maxCoeff(), 1e-8);
+}
+
+TEST(RBDLinearizerTest, DynamicsDerivativesBranchedPrismatic)
+{
+    typedef FixBaseFDSystem<TestBranched::Dynamics> BranchedSystem;
+
+    const size_t STATE_DIM = BranchedSystem::STATE_DIM;
+    const size_t CONTROL_DIM = BranchedSystem::CONTROL_DIM;
+
+    std::shared_ptr<BranchedSystem> branchedSystem(new BranchedSystem);
+
+    FixBaseFDLinearizer<BranchedSystem> fdLinearizer;
+    core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(branchedSystem, true);
+
+    core::StateVector<STATE_DIM> x;
+    core::ControlVector<CONTROL_DIM> u;
+
+    size_t nTests = 500;
+    for (size_t i = 0; i < nTests; i++)
+    {
+        x.setRandom();
+        u.setRandom();
+
+        auto A_fd = fdLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_fd = fdLinearizer.getDerivativeControl(x, u, 0.0);
+
+        auto A_system = systemLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_system = systemLinearizer.getDerivativeControl(x, u, 0.0);
+
+        ASSERT_LT((A_fd - A_system).array().abs().maxCoeff(), 1e-5);
+        ASSERT_LT((B_fd - B_system).array().abs().maxCoeff(), 1e-4);
+    }
+
+    DynamicsDerivatives<TestBranched::Dynamics> derivatives;
+    typedef DynamicsDerivatives<TestBranched::Dynamics>::joint_matrix_t joint_matrix_t;
+
+    TestBranched::Dynamics::JointState_t jointState(x);
+    TestBranched::Dynamics::ExtLinkForces_t force(Eigen::Matrix<double, 6, 1>::Zero());
+    TestBranched::Dynamics::JointAcceleration_t qdd;
+    branchedSystem->dynamics().FixBaseForwardDynamics(jointState, u, force, qdd);
+
+    joint_matrix_t dTau_dq, dTau_dqd, dTau_dqdd;
+    derivatives.computeIDDerivatives(jointState, qdd, force, dTau_dq, dTau_dqd, dTau_dqdd);
+
+    // the two branches do not couple
+    ASSERT_EQ(dTau_dqdd(1, 2), 0.0);
+    ASSERT_TRUE(dTau_dqdd.isApprox(
+        branchedSystem->dynamics().kinematics().robcogen().jSim().update(jointState.getPositions()), 1e-10));
+
+    // a robot definition which misses the branch and the prismatic joint is rejected
+    ASSERT_THROW(DynamicsDerivatives<TestBranchedAsSerial::Dynamics>(), std::runtime_error);
+}
+
 TEST(RBDLinearizerTest, NumDiffComparisonFloatingBase)
 {
     typedef FloatingBaseFDSystem<TestHyQ::Dynamics, false, false> HyQSystem;